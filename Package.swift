@@ -52,6 +52,9 @@ let package = Package(
             cSettings: [
                 .define("MARKETING_VERSION", to: "\"\(ProjectSettings.marketingVersion)\""),
                 .define("NS_BLOCK_ASSERTIONS", to: "1", .when(configuration: .release))
+            ],
+            linkerSettings: [
+                .linkedLibrary("z")
             ]
         ),
         .target(
@@ -91,6 +94,21 @@ let package = Package(
             cSettings: [
                 .headerSearchPath("Private")
             ]
+        ),
+        .testTarget(
+            name: "SRGAnalyticsBenchmarks",
+            dependencies: ["SRGAnalytics"],
+            cSettings: [
+                .headerSearchPath("Private"),
+                .define("NS_BLOCK_ASSERTIONS", to: "1")
+            ]
+        ),
+        .testTarget(
+            name: "SRGAnalyticsLoadTests",
+            dependencies: ["SRGAnalytics"],
+            cSettings: [
+                .headerSearchPath("Private")
+            ]
         )
     ]
 )
@@ -0,0 +1,314 @@
+#!/usr/bin/swift
+
+/**
+ * Labels known to the library are stored in fixed slots of event records, so that their keys never need to be
+ * hashed and their values can be kept in native form until events are encoded.
+ *
+ * This script reads the label schema (SRGAnalyticsLabelSchema.json) and generates the corresponding label catalog
+ * (slots, keys and types) as well as typed event record setters. Run it from the repository root after updating
+ * the schema:
+ *
+ *     Scripts/SRGAnalyticsLabelCatalogGenerator.swift [schema.json] [output directory]
+ *
+ * Generated files must be committed.
+ */
+
+import Foundation
+
+/* Default schema and output locations, relative to the repository root. */
+let arguments = CommandLine.arguments
+let schemaPath = arguments.count > 1 ? arguments[1] : "Scripts/SRGAnalyticsLabelSchema.json"
+let outputPath = arguments.count > 2 ? arguments[2] : "Sources/SRGAnalytics"
+
+struct Label {
+    let name: String
+    let key: String
+    let type: String
+    let count: Int?
+}
+
+struct LabelType {
+    let enumName: String
+    let parameterType: String
+    let setterName: String
+}
+
+let labelTypes = [
+    "string": LabelType(enumName: "SRGAnalyticsLabelTypeString", parameterType: "nullable NSString *", setterName: "setString"),
+    "integer": LabelType(enumName: "SRGAnalyticsLabelTypeInteger", parameterType: "int64_t", setterName: "setInteger"),
+    "double": LabelType(enumName: "SRGAnalyticsLabelTypeDouble", parameterType: "double", setterName: "setDouble"),
+    "boolean": LabelType(enumName: "SRGAnalyticsLabelTypeBoolean", parameterType: "BOOL", setterName: "setBoolean")
+]
+
+func fail(_ message: String) -> Never {
+    print("❌ \(message)")
+    exit(1)
+}
+
+func loadLabels() -> [Label] {
+    guard let data = FileManager.default.contents(atPath: schemaPath) else {
+        fail("Could not read schema file \(schemaPath).")
+    }
+    guard let json = try? JSONSerialization.jsonObject(with: data, options: []) as? [String: Any],
+          let entries = json["labels"] as? [[String: Any]] else {
+        fail("The schema file is not valid.")
+    }
+    return entries.map { entry in
+        guard let name = entry["name"] as? String, let key = entry["key"] as? String, let type = entry["type"] as? String else {
+            fail("Invalid label entry \(entry).")
+        }
+        guard labelTypes[type] != nil else {
+            fail("Unknown type \(type) for label \(name).")
+        }
+        let count = entry["count"] as? Int
+        if count != nil && !key.contains("%d") {
+            fail("The key of indexed label \(name) must contain a %d placeholder.")
+        }
+        return Label(name: name, key: key, type: type, count: count)
+    }
+}
+
+func lowercasedFirst(_ string: String) -> String {
+    return string.prefix(1).lowercased() + string.dropFirst()
+}
+
+/* Expand indexed labels into their individual slots, returning (slot name, key, type) triples. */
+func slots(for labels: [Label]) -> [(String, String, String)] {
+    return labels.flatMap { label -> [(String, String, String)] in
+        if let count = label.count {
+            return (1...count).map { ("SRGAnalyticsLabelSlot\(label.name)\($0)", label.key.replacingOccurrences(of: "%d", with: "\($0)"), label.type) }
+        }
+        else {
+            return [("SRGAnalyticsLabelSlot\(label.name)", label.key, label.type)]
+        }
+    }
+}
+
+let copyright = """
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+// Generated by Scripts/SRGAnalyticsLabelCatalogGenerator.swift from Scripts/SRGAnalyticsLabelSchema.json. Do not edit.
+
+
+"""
+
+func catalogHeader(for labels: [Label]) -> String {
+    let slotList = slots(for: labels)
+    var output = copyright
+    output += """
+    @import Foundation;
+
+    NS_ASSUME_NONNULL_BEGIN
+
+    /**
+     *  Label value types.
+     */
+    typedef NS_ENUM(NSInteger, SRGAnalyticsLabelType) {
+        /**
+         *  String.
+         */
+        SRGAnalyticsLabelTypeString = 0,
+        /**
+         *  Integer, formatted in base 10.
+         */
+        SRGAnalyticsLabelTypeInteger,
+        /**
+         *  Floating-point number, formatted like `NSNumber`.
+         */
+        SRGAnalyticsLabelTypeDouble,
+        /**
+         *  Boolean, formatted as `true` or `false`.
+         */
+        SRGAnalyticsLabelTypeBoolean
+    };
+
+    /**
+     *  Slots of labels known to the library.
+     */
+    typedef NS_ENUM(NSInteger, SRGAnalyticsLabelSlot) {
+
+    """
+    for (index, slot) in slotList.enumerated() {
+        output += index == 0 ? "    \(slot.0) = 0,\n" : "    \(slot.0),\n"
+    }
+    output += "    SRGAnalyticsLabelSlotCount\n};\n\n"
+    for label in labels {
+        if let count = label.count {
+            output += "static const NSUInteger SRGAnalyticsLabel\(label.name)Count = \(count);\n"
+        }
+    }
+    output += """
+
+    /**
+     *  Key of the label stored in the specified slot.
+     */
+    OBJC_EXPORT NSString *SRGAnalyticsLabelKeyForSlot(SRGAnalyticsLabelSlot slot);
+
+    /**
+     *  Type of the label stored in the specified slot.
+     */
+    OBJC_EXPORT SRGAnalyticsLabelType SRGAnalyticsLabelTypeForSlot(SRGAnalyticsLabelSlot slot);
+
+    /**
+     *  Slot of the label with the specified key, `NSNotFound` if the label is not known.
+     */
+    OBJC_EXPORT NSInteger SRGAnalyticsLabelSlotForKey(NSString *key);
+
+    NS_ASSUME_NONNULL_END
+
+    """
+    return output
+}
+
+func catalogImplementation(for labels: [Label]) -> String {
+    let slotList = slots(for: labels)
+    var output = copyright
+    output += """
+    #import "SRGAnalyticsLabelCatalog.h"
+
+    static __unsafe_unretained NSString * const s_keys[SRGAnalyticsLabelSlotCount] = {
+
+    """
+    for slot in slotList {
+        output += "    @\"\(slot.1)\",\n"
+    }
+    output += "};\n\nstatic const SRGAnalyticsLabelType s_types[SRGAnalyticsLabelSlotCount] = {\n"
+    for slot in slotList {
+        output += "    \(labelTypes[slot.2]!.enumName),\n"
+    }
+    output += """
+    };
+
+    NSString *SRGAnalyticsLabelKeyForSlot(SRGAnalyticsLabelSlot slot)
+    {
+        NSCParameterAssert(slot >= 0 && slot < SRGAnalyticsLabelSlotCount);
+        return s_keys[slot];
+    }
+
+    SRGAnalyticsLabelType SRGAnalyticsLabelTypeForSlot(SRGAnalyticsLabelSlot slot)
+    {
+        NSCParameterAssert(slot >= 0 && slot < SRGAnalyticsLabelSlotCount);
+        return s_types[slot];
+    }
+
+    NSInteger SRGAnalyticsLabelSlotForKey(NSString *key)
+    {
+        static NSDictionary<NSString *, NSNumber *> *s_slots;
+        static dispatch_once_t s_onceToken;
+        dispatch_once(&s_onceToken, ^{
+            NSMutableDictionary<NSString *, NSNumber *> *slots = [NSMutableDictionary dictionaryWithCapacity:SRGAnalyticsLabelSlotCount];
+            for (NSInteger slot = 0; slot < SRGAnalyticsLabelSlotCount; ++slot) {
+                slots[s_keys[slot]] = @(slot);
+            }
+            s_slots = slots.copy;
+        });
+        
+        NSNumber *slot = s_slots[key];
+        return slot ? slot.integerValue : NSNotFound;
+    }
+
+    """
+    return output
+}
+
+func recordHeader(for labels: [Label]) -> String {
+    var output = copyright
+    output += """
+    #import "SRGAnalyticsEventRecord.h"
+
+    NS_ASSUME_NONNULL_BEGIN
+
+    /**
+     *  Typed setters for labels known to the library.
+     */
+    @interface SRGAnalyticsEventRecord (Catalog)
+
+
+    """
+    for label in labels {
+        let type = labelTypes[label.type]!
+        let parameterName = lowercasedFirst(label.name)
+        if let count = label.count {
+            output += """
+            /**
+             *  `\(label.key.replacingOccurrences(of: "%d", with: "<index + 1>"))` label, for indexes from 0 to \(count - 1).
+             */
+            - (void)set\(label.name):(\(type.parameterType))\(parameterName) atIndex:(NSUInteger)index;
+
+
+            """
+        }
+        else {
+            output += """
+            /**
+             *  `\(label.key)` label.
+             */
+            - (void)set\(label.name):(\(type.parameterType))\(parameterName);
+
+
+            """
+        }
+    }
+    output += "@end\n\nNS_ASSUME_NONNULL_END\n"
+    return output
+}
+
+func recordImplementation(for labels: [Label]) -> String {
+    var output = copyright
+    output += """
+    #import "SRGAnalyticsEventRecord+Catalog.h"
+
+    @implementation SRGAnalyticsEventRecord (Catalog)
+
+
+    """
+    for label in labels {
+        let type = labelTypes[label.type]!
+        let parameterType = type.parameterType.replacingOccurrences(of: "nullable ", with: "")
+        let parameterName = lowercasedFirst(label.name)
+        if label.count != nil {
+            output += """
+            - (void)set\(label.name):(\(parameterType))\(parameterName) atIndex:(NSUInteger)index
+            {
+                NSParameterAssert(index < SRGAnalyticsLabel\(label.name)Count);
+                [self \(type.setterName):\(parameterName) forSlot:SRGAnalyticsLabelSlot\(label.name)1 + index];
+            }
+
+
+            """
+        }
+        else {
+            output += """
+            - (void)set\(label.name):(\(parameterType))\(parameterName)
+            {
+                [self \(type.setterName):\(parameterName) forSlot:SRGAnalyticsLabelSlot\(label.name)];
+            }
+
+
+            """
+        }
+    }
+    output += "@end\n"
+    return output
+}
+
+func write(_ content: String, to fileName: String) {
+    let path = (outputPath as NSString).appendingPathComponent(fileName)
+    do {
+        try content.write(toFile: path, atomically: true, encoding: .utf8)
+        print("💾 Generated \(path)")
+    } catch {
+        fail("Could not write \(path).")
+    }
+}
+
+let labels = loadLabels()
+write(catalogHeader(for: labels), to: "SRGAnalyticsLabelCatalog.h")
+write(catalogImplementation(for: labels), to: "SRGAnalyticsLabelCatalog.m")
+write(recordHeader(for: labels), to: "SRGAnalyticsEventRecord+Catalog.h")
+write(recordImplementation(for: labels), to: "SRGAnalyticsEventRecord+Catalog.m")
+print("Done. Thanks. Bye. 🎉")
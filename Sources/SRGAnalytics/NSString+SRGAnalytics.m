@@ -6,24 +6,229 @@
 
 #import "NSString+SRGAnalytics.h"
 
+#import <pthread.h>
+
+// Strings are formatted using stack buffers up to this length
+static const NSUInteger SRGAnalyticsFormattingBufferLength = 256;
+
+// Formatted strings are cached (least recently used ones being evicted first) up to this count. Longer strings are
+// not cached.
+static const NSUInteger SRGAnalyticsFormattedStringCacheCapacity = 512;
+static const NSUInteger SRGAnalyticsFormattedStringCacheMaximumLength = 256;
+
+@interface SRGAnalyticsFormattedStringCacheEntry : NSObject
+
+@property (nonatomic, copy) NSString *string;
+@property (nonatomic, copy) NSString *formattedString;
+
+// Entries are retained by the cache dictionary
+@property (nonatomic, unsafe_unretained) SRGAnalyticsFormattedStringCacheEntry *previousEntry;
+@property (nonatomic, unsafe_unretained) SRGAnalyticsFormattedStringCacheEntry *nextEntry;
+
+@end
+
+static pthread_mutex_t s_cacheMutex = PTHREAD_MUTEX_INITIALIZER;
+static NSMutableDictionary<NSString *, SRGAnalyticsFormattedStringCacheEntry *> *s_cacheEntries;
+static SRGAnalyticsFormattedStringCacheEntry *s_mostRecentCacheEntry;
+static SRGAnalyticsFormattedStringCacheEntry *s_leastRecentCacheEntry;
+
+static NSString *SRGAnalyticsFormattedString(NSString *string);
+static NSString *SRGAnalyticsCachedFormattedString(NSString *string);
+static void SRGAnalyticsCacheFormattedString(NSString *string, NSString *formattedString);
+
 @implementation NSString (SRGAnalytics)
 
 - (NSString *)srg_comScoreFormattedString
 {
-    // Remove accentuated characters
-    NSLocale *posixLocale = [[NSLocale alloc] initWithLocaleIdentifier:@"en_US_POSIX"];
-    NSString *normalizedString = [self.lowercaseString stringByFoldingWithOptions:NSDiacriticInsensitiveSearch locale:posixLocale];
+    if (self.length > SRGAnalyticsFormattedStringCacheMaximumLength) {
+        return SRGAnalyticsFormattedString(self);
+    }
     
-    // See rules at https://confluence.srg.beecollaboration.com/display/SRGPLAY/Measurement+of+SRG+Player+Apps#MeasurementofSRGPlayerApps-SupportedCharacters
-    NSCharacterSet *andSet = [NSCharacterSet characterSetWithCharactersInString:@"+&"];
-    normalizedString = [[normalizedString componentsSeparatedByCharactersInSet:andSet] componentsJoinedByString:@"and"];
+    NSString *formattedString = SRGAnalyticsCachedFormattedString(self);
+    if (! formattedString) {
+        formattedString = SRGAnalyticsFormattedString(self);
+        SRGAnalyticsCacheFormattedString(self, formattedString);
+    }
+    return formattedString;
+}
+
+@end
+
+@implementation SRGAnalyticsFormattedStringCacheEntry
+
+@end
+
+#pragma mark Formatting
+
+// Single scan performing the following (see rules at https://confluence.srg.beecollaboration.com/display/SRGPLAY/Measurement+of+SRG+Player+Apps#MeasurementofSRGPlayerApps-SupportedCharacters):
+//   - Replace `+` and `&` with `and`.
+//   - Squash all non-alphanumeric characters as a single hyphen.
+//   - Trim hyphens at both ends, if any.
+// ASCII uppercase letters are lowercased first if requested. The output buffer must be able to hold 3 characters
+// per input character. Return the output length.
+static NSUInteger SRGAnalyticsFormatCharacters(const unichar *characters, NSUInteger length, BOOL lowercase, char *output)
+{
+    NSUInteger outputLength = 0;
+    BOOL pendingHyphen = NO;
     
-    // Squash all non-alphanumeric characters as a single hyphen
-    NSRegularExpression *regularExpression = [NSRegularExpression regularExpressionWithPattern:@"[^a-z0-9]+" options:0 error:NULL];
-    normalizedString = [regularExpression stringByReplacingMatchesInString:normalizedString options:0 range:NSMakeRange(0, normalizedString.length) withTemplate:@"-"];
+    for (NSUInteger i = 0; i < length; ++i) {
+        unichar character = characters[i];
+        if (lowercase && character >= 'A' && character <= 'Z') {
+            character += 'a' - 'A';
+        }
+        
+        BOOL isAlphanumeric = (character >= 'a' && character <= 'z') || (character >= '0' && character <= '9');
+        BOOL isAnd = (character == '+' || character == '&');
+        if (! isAlphanumeric && ! isAnd) {
+            pendingHyphen = YES;
+            continue;
+        }
+        
+        // Hyphens are only written between alphanumeric characters, which trims them at both ends
+        if (pendingHyphen && outputLength != 0) {
+            output[outputLength++] = '-';
+        }
+        pendingHyphen = NO;
+        
+        if (isAnd) {
+            output[outputLength++] = 'a';
+            output[outputLength++] = 'n';
+            output[outputLength++] = 'd';
+        }
+        else {
+            output[outputLength++] = (char)character;
+        }
+    }
     
-    // Trim hyphens at both ends, if any
-    return [normalizedString stringByTrimmingCharactersInSet:[NSCharacterSet characterSetWithCharactersInString:@"-"]];
+    return outputLength;
 }
 
-@end
+static NSString *SRGAnalyticsFormattedString(NSString *string)
+{
+    static NSLocale *s_posixLocale;
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        s_posixLocale = [[NSLocale alloc] initWithLocaleIdentifier:@"en_US_POSIX"];
+    });
+    
+    NSUInteger length = string.length;
+    if (length == 0) {
+        return @"";
+    }
+    
+    unichar stackCharacters[SRGAnalyticsFormattingBufferLength];
+    char stackOutput[3 * SRGAnalyticsFormattingBufferLength];
+    
+    unichar *characters = (length <= SRGAnalyticsFormattingBufferLength) ? stackCharacters : malloc(length * sizeof(unichar));
+    [string getCharacters:characters range:NSMakeRange(0, length)];
+    
+    BOOL isASCII = YES;
+    for (NSUInteger i = 0; i < length; ++i) {
+        if (characters[i] > 0x7f) {
+            isASCII = NO;
+            break;
+        }
+    }
+    
+    // Non-ASCII strings are lowercased and have their diacritics removed first. Lowercasing and folding ASCII
+    // strings reduces to lowercasing letters, which can be performed while scanning.
+    if (! isASCII) {
+        if (characters != stackCharacters) {
+            free(characters);
+        }
+        
+        string = [string.lowercaseString stringByFoldingWithOptions:NSDiacriticInsensitiveSearch locale:s_posixLocale];
+        length = string.length;
+        
+        characters = (length <= SRGAnalyticsFormattingBufferLength) ? stackCharacters : malloc(length * sizeof(unichar));
+        [string getCharacters:characters range:NSMakeRange(0, length)];
+    }
+    
+    char *output = (length <= SRGAnalyticsFormattingBufferLength) ? stackOutput : malloc(3 * length);
+    NSUInteger outputLength = SRGAnalyticsFormatCharacters(characters, length, isASCII, output);
+    NSString *formattedString = [[NSString alloc] initWithBytes:output length:outputLength encoding:NSASCIIStringEncoding];
+    
+    if (characters != stackCharacters) {
+        free(characters);
+    }
+    if (output != stackOutput) {
+        free(output);
+    }
+    
+    return formattedString;
+}
+
+#pragma mark Cache
+
+static void SRGAnalyticsDetachCacheEntry(SRGAnalyticsFormattedStringCacheEntry *entry)
+{
+    if (entry.previousEntry) {
+        entry.previousEntry.nextEntry = entry.nextEntry;
+    }
+    else {
+        s_mostRecentCacheEntry = entry.nextEntry;
+    }
+    
+    if (entry.nextEntry) {
+        entry.nextEntry.previousEntry = entry.previousEntry;
+    }
+    else {
+        s_leastRecentCacheEntry = entry.previousEntry;
+    }
+    
+    entry.previousEntry = nil;
+    entry.nextEntry = nil;
+}
+
+static void SRGAnalyticsAttachCacheEntry(SRGAnalyticsFormattedStringCacheEntry *entry)
+{
+    entry.nextEntry = s_mostRecentCacheEntry;
+    s_mostRecentCacheEntry.previousEntry = entry;
+    s_mostRecentCacheEntry = entry;
+    
+    if (! s_leastRecentCacheEntry) {
+        s_leastRecentCacheEntry = entry;
+    }
+}
+
+static NSString *SRGAnalyticsCachedFormattedString(NSString *string)
+{
+    pthread_mutex_lock(&s_cacheMutex);
+    
+    SRGAnalyticsFormattedStringCacheEntry *entry = s_cacheEntries[string];
+    if (entry && entry != s_mostRecentCacheEntry) {
+        SRGAnalyticsDetachCacheEntry(entry);
+        SRGAnalyticsAttachCacheEntry(entry);
+    }
+    NSString *formattedString = entry.formattedString;
+    
+    pthread_mutex_unlock(&s_cacheMutex);
+    return formattedString;
+}
+
+static void SRGAnalyticsCacheFormattedString(NSString *string, NSString *formattedString)
+{
+    pthread_mutex_lock(&s_cacheMutex);
+    
+    if (! s_cacheEntries) {
+        s_cacheEntries = [NSMutableDictionary dictionaryWithCapacity:SRGAnalyticsFormattedStringCacheCapacity];
+    }
+    
+    // Another thread might have cached the same string in the meantime
+    if (! s_cacheEntries[string]) {
+        SRGAnalyticsFormattedStringCacheEntry *entry = [[SRGAnalyticsFormattedStringCacheEntry alloc] init];
+        entry.string = string;
+        entry.formattedString = formattedString;
+        
+        s_cacheEntries[entry.string] = entry;
+        SRGAnalyticsAttachCacheEntry(entry);
+        
+        if (s_cacheEntries.count > SRGAnalyticsFormattedStringCacheCapacity) {
+            SRGAnalyticsFormattedStringCacheEntry *leastRecentEntry = s_leastRecentCacheEntry;
+            SRGAnalyticsDetachCacheEntry(leastRecentEntry);
+            [s_cacheEntries removeObjectForKey:leastRecentEntry.string];
+        }
+    }
+    
+    pthread_mutex_unlock(&s_cacheMutex);
+}
@@ -0,0 +1,72 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+@import Foundation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Statistics accumulated for an event name and a set of dimension labels.
+ */
+@interface SRGAnalyticsAggregate : NSObject
+
+/**
+ *  The event name.
+ */
+@property (nonatomic, readonly, copy) NSString *name;
+
+/**
+ *  The dimension labels.
+ */
+@property (nonatomic, readonly, copy) NSDictionary<NSString *, NSString *> *dimensions;
+
+/**
+ *  The number of occurrences.
+ */
+@property (nonatomic, readonly) NSUInteger count;
+
+/**
+ *  The number of occurrences for which a value was provided. Sum, minimum and maximum are meaningless if zero.
+ */
+@property (nonatomic, readonly) NSUInteger valueCount;
+
+/**
+ *  Sum, minimum and maximum of the provided values.
+ */
+@property (nonatomic, readonly) double sum;
+@property (nonatomic, readonly) double minimum;
+@property (nonatomic, readonly) double maximum;
+
+/**
+ *  Labels summarizing the aggregate, including dimensions.
+ */
+@property (nonatomic, readonly) NSDictionary<NSString *, NSString *> *labelsDictionary;
+
+@end
+
+/**
+ *  Accumulates occurrences of events in memory, grouped by event name and dimension labels. Thread-safe.
+ */
+@interface SRGAnalyticsAggregator : NSObject
+
+/**
+ *  Record an occurrence of an event, without value.
+ */
+- (void)addOccurrenceWithName:(NSString *)name dimensions:(nullable NSDictionary<NSString *, NSString *> *)dimensions;
+
+/**
+ *  Record an occurrence of an event, with value.
+ */
+- (void)addOccurrenceWithName:(NSString *)name dimensions:(nullable NSDictionary<NSString *, NSString *> *)dimensions value:(double)value;
+
+/**
+ *  Return all aggregates accumulated since the last call, in no specific order, and start over.
+ */
+- (NSArray<SRGAnalyticsAggregate *> *)takeAggregates;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,189 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsAggregator.h"
+
+#import <pthread.h>
+
+@interface SRGAnalyticsAggregationKey : NSObject <NSCopying>
+
+- (instancetype)initWithName:(NSString *)name dimensions:(nullable NSDictionary<NSString *, NSString *> *)dimensions;
+
+@property (nonatomic, readonly, copy) NSString *name;
+@property (nonatomic, readonly, copy) NSDictionary<NSString *, NSString *> *dimensions;
+
+@end
+
+@interface SRGAnalyticsAggregate ()
+
+@property (nonatomic, copy) NSString *name;
+@property (nonatomic, copy) NSDictionary<NSString *, NSString *> *dimensions;
+@property (nonatomic) NSUInteger count;
+@property (nonatomic) NSUInteger valueCount;
+@property (nonatomic) double sum;
+@property (nonatomic) double minimum;
+@property (nonatomic) double maximum;
+
+@end
+
+@interface SRGAnalyticsAggregator ()
+
+@property (nonatomic) NSMutableDictionary<SRGAnalyticsAggregationKey *, SRGAnalyticsAggregate *> *aggregates;
+
+@end
+
+@implementation SRGAnalyticsAggregator {
+@private
+    pthread_mutex_t _mutex;
+}
+
+#pragma mark Object lifecycle
+
+- (instancetype)init
+{
+    if (self = [super init]) {
+        pthread_mutex_init(&_mutex, NULL);
+        self.aggregates = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    pthread_mutex_destroy(&_mutex);
+}
+
+#pragma mark Accumulation
+
+- (void)addOccurrenceWithName:(NSString *)name dimensions:(NSDictionary<NSString *, NSString *> *)dimensions
+{
+    [self addOccurrenceWithName:name dimensions:dimensions value:NAN];
+}
+
+- (void)addOccurrenceWithName:(NSString *)name dimensions:(NSDictionary<NSString *, NSString *> *)dimensions value:(double)value
+{
+    SRGAnalyticsAggregationKey *key = [[SRGAnalyticsAggregationKey alloc] initWithName:name dimensions:dimensions];
+    
+    pthread_mutex_lock(&_mutex);
+    
+    SRGAnalyticsAggregate *aggregate = self.aggregates[key];
+    if (! aggregate) {
+        aggregate = [[SRGAnalyticsAggregate alloc] init];
+        aggregate.name = key.name;
+        aggregate.dimensions = key.dimensions;
+        self.aggregates[key] = aggregate;
+    }
+    
+    aggregate.count += 1;
+    
+    // NaN is used internally for occurrences without value
+    if (! isnan(value)) {
+        if (aggregate.valueCount == 0) {
+            aggregate.minimum = value;
+            aggregate.maximum = value;
+        }
+        else {
+            aggregate.minimum = fmin(aggregate.minimum, value);
+            aggregate.maximum = fmax(aggregate.maximum, value);
+        }
+        aggregate.sum += value;
+        aggregate.valueCount += 1;
+    }
+    
+    pthread_mutex_unlock(&_mutex);
+}
+
+- (NSArray<SRGAnalyticsAggregate *> *)takeAggregates
+{
+    pthread_mutex_lock(&_mutex);
+    NSMutableDictionary<SRGAnalyticsAggregationKey *, SRGAnalyticsAggregate *> *aggregates = self.aggregates;
+    self.aggregates = [NSMutableDictionary dictionary];
+    pthread_mutex_unlock(&_mutex);
+    
+    return aggregates.allValues;
+}
+
+@end
+
+@implementation SRGAnalyticsAggregate
+
+#pragma mark Getters and setters
+
+- (NSDictionary<NSString *, NSString *> *)labelsDictionary
+{
+    NSMutableDictionary<NSString *, NSString *> *dictionary = self.dimensions.mutableCopy;
+    dictionary[@"event_count"] = @(self.count).stringValue;
+    if (self.valueCount != 0) {
+        dictionary[@"event_value_count"] = @(self.valueCount).stringValue;
+        dictionary[@"event_value_sum"] = @(self.sum).stringValue;
+        dictionary[@"event_value_min"] = @(self.minimum).stringValue;
+        dictionary[@"event_value_max"] = @(self.maximum).stringValue;
+    }
+    return dictionary.copy;
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; name = %@; dimensions = %@; count = %@; valueCount = %@; sum = %@; minimum = %@; maximum = %@>",
+            self.class,
+            self,
+            self.name,
+            self.dimensions,
+            @(self.count),
+            @(self.valueCount),
+            @(self.sum),
+            @(self.minimum),
+            @(self.maximum)];
+}
+
+@end
+
+@implementation SRGAnalyticsAggregationKey
+
+#pragma mark Object lifecycle
+
+- (instancetype)initWithName:(NSString *)name dimensions:(NSDictionary<NSString *, NSString *> *)dimensions
+{
+    if (self = [super init]) {
+        _name = name.copy;
+        _dimensions = dimensions.copy ?: @{};
+    }
+    return self;
+}
+
+#pragma mark Equality
+
+- (BOOL)isEqual:(id)object
+{
+    if (! [object isKindOfClass:self.class]) {
+        return NO;
+    }
+    
+    SRGAnalyticsAggregationKey *otherKey = object;
+    return [self.name isEqualToString:otherKey.name] && [self.dimensions isEqualToDictionary:otherKey.dimensions];
+}
+
+- (NSUInteger)hash
+{
+    // Dictionary hashes only depend on their count, mix in key hashes to spread dimension combinations
+    __block NSUInteger hash = self.name.hash;
+    [self.dimensions enumerateKeysAndObjectsUsingBlock:^(NSString * _Nonnull key, NSString * _Nonnull value, BOOL * _Nonnull stop) {
+        hash ^= key.hash * 31 + value.hash;
+    }];
+    return hash;
+}
+
+#pragma mark NSCopying protocol
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    // Immutable
+    return self;
+}
+
+@end
@@ -0,0 +1,77 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+@import Foundation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Completion handler called with the application list JSON data, or an error if no list is available.
+ */
+typedef void (^SRGAnalyticsApplicationListCompletionHandler)(NSData * _Nullable data, NSError * _Nullable error);
+
+/**
+ *  Return a fingerprint identifying a set of installed applications, independent of their order.
+ */
+OBJC_EXPORT NSString *SRGAnalyticsInstalledApplicationsFingerprint(NSArray<NSString *> *applications);
+
+/**
+ *  Disk cache for the remote list of SRG SSR applications, together with the fingerprint of the last reported set of
+ *  installed applications.
+ *
+ *  The list is revalidated with a conditional request (`If-None-Match`) once its time to live has expired, the cached
+ *  copy being used as fallback if revalidation fails.
+ *
+ *  @discussion Must be used from the main thread. Completion handlers are called on the main thread.
+ */
+@interface SRGAnalyticsApplicationListCache : NSObject
+
+/**
+ *  Create a cache for the list available at the specified URL, stored in the specified directory (created if
+ *  needed). Cached data retrieved from another URL is ignored.
+ */
+- (instancetype)initWithURL:(NSURL *)URL directoryURL:(NSURL *)directoryURL timeToLive:(NSTimeInterval)timeToLive NS_DESIGNATED_INITIALIZER;
+
+/**
+ *  The list URL.
+ */
+@property (nonatomic, readonly) NSURL *URL;
+
+/**
+ *  The cached list data, if any, whether fresh or not.
+ */
+@property (nonatomic, readonly, nullable) NSData *cachedData;
+
+/**
+ *  Return `YES` iff the list must be revalidated before use at the specified date.
+ */
+- (BOOL)needsRevalidationAtDate:(NSDate *)date;
+
+/**
+ *  Retrieve the list, from the cache if fresh, otherwise from the network.
+ */
+- (void)retrieveListWithSession:(NSURLSession *)session completionHandler:(SRGAnalyticsApplicationListCompletionHandler)completionHandler;
+
+/**
+ *  Return `YES` iff the specified fingerprint must be reported at the specified date, i.e. if it differs from the last
+ *  reported one, or if the last report is older than the specified interval.
+ */
+- (BOOL)shouldReportFingerprint:(NSString *)fingerprint atDate:(NSDate *)date minimumInterval:(NSTimeInterval)minimumInterval;
+
+/**
+ *  Record that a fingerprint has been reported at the specified date.
+ */
+- (void)setReportedFingerprint:(NSString *)fingerprint date:(NSDate *)date;
+
+@end
+
+@interface SRGAnalyticsApplicationListCache (Unavailable)
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,190 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsApplicationListCache.h"
+
+#import "SRGAnalyticsLogger.h"
+
+static NSString * const SRGAnalyticsApplicationListCacheURLKey = @"URL";
+static NSString * const SRGAnalyticsApplicationListCacheETagKey = @"ETag";
+static NSString * const SRGAnalyticsApplicationListCacheValidationDateKey = @"ValidationDate";
+static NSString * const SRGAnalyticsApplicationListCacheReportedFingerprintKey = @"ReportedFingerprint";
+static NSString * const SRGAnalyticsApplicationListCacheReportDateKey = @"ReportDate";
+
+NSString *SRGAnalyticsInstalledApplicationsFingerprint(NSArray<NSString *> *applications)
+{
+    NSArray<NSString *> *sortedApplications = [[NSSet setWithArray:applications].allObjects sortedArrayUsingSelector:@selector(compare:)];
+    NSData *data = [[sortedApplications componentsJoinedByString:@"\n"] dataUsingEncoding:NSUTF8StringEncoding];
+    
+    // FNV-1a
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    const uint8_t *bytes = data.bytes;
+    for (NSUInteger i = 0; i < data.length; ++i) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return [NSString stringWithFormat:@"%016llx", hash];
+}
+
+@interface SRGAnalyticsApplicationListCache ()
+
+@property (nonatomic) NSURL *URL;
+@property (nonatomic) NSURL *directoryURL;
+@property (nonatomic) NSTimeInterval timeToLive;
+
+@property (nonatomic) NSMutableDictionary<NSString *, id> *metadata;
+@property (nonatomic, nullable) NSData *cachedData;
+
+@end
+
+@implementation SRGAnalyticsApplicationListCache
+
+#pragma mark Object lifecycle
+
+- (instancetype)initWithURL:(NSURL *)URL directoryURL:(NSURL *)directoryURL timeToLive:(NSTimeInterval)timeToLive
+{
+    if (self = [super init]) {
+        self.URL = URL;
+        self.directoryURL = directoryURL;
+        self.timeToLive = timeToLive;
+        
+        [NSFileManager.defaultManager createDirectoryAtURL:directoryURL withIntermediateDirectories:YES attributes:nil error:NULL];
+        
+        NSDictionary<NSString *, id> *metadata = [NSDictionary dictionaryWithContentsOfURL:self.metadataFileURL];
+        self.metadata = metadata ? metadata.mutableCopy : [NSMutableDictionary dictionary];
+        
+        // Fingerprints remain valid when the list URL changes, cached lists do not
+        if ([self.metadata[SRGAnalyticsApplicationListCacheURLKey] isEqualToString:URL.absoluteString]) {
+            self.cachedData = [NSData dataWithContentsOfURL:self.dataFileURL];
+        }
+        else {
+            [self.metadata removeObjectForKey:SRGAnalyticsApplicationListCacheETagKey];
+            [self.metadata removeObjectForKey:SRGAnalyticsApplicationListCacheValidationDateKey];
+        }
+    }
+    return self;
+}
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-implementations"
+
+- (instancetype)init
+{
+    [self doesNotRecognizeSelector:_cmd];
+    return [self initWithURL:[NSURL URLWithString:@""] directoryURL:[NSURL fileURLWithPath:NSTemporaryDirectory()] timeToLive:0.];
+}
+
+#pragma clang diagnostic pop
+
+#pragma mark Getters and setters
+
+- (NSURL *)dataFileURL
+{
+    return [self.directoryURL URLByAppendingPathComponent:@"applications.json"];
+}
+
+- (NSURL *)metadataFileURL
+{
+    return [self.directoryURL URLByAppendingPathComponent:@"metadata.plist"];
+}
+
+#pragma mark List retrieval
+
+- (BOOL)needsRevalidationAtDate:(NSDate *)date
+{
+    NSDate *validationDate = self.metadata[SRGAnalyticsApplicationListCacheValidationDateKey];
+    return ! self.cachedData || ! validationDate || [date timeIntervalSinceDate:validationDate] >= self.timeToLive;
+}
+
+- (void)retrieveListWithSession:(NSURLSession *)session completionHandler:(SRGAnalyticsApplicationListCompletionHandler)completionHandler
+{
+    NSAssert(NSThread.isMainThread, @"The application list must be retrieved from the main thread");
+    
+    if (! [self needsRevalidationAtDate:NSDate.date]) {
+        completionHandler(self.cachedData, nil);
+        return;
+    }
+    
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:self.URL];
+    NSString *ETag = self.metadata[SRGAnalyticsApplicationListCacheETagKey];
+    if (ETag && self.cachedData) {
+        [request setValue:ETag forHTTPHeaderField:@"If-None-Match"];
+    }
+    
+    [[session dataTaskWithRequest:request completionHandler:^(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            NSHTTPURLResponse *HTTPResponse = [response isKindOfClass:NSHTTPURLResponse.class] ? (NSHTTPURLResponse *)response : nil;
+            if (! error && HTTPResponse.statusCode == 304) {
+                SRGAnalyticsLogDebug(@"tracker", @"The cached application list is still valid");
+                [self updateWithData:nil response:HTTPResponse];
+                completionHandler(self.cachedData, nil);
+            }
+            else if (! error && data && (! HTTPResponse || HTTPResponse.statusCode == 200)) {
+                [self updateWithData:data response:HTTPResponse];
+                completionHandler(data, nil);
+            }
+            else if (self.cachedData) {
+                SRGAnalyticsLogInfo(@"tracker", @"The application list could not be revalidated. The cached list is used instead");
+                completionHandler(self.cachedData, nil);
+            }
+            else {
+                NSError *listError = error ?: [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorBadServerResponse userInfo:nil];
+                completionHandler(nil, listError);
+            }
+        });
+    }] resume];
+}
+
+// Data is `nil` if the cached data is still valid
+- (void)updateWithData:(NSData *)data response:(NSHTTPURLResponse *)response
+{
+    if (data) {
+        if (! [data writeToURL:self.dataFileURL options:NSDataWritingAtomic error:NULL]) {
+            return;
+        }
+        self.cachedData = data;
+        self.metadata[SRGAnalyticsApplicationListCacheURLKey] = self.URL.absoluteString;
+        self.metadata[SRGAnalyticsApplicationListCacheETagKey] = response.allHeaderFields[@"ETag"];
+    }
+    self.metadata[SRGAnalyticsApplicationListCacheValidationDateKey] = NSDate.date;
+    [self saveMetadata];
+}
+
+#pragma mark Fingerprints
+
+- (BOOL)shouldReportFingerprint:(NSString *)fingerprint atDate:(NSDate *)date minimumInterval:(NSTimeInterval)minimumInterval
+{
+    NSString *reportedFingerprint = self.metadata[SRGAnalyticsApplicationListCacheReportedFingerprintKey];
+    NSDate *reportDate = self.metadata[SRGAnalyticsApplicationListCacheReportDateKey];
+    return ! [fingerprint isEqualToString:reportedFingerprint] || ! reportDate || [date timeIntervalSinceDate:reportDate] >= minimumInterval;
+}
+
+- (void)setReportedFingerprint:(NSString *)fingerprint date:(NSDate *)date
+{
+    self.metadata[SRGAnalyticsApplicationListCacheReportedFingerprintKey] = fingerprint;
+    self.metadata[SRGAnalyticsApplicationListCacheReportDateKey] = date;
+    [self saveMetadata];
+}
+
+#pragma mark Persistence
+
+- (void)saveMetadata
+{
+    [self.metadata writeToURL:self.metadataFileURL atomically:YES];
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; URL = %@; metadata = %@>",
+            self.class,
+            self,
+            self.URL,
+            self.metadata];
+}
+
+@end
@@ -0,0 +1,86 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsLabelContext.h"
+
+@import Foundation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  MIME type of encoded batches.
+ */
+OBJC_EXPORT NSString * const SRGAnalyticsBatchContentType;
+
+/**
+ *  Encodes a batch of events into a compact payload. Label keys and values are interned into a string table built for
+ *  the batch, events referencing them by index, and the result is deflated. Since consecutive events (e.g. heartbeats)
+ *  mostly share their labels, each of them usually costs a few bytes only.
+ *
+ *  Before compression, a batch is laid out as follows, all integers being unsigned LEB128 varints:
+ *    - The `SRGB` magic, followed by a version byte (1).
+ *    - The string count, followed by each string as its UTF-8 byte length and bytes.
+ *    - The shared label count, followed by (key index, value index) pairs. Shared labels apply to all events.
+ *    - The event count, followed by each event as its label count and (key index, value index) pairs.
+ *
+ *  The payload is a zlib stream (RFC 1950) of these bytes.
+ *
+ *  @discussion An encoder is not thread-safe.
+ */
+@interface SRGAnalyticsBatchEncoder : NSObject
+
+/**
+ *  Create an encoder for batches whose events all share the specified labels. Event labels override shared labels
+ *  with the same keys when decoded.
+ */
+- (instancetype)initWithSharedLabels:(NSDictionary<NSString *, NSString *> *)sharedLabels NS_DESIGNATED_INITIALIZER;
+
+/**
+ *  The labels shared by all events.
+ */
+@property (nonatomic, readonly, copy) NSDictionary<NSString *, NSString *> *sharedLabels;
+
+/**
+ *  Add an event with all labels resolved through the specified context.
+ */
+- (void)addEventWithLabelContext:(SRGAnalyticsLabelContext *)context;
+
+/**
+ *  Add an event with the specified labels.
+ */
+- (void)addEventWithLabels:(NSDictionary<NSString *, NSString *> *)labels;
+
+/**
+ *  The number of events in the current batch.
+ */
+@property (nonatomic, readonly) NSUInteger eventCount;
+
+/**
+ *  The size of the current batch before compression, in bytes.
+ */
+@property (nonatomic, readonly) NSUInteger byteCount;
+
+/**
+ *  Return the compressed payload for the current batch and start a new batch. Return `nil` if the current batch is
+ *  empty.
+ */
+- (nullable NSData *)finishBatch;
+
+@end
+
+/**
+ *  Decode a batch payload into the labels of each event, shared labels included. Return `nil` if the payload is
+ *  invalid.
+ */
+OBJC_EXPORT NSArray<NSDictionary<NSString *, NSString *> *> * _Nullable SRGAnalyticsDecodeBatch(NSData *data);
+
+@interface SRGAnalyticsBatchEncoder (Unavailable)
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
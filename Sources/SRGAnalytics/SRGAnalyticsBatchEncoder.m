@@ -0,0 +1,328 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsBatchEncoder.h"
+
+#import "SRGAnalyticsByteBuffer.h"
+
+#import <zlib.h>
+
+NSString * const SRGAnalyticsBatchContentType = @"application/vnd.srgssr.analytics-batch";
+
+static const uint8_t SRGAnalyticsBatchMagic[] = { 'S', 'R', 'G', 'B' };
+static const uint8_t SRGAnalyticsBatchVersion = 1;
+
+// Initial capacity of batch encoding buffers
+static const size_t SRGAnalyticsBatchBufferCapacity = 16 * 1024;
+
+// Decoded batches are limited to this size, protecting the decoder against decompression bombs
+static const size_t SRGAnalyticsBatchMaximumDecodedLength = 64 * 1024 * 1024;
+
+#pragma mark Varints
+
+static void SRGAnalyticsBatchAppendVarint(SRGAnalyticsByteBuffer *buffer, uint64_t value)
+{
+    uint8_t bytes[10];
+    size_t length = 0;
+    do {
+        uint8_t byte = value & 0x7f;
+        value >>= 7;
+        bytes[length++] = (value != 0) ? (byte | 0x80) : byte;
+    } while (value != 0);
+    [buffer appendBytes:bytes length:length];
+}
+
+static BOOL SRGAnalyticsBatchReadVarint(const uint8_t **cursor, const uint8_t *end, uint64_t *value)
+{
+    uint64_t result = 0;
+    for (unsigned int shift = 0; shift < 64; shift += 7) {
+        if (*cursor == end) {
+            return NO;
+        }
+        
+        uint8_t byte = *(*cursor)++;
+        result |= (uint64_t)(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            *value = result;
+            return YES;
+        }
+    }
+    return NO;
+}
+
+#pragma mark Encoder
+
+@interface SRGAnalyticsBatchEncoder ()
+
+@property (nonatomic, copy) NSDictionary<NSString *, NSString *> *sharedLabels;
+
+@property (nonatomic) NSMutableDictionary<NSString *, NSNumber *> *stringIndexes;
+@property (nonatomic) SRGAnalyticsByteBuffer *stringBuffer;
+@property (nonatomic) SRGAnalyticsByteBuffer *sharedLabelBuffer;
+@property (nonatomic) SRGAnalyticsByteBuffer *eventBuffer;
+@property (nonatomic) SRGAnalyticsByteBuffer *labelBuffer;
+@property (nonatomic) SRGAnalyticsByteBuffer *outputBuffer;
+
+@property (nonatomic) NSUInteger eventCount;
+
+@end
+
+@implementation SRGAnalyticsBatchEncoder
+
+#pragma mark Object lifecycle
+
+- (instancetype)initWithSharedLabels:(NSDictionary<NSString *, NSString *> *)sharedLabels
+{
+    if (self = [super init]) {
+        self.sharedLabels = sharedLabels;
+        
+        self.stringIndexes = [NSMutableDictionary dictionary];
+        self.stringBuffer = [[SRGAnalyticsByteBuffer alloc] initWithCapacity:SRGAnalyticsBatchBufferCapacity];
+        self.sharedLabelBuffer = [[SRGAnalyticsByteBuffer alloc] initWithCapacity:256];
+        self.eventBuffer = [[SRGAnalyticsByteBuffer alloc] initWithCapacity:SRGAnalyticsBatchBufferCapacity];
+        self.labelBuffer = [[SRGAnalyticsByteBuffer alloc] initWithCapacity:256];
+        self.outputBuffer = [[SRGAnalyticsByteBuffer alloc] initWithCapacity:SRGAnalyticsBatchBufferCapacity];
+        
+        [self startBatch];
+    }
+    return self;
+}
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-implementations"
+
+- (instancetype)init
+{
+    [self doesNotRecognizeSelector:_cmd];
+    return [self initWithSharedLabels:@{}];
+}
+
+#pragma clang diagnostic pop
+
+#pragma mark Getters and setters
+
+- (NSUInteger)byteCount
+{
+    // Magic, version and varint counts (estimated) come in addition to the buffers
+    return sizeof(SRGAnalyticsBatchMagic) + 1 + 3 * 5 + self.stringBuffer.length + self.sharedLabelBuffer.length + self.eventBuffer.length;
+}
+
+#pragma mark Encoding
+
+- (void)startBatch
+{
+    [self.stringIndexes removeAllObjects];
+    [self.stringBuffer reset];
+    [self.sharedLabelBuffer reset];
+    [self.eventBuffer reset];
+    self.eventCount = 0;
+    
+    // Shared labels are sorted so that identical batches yield identical bytes
+    NSArray<NSString *> *keys = [self.sharedLabels.allKeys sortedArrayUsingSelector:@selector(compare:)];
+    SRGAnalyticsBatchAppendVarint(self.sharedLabelBuffer, keys.count);
+    for (NSString *key in keys) {
+        [self appendLabel:self.sharedLabels[key] forKey:key toBuffer:self.sharedLabelBuffer];
+    }
+}
+
+- (NSUInteger)indexForString:(NSString *)string
+{
+    NSNumber *index = self.stringIndexes[string];
+    if (index) {
+        return index.unsignedIntegerValue;
+    }
+    
+    NSUInteger newIndex = self.stringIndexes.count;
+    self.stringIndexes[string] = @(newIndex);
+    
+    const char *bytes = string.UTF8String ?: "";
+    size_t length = strlen(bytes);
+    SRGAnalyticsBatchAppendVarint(self.stringBuffer, length);
+    [self.stringBuffer appendBytes:bytes length:length];
+    return newIndex;
+}
+
+- (void)appendLabel:(NSString *)label forKey:(NSString *)key toBuffer:(SRGAnalyticsByteBuffer *)buffer
+{
+    SRGAnalyticsBatchAppendVarint(buffer, [self indexForString:key]);
+    SRGAnalyticsBatchAppendVarint(buffer, [self indexForString:label]);
+}
+
+- (void)addEventWithLabelContext:(SRGAnalyticsLabelContext *)context
+{
+    SRGAnalyticsByteBuffer *labelBuffer = self.labelBuffer;
+    [labelBuffer reset];
+    
+    __block NSUInteger labelCount = 0;
+    [context enumerateLabelsUsingBlock:^(NSString * _Nonnull key, NSString * _Nonnull label, BOOL * _Nonnull stop) {
+        [self appendLabel:label forKey:key toBuffer:labelBuffer];
+        labelCount++;
+    }];
+    
+    SRGAnalyticsBatchAppendVarint(self.eventBuffer, labelCount);
+    [self.eventBuffer appendBytes:labelBuffer.bytes length:labelBuffer.length];
+    self.eventCount += 1;
+}
+
+- (void)addEventWithLabels:(NSDictionary<NSString *, NSString *> *)labels
+{
+    SRGAnalyticsBatchAppendVarint(self.eventBuffer, labels.count);
+    [labels enumerateKeysAndObjectsUsingBlock:^(NSString * _Nonnull key, NSString * _Nonnull label, BOOL * _Nonnull stop) {
+        [self appendLabel:label forKey:key toBuffer:self.eventBuffer];
+    }];
+    self.eventCount += 1;
+}
+
+- (NSData *)finishBatch
+{
+    if (self.eventCount == 0) {
+        return nil;
+    }
+    
+    SRGAnalyticsByteBuffer *outputBuffer = self.outputBuffer;
+    [outputBuffer reset];
+    [outputBuffer appendBytes:SRGAnalyticsBatchMagic length:sizeof(SRGAnalyticsBatchMagic)];
+    [outputBuffer appendBytes:&SRGAnalyticsBatchVersion length:1];
+    SRGAnalyticsBatchAppendVarint(outputBuffer, self.stringIndexes.count);
+    [outputBuffer appendBytes:self.stringBuffer.bytes length:self.stringBuffer.length];
+    [outputBuffer appendBytes:self.sharedLabelBuffer.bytes length:self.sharedLabelBuffer.length];
+    SRGAnalyticsBatchAppendVarint(outputBuffer, self.eventCount);
+    [outputBuffer appendBytes:self.eventBuffer.bytes length:self.eventBuffer.length];
+    
+    [self startBatch];
+    
+    uLongf compressedLength = compressBound((uLong)outputBuffer.length);
+    NSMutableData *data = [NSMutableData dataWithLength:compressedLength];
+    if (compress2(data.mutableBytes, &compressedLength, outputBuffer.bytes, (uLong)outputBuffer.length, Z_BEST_SPEED) != Z_OK) {
+        return nil;
+    }
+    data.length = compressedLength;
+    return data.copy;
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; eventCount = %@; stringCount = %@; byteCount = %@>",
+            self.class,
+            self,
+            @(self.eventCount),
+            @(self.stringIndexes.count),
+            @(self.byteCount)];
+}
+
+@end
+
+#pragma mark Decoder
+
+static NSData *SRGAnalyticsBatchInflate(NSData *data)
+{
+    z_stream stream = { 0 };
+    if (inflateInit(&stream) != Z_OK) {
+        return nil;
+    }
+    
+    NSMutableData *inflatedData = [NSMutableData dataWithLength:MAX(4 * data.length, 1024)];
+    stream.next_in = (Bytef *)data.bytes;
+    stream.avail_in = (uInt)data.length;
+    
+    int status = Z_OK;
+    while (status == Z_OK) {
+        if (stream.total_out == inflatedData.length) {
+            if (inflatedData.length >= SRGAnalyticsBatchMaximumDecodedLength) {
+                break;
+            }
+            inflatedData.length = MIN(2 * inflatedData.length, SRGAnalyticsBatchMaximumDecodedLength);
+        }
+        stream.next_out = (Bytef *)inflatedData.mutableBytes + stream.total_out;
+        stream.avail_out = (uInt)(inflatedData.length - stream.total_out);
+        status = inflate(&stream, Z_NO_FLUSH);
+    }
+    inflateEnd(&stream);
+    
+    if (status != Z_STREAM_END) {
+        return nil;
+    }
+    inflatedData.length = stream.total_out;
+    return inflatedData.copy;
+}
+
+static BOOL SRGAnalyticsBatchReadLabels(const uint8_t **cursor, const uint8_t *end, NSArray<NSString *> *strings, NSMutableDictionary<NSString *, NSString *> *labels)
+{
+    uint64_t labelCount = 0;
+    if (! SRGAnalyticsBatchReadVarint(cursor, end, &labelCount)) {
+        return NO;
+    }
+    
+    for (uint64_t i = 0; i < labelCount; ++i) {
+        uint64_t keyIndex = 0, valueIndex = 0;
+        if (! SRGAnalyticsBatchReadVarint(cursor, end, &keyIndex) || ! SRGAnalyticsBatchReadVarint(cursor, end, &valueIndex)
+                || keyIndex >= strings.count || valueIndex >= strings.count) {
+            return NO;
+        }
+        labels[strings[keyIndex]] = strings[valueIndex];
+    }
+    return YES;
+}
+
+NSArray<NSDictionary<NSString *, NSString *> *> *SRGAnalyticsDecodeBatch(NSData *data)
+{
+    NSData *inflatedData = SRGAnalyticsBatchInflate(data);
+    if (! inflatedData) {
+        return nil;
+    }
+    
+    const uint8_t *cursor = inflatedData.bytes;
+    const uint8_t *end = cursor + inflatedData.length;
+    if (inflatedData.length < sizeof(SRGAnalyticsBatchMagic) + 1
+            || memcmp(cursor, SRGAnalyticsBatchMagic, sizeof(SRGAnalyticsBatchMagic)) != 0
+            || cursor[sizeof(SRGAnalyticsBatchMagic)] != SRGAnalyticsBatchVersion) {
+        return nil;
+    }
+    cursor += sizeof(SRGAnalyticsBatchMagic) + 1;
+    
+    // Each string takes at least one byte, which bounds counts read from corrupt payloads
+    uint64_t stringCount = 0;
+    if (! SRGAnalyticsBatchReadVarint(&cursor, end, &stringCount) || stringCount > (uint64_t)(end - cursor)) {
+        return nil;
+    }
+    
+    NSMutableArray<NSString *> *strings = [NSMutableArray arrayWithCapacity:(NSUInteger)stringCount];
+    for (uint64_t i = 0; i < stringCount; ++i) {
+        uint64_t length = 0;
+        if (! SRGAnalyticsBatchReadVarint(&cursor, end, &length) || length > (uint64_t)(end - cursor)) {
+            return nil;
+        }
+        
+        NSString *string = [[NSString alloc] initWithBytes:cursor length:(NSUInteger)length encoding:NSUTF8StringEncoding];
+        if (! string) {
+            return nil;
+        }
+        [strings addObject:string];
+        cursor += length;
+    }
+    
+    NSMutableDictionary<NSString *, NSString *> *sharedLabels = [NSMutableDictionary dictionary];
+    if (! SRGAnalyticsBatchReadLabels(&cursor, end, strings, sharedLabels)) {
+        return nil;
+    }
+    
+    uint64_t eventCount = 0;
+    if (! SRGAnalyticsBatchReadVarint(&cursor, end, &eventCount) || eventCount > (uint64_t)(end - cursor)) {
+        return nil;
+    }
+    
+    NSMutableArray<NSDictionary<NSString *, NSString *> *> *events = [NSMutableArray arrayWithCapacity:(NSUInteger)eventCount];
+    for (uint64_t i = 0; i < eventCount; ++i) {
+        NSMutableDictionary<NSString *, NSString *> *labels = sharedLabels.mutableCopy;
+        if (! SRGAnalyticsBatchReadLabels(&cursor, end, strings, labels)) {
+            return nil;
+        }
+        [events addObject:labels.copy];
+    }
+    return (cursor == end) ? events.copy : nil;
+}
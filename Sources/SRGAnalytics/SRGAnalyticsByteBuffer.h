@@ -0,0 +1,90 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+@import Foundation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Growable byte buffer, meant to be reused through a buffer pool.
+ *
+ *  @discussion A buffer is not thread-safe.
+ */
+@interface SRGAnalyticsByteBuffer : NSObject
+
+/**
+ *  Create an empty buffer with the specified initial capacity, in bytes.
+ */
+- (instancetype)initWithCapacity:(size_t)capacity NS_DESIGNATED_INITIALIZER;
+
+/**
+ *  The buffer contents. Only valid until the buffer is next modified.
+ */
+@property (nonatomic, readonly) const uint8_t *bytes;
+
+/**
+ *  The number of bytes stored in the buffer.
+ */
+@property (nonatomic, readonly) size_t length;
+
+/**
+ *  The current buffer capacity, in bytes.
+ */
+@property (nonatomic, readonly) size_t capacity;
+
+/**
+ *  Append bytes, growing the buffer if needed.
+ */
+- (void)appendBytes:(const void *)bytes length:(size_t)length;
+
+/**
+ *  Empty the buffer, keeping its capacity.
+ */
+- (void)reset;
+
+@end
+
+@interface SRGAnalyticsByteBuffer (Unavailable)
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+/**
+ *  Thread-safe pool of reusable byte buffers.
+ */
+@interface SRGAnalyticsByteBufferPool : NSObject
+
+/**
+ *  Create a pool keeping at most the specified number of buffers for reuse. Buffers are created with the specified
+ *  initial capacity. Buffers which have grown much larger are not kept for reuse.
+ */
+- (instancetype)initWithMaximumBufferCount:(NSUInteger)maximumBufferCount bufferCapacity:(size_t)bufferCapacity NS_DESIGNATED_INITIALIZER;
+
+/**
+ *  Return an empty buffer, reused if available.
+ */
+- (SRGAnalyticsByteBuffer *)dequeueBuffer;
+
+/**
+ *  Return a buffer to the pool once done with it. The buffer must not be used afterwards.
+ */
+- (void)recycleBuffer:(SRGAnalyticsByteBuffer *)buffer;
+
+/**
+ *  The number of buffers currently available for reuse.
+ */
+@property (nonatomic, readonly) NSUInteger availableBufferCount;
+
+@end
+
+@interface SRGAnalyticsByteBufferPool (Unavailable)
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,189 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsByteBuffer.h"
+
+#import <pthread.h>
+
+// Buffers which have grown beyond this factor of their initial capacity are not reused
+static const size_t SRGAnalyticsByteBufferMaximumRecycledGrowthFactor = 16;
+
+@interface SRGAnalyticsByteBuffer ()
+
+@property (nonatomic) uint8_t *mutableBytes;
+@property (nonatomic) size_t length;
+@property (nonatomic) size_t capacity;
+
+@end
+
+@implementation SRGAnalyticsByteBuffer
+
+#pragma mark Object lifecycle
+
+- (instancetype)initWithCapacity:(size_t)capacity
+{
+    if (self = [super init]) {
+        self.capacity = MAX(capacity, 1);
+        self.mutableBytes = malloc(self.capacity);
+    }
+    return self;
+}
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-implementations"
+
+- (instancetype)init
+{
+    [self doesNotRecognizeSelector:_cmd];
+    return [self initWithCapacity:0];
+}
+
+#pragma clang diagnostic pop
+
+- (void)dealloc
+{
+    free(_mutableBytes);
+}
+
+#pragma mark Getters and setters
+
+- (const uint8_t *)bytes
+{
+    return self.mutableBytes;
+}
+
+#pragma mark Contents
+
+- (void)appendBytes:(const void *)bytes length:(size_t)length
+{
+    size_t requiredCapacity = self.length + length;
+    if (requiredCapacity > self.capacity) {
+        size_t capacity = self.capacity;
+        while (capacity < requiredCapacity) {
+            capacity *= 2;
+        }
+        
+        uint8_t *mutableBytes = realloc(self.mutableBytes, capacity);
+        NSAssert(mutableBytes != NULL, @"Buffer allocation failed");
+        self.mutableBytes = mutableBytes;
+        self.capacity = capacity;
+    }
+    
+    memcpy(self.mutableBytes + self.length, bytes, length);
+    self.length += length;
+}
+
+- (void)reset
+{
+    self.length = 0;
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; length = %@; capacity = %@>",
+            self.class,
+            self,
+            @(self.length),
+            @(self.capacity)];
+}
+
+@end
+
+@interface SRGAnalyticsByteBufferPool () {
+@private
+    pthread_mutex_t _mutex;
+}
+
+@property (nonatomic) NSUInteger maximumBufferCount;
+@property (nonatomic) size_t bufferCapacity;
+@property (nonatomic) NSMutableArray<SRGAnalyticsByteBuffer *> *buffers;
+
+@end
+
+@implementation SRGAnalyticsByteBufferPool
+
+#pragma mark Object lifecycle
+
+- (instancetype)initWithMaximumBufferCount:(NSUInteger)maximumBufferCount bufferCapacity:(size_t)bufferCapacity
+{
+    if (self = [super init]) {
+        self.maximumBufferCount = maximumBufferCount;
+        self.bufferCapacity = bufferCapacity;
+        self.buffers = [NSMutableArray arrayWithCapacity:maximumBufferCount];
+        pthread_mutex_init(&_mutex, NULL);
+    }
+    return self;
+}
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-implementations"
+
+- (instancetype)init
+{
+    [self doesNotRecognizeSelector:_cmd];
+    return [self initWithMaximumBufferCount:0 bufferCapacity:0];
+}
+
+#pragma clang diagnostic pop
+
+- (void)dealloc
+{
+    pthread_mutex_destroy(&_mutex);
+}
+
+#pragma mark Getters and setters
+
+- (NSUInteger)availableBufferCount
+{
+    pthread_mutex_lock(&_mutex);
+    NSUInteger availableBufferCount = self.buffers.count;
+    pthread_mutex_unlock(&_mutex);
+    return availableBufferCount;
+}
+
+#pragma mark Buffers
+
+- (SRGAnalyticsByteBuffer *)dequeueBuffer
+{
+    pthread_mutex_lock(&_mutex);
+    SRGAnalyticsByteBuffer *buffer = self.buffers.lastObject;
+    if (buffer) {
+        [self.buffers removeLastObject];
+    }
+    pthread_mutex_unlock(&_mutex);
+    
+    return buffer ?: [[SRGAnalyticsByteBuffer alloc] initWithCapacity:self.bufferCapacity];
+}
+
+- (void)recycleBuffer:(SRGAnalyticsByteBuffer *)buffer
+{
+    if (buffer.capacity > self.bufferCapacity * SRGAnalyticsByteBufferMaximumRecycledGrowthFactor) {
+        return;
+    }
+    
+    [buffer reset];
+    
+    pthread_mutex_lock(&_mutex);
+    if (self.buffers.count < self.maximumBufferCount) {
+        [self.buffers addObject:buffer];
+    }
+    pthread_mutex_unlock(&_mutex);
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; availableBufferCount = %@; bufferCapacity = %@>",
+            self.class,
+            self,
+            @(self.availableBufferCount),
+            @(self.bufferCapacity)];
+}
+
+@end
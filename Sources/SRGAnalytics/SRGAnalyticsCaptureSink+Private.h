@@ -0,0 +1,37 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsCaptureSink.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface SRGAnalyticsCaptureSink (Private)
+
+/**
+ *  Create a sink whose buffer has the specified capacity (in bytes, rounded up to a power of two).
+ */
+- (instancetype)initWithCapacity:(NSUInteger)capacity;
+
+/**
+ *  Capture an event whose labels have been URL-encoded. Events larger than a quarter of the buffer capacity are
+ *  discarded. Return the sequence number of the captured event, 0 if discarded.
+ *
+ *  @discussion Single producer: must not be called from several threads concurrently.
+ */
+- (uint64_t)captureEventWithService:(SRGAnalyticsCaptureService)service encodedLabels:(const uint8_t *)bytes length:(size_t)length;
+
+@end
+
+@interface SRGAnalyticsCapturedEvent (Private)
+
+/**
+ *  Decode URL-encoded labels.
+ */
++ (NSDictionary<NSString *, NSString *> *)labelsFromEncodedLabels:(NSString *)encodedLabels;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,349 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsCaptureSink.h"
+
+#import "SRGAnalyticsCaptureSink+Private.h"
+
+#import <pthread.h>
+#import <stdatomic.h>
+#import <sys/time.h>
+
+// Smallest expected record size, used to size the record index
+static const size_t SRGAnalyticsCaptureMinimumRecordSize = 64;
+
+// Records are stored contiguously in the ring (wrapping around its end), each one starting with a header
+typedef struct {
+    uint64_t sequence;
+    uint64_t timestamp;         // Microseconds since 1970
+    uint32_t length;
+    uint32_t service;
+} SRGAnalyticsCaptureRecordHeader;
+
+static size_t SRGAnalyticsCaptureRecordSize(size_t length)
+{
+    // Keep headers 8-byte aligned
+    return (sizeof(SRGAnalyticsCaptureRecordHeader) + length + 7) & ~(size_t)7;
+}
+
+@interface SRGAnalyticsCapturedEvent ()
+
+- (instancetype)initWithSequence:(uint64_t)sequence
+                            date:(NSDate *)date
+                         service:(SRGAnalyticsCaptureService)service
+                   encodedLabels:(NSString *)encodedLabels;
+
+@property (nonatomic) NSDictionary<NSString *, NSString *> *decodedLabels;
+
+@end
+
+@implementation SRGAnalyticsCaptureSink {
+@private
+    uint8_t *_bytes;
+    size_t _capacity;
+    
+    // Position of each record, indexed by sequence number modulo the index capacity
+    _Atomic(uint64_t) *_positions;
+    uint64_t _indexCapacity;
+    
+    // Total number of bytes reserved by the producer, including the record being written, if any. Readers use it to
+    // detect records overwritten while they were copying them, as with a seqlock.
+    _Atomic(uint64_t) _reservedLength;
+    _Atomic(uint64_t) _lastSequence;
+    
+    // Waiters are only signaled when there are some, so that the producer never takes the lock otherwise
+    _Atomic(NSUInteger) _waiterCount;
+    pthread_mutex_t _mutex;
+    pthread_cond_t _condition;
+}
+
+#pragma mark Object lifecycle
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity
+{
+    if (self = [super init]) {
+        _capacity = 1024;
+        while (_capacity < capacity) {
+            _capacity <<= 1;
+        }
+        _bytes = calloc(_capacity, 1);
+        
+        _indexCapacity = _capacity / SRGAnalyticsCaptureMinimumRecordSize;
+        _positions = calloc(_indexCapacity, sizeof(_Atomic(uint64_t)));
+        
+        atomic_init(&_reservedLength, 0);
+        atomic_init(&_lastSequence, 0);
+        atomic_init(&_waiterCount, 0);
+        
+        pthread_mutex_init(&_mutex, NULL);
+        pthread_cond_init(&_condition, NULL);
+    }
+    return self;
+}
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-implementations"
+
+- (instancetype)init
+{
+    [self doesNotRecognizeSelector:_cmd];
+    return [self initWithCapacity:0];
+}
+
+#pragma clang diagnostic pop
+
+- (void)dealloc
+{
+    free(_bytes);
+    free(_positions);
+    
+    pthread_mutex_destroy(&_mutex);
+    pthread_cond_destroy(&_condition);
+}
+
+#pragma mark Getters and setters
+
+- (NSUInteger)capacity
+{
+    return _capacity;
+}
+
+- (uint64_t)lastSequence
+{
+    return atomic_load_explicit(&_lastSequence, memory_order_acquire);
+}
+
+#pragma mark Ring buffer
+
+- (void)writeBytes:(const void *)bytes length:(size_t)length atPosition:(uint64_t)position
+{
+    size_t offset = position & (_capacity - 1);
+    size_t firstLength = MIN(length, _capacity - offset);
+    memcpy(_bytes + offset, bytes, firstLength);
+    memcpy(_bytes, (const uint8_t *)bytes + firstLength, length - firstLength);
+}
+
+- (void)readBytes:(void *)bytes length:(size_t)length atPosition:(uint64_t)position
+{
+    size_t offset = position & (_capacity - 1);
+    size_t firstLength = MIN(length, _capacity - offset);
+    memcpy(bytes, _bytes + offset, firstLength);
+    memcpy((uint8_t *)bytes + firstLength, _bytes, length - firstLength);
+}
+
+// Return YES iff the bytes read from the specified position have not been overwritten meanwhile
+- (BOOL)isPositionValid:(uint64_t)position
+{
+    atomic_thread_fence(memory_order_acquire);
+    uint64_t reservedLength = atomic_load_explicit(&_reservedLength, memory_order_relaxed);
+    return reservedLength <= position + _capacity;
+}
+
+#pragma mark Capture
+
+- (uint64_t)captureEventWithService:(SRGAnalyticsCaptureService)service encodedLabels:(const uint8_t *)bytes length:(size_t)length
+{
+    size_t recordSize = SRGAnalyticsCaptureRecordSize(length);
+    if (recordSize > _capacity / 4) {
+        return 0;
+    }
+    
+    struct timeval time;
+    gettimeofday(&time, NULL);
+    
+    uint64_t sequence = atomic_load_explicit(&_lastSequence, memory_order_relaxed) + 1;
+    SRGAnalyticsCaptureRecordHeader header = {
+        .sequence = sequence,
+        .timestamp = (uint64_t)time.tv_sec * USEC_PER_SEC + time.tv_usec,
+        .length = (uint32_t)length,
+        .service = (uint32_t)service
+    };
+    
+    // Announce the bytes about to be overwritten before writing them
+    uint64_t position = atomic_load_explicit(&_reservedLength, memory_order_relaxed);
+    atomic_store_explicit(&_reservedLength, position + recordSize, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    
+    [self writeBytes:&header length:sizeof(header) atPosition:position];
+    [self writeBytes:bytes length:length atPosition:position + sizeof(header)];
+    
+    atomic_store_explicit(&_positions[sequence & (_indexCapacity - 1)], position, memory_order_relaxed);
+    atomic_store_explicit(&_lastSequence, sequence, memory_order_release);
+    
+    if (atomic_load_explicit(&_waiterCount, memory_order_acquire) != 0) {
+        pthread_mutex_lock(&_mutex);
+        pthread_cond_broadcast(&_condition);
+        pthread_mutex_unlock(&_mutex);
+    }
+    
+    return sequence;
+}
+
+#pragma mark Queries
+
+- (SRGAnalyticsCapturedEvent *)eventWithSequence:(uint64_t)sequence
+{
+    uint64_t position = atomic_load_explicit(&_positions[sequence & (_indexCapacity - 1)], memory_order_relaxed);
+    
+    SRGAnalyticsCaptureRecordHeader header;
+    [self readBytes:&header length:sizeof(header) atPosition:position];
+    if (! [self isPositionValid:position] || header.sequence != sequence || header.length > _capacity) {
+        return nil;
+    }
+    
+    NSMutableData *data = [NSMutableData dataWithLength:header.length];
+    [self readBytes:data.mutableBytes length:header.length atPosition:position + sizeof(header)];
+    if (! [self isPositionValid:position]) {
+        return nil;
+    }
+    
+    NSString *encodedLabels = [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
+    NSDate *date = [NSDate dateWithTimeIntervalSince1970:(NSTimeInterval)header.timestamp / USEC_PER_SEC];
+    return [[SRGAnalyticsCapturedEvent alloc] initWithSequence:sequence date:date service:header.service encodedLabels:encodedLabels ?: @""];
+}
+
+- (NSArray<SRGAnalyticsCapturedEvent *> *)eventsAfterSequence:(uint64_t)sequence matchingFilter:(SRGAnalyticsCapturedEventFilter)filter
+{
+    uint64_t lastSequence = self.lastSequence;
+    
+    // Older events are not indexed anymore, and therefore have necessarily been overwritten
+    uint64_t firstSequence = MAX(sequence + 1, (lastSequence > _indexCapacity) ? lastSequence - _indexCapacity + 1 : 1);
+    
+    NSMutableArray<SRGAnalyticsCapturedEvent *> *events = [NSMutableArray array];
+    for (uint64_t eventSequence = firstSequence; eventSequence <= lastSequence; ++eventSequence) {
+        SRGAnalyticsCapturedEvent *event = [self eventWithSequence:eventSequence];
+        if (event && (! filter || filter(event))) {
+            [events addObject:event];
+        }
+    }
+    return events.copy;
+}
+
+- (SRGAnalyticsCapturedEvent *)waitForEventAfterSequence:(uint64_t)sequence matchingFilter:(SRGAnalyticsCapturedEventFilter)filter timeout:(NSTimeInterval)timeout
+{
+    NSDate *deadline = [NSDate dateWithTimeIntervalSinceNow:timeout];
+    
+    atomic_fetch_add_explicit(&_waiterCount, 1, memory_order_acq_rel);
+    
+    SRGAnalyticsCapturedEvent *matchingEvent = nil;
+    while (1) {
+        // Read the last sequence under the lock, so that no capture can be missed before waiting
+        pthread_mutex_lock(&_mutex);
+        uint64_t lastSequence = self.lastSequence;
+        if (lastSequence == sequence) {
+            NSTimeInterval remainingTime = deadline.timeIntervalSinceNow;
+            if (remainingTime <= 0.) {
+                pthread_mutex_unlock(&_mutex);
+                break;
+            }
+            
+            struct timespec absoluteTime;
+            NSTimeInterval deadlineTime = deadline.timeIntervalSince1970;
+            absoluteTime.tv_sec = (time_t)deadlineTime;
+            absoluteTime.tv_nsec = (long)((deadlineTime - absoluteTime.tv_sec) * NSEC_PER_SEC);
+            pthread_cond_timedwait(&_condition, &_mutex, &absoluteTime);
+            pthread_mutex_unlock(&_mutex);
+            continue;
+        }
+        pthread_mutex_unlock(&_mutex);
+        
+        matchingEvent = [self eventsAfterSequence:sequence matchingFilter:filter].firstObject;
+        if (matchingEvent) {
+            break;
+        }
+        sequence = lastSequence;
+    }
+    
+    atomic_fetch_sub_explicit(&_waiterCount, 1, memory_order_acq_rel);
+    return matchingEvent;
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; capacity = %@; lastSequence = %@>",
+            self.class,
+            self,
+            @(self.capacity),
+            @(self.lastSequence)];
+}
+
+@end
+
+@implementation SRGAnalyticsCapturedEvent
+
+#pragma mark Class methods
+
++ (NSDictionary<NSString *, NSString *> *)labelsFromEncodedLabels:(NSString *)encodedLabels
+{
+    NSMutableDictionary<NSString *, NSString *> *labels = [NSMutableDictionary dictionary];
+    for (NSString *component in [encodedLabels componentsSeparatedByString:@"&"]) {
+        NSRange separatorRange = [component rangeOfString:@"="];
+        if (separatorRange.location == NSNotFound) {
+            continue;
+        }
+        
+        NSString *key = [component substringToIndex:separatorRange.location].stringByRemovingPercentEncoding;
+        NSString *label = [component substringFromIndex:NSMaxRange(separatorRange)].stringByRemovingPercentEncoding;
+        if (key && label) {
+            labels[key] = label;
+        }
+    }
+    return labels.copy;
+}
+
+#pragma mark Object lifecycle
+
+- (instancetype)initWithSequence:(uint64_t)sequence date:(NSDate *)date service:(SRGAnalyticsCaptureService)service encodedLabels:(NSString *)encodedLabels
+{
+    if (self = [super init]) {
+        _sequence = sequence;
+        _date = date;
+        _service = service;
+        _encodedLabels = encodedLabels.copy;
+    }
+    return self;
+}
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-implementations"
+
+- (instancetype)init
+{
+    [self doesNotRecognizeSelector:_cmd];
+    return [self initWithSequence:0 date:NSDate.date service:SRGAnalyticsCaptureServiceTagCommander encodedLabels:@""];
+}
+
+#pragma clang diagnostic pop
+
+#pragma mark Getters and setters
+
+- (NSDictionary<NSString *, NSString *> *)labels
+{
+    // Decoded lazily, events being usually filtered by their encoded form
+    @synchronized(self) {
+        if (! self.decodedLabels) {
+            self.decodedLabels = [SRGAnalyticsCapturedEvent labelsFromEncodedLabels:self.encodedLabels];
+        }
+        return self.decodedLabels;
+    }
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; sequence = %@; date = %@; service = %@; encodedLabels = %@>",
+            self.class,
+            self,
+            @(self.sequence),
+            self.date,
+            @(self.service),
+            self.encodedLabels];
+}
+
+@end
@@ -0,0 +1,16 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+@import Foundation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Return the current time of a monotonic clock, in nanoseconds.
+ */
+OBJC_EXPORT uint64_t SRGAnalyticsMonotonicTime(void);
+
+NS_ASSUME_NONNULL_END
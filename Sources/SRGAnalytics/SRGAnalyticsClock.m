@@ -0,0 +1,26 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsClock.h"
+
+#import <mach/mach_time.h>
+
+uint64_t SRGAnalyticsMonotonicTime(void)
+{
+    static mach_timebase_info_data_t s_timebaseInfo;
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        mach_timebase_info(&s_timebaseInfo);
+    });
+    
+    uint64_t time = mach_absolute_time();
+    if (s_timebaseInfo.numer == s_timebaseInfo.denom) {
+        return time;
+    }
+    else {
+        return (uint64_t)((__uint128_t)time * s_timebaseInfo.numer / s_timebaseInfo.denom);
+    }
+}
@@ -0,0 +1,68 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsCaptureSink.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Completion handler called once an event has been delivered, or given up on.
+ */
+typedef void (^SRGAnalyticsCollectorCompletionHandler)(BOOL delivered);
+
+/**
+ *  Sends URL-encoded events to a collector speaking the TagCommander and comScore HTTP formats, @see
+ *  `SRGAnalyticsConfiguration.collectorURL`:
+ *    - TagCommander events are posted to `<base URL>/tagcommander`, labels being sent as the request body.
+ *    - TagCommander event batches are posted to `<base URL>/tagcommander/batch`, @see `SRGAnalyticsBatchEncoder`.
+ *    - comScore events are sent to `<base URL>/comscore`, labels being sent as the request query.
+ *
+ *  Requests failing because of network errors, throttling (429) or server errors (5xx) are retried with exponential
+ *  backoff and jitter, honoring `Retry-After` headers.
+ *
+ *  @discussion Thread-safe.
+ */
+@interface SRGAnalyticsCollectorClient : NSObject
+
+/**
+ *  Create a client for the collector at the specified base URL, making at most the specified number of attempts per
+ *  event.
+ */
+- (instancetype)initWithBaseURL:(NSURL *)baseURL maximumAttemptCount:(NSUInteger)maximumAttemptCount NS_DESIGNATED_INITIALIZER;
+
+/**
+ *  The collector base URL.
+ */
+@property (nonatomic, readonly) NSURL *baseURL;
+
+/**
+ *  The URL from which the application list is retrieved.
+ */
+@property (nonatomic, readonly) NSURL *applicationListURL;
+
+/**
+ *  Send an event with URL-encoded labels to the specified service. Bytes are copied.
+ */
+- (void)sendEventWithService:(SRGAnalyticsCaptureService)service
+               encodedLabels:(const uint8_t *)bytes
+                      length:(size_t)length
+           completionHandler:(nullable SRGAnalyticsCollectorCompletionHandler)completionHandler;
+
+/**
+ *  Send a batch of TagCommander events, as encoded by `SRGAnalyticsBatchEncoder`. The completion handler is called
+ *  once for the whole batch.
+ */
+- (void)sendTagCommanderBatch:(NSData *)batch completionHandler:(nullable SRGAnalyticsCollectorCompletionHandler)completionHandler;
+
+@end
+
+@interface SRGAnalyticsCollectorClient (Unavailable)
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,158 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsCollectorClient.h"
+
+#import "SRGAnalyticsBatchEncoder.h"
+#import "SRGAnalyticsLogger.h"
+
+// Backoff settings (in seconds)
+static const NSTimeInterval SRGAnalyticsCollectorInitialRetryDelay = 0.25;
+static const NSTimeInterval SRGAnalyticsCollectorMaximumRetryDelay = 30.;
+
+static const NSInteger SRGAnalyticsCollectorMaximumConnectionCount = 4;
+static const NSTimeInterval SRGAnalyticsCollectorRequestTimeout = 10.;
+
+@interface SRGAnalyticsCollectorClient ()
+
+@property (nonatomic) NSURL *baseURL;
+@property (nonatomic) NSUInteger maximumAttemptCount;
+@property (nonatomic) NSURLSession *session;
+
+@end
+
+@implementation SRGAnalyticsCollectorClient
+
+#pragma mark Object lifecycle
+
+- (instancetype)initWithBaseURL:(NSURL *)baseURL maximumAttemptCount:(NSUInteger)maximumAttemptCount
+{
+    NSParameterAssert(maximumAttemptCount > 0);
+    
+    if (self = [super init]) {
+        self.baseURL = baseURL;
+        self.maximumAttemptCount = maximumAttemptCount;
+        
+        NSURLSessionConfiguration *sessionConfiguration = NSURLSessionConfiguration.ephemeralSessionConfiguration;
+        sessionConfiguration.HTTPMaximumConnectionsPerHost = SRGAnalyticsCollectorMaximumConnectionCount;
+        sessionConfiguration.timeoutIntervalForRequest = SRGAnalyticsCollectorRequestTimeout;
+        sessionConfiguration.requestCachePolicy = NSURLRequestReloadIgnoringLocalCacheData;
+        self.session = [NSURLSession sessionWithConfiguration:sessionConfiguration];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [self.session finishTasksAndInvalidate];
+}
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-implementations"
+
+- (instancetype)init
+{
+    [self doesNotRecognizeSelector:_cmd];
+    return [self initWithBaseURL:[NSURL URLWithString:@""] maximumAttemptCount:1];
+}
+
+#pragma clang diagnostic pop
+
+#pragma mark Getters and setters
+
+- (NSURL *)applicationListURL
+{
+    return [self.baseURL URLByAppendingPathComponent:@"applications"];
+}
+
+#pragma mark Requests
+
+- (NSURLRequest *)requestWithService:(SRGAnalyticsCaptureService)service encodedLabels:(NSData *)encodedLabels
+{
+    if (service == SRGAnalyticsCaptureServiceTagCommander) {
+        NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:[self.baseURL URLByAppendingPathComponent:@"tagcommander"]];
+        request.HTTPMethod = @"POST";
+        request.HTTPBody = encodedLabels;
+        [request setValue:@"application/x-www-form-urlencoded" forHTTPHeaderField:@"Content-Type"];
+        return request.copy;
+    }
+    else {
+        NSURLComponents *URLComponents = [NSURLComponents componentsWithURL:[self.baseURL URLByAppendingPathComponent:@"comscore"] resolvingAgainstBaseURL:NO];
+        URLComponents.percentEncodedQuery = [[NSString alloc] initWithData:encodedLabels encoding:NSASCIIStringEncoding];
+        return [NSURLRequest requestWithURL:URLComponents.URL];
+    }
+}
+
+- (void)sendEventWithService:(SRGAnalyticsCaptureService)service
+               encodedLabels:(const uint8_t *)bytes
+                      length:(size_t)length
+           completionHandler:(SRGAnalyticsCollectorCompletionHandler)completionHandler
+{
+    NSURLRequest *request = [self requestWithService:service encodedLabels:[NSData dataWithBytes:bytes length:length]];
+    [self sendRequest:request attempt:0 completionHandler:completionHandler];
+}
+
+- (void)sendTagCommanderBatch:(NSData *)batch completionHandler:(SRGAnalyticsCollectorCompletionHandler)completionHandler
+{
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:[self.baseURL URLByAppendingPathComponent:@"tagcommander/batch"]];
+    request.HTTPMethod = @"POST";
+    request.HTTPBody = batch;
+    [request setValue:SRGAnalyticsBatchContentType forHTTPHeaderField:@"Content-Type"];
+    [self sendRequest:request.copy attempt:0 completionHandler:completionHandler];
+}
+
+- (void)sendRequest:(NSURLRequest *)request attempt:(NSUInteger)attempt completionHandler:(SRGAnalyticsCollectorCompletionHandler)completionHandler
+{
+    [[self.session dataTaskWithRequest:request completionHandler:^(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error) {
+        NSInteger statusCode = [response isKindOfClass:NSHTTPURLResponse.class] ? ((NSHTTPURLResponse *)response).statusCode : 0;
+        if (! error && statusCode >= 200 && statusCode < 300) {
+            completionHandler ? completionHandler(YES) : nil;
+            return;
+        }
+        
+        BOOL retryable = (error != nil || statusCode == 429 || statusCode >= 500);
+        if (! retryable || attempt + 1 >= self.maximumAttemptCount) {
+            SRGAnalyticsLogWarning(@"collector", @"Event could not be delivered to %@ (status %@, error %@)", request.URL, @(statusCode), error);
+            completionHandler ? completionHandler(NO) : nil;
+            return;
+        }
+        
+        NSTimeInterval delay = [self retryDelayForAttempt:attempt response:response];
+        SRGAnalyticsLogDebug(@"collector", @"Request to %@ failed (status %@, error %@). Retry in %.2f s", request.URL, @(statusCode), error, delay);
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+            [self sendRequest:request attempt:attempt + 1 completionHandler:completionHandler];
+        });
+    }] resume];
+}
+
+- (NSTimeInterval)retryDelayForAttempt:(NSUInteger)attempt response:(NSURLResponse *)response
+{
+    // Full jitter spreads retries of requests failing together
+    NSTimeInterval jitter = (double)arc4random_uniform(1000) / 1000.;
+    
+    if ([response isKindOfClass:NSHTTPURLResponse.class]) {
+        NSString *retryAfter = ((NSHTTPURLResponse *)response).allHeaderFields[@"Retry-After"];
+        if (retryAfter.doubleValue > 0.) {
+            return MIN(retryAfter.doubleValue, SRGAnalyticsCollectorMaximumRetryDelay) * (1. + jitter / 2.);
+        }
+    }
+    
+    NSTimeInterval delay = MIN(SRGAnalyticsCollectorInitialRetryDelay * (1 << MIN(attempt, 16)), SRGAnalyticsCollectorMaximumRetryDelay);
+    return delay / 2. + delay * jitter / 2.;
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; baseURL = %@; maximumAttemptCount = %@>",
+            self.class,
+            self,
+            self.baseURL,
+            @(self.maximumAttemptCount)];
+}
+
+@end
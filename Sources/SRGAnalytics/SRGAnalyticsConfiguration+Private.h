@@ -0,0 +1,20 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsConfiguration.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface SRGAnalyticsConfiguration (Private)
+
+/**
+ *  Sampling ratios set for specific hidden event names.
+ */
+@property (nonatomic, readonly) NSDictionary<NSString *, NSNumber *> *hiddenEventSamplingRatiosByName;
+
+@end
+
+NS_ASSUME_NONNULL_END
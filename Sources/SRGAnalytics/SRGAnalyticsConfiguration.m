@@ -23,6 +23,7 @@ SRGAnalyticsEnvironment const SRGAnalyticsEnvironmentProduction = @"prod";
 @property (nonatomic, copy) SRGAnalyticsBusinessUnitIdentifier businessUnitIdentifier;
 @property (nonatomic) NSInteger container;
 @property (nonatomic, copy) NSString *siteName;
+@property (nonatomic) NSMutableDictionary<NSString *, NSNumber *> *hiddenEventSamplingRatios;
 
 @end
 
@@ -40,6 +41,18 @@ SRGAnalyticsEnvironment const SRGAnalyticsEnvironmentProduction = @"prod";
         self.siteName = siteName;
         self.centralized = YES;
         self.environmentMode = SRGAnalyticsEnvironmentModeAutomatic;
+        self.eventJournalEnabled = YES;
+        self.pageViewDebounceInterval = 0.;
+        self.pageViewSamplingRatio = 1.;
+        self.hiddenEventSamplingRatio = 1.;
+        self.hiddenEventSamplingRatios = [NSMutableDictionary dictionary];
+        self.hiddenEventBurstSize = 20;
+        self.eventSummaryInterval = 300.;
+        self.hiddenEventAggregationInterval = 60.;
+        self.pendingEventMemoryBudget = 2 * 1024 * 1024;
+        self.pendingEventDropPolicy = SRGAnalyticsPendingEventDropPolicySampleHeartbeats;
+        self.applicationListMeasurementInterval = 7. * 24. * 60. * 60.;
+        self.collectorBatchInterval = 1.;
     }
     return self;
 }
@@ -84,6 +97,39 @@ SRGAnalyticsEnvironment const SRGAnalyticsEnvironmentProduction = @"prod";
     }
 }
 
+- (void)setPageViewSamplingRatio:(double)pageViewSamplingRatio
+{
+    _pageViewSamplingRatio = fmin(fmax(pageViewSamplingRatio, 0.), 1.);
+}
+
+- (void)setHiddenEventSamplingRatio:(double)hiddenEventSamplingRatio
+{
+    _hiddenEventSamplingRatio = fmin(fmax(hiddenEventSamplingRatio, 0.), 1.);
+}
+
+- (void)setMaximumHiddenEventRate:(double)maximumHiddenEventRate
+{
+    _maximumHiddenEventRate = fmax(maximumHiddenEventRate, 0.);
+}
+
+#pragma mark Sampling
+
+- (void)setSamplingRatio:(double)samplingRatio forHiddenEventsWithName:(NSString *)name
+{
+    self.hiddenEventSamplingRatios[name] = @(fmin(fmax(samplingRatio, 0.), 1.));
+}
+
+- (double)samplingRatioForHiddenEventsWithName:(NSString *)name
+{
+    NSNumber *samplingRatio = self.hiddenEventSamplingRatios[name];
+    return samplingRatio ? samplingRatio.doubleValue : self.hiddenEventSamplingRatio;
+}
+
+- (NSDictionary<NSString *, NSNumber *> *)hiddenEventSamplingRatiosByName
+{
+    return self.hiddenEventSamplingRatios.copy;
+}
+
 #pragma mark NSCopying protocol
 
 - (id)copyWithZone:(NSZone *)zone
@@ -95,6 +141,23 @@ SRGAnalyticsEnvironment const SRGAnalyticsEnvironmentProduction = @"prod";
     configuration.centralized = self.centralized;
     configuration.environmentMode = self.environmentMode;
     configuration.unitTesting = self.unitTesting;
+    configuration.eventJournalEnabled = self.eventJournalEnabled;
+    configuration.startDeferred = self.startDeferred;
+    configuration.pageViewDebounceInterval = self.pageViewDebounceInterval;
+    configuration.pageViewSamplingRatio = self.pageViewSamplingRatio;
+    configuration.hiddenEventSamplingRatio = self.hiddenEventSamplingRatio;
+    configuration.hiddenEventSamplingRatios = self.hiddenEventSamplingRatios.mutableCopy;
+    configuration.maximumHiddenEventRate = self.maximumHiddenEventRate;
+    configuration.hiddenEventBurstSize = self.hiddenEventBurstSize;
+    configuration.eventSummaryInterval = self.eventSummaryInterval;
+    configuration.hiddenEventAggregationInterval = self.hiddenEventAggregationInterval;
+    configuration.metricsNotificationInterval = self.metricsNotificationInterval;
+    configuration.captureBufferCapacity = self.captureBufferCapacity;
+    configuration.pendingEventMemoryBudget = self.pendingEventMemoryBudget;
+    configuration.pendingEventDropPolicy = self.pendingEventDropPolicy;
+    configuration.collectorURL = self.collectorURL;
+    configuration.collectorBatchInterval = self.collectorBatchInterval;
+    configuration.applicationListMeasurementInterval = self.applicationListMeasurementInterval;
     return configuration;
 }
 
@@ -0,0 +1,39 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsByteBuffer.h"
+#import "SRGAnalyticsLabelContext.h"
+
+@import Foundation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Label encoding formats.
+ */
+typedef NS_ENUM(NSInteger, SRGAnalyticsEncodingFormat) {
+    /**
+     *  JSON object, e.g. `{"key1":"value1","key2":"value2"}`.
+     */
+    SRGAnalyticsEncodingFormatJSON = 0,
+    /**
+     *  URL-encoded form, e.g. `key1=value1&key2=value2`.
+     */
+    SRGAnalyticsEncodingFormatURL
+};
+
+/**
+ *  Encode all labels resolved through a label context, appending the result to the specified buffer. Labels are
+ *  written straight from their storage, in key order, so that identical labels always yield identical bytes.
+ */
+OBJC_EXPORT void SRGAnalyticsEncodeLabelContext(SRGAnalyticsLabelContext *context, SRGAnalyticsEncodingFormat format, SRGAnalyticsByteBuffer *buffer);
+
+/**
+ *  Encode a labels dictionary, appending the result to the specified buffer.
+ */
+OBJC_EXPORT void SRGAnalyticsEncodeLabels(NSDictionary<NSString *, NSString *> *labels, SRGAnalyticsEncodingFormat format, SRGAnalyticsByteBuffer *buffer);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,214 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsEncoder.h"
+
+// Labels are collected on the stack up to this count
+static const NSUInteger SRGAnalyticsEncoderStackLabelCount = 64;
+
+// Strings are escaped by chunks of this size (in UTF-8 bytes)
+static const CFIndex SRGAnalyticsEncoderChunkSize = 256;
+
+// Labels are retained while collected, since some of them (e.g. numeric record values) are formatted on the fly
+typedef struct {
+    CFStringRef key;
+    CFStringRef label;
+} SRGAnalyticsEncoderLabel;
+
+typedef struct {
+    SRGAnalyticsEncoderLabel *labels;
+    NSUInteger count;
+    NSUInteger capacity;
+    SRGAnalyticsEncoderLabel stackLabels[SRGAnalyticsEncoderStackLabelCount];
+} SRGAnalyticsEncoderLabelList;
+
+static const char SRGAnalyticsEncoderHexDigits[] = "0123456789ABCDEF";
+
+#pragma mark Label list
+
+static void SRGAnalyticsEncoderLabelListInit(SRGAnalyticsEncoderLabelList *list)
+{
+    list->labels = list->stackLabels;
+    list->count = 0;
+    list->capacity = SRGAnalyticsEncoderStackLabelCount;
+}
+
+static void SRGAnalyticsEncoderLabelListAdd(SRGAnalyticsEncoderLabelList *list, NSString *key, NSString *label)
+{
+    if (list->count == list->capacity) {
+        NSUInteger capacity = 2 * list->capacity;
+        if (list->labels == list->stackLabels) {
+            list->labels = malloc(capacity * sizeof(SRGAnalyticsEncoderLabel));
+            memcpy(list->labels, list->stackLabels, list->count * sizeof(SRGAnalyticsEncoderLabel));
+        }
+        else {
+            list->labels = realloc(list->labels, capacity * sizeof(SRGAnalyticsEncoderLabel));
+        }
+        list->capacity = capacity;
+    }
+    
+    list->labels[list->count].key = (__bridge_retained CFStringRef)key;
+    list->labels[list->count].label = (__bridge_retained CFStringRef)label;
+    list->count += 1;
+}
+
+static void SRGAnalyticsEncoderLabelListDestroy(SRGAnalyticsEncoderLabelList *list)
+{
+    for (NSUInteger i = 0; i < list->count; ++i) {
+        CFRelease(list->labels[i].key);
+        CFRelease(list->labels[i].label);
+    }
+    if (list->labels != list->stackLabels) {
+        free(list->labels);
+    }
+}
+
+static int SRGAnalyticsEncoderCompareLabels(const void *label1, const void *label2)
+{
+    CFStringRef key1 = ((const SRGAnalyticsEncoderLabel *)label1)->key;
+    CFStringRef key2 = ((const SRGAnalyticsEncoderLabel *)label2)->key;
+    return (int)CFStringCompare(key1, key2, 0);
+}
+
+#pragma mark Escaping
+
+// Escape UTF-8 bytes into the output, which must be able to hold 6 bytes per input byte. Return the output length.
+static size_t SRGAnalyticsEncoderEscape(const uint8_t *bytes, size_t length, SRGAnalyticsEncodingFormat format, uint8_t *output)
+{
+    size_t outputLength = 0;
+    
+    for (size_t i = 0; i < length; ++i) {
+        uint8_t byte = bytes[i];
+        if (format == SRGAnalyticsEncodingFormatJSON) {
+            if (byte == '"' || byte == '\\') {
+                output[outputLength++] = '\\';
+                output[outputLength++] = byte;
+            }
+            else if (byte < 0x20) {
+                output[outputLength++] = '\\';
+                output[outputLength++] = 'u';
+                output[outputLength++] = '0';
+                output[outputLength++] = '0';
+                output[outputLength++] = SRGAnalyticsEncoderHexDigits[byte >> 4];
+                output[outputLength++] = SRGAnalyticsEncoderHexDigits[byte & 0xf];
+            }
+            else {
+                output[outputLength++] = byte;
+            }
+        }
+        else {
+            // Unreserved characters, see https://tools.ietf.org/html/rfc3986#section-2.3
+            BOOL isUnreserved = (byte >= 'a' && byte <= 'z') || (byte >= 'A' && byte <= 'Z') || (byte >= '0' && byte <= '9')
+                || byte == '-' || byte == '.' || byte == '_' || byte == '~';
+            if (isUnreserved) {
+                output[outputLength++] = byte;
+            }
+            else {
+                output[outputLength++] = '%';
+                output[outputLength++] = SRGAnalyticsEncoderHexDigits[byte >> 4];
+                output[outputLength++] = SRGAnalyticsEncoderHexDigits[byte & 0xf];
+            }
+        }
+    }
+    
+    return outputLength;
+}
+
+static void SRGAnalyticsEncoderAppendString(CFStringRef string, SRGAnalyticsEncodingFormat format, SRGAnalyticsByteBuffer *buffer)
+{
+    uint8_t output[6 * SRGAnalyticsEncoderChunkSize];
+    
+    // Fast path: strings whose UTF-8 representation is directly available, which is only the case for ASCII contents
+    // (one byte per character)
+    const char *cString = CFStringGetCStringPtr(string, kCFStringEncodingUTF8);
+    if (cString) {
+        size_t length = (size_t)CFStringGetLength(string);
+        for (size_t location = 0; location < length; location += SRGAnalyticsEncoderChunkSize) {
+            size_t chunkLength = MIN(length - location, (size_t)SRGAnalyticsEncoderChunkSize);
+            size_t outputLength = SRGAnalyticsEncoderEscape((const uint8_t *)cString + location, chunkLength, format, output);
+            [buffer appendBytes:output length:outputLength];
+        }
+        return;
+    }
+    
+    // Otherwise convert to UTF-8 by chunks on the stack
+    uint8_t chunk[SRGAnalyticsEncoderChunkSize];
+    CFIndex length = CFStringGetLength(string);
+    CFIndex location = 0;
+    while (location < length) {
+        CFIndex usedLength = 0;
+        CFIndex convertedLength = CFStringGetBytes(string, CFRangeMake(location, length - location), kCFStringEncodingUTF8, '?', false, chunk, sizeof(chunk), &usedLength);
+        if (convertedLength == 0) {
+            break;
+        }
+        
+        size_t outputLength = SRGAnalyticsEncoderEscape(chunk, usedLength, format, output);
+        [buffer appendBytes:output length:outputLength];
+        location += convertedLength;
+    }
+}
+
+static void SRGAnalyticsEncoderAppendLiteral(const char *literal, SRGAnalyticsByteBuffer *buffer)
+{
+    [buffer appendBytes:literal length:strlen(literal)];
+}
+
+#pragma mark Encoding
+
+static void SRGAnalyticsEncodeLabelList(SRGAnalyticsEncoderLabelList *list, SRGAnalyticsEncodingFormat format, SRGAnalyticsByteBuffer *buffer)
+{
+    qsort(list->labels, list->count, sizeof(SRGAnalyticsEncoderLabel), SRGAnalyticsEncoderCompareLabels);
+    
+    if (format == SRGAnalyticsEncodingFormatJSON) {
+        SRGAnalyticsEncoderAppendLiteral("{", buffer);
+        for (NSUInteger i = 0; i < list->count; ++i) {
+            SRGAnalyticsEncoderAppendLiteral(i == 0 ? "\"" : ",\"", buffer);
+            SRGAnalyticsEncoderAppendString(list->labels[i].key, format, buffer);
+            SRGAnalyticsEncoderAppendLiteral("\":\"", buffer);
+            SRGAnalyticsEncoderAppendString(list->labels[i].label, format, buffer);
+            SRGAnalyticsEncoderAppendLiteral("\"", buffer);
+        }
+        SRGAnalyticsEncoderAppendLiteral("}", buffer);
+    }
+    else {
+        for (NSUInteger i = 0; i < list->count; ++i) {
+            if (i != 0) {
+                SRGAnalyticsEncoderAppendLiteral("&", buffer);
+            }
+            SRGAnalyticsEncoderAppendString(list->labels[i].key, format, buffer);
+            SRGAnalyticsEncoderAppendLiteral("=", buffer);
+            SRGAnalyticsEncoderAppendString(list->labels[i].label, format, buffer);
+        }
+    }
+}
+
+void SRGAnalyticsEncodeLabelContext(SRGAnalyticsLabelContext *context, SRGAnalyticsEncodingFormat format, SRGAnalyticsByteBuffer *buffer)
+{
+    SRGAnalyticsEncoderLabelList list;
+    SRGAnalyticsEncoderLabelListInit(&list);
+    
+    SRGAnalyticsEncoderLabelList *listPointer = &list;
+    [context enumerateLabelsUsingBlock:^(NSString * _Nonnull key, NSString * _Nonnull label, BOOL * _Nonnull stop) {
+        SRGAnalyticsEncoderLabelListAdd(listPointer, key, label);
+    }];
+    
+    SRGAnalyticsEncodeLabelList(&list, format, buffer);
+    SRGAnalyticsEncoderLabelListDestroy(&list);
+}
+
+void SRGAnalyticsEncodeLabels(NSDictionary<NSString *, NSString *> *labels, SRGAnalyticsEncodingFormat format, SRGAnalyticsByteBuffer *buffer)
+{
+    SRGAnalyticsEncoderLabelList list;
+    SRGAnalyticsEncoderLabelListInit(&list);
+    
+    SRGAnalyticsEncoderLabelList *listPointer = &list;
+    [labels enumerateKeysAndObjectsUsingBlock:^(NSString * _Nonnull key, NSString * _Nonnull label, BOOL * _Nonnull stop) {
+        SRGAnalyticsEncoderLabelListAdd(listPointer, key, label);
+    }];
+    
+    SRGAnalyticsEncodeLabelList(&list, format, buffer);
+    SRGAnalyticsEncoderLabelListDestroy(&list);
+}
@@ -0,0 +1,242 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsEventRecord.h"
+#import "SRGAnalyticsHiddenEventLabels.h"
+#import "SRGAnalyticsPageViewLabels.h"
+
+@import Foundation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class SRGAnalyticsMemoryBudgetEntry;
+
+/**
+ *  Event types.
+ */
+typedef NS_ENUM(NSInteger, SRGAnalyticsEventType) {
+    /**
+     *  Page view.
+     */
+    SRGAnalyticsEventTypePageView = 0,
+    /**
+     *  Hidden event.
+     */
+    SRGAnalyticsEventTypeHiddenEvent,
+    /**
+     *  Event whose TagCommander labels have been fully built by the emitter as a record (e.g. media events).
+     */
+    SRGAnalyticsEventTypeRecord
+};
+
+/**
+ *  Event priorities, deciding which pending events are dropped first under memory pressure. Priorities follow lanes
+ *  (@see `SRGAnalyticsEventLane`), events of less important lanes having lower priorities.
+ */
+typedef NS_ENUM(NSInteger, SRGAnalyticsEventPriority) {
+    /**
+     *  Media heartbeats.
+     */
+    SRGAnalyticsEventPriorityLow = 0,
+    /**
+     *  Internal measurement events.
+     */
+    SRGAnalyticsEventPriorityNormal,
+    /**
+     *  Page views, hidden events and media events other than heartbeats.
+     */
+    SRGAnalyticsEventPriorityHigh
+};
+
+/**
+ *  Number of event priorities.
+ */
+static const NSUInteger SRGAnalyticsEventPriorityCount = 3;
+
+/**
+ *  Event lanes, from the most to the least important. Pending events are processed lane by lane in this order, so
+ *  that important events go out first when events pile up, e.g. under backpressure or when little background time
+ *  is left. Events of a same session are an exception, @see `SRGAnalyticsEvent.sessionIdentifier`.
+ */
+typedef NS_ENUM(NSInteger, SRGAnalyticsEventLane) {
+    /**
+     *  Media session events (play, stop, eof, etc.), heartbeats excepted.
+     */
+    SRGAnalyticsEventLaneCritical = 0,
+    /**
+     *  Page views and hidden events.
+     */
+    SRGAnalyticsEventLanePageView,
+    /**
+     *  Internal measurement events, e.g. installed application measurements or event summaries.
+     */
+    SRGAnalyticsEventLaneBackground,
+    /**
+     *  Media heartbeats.
+     */
+    SRGAnalyticsEventLaneHeartbeat
+};
+
+/**
+ *  Number of event lanes.
+ */
+static const NSUInteger SRGAnalyticsEventLaneCount = 4;
+
+/**
+ *  Processing policy of an event lane.
+ */
+typedef struct {
+    /**
+     *  Maximum time (in seconds) events wait in the event queue before being processed. Events with a deadline are
+     *  processed together, or earlier along with events of other lanes.
+     */
+    NSTimeInterval deadline;
+    /**
+     *  Whether sinks are flushed after events of the lane have been processed, rather than being left to send them
+     *  along with later events.
+     */
+    BOOL flushesSinks;
+    /**
+     *  The ratio (between 0 and 1) of a sink pipeline capacity available to events of the lane. Less important lanes
+     *  cannot fill a pipeline, keeping room for more important events.
+     */
+    double sinkCapacityRatio;
+} SRGAnalyticsEventLanePolicy;
+
+/**
+ *  Return the policy of the specified lane.
+ */
+OBJC_EXPORT SRGAnalyticsEventLanePolicy SRGAnalyticsEventLanePolicyForLane(SRGAnalyticsEventLane lane);
+
+/**
+ *  Compact and immutable record of an event, captured on the thread the event is emitted from. Labels are built
+ *  from this record later, when the event is processed.
+ */
+@interface SRGAnalyticsEvent : NSObject
+
+/**
+ *  Page view event.
+ */
++ (SRGAnalyticsEvent *)pageViewEventWithTitle:(NSString *)title
+                                       levels:(nullable NSArray<NSString *> *)levels
+                                       labels:(nullable SRGAnalyticsPageViewLabels *)labels
+                         fromPushNotification:(BOOL)fromPushNotification;
+
+/**
+ *  Hidden event.
+ */
++ (SRGAnalyticsEvent *)hiddenEventWithName:(NSString *)name labels:(nullable SRGAnalyticsHiddenEventLabels *)labels;
+
+/**
+ *  Hidden event emitted by the library itself to measure the application or the library (e.g. installed applications
+ *  or event summaries). Such events are sent in the background lane.
+ */
++ (SRGAnalyticsEvent *)measurementEventWithName:(NSString *)name labels:(nullable SRGAnalyticsHiddenEventLabels *)labels;
+
+/**
+ *  Event with TagCommander labels prebuilt as a record. Session labels override record labels and, since they are
+ *  usually shared by several events, are retained without being copied. Events of a same session must share the
+ *  same non-zero session identifier.
+ */
++ (SRGAnalyticsEvent *)recordEventWithRecord:(SRGAnalyticsEventRecord *)record
+                               sessionLabels:(nullable NSDictionary<NSString *, NSString *> *)sessionLabels
+                           sessionIdentifier:(NSUInteger)sessionIdentifier
+                       unitTestingIdentifier:(nullable NSString *)unitTestingIdentifier;
+
+/**
+ *  The event type.
+ */
+@property (nonatomic, readonly) SRGAnalyticsEventType type;
+
+/**
+ *  The page view title or the hidden event name, `nil` for record events.
+ */
+@property (nonatomic, readonly, copy, nullable) NSString *name;
+
+/**
+ *  The page view levels, if any.
+ */
+@property (nonatomic, readonly, copy, nullable) NSArray<NSString *> *levels;
+
+/**
+ *  The labels associated with a page view or hidden event, if any.
+ */
+@property (nonatomic, readonly, copy, nullable) __kindof SRGAnalyticsLabels *labels;
+
+/**
+ *  The record associated with a record event.
+ */
+@property (nonatomic, readonly, nullable) SRGAnalyticsEventRecord *record;
+
+/**
+ *  The session labels associated with a record event, if any.
+ */
+@property (nonatomic, readonly, nullable) NSDictionary<NSString *, NSString *> *sessionLabels;
+
+/**
+ *  The identifier of the session a record event belongs to, 0 if none. Events of a same session are processed in
+ *  the order they were emitted, whatever their lanes.
+ */
+@property (nonatomic, readonly) NSUInteger sessionIdentifier;
+
+/**
+ *  `YES` iff the page view was opened from a push notification.
+ */
+@property (nonatomic, readonly, getter=isFromPushNotification) BOOL fromPushNotification;
+
+/**
+ *  The time at which the event was recorded.
+ */
+@property (nonatomic, readonly) NSTimeInterval timestamp;
+
+/**
+ *  The unit testing identifier valid when the event was recorded, if any.
+ */
+@property (nonatomic, readonly, copy, nullable) NSString *unitTestingIdentifier;
+
+/**
+ *  The event lane, determined when the event is created.
+ */
+@property (nonatomic, readonly) SRGAnalyticsEventLane lane;
+
+/**
+ *  The event priority, derived from its lane.
+ */
+@property (nonatomic, readonly) SRGAnalyticsEventPriority priority;
+
+/**
+ *  Estimate of the memory (in bytes) retained by the event, accounted for within the pending event memory budget.
+ *  Calculated once when the event is created, from instance sizes, string lengths and record slot storage, without
+ *  formatting any label.
+ */
+@property (nonatomic, readonly) NSUInteger byteCount;
+
+/**
+ *  Block called once TagCommander labels of the event have been delivered, on an arbitrary thread. Must be set before
+ *  the event is tracked.
+ */
+@property (nonatomic, copy, nullable) void (^deliveryHandler)(void);
+
+/**
+ *  `YES` iff the event was emitted before the tracker configuration was known, and therefore must still be
+ *  deduplicated and subjected to sampling and rate limiting when released. Must be set before the event is tracked.
+ */
+@property (nonatomic, getter=isFilteringDeferred) BOOL filteringDeferred;
+
+/**
+ *  The entry accounting for the event within the pending event memory budget, set when the event is admitted.
+ */
+@property (nonatomic, nullable) SRGAnalyticsMemoryBudgetEntry *budgetEntry;
+
+@end
+
+@interface SRGAnalyticsEvent (Unavailable)
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,198 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsEvent.h"
+
+#import "SRGAnalyticsNotifications.h"
+#import "SRGAnalyticsTracker.h"
+
+#import <objc/runtime.h>
+
+SRGAnalyticsEventLanePolicy SRGAnalyticsEventLanePolicyForLane(SRGAnalyticsEventLane lane)
+{
+    static const SRGAnalyticsEventLanePolicy s_policies[] = {
+        [SRGAnalyticsEventLaneCritical] = { .deadline = 0., .flushesSinks = YES, .sinkCapacityRatio = 1. },
+        [SRGAnalyticsEventLanePageView] = { .deadline = 0., .flushesSinks = YES, .sinkCapacityRatio = 1. },
+        [SRGAnalyticsEventLaneBackground] = { .deadline = 2., .flushesSinks = NO, .sinkCapacityRatio = 0.75 },
+        [SRGAnalyticsEventLaneHeartbeat] = { .deadline = 0.5, .flushesSinks = NO, .sinkCapacityRatio = 0.5 }
+    };
+    NSCParameterAssert(lane >= 0 && lane < SRGAnalyticsEventLaneCount);
+    return s_policies[lane];
+}
+
+@interface SRGAnalyticsEvent ()
+
+@property (nonatomic) SRGAnalyticsEventType type;
+@property (nonatomic, copy) NSString *name;
+@property (nonatomic, copy) NSArray<NSString *> *levels;
+@property (nonatomic, copy) __kindof SRGAnalyticsLabels *labels;
+@property (nonatomic) SRGAnalyticsEventRecord *record;
+@property (nonatomic) NSDictionary<NSString *, NSString *> *sessionLabels;
+@property (nonatomic) NSUInteger sessionIdentifier;
+@property (nonatomic, getter=isFromPushNotification) BOOL fromPushNotification;
+@property (nonatomic) NSTimeInterval timestamp;
+@property (nonatomic, copy) NSString *unitTestingIdentifier;
+@property (nonatomic) SRGAnalyticsEventLane lane;
+@property (nonatomic) NSUInteger byteCount;
+
+@end
+
+@implementation SRGAnalyticsEvent
+
+#pragma mark Class methods
+
++ (SRGAnalyticsEvent *)pageViewEventWithTitle:(NSString *)title
+                                       levels:(NSArray<NSString *> *)levels
+                                       labels:(SRGAnalyticsPageViewLabels *)labels
+                         fromPushNotification:(BOOL)fromPushNotification
+{
+    SRGAnalyticsEvent *event = [[SRGAnalyticsEvent alloc] initWithType:SRGAnalyticsEventTypePageView lane:SRGAnalyticsEventLanePageView];
+    event.name = title;
+    event.levels = levels;
+    event.labels = labels;
+    event.fromPushNotification = fromPushNotification;
+    event.byteCount = [event calculatedByteCount];
+    return event;
+}
+
++ (SRGAnalyticsEvent *)hiddenEventWithName:(NSString *)name labels:(SRGAnalyticsHiddenEventLabels *)labels
+{
+    return [self hiddenEventWithName:name labels:labels lane:SRGAnalyticsEventLanePageView];
+}
+
++ (SRGAnalyticsEvent *)measurementEventWithName:(NSString *)name labels:(SRGAnalyticsHiddenEventLabels *)labels
+{
+    return [self hiddenEventWithName:name labels:labels lane:SRGAnalyticsEventLaneBackground];
+}
+
++ (SRGAnalyticsEvent *)hiddenEventWithName:(NSString *)name labels:(SRGAnalyticsHiddenEventLabels *)labels lane:(SRGAnalyticsEventLane)lane
+{
+    SRGAnalyticsEvent *event = [[SRGAnalyticsEvent alloc] initWithType:SRGAnalyticsEventTypeHiddenEvent lane:lane];
+    event.name = name;
+    event.labels = labels;
+    event.byteCount = [event calculatedByteCount];
+    return event;
+}
+
++ (SRGAnalyticsEvent *)recordEventWithRecord:(SRGAnalyticsEventRecord *)record
+                               sessionLabels:(NSDictionary<NSString *, NSString *> *)sessionLabels
+                           sessionIdentifier:(NSUInteger)sessionIdentifier
+                       unitTestingIdentifier:(NSString *)unitTestingIdentifier
+{
+    // The record is immutable, its event identifier can be read once
+    NSString *eventId = [record labelForKey:@"event_id"];
+    BOOL heartbeat = [eventId isEqualToString:@"pos"] || [eventId isEqualToString:@"uptime"];
+    
+    SRGAnalyticsEvent *event = [[SRGAnalyticsEvent alloc] initWithType:SRGAnalyticsEventTypeRecord
+                                                                   lane:heartbeat ? SRGAnalyticsEventLaneHeartbeat : SRGAnalyticsEventLaneCritical];
+    event.record = record;
+    event.sessionLabels = sessionLabels;
+    event.sessionIdentifier = sessionIdentifier;
+    if (unitTestingIdentifier) {
+        event.unitTestingIdentifier = unitTestingIdentifier;
+    }
+    event.byteCount = [event calculatedByteCount];
+    return event;
+}
+
+#pragma mark Object lifecycle
+
+- (instancetype)initWithType:(SRGAnalyticsEventType)type lane:(SRGAnalyticsEventLane)lane
+{
+    if (self = [super init]) {
+        self.type = type;
+        self.lane = lane;
+        self.timestamp = NSDate.date.timeIntervalSince1970;
+        
+        // The identifier might be renewed before the event is processed. Capture it now.
+        if (SRGAnalyticsTracker.sharedTracker.configuration.unitTesting) {
+            self.unitTestingIdentifier = SRGAnalyticsUnitTestingIdentifier();
+        }
+    }
+    return self;
+}
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-implementations"
+
+- (instancetype)init
+{
+    [self doesNotRecognizeSelector:_cmd];
+    return [self initWithType:SRGAnalyticsEventTypeRecord lane:SRGAnalyticsEventLaneCritical];
+}
+
+#pragma clang diagnostic pop
+
+#pragma mark Getters and setters
+
+- (SRGAnalyticsEventPriority)priority
+{
+    switch (self.lane) {
+        case SRGAnalyticsEventLaneBackground: {
+            return SRGAnalyticsEventPriorityNormal;
+            break;
+        }
+            
+        case SRGAnalyticsEventLaneHeartbeat: {
+            return SRGAnalyticsEventPriorityLow;
+            break;
+        }
+            
+        default: {
+            return SRGAnalyticsEventPriorityHigh;
+            break;
+        }
+    }
+}
+
+#pragma mark Accounting
+
+// Every object retained by the event is accounted for, estimated from its instance size and string lengths. Session
+// labels, though usually shared by all events of a media session, are accounted for by each event retaining them, so
+// that usage is never underestimated. Labels stored in record slots are accounted for by the record itself, without
+// being formatted.
+- (NSUInteger)calculatedByteCount
+{
+    NSUInteger byteCount = class_getInstanceSize(self.class) + SRGAnalyticsStringByteCount(self.name) + SRGAnalyticsStringByteCount(self.unitTestingIdentifier);
+    for (NSString *level in self.levels) {
+        byteCount += SRGAnalyticsStringByteCount(level);
+    }
+    byteCount += [self labelsByteCount];
+    byteCount += self.record.byteCount + SRGAnalyticsLabelsByteCount(self.sessionLabels);
+    return byteCount;
+}
+
+- (NSUInteger)labelsByteCount
+{
+    SRGAnalyticsLabels *labels = self.labels;
+    if (! labels) {
+        return 0;
+    }
+    
+    NSUInteger byteCount = class_getInstanceSize(labels.class) + SRGAnalyticsLabelsByteCount(labels.customInfo) + SRGAnalyticsLabelsByteCount(labels.comScoreCustomInfo);
+    if ([labels isKindOfClass:SRGAnalyticsHiddenEventLabels.class]) {
+        SRGAnalyticsHiddenEventLabels *hiddenEventLabels = (SRGAnalyticsHiddenEventLabels *)labels;
+        byteCount += SRGAnalyticsStringByteCount(hiddenEventLabels.type) + SRGAnalyticsStringByteCount(hiddenEventLabels.value) + SRGAnalyticsStringByteCount(hiddenEventLabels.source);
+        byteCount += SRGAnalyticsStringByteCount(hiddenEventLabels.extraValue1) + SRGAnalyticsStringByteCount(hiddenEventLabels.extraValue2) + SRGAnalyticsStringByteCount(hiddenEventLabels.extraValue3);
+        byteCount += SRGAnalyticsStringByteCount(hiddenEventLabels.extraValue4) + SRGAnalyticsStringByteCount(hiddenEventLabels.extraValue5);
+    }
+    return byteCount;
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; type = %@; lane = %@; name = %@; timestamp = %@>",
+            self.class,
+            self,
+            @(self.type),
+            @(self.lane),
+            self.name,
+            @(self.timestamp)];
+}
+
+@end
@@ -0,0 +1,76 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsConfiguration.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Policy decisions.
+ */
+typedef NS_ENUM(NSInteger, SRGAnalyticsEventDecision) {
+    /**
+     *  The event must be sent.
+     */
+    SRGAnalyticsEventDecisionAccept = 0,
+    /**
+     *  The event must be dropped, the user being sampled out.
+     */
+    SRGAnalyticsEventDecisionSampledOut,
+    /**
+     *  The event must be dropped, the maximum rate having been exceeded.
+     */
+    SRGAnalyticsEventDecisionRateLimited
+};
+
+/**
+ *  Number of events dropped by a policy.
+ */
+typedef struct {
+    NSUInteger sampledOutCount;
+    NSUInteger rateLimitedCount;
+} SRGAnalyticsEventPolicyCounts;
+
+/**
+ *  Sampling and rate limiting policy applied before events are enqueued. Decisions are thread-safe, lock-free and
+ *  do not allocate.
+ */
+@interface SRGAnalyticsEventPolicy : NSObject
+
+/**
+ *  Return the sampling seed of the current user, generated once and persisted in the user defaults.
+ */
++ (uint64_t)userSamplingSeed;
+
+/**
+ *  Create a policy applying the settings of the specified configuration. Sampling is deterministic for a given seed.
+ */
+- (instancetype)initWithConfiguration:(SRGAnalyticsConfiguration *)configuration samplingSeed:(uint64_t)samplingSeed NS_DESIGNATED_INITIALIZER;
+
+/**
+ *  Decision for a page view.
+ */
+- (SRGAnalyticsEventDecision)decisionForPageView;
+
+/**
+ *  Decision for a hidden event with the specified name.
+ */
+- (SRGAnalyticsEventDecision)decisionForHiddenEventWithName:(NSString *)name;
+
+/**
+ *  Return the number of events dropped since the last call, resetting counts to zero.
+ */
+- (SRGAnalyticsEventPolicyCounts)takeCounts;
+
+@end
+
+@interface SRGAnalyticsEventPolicy (Unavailable)
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
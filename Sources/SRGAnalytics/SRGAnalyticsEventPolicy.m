@@ -0,0 +1,180 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsEventPolicy.h"
+
+#import "SRGAnalyticsConfiguration+Private.h"
+#import "SRGAnalyticsRateLimiter.h"
+
+#import <stdatomic.h>
+
+static NSString * const SRGAnalyticsSamplingSeedKey = @"SRGAnalyticsSamplingSeed";
+
+// Distinguishes page views from hidden events sharing the same seed
+static const uint64_t SRGAnalyticsPageViewSamplingSalt = 0x70616765766965ULL;
+
+static uint64_t SRGAnalyticsMix(uint64_t value)
+{
+    // splitmix64 finalizer
+    value += 0x9e3779b97f4a7c15ULL;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+static uint64_t SRGAnalyticsNameHash(NSString *name)
+{
+    // FNV-1a over UTF-16 code units, read in stack chunks
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    
+    unichar characters[64];
+    NSUInteger length = name.length;
+    for (NSUInteger location = 0; location < length; location += 64) {
+        NSUInteger chunkLength = MIN(length - location, 64);
+        [name getCharacters:characters range:NSMakeRange(location, chunkLength)];
+        for (NSUInteger i = 0; i < chunkLength; ++i) {
+            hash ^= characters[i];
+            hash *= 0x100000001b3ULL;
+        }
+    }
+    return hash;
+}
+
+// Map a 64-bit value to [0, 1) and compare it with the ratio
+static BOOL SRGAnalyticsIsSampledIn(uint64_t value, double ratio)
+{
+    if (ratio >= 1.) {
+        return YES;
+    }
+    else if (ratio <= 0.) {
+        return NO;
+    }
+    else {
+        return (double)(SRGAnalyticsMix(value) >> 11) * 0x1.0p-53 < ratio;
+    }
+}
+
+@interface SRGAnalyticsEventPolicy ()
+
+@property (nonatomic) uint64_t samplingSeed;
+@property (nonatomic) double pageViewSamplingRatio;
+@property (nonatomic) double hiddenEventSamplingRatio;
+@property (nonatomic, copy) NSDictionary<NSString *, NSNumber *> *hiddenEventSamplingRatios;
+@property (nonatomic) SRGAnalyticsRateLimiter *hiddenEventRateLimiter;
+
+@end
+
+@implementation SRGAnalyticsEventPolicy {
+@private
+    _Atomic(NSUInteger) _sampledOutCount;
+    _Atomic(NSUInteger) _rateLimitedCount;
+}
+
+#pragma mark Class methods
+
++ (uint64_t)userSamplingSeed
+{
+    static uint64_t s_samplingSeed;
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        NSUserDefaults *userDefaults = NSUserDefaults.standardUserDefaults;
+        NSString *seedString = [userDefaults stringForKey:SRGAnalyticsSamplingSeedKey];
+        if (seedString) {
+            s_samplingSeed = strtoull(seedString.UTF8String, NULL, 16);
+        }
+        else {
+            arc4random_buf(&s_samplingSeed, sizeof(s_samplingSeed));
+            [userDefaults setObject:[NSString stringWithFormat:@"%016llx", s_samplingSeed] forKey:SRGAnalyticsSamplingSeedKey];
+        }
+    });
+    return s_samplingSeed;
+}
+
+#pragma mark Object lifecycle
+
+- (instancetype)initWithConfiguration:(SRGAnalyticsConfiguration *)configuration samplingSeed:(uint64_t)samplingSeed
+{
+    if (self = [super init]) {
+        self.samplingSeed = samplingSeed;
+        self.pageViewSamplingRatio = configuration.pageViewSamplingRatio;
+        self.hiddenEventSamplingRatio = configuration.hiddenEventSamplingRatio;
+        self.hiddenEventSamplingRatios = configuration.hiddenEventSamplingRatiosByName;
+        
+        if (configuration.maximumHiddenEventRate > 0.) {
+            self.hiddenEventRateLimiter = [[SRGAnalyticsRateLimiter alloc] initWithRate:configuration.maximumHiddenEventRate
+                                                                              burstSize:configuration.hiddenEventBurstSize];
+        }
+        
+        atomic_init(&_sampledOutCount, 0);
+        atomic_init(&_rateLimitedCount, 0);
+    }
+    return self;
+}
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-implementations"
+
+- (instancetype)init
+{
+    [self doesNotRecognizeSelector:_cmd];
+    return [self initWithConfiguration:[SRGAnalyticsConfiguration new] samplingSeed:0];
+}
+
+#pragma clang diagnostic pop
+
+#pragma mark Decisions
+
+- (SRGAnalyticsEventDecision)decisionForPageView
+{
+    if (! SRGAnalyticsIsSampledIn(self.samplingSeed ^ SRGAnalyticsPageViewSamplingSalt, self.pageViewSamplingRatio)) {
+        atomic_fetch_add_explicit(&_sampledOutCount, 1, memory_order_relaxed);
+        return SRGAnalyticsEventDecisionSampledOut;
+    }
+    return SRGAnalyticsEventDecisionAccept;
+}
+
+- (SRGAnalyticsEventDecision)decisionForHiddenEventWithName:(NSString *)name
+{
+    NSNumber *samplingRatioNumber = self.hiddenEventSamplingRatios[name];
+    double samplingRatio = samplingRatioNumber ? samplingRatioNumber.doubleValue : self.hiddenEventSamplingRatio;
+    
+    // Avoid hashing the name when no sampling is applied
+    if (samplingRatio < 1. && ! SRGAnalyticsIsSampledIn(self.samplingSeed ^ SRGAnalyticsNameHash(name), samplingRatio)) {
+        atomic_fetch_add_explicit(&_sampledOutCount, 1, memory_order_relaxed);
+        return SRGAnalyticsEventDecisionSampledOut;
+    }
+    
+    if (self.hiddenEventRateLimiter && ! [self.hiddenEventRateLimiter acquire]) {
+        atomic_fetch_add_explicit(&_rateLimitedCount, 1, memory_order_relaxed);
+        return SRGAnalyticsEventDecisionRateLimited;
+    }
+    
+    return SRGAnalyticsEventDecisionAccept;
+}
+
+#pragma mark Counts
+
+- (SRGAnalyticsEventPolicyCounts)takeCounts
+{
+    SRGAnalyticsEventPolicyCounts counts;
+    counts.sampledOutCount = atomic_exchange_explicit(&_sampledOutCount, 0, memory_order_relaxed);
+    counts.rateLimitedCount = atomic_exchange_explicit(&_rateLimitedCount, 0, memory_order_relaxed);
+    return counts;
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; pageViewSamplingRatio = %@; hiddenEventSamplingRatio = %@; hiddenEventRateLimiter = %@>",
+            self.class,
+            self,
+            @(self.pageViewSamplingRatio),
+            @(self.hiddenEventSamplingRatio),
+            self.hiddenEventRateLimiter];
+}
+
+@end
@@ -0,0 +1,78 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsEvent.h"
+
+@import Foundation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Block called on the queue worker to process a batch of events, lane by lane, in the order they were enqueued
+ *  within each lane.
+ */
+typedef void (^SRGAnalyticsEventQueueHandler)(NSArray<SRGAnalyticsEvent *> *events);
+
+/**
+ *  Multi-producer, single-consumer event queue. Events can be enqueued from any thread without taking any lock. They
+ *  are processed by a single serial worker, in batches containing all events enqueued since the worker last ran.
+ *
+ *  Each event lane (@see `SRGAnalyticsEventLane`) has its own queue. Events of lanes without deadline wake the worker
+ *  up immediately, while events of other lanes wait for their lane deadline to expire, unless the worker runs earlier.
+ *  Batches contain events of more important lanes first, so that they are processed first when events pile up. Events
+ *  of a session enqueued before a more important event of the same session are moved to its lane, so that e.g. pending
+ *  heartbeats of a playback session are processed before its stop event.
+ */
+@interface SRGAnalyticsEventQueue : NSObject
+
+/**
+ *  Create a queue whose worker calls the provided handler.
+ */
+- (instancetype)initWithName:(NSString *)name handler:(SRGAnalyticsEventQueueHandler)handler;
+
+/**
+ *  Enqueue an event. Can be called from any thread.
+ */
+- (void)enqueueEvent:(SRGAnalyticsEvent *)event;
+
+/**
+ *  Process all events enqueued so far, deadlines notwithstanding, calling the completion handler on the main thread
+ *  afterwards.
+ */
+- (void)flushWithCompletionHandler:(nullable void (^)(void))completionHandler;
+
+/**
+ *  Process all events enqueued so far, blocking the calling thread until done or until the timeout expires. Returns
+ *  `YES` iff all events could be processed before the timeout.
+ *
+ *  @discussion Must not be called from the queue worker.
+ */
+- (BOOL)drainWithTimeout:(NSTimeInterval)timeout;
+
+/**
+ *  Perform a block on the queue worker, after all events enqueued so far have been processed.
+ */
+- (void)performBlock:(void (^)(void))block;
+
+/**
+ *  The number of events enqueued but not processed yet.
+ */
+@property (nonatomic, readonly) NSUInteger pendingCount;
+
+/**
+ *  Return `YES` iff called from the queue worker.
+ */
+@property (nonatomic, readonly, getter=isCurrentQueue) BOOL currentQueue;
+
+@end
+
+@interface SRGAnalyticsEventQueue (Unavailable)
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
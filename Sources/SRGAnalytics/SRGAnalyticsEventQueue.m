@@ -0,0 +1,270 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsEventQueue.h"
+
+#import <stdatomic.h>
+
+typedef struct SRGAnalyticsEventQueueNode {
+    struct SRGAnalyticsEventQueueNode *next;
+    void *event;                                    // Retained `SRGAnalyticsEvent`
+    unsigned long sequence;                         // Enqueuing order, across all lanes
+    NSUInteger sessionIdentifier;
+    SRGAnalyticsEventLane lane;                     // Lane the event is processed in, possibly promoted
+} SRGAnalyticsEventQueueNode;
+
+static void *s_queueKey = &s_queueKey;
+
+static int SRGAnalyticsEventQueueNodeCompareSequences(const void *value1, const void *value2);
+static int SRGAnalyticsEventQueueNodeCompareLanes(const void *value1, const void *value2);
+
+@interface SRGAnalyticsEventQueue () {
+@private
+    _Atomic(SRGAnalyticsEventQueueNode *) _heads[SRGAnalyticsEventLaneCount];
+    atomic_bool _deadlinesArmed[SRGAnalyticsEventLaneCount];
+    atomic_long _pendingCount;
+    atomic_ulong _nextSequence;
+}
+
+@property (nonatomic) dispatch_queue_t queue;
+@property (nonatomic) dispatch_source_t source;
+@property (nonatomic, copy) SRGAnalyticsEventQueueHandler handler;
+
+@end
+
+@implementation SRGAnalyticsEventQueue
+
+#pragma mark Object lifecycle
+
+- (instancetype)initWithName:(NSString *)name handler:(SRGAnalyticsEventQueueHandler)handler
+{
+    if (self = [super init]) {
+        for (NSUInteger lane = 0; lane < SRGAnalyticsEventLaneCount; ++lane) {
+            atomic_init(&_heads[lane], NULL);
+            atomic_init(&_deadlinesArmed[lane], false);
+        }
+        atomic_init(&_pendingCount, 0);
+        atomic_init(&_nextSequence, 0);
+        
+        self.handler = handler;
+        self.queue = dispatch_queue_create(name.UTF8String, DISPATCH_QUEUE_SERIAL);
+        dispatch_queue_set_specific(self.queue, s_queueKey, (__bridge void *)self, NULL);
+        
+        // Producers only signal the source, which coalesces signals received while the worker is busy. A single
+        // worker run can therefore process events enqueued by several producers.
+        self.source = dispatch_source_create(DISPATCH_SOURCE_TYPE_DATA_ADD, 0, 0, self.queue);
+        
+        __weak __typeof(self) weakSelf = self;
+        dispatch_source_set_event_handler(self.source, ^{
+            [weakSelf processPendingEvents];
+        });
+        dispatch_resume(self.source);
+    }
+    return self;
+}
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-implementations"
+
+- (instancetype)init
+{
+    [self doesNotRecognizeSelector:_cmd];
+    return [self initWithName:@"" handler:^(NSArray<SRGAnalyticsEvent *> *events) {}];
+}
+
+#pragma clang diagnostic pop
+
+- (void)dealloc
+{
+    dispatch_source_cancel(_source);
+    
+    for (NSUInteger lane = 0; lane < SRGAnalyticsEventLaneCount; ++lane) {
+        SRGAnalyticsEventQueueNode *node = atomic_exchange(&_heads[lane], NULL);
+        while (node) {
+            SRGAnalyticsEventQueueNode *next = node->next;
+            CFRelease(node->event);
+            free(node);
+            node = next;
+        }
+    }
+}
+
+#pragma mark Getters and setters
+
+- (NSUInteger)pendingCount
+{
+    long pendingCount = atomic_load_explicit(&_pendingCount, memory_order_relaxed);
+    return (NSUInteger)MAX(pendingCount, 0);
+}
+
+- (BOOL)isCurrentQueue
+{
+    return dispatch_get_specific(s_queueKey) == (__bridge void *)self;
+}
+
+#pragma mark Queue management
+
+- (void)enqueueEvent:(SRGAnalyticsEvent *)event
+{
+    SRGAnalyticsEventLane lane = event.lane;
+    
+    SRGAnalyticsEventQueueNode *node = malloc(sizeof(SRGAnalyticsEventQueueNode));
+    node->event = (__bridge_retained void *)event;
+    node->sequence = atomic_fetch_add_explicit(&_nextSequence, 1, memory_order_relaxed);
+    node->sessionIdentifier = event.sessionIdentifier;
+    node->lane = lane;
+    
+    // Lock-free push onto the lane list head. The consumer always detaches whole lists at once, so there is no ABA
+    // issue to fear.
+    node->next = atomic_load_explicit(&_heads[lane], memory_order_relaxed);
+    while (! atomic_compare_exchange_weak_explicit(&_heads[lane], &node->next, node, memory_order_release, memory_order_relaxed));
+    
+    atomic_fetch_add_explicit(&_pendingCount, 1, memory_order_relaxed);
+    
+    NSTimeInterval deadline = SRGAnalyticsEventLanePolicyForLane(lane).deadline;
+    if (deadline == 0.) {
+        dispatch_source_merge_data(self.source, 1);
+    }
+    else if (! atomic_exchange_explicit(&_deadlinesArmed[lane], true, memory_order_acq_rel)) {
+        // The flag is cleared before events are detached, so that events enqueued afterwards arm a new deadline
+        __weak __typeof(self) weakSelf = self;
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(deadline * NSEC_PER_SEC)), self.queue, ^{
+            __strong __typeof(weakSelf) strongSelf = weakSelf;
+            if (strongSelf) {
+                atomic_store_explicit(&strongSelf->_deadlinesArmed[lane], false, memory_order_release);
+                [strongSelf processPendingEvents];
+            }
+        });
+    }
+}
+
+- (void)processPendingEvents
+{
+    NSAssert(self.currentQueue, @"Events must be processed on the queue worker");
+    
+    @autoreleasepool {
+        NSUInteger count = 0;
+        SRGAnalyticsEventQueueNode *heads[SRGAnalyticsEventLaneCount];
+        for (NSUInteger lane = 0; lane < SRGAnalyticsEventLaneCount; ++lane) {
+            heads[lane] = atomic_exchange_explicit(&_heads[lane], NULL, memory_order_acquire);
+            for (SRGAnalyticsEventQueueNode *node = heads[lane]; node; node = node->next) {
+                ++count;
+            }
+        }
+        
+        if (count == 0) {
+            return;
+        }
+        
+        SRGAnalyticsEventQueueNode **nodes = malloc(count * sizeof(SRGAnalyticsEventQueueNode *));
+        NSUInteger index = 0;
+        for (NSUInteger lane = 0; lane < SRGAnalyticsEventLaneCount; ++lane) {
+            for (SRGAnalyticsEventQueueNode *node = heads[lane]; node; node = node->next) {
+                nodes[index++] = node;
+            }
+        }
+        
+        // Events of a session must not overtake each other. Walking events backwards in enqueuing order, promote each
+        // session event to the most important lane of the events of the same session enqueued after it, so that e.g.
+        // pending heartbeats are processed before the stop event which triggered processing.
+        qsort(nodes, count, sizeof(SRGAnalyticsEventQueueNode *), SRGAnalyticsEventQueueNodeCompareSequences);
+        
+        NSMutableDictionary<NSNumber *, NSNumber *> *sessionLanes = nil;
+        for (NSInteger i = (NSInteger)count - 1; i >= 0; --i) {
+            SRGAnalyticsEventQueueNode *node = nodes[i];
+            if (node->sessionIdentifier == 0) {
+                continue;
+            }
+            
+            if (! sessionLanes) {
+                sessionLanes = [NSMutableDictionary dictionary];
+            }
+            
+            NSNumber *sessionLane = sessionLanes[@(node->sessionIdentifier)];
+            if (sessionLane && sessionLane.integerValue < node->lane) {
+                node->lane = sessionLane.integerValue;
+            }
+            else {
+                sessionLanes[@(node->sessionIdentifier)] = @(node->lane);
+            }
+        }
+        
+        // Process events lane by lane, in the order they were enqueued within each lane
+        qsort(nodes, count, sizeof(SRGAnalyticsEventQueueNode *), SRGAnalyticsEventQueueNodeCompareLanes);
+        
+        NSMutableArray<SRGAnalyticsEvent *> *events = [NSMutableArray arrayWithCapacity:count];
+        for (NSUInteger i = 0; i < count; ++i) {
+            SRGAnalyticsEventQueueNode *node = nodes[i];
+            [events addObject:(__bridge_transfer SRGAnalyticsEvent *)node->event];
+            free(node);
+        }
+        free(nodes);
+        
+        self.handler(events.copy);
+        atomic_fetch_sub_explicit(&_pendingCount, (long)events.count, memory_order_relaxed);
+    }
+}
+
+- (void)performBlock:(void (^)(void))block
+{
+    dispatch_async(self.queue, ^{
+        [self processPendingEvents];
+        block();
+    });
+}
+
+- (void)flushWithCompletionHandler:(void (^)(void))completionHandler
+{
+    [self performBlock:^{
+        if (completionHandler) {
+            dispatch_async(dispatch_get_main_queue(), completionHandler);
+        }
+    }];
+}
+
+- (BOOL)drainWithTimeout:(NSTimeInterval)timeout
+{
+    NSAssert(! self.currentQueue, @"Cannot drain the queue from its own worker");
+    
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    [self performBlock:^{
+        dispatch_semaphore_signal(semaphore);
+    }];
+    return dispatch_semaphore_wait(semaphore, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(timeout * NSEC_PER_SEC))) == 0;
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; pendingCount = %@>",
+            self.class,
+            self,
+            @(self.pendingCount)];
+}
+
+@end
+
+#pragma mark Functions
+
+static int SRGAnalyticsEventQueueNodeCompareSequences(const void *value1, const void *value2)
+{
+    const SRGAnalyticsEventQueueNode *node1 = *(SRGAnalyticsEventQueueNode * const *)value1;
+    const SRGAnalyticsEventQueueNode *node2 = *(SRGAnalyticsEventQueueNode * const *)value2;
+    return (node1->sequence > node2->sequence) - (node1->sequence < node2->sequence);
+}
+
+static int SRGAnalyticsEventQueueNodeCompareLanes(const void *value1, const void *value2)
+{
+    const SRGAnalyticsEventQueueNode *node1 = *(SRGAnalyticsEventQueueNode * const *)value1;
+    const SRGAnalyticsEventQueueNode *node2 = *(SRGAnalyticsEventQueueNode * const *)value2;
+    if (node1->lane != node2->lane) {
+        return (node1->lane > node2->lane) - (node1->lane < node2->lane);
+    }
+    else {
+        return SRGAnalyticsEventQueueNodeCompareSequences(value1, value2);
+    }
+}
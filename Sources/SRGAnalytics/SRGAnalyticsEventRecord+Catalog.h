@@ -0,0 +1,155 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+// Generated by Scripts/SRGAnalyticsLabelCatalogGenerator.swift from Scripts/SRGAnalyticsLabelSchema.json. Do not edit.
+
+#import "SRGAnalyticsEventRecord.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Typed setters for labels known to the library.
+ */
+@interface SRGAnalyticsEventRecord (Catalog)
+
+/**
+ *  `event_id` label.
+ */
+- (void)setEventId:(nullable NSString *)eventId;
+
+/**
+ *  `event_name` label.
+ */
+- (void)setEventName:(nullable NSString *)eventName;
+
+/**
+ *  `navigation_property_type` label.
+ */
+- (void)setNavigationPropertyType:(nullable NSString *)navigationPropertyType;
+
+/**
+ *  `navigation_bu_distributer` label.
+ */
+- (void)setNavigationBuDistributer:(nullable NSString *)navigationBuDistributer;
+
+/**
+ *  `navigation_level_<index + 1>` label, for indexes from 0 to 7.
+ */
+- (void)setNavigationLevel:(nullable NSString *)navigationLevel atIndex:(NSUInteger)index;
+
+/**
+ *  `content_title` label.
+ */
+- (void)setContentTitle:(nullable NSString *)contentTitle;
+
+/**
+ *  `accessed_after_push_notification` label.
+ */
+- (void)setAccessedAfterPushNotification:(BOOL)accessedAfterPushNotification;
+
+/**
+ *  `media_embedding_environment` label.
+ */
+- (void)setMediaEmbeddingEnvironment:(nullable NSString *)mediaEmbeddingEnvironment;
+
+/**
+ *  `media_player_display` label.
+ */
+- (void)setMediaPlayerDisplay:(nullable NSString *)mediaPlayerDisplay;
+
+/**
+ *  `media_player_version` label.
+ */
+- (void)setMediaPlayerVersion:(nullable NSString *)mediaPlayerVersion;
+
+/**
+ *  `media_position` label.
+ */
+- (void)setMediaPosition:(int64_t)mediaPosition;
+
+/**
+ *  `media_volume` label.
+ */
+- (void)setMediaVolume:(int64_t)mediaVolume;
+
+/**
+ *  `media_subtitles_on` label.
+ */
+- (void)setMediaSubtitlesOn:(BOOL)mediaSubtitlesOn;
+
+/**
+ *  `media_subtitle_selection` label.
+ */
+- (void)setMediaSubtitleSelection:(nullable NSString *)mediaSubtitleSelection;
+
+/**
+ *  `media_audio_track` label.
+ */
+- (void)setMediaAudioTrack:(nullable NSString *)mediaAudioTrack;
+
+/**
+ *  `media_bandwidth` label.
+ */
+- (void)setMediaBandwidth:(double)mediaBandwidth;
+
+/**
+ *  `media_bandwidth_p50` label.
+ */
+- (void)setMediaBandwidthP50:(double)mediaBandwidthP50;
+
+/**
+ *  `media_bandwidth_p90` label.
+ */
+- (void)setMediaBandwidthP90:(double)mediaBandwidthP90;
+
+/**
+ *  `media_indicated_bitrate` label.
+ */
+- (void)setMediaIndicatedBitrate:(double)mediaIndicatedBitrate;
+
+/**
+ *  `media_indicated_bitrate_p50` label.
+ */
+- (void)setMediaIndicatedBitrateP50:(double)mediaIndicatedBitrateP50;
+
+/**
+ *  `media_indicated_bitrate_p90` label.
+ */
+- (void)setMediaIndicatedBitrateP90:(double)mediaIndicatedBitrateP90;
+
+/**
+ *  `media_timeshift` label.
+ */
+- (void)setMediaTimeshift:(int64_t)mediaTimeshift;
+
+/**
+ *  `srg_title` label.
+ */
+- (void)setSrgTitle:(nullable NSString *)srgTitle;
+
+/**
+ *  `srg_ap_push` label.
+ */
+- (void)setSrgApPush:(int64_t)srgApPush;
+
+/**
+ *  `srg_n<index + 1>` label, for indexes from 0 to 9.
+ */
+- (void)setSrgN:(nullable NSString *)srgN atIndex:(NSUInteger)index;
+
+/**
+ *  `ns_category` label.
+ */
+- (void)setNsCategory:(nullable NSString *)nsCategory;
+
+/**
+ *  `name` label.
+ */
+- (void)setName:(nullable NSString *)name;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,150 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+// Generated by Scripts/SRGAnalyticsLabelCatalogGenerator.swift from Scripts/SRGAnalyticsLabelSchema.json. Do not edit.
+
+#import "SRGAnalyticsEventRecord+Catalog.h"
+
+@implementation SRGAnalyticsEventRecord (Catalog)
+
+- (void)setEventId:(NSString *)eventId
+{
+    [self setString:eventId forSlot:SRGAnalyticsLabelSlotEventId];
+}
+
+- (void)setEventName:(NSString *)eventName
+{
+    [self setString:eventName forSlot:SRGAnalyticsLabelSlotEventName];
+}
+
+- (void)setNavigationPropertyType:(NSString *)navigationPropertyType
+{
+    [self setString:navigationPropertyType forSlot:SRGAnalyticsLabelSlotNavigationPropertyType];
+}
+
+- (void)setNavigationBuDistributer:(NSString *)navigationBuDistributer
+{
+    [self setString:navigationBuDistributer forSlot:SRGAnalyticsLabelSlotNavigationBuDistributer];
+}
+
+- (void)setNavigationLevel:(NSString *)navigationLevel atIndex:(NSUInteger)index
+{
+    NSParameterAssert(index < SRGAnalyticsLabelNavigationLevelCount);
+    [self setString:navigationLevel forSlot:SRGAnalyticsLabelSlotNavigationLevel1 + index];
+}
+
+- (void)setContentTitle:(NSString *)contentTitle
+{
+    [self setString:contentTitle forSlot:SRGAnalyticsLabelSlotContentTitle];
+}
+
+- (void)setAccessedAfterPushNotification:(BOOL)accessedAfterPushNotification
+{
+    [self setBoolean:accessedAfterPushNotification forSlot:SRGAnalyticsLabelSlotAccessedAfterPushNotification];
+}
+
+- (void)setMediaEmbeddingEnvironment:(NSString *)mediaEmbeddingEnvironment
+{
+    [self setString:mediaEmbeddingEnvironment forSlot:SRGAnalyticsLabelSlotMediaEmbeddingEnvironment];
+}
+
+- (void)setMediaPlayerDisplay:(NSString *)mediaPlayerDisplay
+{
+    [self setString:mediaPlayerDisplay forSlot:SRGAnalyticsLabelSlotMediaPlayerDisplay];
+}
+
+- (void)setMediaPlayerVersion:(NSString *)mediaPlayerVersion
+{
+    [self setString:mediaPlayerVersion forSlot:SRGAnalyticsLabelSlotMediaPlayerVersion];
+}
+
+- (void)setMediaPosition:(int64_t)mediaPosition
+{
+    [self setInteger:mediaPosition forSlot:SRGAnalyticsLabelSlotMediaPosition];
+}
+
+- (void)setMediaVolume:(int64_t)mediaVolume
+{
+    [self setInteger:mediaVolume forSlot:SRGAnalyticsLabelSlotMediaVolume];
+}
+
+- (void)setMediaSubtitlesOn:(BOOL)mediaSubtitlesOn
+{
+    [self setBoolean:mediaSubtitlesOn forSlot:SRGAnalyticsLabelSlotMediaSubtitlesOn];
+}
+
+- (void)setMediaSubtitleSelection:(NSString *)mediaSubtitleSelection
+{
+    [self setString:mediaSubtitleSelection forSlot:SRGAnalyticsLabelSlotMediaSubtitleSelection];
+}
+
+- (void)setMediaAudioTrack:(NSString *)mediaAudioTrack
+{
+    [self setString:mediaAudioTrack forSlot:SRGAnalyticsLabelSlotMediaAudioTrack];
+}
+
+- (void)setMediaBandwidth:(double)mediaBandwidth
+{
+    [self setDouble:mediaBandwidth forSlot:SRGAnalyticsLabelSlotMediaBandwidth];
+}
+
+- (void)setMediaBandwidthP50:(double)mediaBandwidthP50
+{
+    [self setDouble:mediaBandwidthP50 forSlot:SRGAnalyticsLabelSlotMediaBandwidthP50];
+}
+
+- (void)setMediaBandwidthP90:(double)mediaBandwidthP90
+{
+    [self setDouble:mediaBandwidthP90 forSlot:SRGAnalyticsLabelSlotMediaBandwidthP90];
+}
+
+- (void)setMediaIndicatedBitrate:(double)mediaIndicatedBitrate
+{
+    [self setDouble:mediaIndicatedBitrate forSlot:SRGAnalyticsLabelSlotMediaIndicatedBitrate];
+}
+
+- (void)setMediaIndicatedBitrateP50:(double)mediaIndicatedBitrateP50
+{
+    [self setDouble:mediaIndicatedBitrateP50 forSlot:SRGAnalyticsLabelSlotMediaIndicatedBitrateP50];
+}
+
+- (void)setMediaIndicatedBitrateP90:(double)mediaIndicatedBitrateP90
+{
+    [self setDouble:mediaIndicatedBitrateP90 forSlot:SRGAnalyticsLabelSlotMediaIndicatedBitrateP90];
+}
+
+- (void)setMediaTimeshift:(int64_t)mediaTimeshift
+{
+    [self setInteger:mediaTimeshift forSlot:SRGAnalyticsLabelSlotMediaTimeshift];
+}
+
+- (void)setSrgTitle:(NSString *)srgTitle
+{
+    [self setString:srgTitle forSlot:SRGAnalyticsLabelSlotSrgTitle];
+}
+
+- (void)setSrgApPush:(int64_t)srgApPush
+{
+    [self setInteger:srgApPush forSlot:SRGAnalyticsLabelSlotSrgApPush];
+}
+
+- (void)setSrgN:(NSString *)srgN atIndex:(NSUInteger)index
+{
+    NSParameterAssert(index < SRGAnalyticsLabelSrgNCount);
+    [self setString:srgN forSlot:SRGAnalyticsLabelSlotSrgN1 + index];
+}
+
+- (void)setNsCategory:(NSString *)nsCategory
+{
+    [self setString:nsCategory forSlot:SRGAnalyticsLabelSlotNsCategory];
+}
+
+- (void)setName:(NSString *)name
+{
+    [self setString:name forSlot:SRGAnalyticsLabelSlotName];
+}
+
+@end
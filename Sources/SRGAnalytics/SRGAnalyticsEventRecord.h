@@ -0,0 +1,83 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsLabelCatalog.h"
+
+@import Foundation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Fixed-slot record of event labels. Labels known to the library (see `SRGAnalyticsLabelCatalog.h`) are stored
+ *  in slots indexed at compile time, keeping their native value until they are formatted when the record is
+ *  enumerated. Other labels are stored in an overflow map.
+ *
+ *  Typed setters for known labels are available from the `Catalog` category, generated from the label schema.
+ *
+ *  @discussion A record is not thread-safe and must not be mutated once handed over to the tracker.
+ */
+@interface SRGAnalyticsEventRecord : NSObject
+
+/**
+ *  Set a label value for the specified slot. Setting `nil` removes the label. The slot type must match the
+ *  setter used.
+ */
+- (void)setString:(nullable NSString *)string forSlot:(SRGAnalyticsLabelSlot)slot;
+- (void)setInteger:(int64_t)integer forSlot:(SRGAnalyticsLabelSlot)slot;
+- (void)setDouble:(double)value forSlot:(SRGAnalyticsLabelSlot)slot;
+- (void)setBoolean:(BOOL)boolean forSlot:(SRGAnalyticsLabelSlot)slot;
+
+/**
+ *  Remove the label stored in the specified slot, if any.
+ */
+- (void)removeValueForSlot:(SRGAnalyticsLabelSlot)slot;
+
+/**
+ *  Free-form labels (e.g. custom information), overriding labels stored in slots. The dictionary is shared, not
+ *  copied.
+ */
+@property (nonatomic, nullable) NSDictionary<NSString *, NSString *> *overflowLabels;
+
+/**
+ *  Return the formatted label for the specified key, if any.
+ */
+- (nullable NSString *)labelForKey:(NSString *)key;
+
+/**
+ *  Return `YES` iff the record contains a label for the specified key.
+ */
+- (BOOL)containsLabelForKey:(NSString *)key;
+
+/**
+ *  Enumerate all labels, formatted as strings. Labels stored in slots are enumerated first, in slot order, followed
+ *  by overflow labels.
+ */
+- (void)enumerateLabelsUsingBlock:(void (NS_NOESCAPE ^)(NSString *key, NSString *label, BOOL *stop))block;
+
+/**
+ *  A dictionary of all labels, formatted as strings.
+ */
+@property (nonatomic, readonly) NSDictionary<NSString *, NSString *> *dictionary;
+
+/**
+ *  The memory (in bytes) used by the record: its fixed slot storage, the contents of strings stored in slots and
+ *  of overflow labels. Maintained by setters, so that no label needs to be formatted.
+ */
+@property (nonatomic, readonly) NSUInteger byteCount;
+
+@end
+
+/**
+ *  Return the memory (in bytes) used by a string, i.e. its UTF-16 contents and a reference to it.
+ */
+OBJC_EXPORT NSUInteger SRGAnalyticsStringByteCount(NSString * _Nullable string);
+
+/**
+ *  Return the memory (in bytes) used by the contents of the specified labels.
+ */
+OBJC_EXPORT NSUInteger SRGAnalyticsLabelsByteCount(NSDictionary<NSString *, NSString *> * _Nullable labels);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,196 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsEventRecord.h"
+
+#import <objc/runtime.h>
+
+typedef union {
+    int64_t integer;
+    double doubleValue;
+    BOOL boolean;
+} SRGAnalyticsEventRecordValue;
+
+NSUInteger SRGAnalyticsStringByteCount(NSString *string)
+{
+    return string ? sizeof(NSString *) + string.length * sizeof(unichar) : 0;
+}
+
+NSUInteger SRGAnalyticsLabelsByteCount(NSDictionary<NSString *, NSString *> *labels)
+{
+    __block NSUInteger byteCount = 0;
+    [labels enumerateKeysAndObjectsUsingBlock:^(NSString * _Nonnull key, NSString * _Nonnull label, BOOL * _Nonnull stop) {
+        byteCount += SRGAnalyticsStringByteCount(key) + SRGAnalyticsStringByteCount(label);
+    }];
+    return byteCount;
+}
+
+@implementation SRGAnalyticsEventRecord {
+@private
+    NSString *_strings[SRGAnalyticsLabelSlotCount];
+    SRGAnalyticsEventRecordValue _values[SRGAnalyticsLabelSlotCount];
+    BOOL _occupied[SRGAnalyticsLabelSlotCount];
+    
+    // Contents of strings stored in slots, in bytes
+    NSUInteger _stringByteCount;
+}
+
+#pragma mark Setters
+
+- (void)setString:(NSString *)string forSlot:(SRGAnalyticsLabelSlot)slot
+{
+    NSParameterAssert(slot >= 0 && slot < SRGAnalyticsLabelSlotCount);
+    NSAssert(SRGAnalyticsLabelTypeForSlot(slot) == SRGAnalyticsLabelTypeString, @"The slot must store strings");
+    
+    _stringByteCount -= SRGAnalyticsStringByteCount(_strings[slot]);
+    _strings[slot] = string.copy;
+    _stringByteCount += SRGAnalyticsStringByteCount(_strings[slot]);
+    _occupied[slot] = (string != nil);
+}
+
+- (void)setInteger:(int64_t)integer forSlot:(SRGAnalyticsLabelSlot)slot
+{
+    NSParameterAssert(slot >= 0 && slot < SRGAnalyticsLabelSlotCount);
+    NSAssert(SRGAnalyticsLabelTypeForSlot(slot) == SRGAnalyticsLabelTypeInteger, @"The slot must store integers");
+    
+    _values[slot].integer = integer;
+    _occupied[slot] = YES;
+}
+
+- (void)setDouble:(double)value forSlot:(SRGAnalyticsLabelSlot)slot
+{
+    NSParameterAssert(slot >= 0 && slot < SRGAnalyticsLabelSlotCount);
+    NSAssert(SRGAnalyticsLabelTypeForSlot(slot) == SRGAnalyticsLabelTypeDouble, @"The slot must store doubles");
+    
+    _values[slot].doubleValue = value;
+    _occupied[slot] = YES;
+}
+
+- (void)setBoolean:(BOOL)boolean forSlot:(SRGAnalyticsLabelSlot)slot
+{
+    NSParameterAssert(slot >= 0 && slot < SRGAnalyticsLabelSlotCount);
+    NSAssert(SRGAnalyticsLabelTypeForSlot(slot) == SRGAnalyticsLabelTypeBoolean, @"The slot must store booleans");
+    
+    _values[slot].boolean = boolean;
+    _occupied[slot] = YES;
+}
+
+- (void)removeValueForSlot:(SRGAnalyticsLabelSlot)slot
+{
+    NSParameterAssert(slot >= 0 && slot < SRGAnalyticsLabelSlotCount);
+    
+    _stringByteCount -= SRGAnalyticsStringByteCount(_strings[slot]);
+    _strings[slot] = nil;
+    _occupied[slot] = NO;
+}
+
+#pragma mark Getters
+
+- (NSString *)formattedLabelForSlot:(SRGAnalyticsLabelSlot)slot
+{
+    if (! _occupied[slot]) {
+        return nil;
+    }
+    
+    // Formatting must match the one previously applied when building string labels eagerly
+    switch (SRGAnalyticsLabelTypeForSlot(slot)) {
+        case SRGAnalyticsLabelTypeString: {
+            return _strings[slot];
+        }
+            
+        case SRGAnalyticsLabelTypeInteger: {
+            return @(_values[slot].integer).stringValue;
+        }
+            
+        case SRGAnalyticsLabelTypeDouble: {
+            return @(_values[slot].doubleValue).stringValue;
+        }
+            
+        case SRGAnalyticsLabelTypeBoolean: {
+            return _values[slot].boolean ? @"true" : @"false";
+        }
+            
+        default: {
+            return nil;
+        }
+    }
+}
+
+- (NSString *)labelForKey:(NSString *)key
+{
+    NSString *overflowLabel = self.overflowLabels[key];
+    if (overflowLabel) {
+        return overflowLabel;
+    }
+    
+    NSInteger slot = SRGAnalyticsLabelSlotForKey(key);
+    return (slot != NSNotFound) ? [self formattedLabelForSlot:slot] : nil;
+}
+
+- (BOOL)containsLabelForKey:(NSString *)key
+{
+    if (self.overflowLabels[key]) {
+        return YES;
+    }
+    
+    NSInteger slot = SRGAnalyticsLabelSlotForKey(key);
+    return (slot != NSNotFound) && _occupied[slot];
+}
+
+- (void)enumerateLabelsUsingBlock:(void (NS_NOESCAPE ^)(NSString *key, NSString *label, BOOL *stop))block
+{
+    NSDictionary<NSString *, NSString *> *overflowLabels = self.overflowLabels;
+    BOOL hasOverflowLabels = (overflowLabels.count != 0);
+    
+    BOOL stop = NO;
+    for (NSInteger slot = 0; slot < SRGAnalyticsLabelSlotCount; ++slot) {
+        if (! _occupied[slot]) {
+            continue;
+        }
+        
+        NSString *key = SRGAnalyticsLabelKeyForSlot(slot);
+        if (hasOverflowLabels && overflowLabels[key]) {
+            continue;
+        }
+        
+        block(key, [self formattedLabelForSlot:slot], &stop);
+        if (stop) {
+            return;
+        }
+    }
+    
+    if (hasOverflowLabels) {
+        [overflowLabels enumerateKeysAndObjectsUsingBlock:^(NSString * _Nonnull key, NSString * _Nonnull label, BOOL * _Nonnull stop) {
+            block(key, label, stop);
+        }];
+    }
+}
+
+- (NSDictionary<NSString *, NSString *> *)dictionary
+{
+    NSMutableDictionary<NSString *, NSString *> *dictionary = [NSMutableDictionary dictionary];
+    [self enumerateLabelsUsingBlock:^(NSString * _Nonnull key, NSString * _Nonnull label, BOOL * _Nonnull stop) {
+        dictionary[key] = label;
+    }];
+    return dictionary.copy;
+}
+
+- (NSUInteger)byteCount
+{
+    return class_getInstanceSize(self.class) + _stringByteCount + SRGAnalyticsLabelsByteCount(self.overflowLabels);
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; labels = %@>",
+            self.class,
+            self,
+            self.dictionary];
+}
+
+@end
@@ -0,0 +1,92 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+@import Foundation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  A repeating heartbeat, created by a scheduler.
+ */
+@interface SRGAnalyticsHeartbeat : NSObject
+
+/**
+ *  The heartbeat interval, in seconds.
+ */
+@property (nonatomic, readonly) NSTimeInterval interval;
+
+/**
+ *  `NO` once the heartbeat has been invalidated.
+ */
+@property (nonatomic, readonly, getter=isValid) BOOL valid;
+
+/**
+ *  Stop the heartbeat. Its handler is not called anymore once this method returns, provided it is called from the
+ *  main thread. Can be called from any thread.
+ */
+- (void)invalidate;
+
+@end
+
+/**
+ *  Schedules repeating heartbeats with a timing wheel driven by a single dispatch source on a dedicated queue, rather
+ *  than with one timer per heartbeat on the main run loop.
+ *
+ *  Time is measured with a monotonic clock (@see `SRGAnalyticsMonotonicTime()`) and divided into ticks. Heartbeats
+ *  due during the same tick fire together, and the first deadline of a new heartbeat is moved earlier (by at most 10%
+ *  of its interval) to match the deadline of an existing heartbeat, if any. Since heartbeats then keep their phase,
+ *  heartbeats sharing an interval usually fire together, so that a single wakeup per interval serves all of them. The
+ *  dispatch source is only armed for the next tick with due heartbeats.
+ *
+ *  Deadlines do not depend on when previous beats were handled, so that a busy main thread delays beats without them
+ *  drifting. Beats missed entirely (e.g. while the process was suspended) are skipped.
+ *
+ *  @discussion Thread-safe. Handlers are called on the main thread.
+ */
+@interface SRGAnalyticsHeartbeatScheduler : NSObject
+
+/**
+ *  The process-wide scheduler.
+ */
+@property (class, nonatomic, readonly) SRGAnalyticsHeartbeatScheduler *sharedScheduler;
+
+/**
+ *  Create a scheduler whose wheel has the specified number of slots, each one lasting the specified tick interval (in
+ *  seconds). Heartbeats due in more than one wheel rotation are supported, though less efficiently.
+ */
+- (instancetype)initWithTickInterval:(NSTimeInterval)tickInterval slotCount:(NSUInteger)slotCount NS_DESIGNATED_INITIALIZER;
+
+/**
+ *  Schedule a heartbeat calling the handler on the main thread at the specified interval (in seconds), starting one
+ *  interval from now. The heartbeat fires until invalidated. Handlers should not retain their heartbeat owner.
+ */
+- (SRGAnalyticsHeartbeat *)scheduleHeartbeatWithInterval:(NSTimeInterval)interval handler:(void (^)(void))handler;
+
+/**
+ *  The number of valid heartbeats.
+ */
+@property (nonatomic, readonly) NSUInteger heartbeatCount;
+
+/**
+ *  The number of times the scheduler woke up to fire heartbeats.
+ */
+@property (nonatomic, readonly) NSUInteger wakeupCount;
+
+@end
+
+@interface SRGAnalyticsHeartbeat (Unavailable)
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+@interface SRGAnalyticsHeartbeatScheduler (Unavailable)
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,349 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsHeartbeatScheduler.h"
+
+#import "SRGAnalyticsClock.h"
+
+#import <stdatomic.h>
+
+// Shared scheduler settings (a rotation lasts 64 seconds)
+static const NSTimeInterval SRGAnalyticsHeartbeatSchedulerTickInterval = 0.25;
+static const NSUInteger SRGAnalyticsHeartbeatSchedulerSlotCount = 256;
+
+// First deadlines can be moved earlier by this ratio of the heartbeat interval
+static const double SRGAnalyticsHeartbeatAlignmentTolerance = 0.1;
+
+@interface SRGAnalyticsHeartbeat () {
+@private
+    atomic_bool _valid;
+}
+
+- (instancetype)initWithScheduler:(SRGAnalyticsHeartbeatScheduler *)scheduler interval:(NSTimeInterval)interval handler:(void (^)(void))handler;
+
+@property (nonatomic, weak) SRGAnalyticsHeartbeatScheduler *scheduler;
+@property (nonatomic) NSTimeInterval interval;
+@property (nonatomic, copy) void (^handler)(void);
+
+// Wheel state, only accessed on the scheduler queue
+@property (nonatomic) uint64_t intervalTicks;
+@property (nonatomic) uint64_t deadlineTick;
+
+@end
+
+@interface SRGAnalyticsHeartbeatScheduler () {
+@private
+    atomic_ulong _heartbeatCount;
+    atomic_ulong _wakeupCount;
+}
+
+@property (nonatomic) uint64_t tickDuration;            // In nanoseconds
+@property (nonatomic) uint64_t originTime;
+
+@property (nonatomic) dispatch_queue_t queue;
+@property (nonatomic) dispatch_source_t source;
+
+// Only accessed on the queue
+@property (nonatomic) NSArray<NSMutableArray<SRGAnalyticsHeartbeat *> *> *slots;
+@property (nonatomic) uint64_t currentTick;
+
+- (void)removeHeartbeat:(SRGAnalyticsHeartbeat *)heartbeat;
+
+@end
+
+@implementation SRGAnalyticsHeartbeatScheduler
+
+#pragma mark Class methods
+
++ (SRGAnalyticsHeartbeatScheduler *)sharedScheduler
+{
+    static dispatch_once_t s_onceToken;
+    static SRGAnalyticsHeartbeatScheduler *s_scheduler;
+    dispatch_once(&s_onceToken, ^{
+        s_scheduler = [[SRGAnalyticsHeartbeatScheduler alloc] initWithTickInterval:SRGAnalyticsHeartbeatSchedulerTickInterval
+                                                                         slotCount:SRGAnalyticsHeartbeatSchedulerSlotCount];
+    });
+    return s_scheduler;
+}
+
+#pragma mark Object lifecycle
+
+- (instancetype)initWithTickInterval:(NSTimeInterval)tickInterval slotCount:(NSUInteger)slotCount
+{
+    NSParameterAssert(tickInterval > 0.);
+    NSParameterAssert(slotCount > 0);
+    
+    if (self = [super init]) {
+        atomic_init(&_heartbeatCount, 0);
+        atomic_init(&_wakeupCount, 0);
+        
+        self.tickDuration = (uint64_t)(tickInterval * NSEC_PER_SEC);
+        self.originTime = SRGAnalyticsMonotonicTime();
+        
+        NSMutableArray<NSMutableArray<SRGAnalyticsHeartbeat *> *> *slots = [NSMutableArray arrayWithCapacity:slotCount];
+        for (NSUInteger i = 0; i < slotCount; ++i) {
+            [slots addObject:[NSMutableArray array]];
+        }
+        self.slots = slots.copy;
+        
+        self.queue = dispatch_queue_create("ch.srgssr.analytics.heartbeats", DISPATCH_QUEUE_SERIAL);
+        self.source = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, self.queue);
+        
+        __weak __typeof(self) weakSelf = self;
+        dispatch_source_set_event_handler(self.source, ^{
+            [weakSelf fireDueHeartbeats];
+        });
+        dispatch_source_set_timer(self.source, DISPATCH_TIME_FOREVER, DISPATCH_TIME_FOREVER, 0);
+        dispatch_resume(self.source);
+    }
+    return self;
+}
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-implementations"
+
+- (instancetype)init
+{
+    [self doesNotRecognizeSelector:_cmd];
+    return [self initWithTickInterval:1. slotCount:1];
+}
+
+#pragma clang diagnostic pop
+
+- (void)dealloc
+{
+    dispatch_source_cancel(_source);
+}
+
+#pragma mark Getters and setters
+
+- (NSUInteger)heartbeatCount
+{
+    return atomic_load_explicit(&_heartbeatCount, memory_order_relaxed);
+}
+
+- (NSUInteger)wakeupCount
+{
+    return atomic_load_explicit(&_wakeupCount, memory_order_relaxed);
+}
+
+#pragma mark Scheduling
+
+- (SRGAnalyticsHeartbeat *)scheduleHeartbeatWithInterval:(NSTimeInterval)interval handler:(void (^)(void))handler
+{
+    NSParameterAssert(interval > 0.);
+    
+    SRGAnalyticsHeartbeat *heartbeat = [[SRGAnalyticsHeartbeat alloc] initWithScheduler:self interval:interval handler:handler];
+    atomic_fetch_add_explicit(&_heartbeatCount, 1, memory_order_relaxed);
+    
+    uint64_t scheduleTime = SRGAnalyticsMonotonicTime();
+    dispatch_async(self.queue, ^{
+        if (! heartbeat.valid) {
+            return;
+        }
+        
+        uint64_t tickDuration = self.tickDuration;
+        uint64_t intervalTicks = MAX((uint64_t)(interval * NSEC_PER_SEC) / tickDuration, 1);
+        heartbeat.intervalTicks = intervalTicks;
+        
+        // Round the first deadline up to a tick boundary, then move it earlier to match an existing deadline if possible
+        uint64_t deadlineTick = MAX((scheduleTime - self.originTime + intervalTicks * tickDuration + tickDuration - 1) / tickDuration, self.currentTick + 1);
+        uint64_t toleranceTicks = (uint64_t)(intervalTicks * SRGAnalyticsHeartbeatAlignmentTolerance);
+        for (uint64_t tick = deadlineTick - 1; tick > self.currentTick && deadlineTick - tick <= toleranceTicks; --tick) {
+            if ([self hasHeartbeatWithDeadlineTick:tick]) {
+                deadlineTick = tick;
+                break;
+            }
+        }
+        
+        [self insertHeartbeat:heartbeat withDeadlineTick:deadlineTick];
+        [self armSource];
+    });
+    return heartbeat;
+}
+
+- (void)removeHeartbeat:(SRGAnalyticsHeartbeat *)heartbeat
+{
+    atomic_fetch_sub_explicit(&_heartbeatCount, 1, memory_order_relaxed);
+    
+    dispatch_async(self.queue, ^{
+        // Not inserted yet if its scheduling block has not run yet
+        if (heartbeat.intervalTicks == 0) {
+            return;
+        }
+        
+        [[self slotForTick:heartbeat.deadlineTick] removeObjectIdenticalTo:heartbeat];
+        [self armSource];
+    });
+}
+
+#pragma mark Wheel management (on the scheduler queue)
+
+- (NSMutableArray<SRGAnalyticsHeartbeat *> *)slotForTick:(uint64_t)tick
+{
+    return self.slots[tick % self.slots.count];
+}
+
+- (BOOL)hasHeartbeatWithDeadlineTick:(uint64_t)tick
+{
+    for (SRGAnalyticsHeartbeat *heartbeat in [self slotForTick:tick]) {
+        if (heartbeat.deadlineTick == tick) {
+            return YES;
+        }
+    }
+    return NO;
+}
+
+- (void)insertHeartbeat:(SRGAnalyticsHeartbeat *)heartbeat withDeadlineTick:(uint64_t)deadlineTick
+{
+    heartbeat.deadlineTick = deadlineTick;
+    [[self slotForTick:deadlineTick] addObject:heartbeat];
+}
+
+- (void)fireDueHeartbeats
+{
+    atomic_fetch_add_explicit(&_wakeupCount, 1, memory_order_relaxed);
+    
+    uint64_t nowTick = (SRGAnalyticsMonotonicTime() - self.originTime) / self.tickDuration;
+    if (nowTick <= self.currentTick) {
+        [self armSource];
+        return;
+    }
+    
+    // Visit slots of elapsed ticks, at most one full rotation
+    NSUInteger slotCount = self.slots.count;
+    uint64_t elapsedTickCount = MIN(nowTick - self.currentTick, (uint64_t)slotCount);
+    NSMutableArray<SRGAnalyticsHeartbeat *> *dueHeartbeats = [NSMutableArray array];
+    for (uint64_t tick = nowTick - elapsedTickCount + 1; tick <= nowTick; ++tick) {
+        NSMutableArray<SRGAnalyticsHeartbeat *> *slot = [self slotForTick:tick];
+        for (SRGAnalyticsHeartbeat *heartbeat in slot.copy) {
+            if (heartbeat.deadlineTick <= nowTick) {
+                [slot removeObjectIdenticalTo:heartbeat];
+                [dueHeartbeats addObject:heartbeat];
+            }
+        }
+    }
+    self.currentTick = nowTick;
+    
+    // Next deadlines keep the heartbeat phase, skipping missed beats
+    for (SRGAnalyticsHeartbeat *heartbeat in dueHeartbeats) {
+        uint64_t deadlineTick = heartbeat.deadlineTick + heartbeat.intervalTicks;
+        if (deadlineTick <= nowTick) {
+            deadlineTick += ((nowTick - deadlineTick) / heartbeat.intervalTicks + 1) * heartbeat.intervalTicks;
+        }
+        [self insertHeartbeat:heartbeat withDeadlineTick:deadlineTick];
+    }
+    [self armSource];
+    
+    if (dueHeartbeats.count != 0) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            for (SRGAnalyticsHeartbeat *heartbeat in dueHeartbeats) {
+                if (heartbeat.valid) {
+                    heartbeat.handler();
+                }
+            }
+        });
+    }
+}
+
+- (void)armSource
+{
+    uint64_t nextDeadlineTick = UINT64_MAX;
+    
+    // Deadlines within the next rotation are found in tick order, later ones require a full scan
+    NSUInteger slotCount = self.slots.count;
+    for (uint64_t tick = self.currentTick + 1; tick <= self.currentTick + slotCount && nextDeadlineTick == UINT64_MAX; ++tick) {
+        if ([self hasHeartbeatWithDeadlineTick:tick]) {
+            nextDeadlineTick = tick;
+        }
+    }
+    if (nextDeadlineTick == UINT64_MAX) {
+        for (NSMutableArray<SRGAnalyticsHeartbeat *> *slot in self.slots) {
+            for (SRGAnalyticsHeartbeat *heartbeat in slot) {
+                nextDeadlineTick = MIN(nextDeadlineTick, heartbeat.deadlineTick);
+            }
+        }
+    }
+    
+    if (nextDeadlineTick == UINT64_MAX) {
+        dispatch_source_set_timer(self.source, DISPATCH_TIME_FOREVER, DISPATCH_TIME_FOREVER, 0);
+        return;
+    }
+    
+    uint64_t deadlineTime = self.originTime + nextDeadlineTick * self.tickDuration;
+    uint64_t now = SRGAnalyticsMonotonicTime();
+    int64_t delay = (deadlineTime > now) ? (int64_t)(deadlineTime - now) : 0;
+    dispatch_source_set_timer(self.source, dispatch_time(DISPATCH_TIME_NOW, delay), DISPATCH_TIME_FOREVER, self.tickDuration / 4);
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; heartbeatCount = %@; wakeupCount = %@>",
+            self.class,
+            self,
+            @(self.heartbeatCount),
+            @(self.wakeupCount)];
+}
+
+@end
+
+@implementation SRGAnalyticsHeartbeat
+
+#pragma mark Object lifecycle
+
+- (instancetype)initWithScheduler:(SRGAnalyticsHeartbeatScheduler *)scheduler interval:(NSTimeInterval)interval handler:(void (^)(void))handler
+{
+    if (self = [super init]) {
+        atomic_init(&_valid, true);
+        
+        self.scheduler = scheduler;
+        self.interval = interval;
+        self.handler = handler;
+    }
+    return self;
+}
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-implementations"
+
+- (instancetype)init
+{
+    [self doesNotRecognizeSelector:_cmd];
+    return [self initWithScheduler:SRGAnalyticsHeartbeatScheduler.sharedScheduler interval:1. handler:^{}];
+}
+
+#pragma clang diagnostic pop
+
+#pragma mark Getters and setters
+
+- (BOOL)isValid
+{
+    return atomic_load_explicit(&_valid, memory_order_acquire);
+}
+
+#pragma mark Invalidation
+
+- (void)invalidate
+{
+    if (atomic_exchange_explicit(&_valid, false, memory_order_acq_rel)) {
+        [self.scheduler removeHeartbeat:self];
+    }
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; interval = %@; valid = %@>",
+            self.class,
+            self,
+            @(self.interval),
+            self.valid ? @"YES" : @"NO"];
+}
+
+@end
@@ -0,0 +1,88 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+@import Foundation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Append-only journal of encoded events, stored in a directory as a list of fixed-size memory-mapped segment files.
+ *  Each record is checksummed and flagged once delivered, so that pending records can be replayed if the process is
+ *  killed before delivery. Segments whose records have all been delivered are reclaimed.
+ *
+ *  Appending a record costs a copy into the mapped segment, with an asynchronous `msync` every few records. Records
+ *  still pending when a journal is opened are considered as belonging to a previous session and can be replayed.
+ *
+ *  @discussion A journal is not thread-safe and must be used from a single thread or serial queue.
+ */
+@interface SRGAnalyticsJournal : NSObject
+
+/**
+ *  Open the journal stored in the specified directory, creating it if needed.
+ *
+ *  @param segmentSize         The size of each segment file, in bytes.
+ *  @param maximumSegmentCount The maximum number of segments to keep. When reached, the oldest segment is discarded,
+ *                             even if it still contains pending records.
+ */
+- (nullable instancetype)initWithDirectoryURL:(NSURL *)directoryURL
+                                  segmentSize:(size_t)segmentSize
+                          maximumSegmentCount:(NSUInteger)maximumSegmentCount NS_DESIGNATED_INITIALIZER;
+
+/**
+ *  Append a record, returning its sequence number (or 0 if the record could not be journaled).
+ */
+- (uint64_t)appendRecordWithData:(NSData *)data;
+
+/**
+ *  Append a record from raw bytes, returning its sequence number (or 0 if the record could not be journaled).
+ */
+- (uint64_t)appendRecordWithBytes:(const void *)bytes length:(size_t)length;
+
+/**
+ *  Flag the record with the specified sequence number as delivered.
+ */
+- (void)markRecordAsDelivered:(uint64_t)sequence;
+
+/**
+ *  Call the provided block for at most `maximumCount` records left pending by a previous session, in order. The block
+ *  returns `YES` if it accepted the record, or `NO` to stop replay, in which case the same record is replayed first
+ *  the next time the method is called. Returns the number of accepted records.
+ *
+ *  @discussion Records are not flagged as delivered when replayed. This must be done with `-markRecordAsDelivered:`
+ *              once they have actually been delivered. Accepted records are never replayed again during the same
+ *              session, though.
+ */
+- (NSUInteger)replayRecordsWithMaximumCount:(NSUInteger)maximumCount block:(BOOL (NS_NOESCAPE ^)(NSData *data, uint64_t sequence))block;
+
+/**
+ *  `YES` iff all records left pending by a previous session have been accepted for replay.
+ */
+@property (nonatomic, readonly, getter=isReplayCompleted) BOOL replayCompleted;
+
+/**
+ *  Synchronously flush all segments to disk.
+ */
+- (void)synchronize;
+
+/**
+ *  The number of records not yet delivered.
+ */
+@property (nonatomic, readonly) NSUInteger pendingRecordCount;
+
+/**
+ *  The number of segments currently stored.
+ */
+@property (nonatomic, readonly) NSUInteger segmentCount;
+
+@end
+
+@interface SRGAnalyticsJournal (Unavailable)
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,533 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsJournal.h"
+
+#import "SRGAnalyticsLogger.h"
+
+#import <fcntl.h>
+#import <stdatomic.h>
+#import <sys/mman.h>
+#import <sys/stat.h>
+#import <unistd.h>
+#import <zlib.h>
+
+static const uint32_t SRGAnalyticsJournalSegmentMagic = 0x4A475253;         // 'SRGJ'
+static const uint32_t SRGAnalyticsJournalRecordMagic = 0x43455253;          // 'SREC'
+static const uint32_t SRGAnalyticsJournalVersion = 1;
+
+// Number of records after which an asynchronous `msync` is scheduled
+static const NSUInteger SRGAnalyticsJournalSynchronizationInterval = 32;
+
+typedef NS_ENUM(uint32_t, SRGAnalyticsJournalRecordState) {
+    SRGAnalyticsJournalRecordStatePending = 0,
+    SRGAnalyticsJournalRecordStateDelivered
+};
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t firstSequence;
+} SRGAnalyticsJournalSegmentHeader;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t length;                                // Payload length
+    uint32_t checksum;                              // CRC-32 of the payload
+    uint32_t state;                                 // `SRGAnalyticsJournalRecordState`
+    uint64_t sequence;
+} SRGAnalyticsJournalRecordHeader;
+
+static size_t SRGAnalyticsJournalAlignedSize(size_t size)
+{
+    return (size + 7) & ~(size_t)7;
+}
+
+#pragma mark Segment
+
+@interface SRGAnalyticsJournalSegment : NSObject
+
+@property (nonatomic) NSURL *fileURL;
+@property (nonatomic) uint8_t *bytes;
+@property (nonatomic) size_t size;
+
+@property (nonatomic) uint64_t firstSequence;
+@property (nonatomic) size_t writeOffset;
+@property (nonatomic) NSMutableData *recordOffsets;
+@property (nonatomic) NSUInteger pendingCount;
+
+@property (nonatomic, readonly) NSUInteger recordCount;
+@property (nonatomic, readonly) uint64_t endSequence;
+
+@end
+
+@implementation SRGAnalyticsJournalSegment
+
+#pragma mark Class methods
+
++ (uint8_t *)mappedBytesForFileDescriptor:(int)fileDescriptor size:(size_t)size
+{
+    void *bytes = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+    return (bytes != MAP_FAILED) ? bytes : NULL;
+}
+
+#pragma mark Object lifecycle
+
+- (instancetype)initWithFileURL:(NSURL *)fileURL size:(size_t)size firstSequence:(uint64_t)firstSequence
+{
+    int fileDescriptor = open(fileURL.fileSystemRepresentation, O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    if (fileDescriptor == -1) {
+        return nil;
+    }
+    
+    uint8_t *bytes = NULL;
+    if (ftruncate(fileDescriptor, (off_t)size) == 0) {
+        bytes = [SRGAnalyticsJournalSegment mappedBytesForFileDescriptor:fileDescriptor size:size];
+    }
+    close(fileDescriptor);
+    
+    if (! bytes) {
+        unlink(fileURL.fileSystemRepresentation);
+        return nil;
+    }
+    
+    if (self = [super init]) {
+        self.fileURL = fileURL;
+        self.bytes = bytes;
+        self.size = size;
+        self.firstSequence = firstSequence;
+        self.writeOffset = sizeof(SRGAnalyticsJournalSegmentHeader);
+        self.recordOffsets = [NSMutableData data];
+        
+        SRGAnalyticsJournalSegmentHeader *header = (SRGAnalyticsJournalSegmentHeader *)bytes;
+        header->version = SRGAnalyticsJournalVersion;
+        header->firstSequence = firstSequence;
+        header->magic = SRGAnalyticsJournalSegmentMagic;
+    }
+    return self;
+}
+
+- (instancetype)initWithExistingFileURL:(NSURL *)fileURL
+{
+    int fileDescriptor = open(fileURL.fileSystemRepresentation, O_RDWR);
+    if (fileDescriptor == -1) {
+        return nil;
+    }
+    
+    uint8_t *bytes = NULL;
+    size_t size = 0;
+    
+    struct stat fileStat;
+    if (fstat(fileDescriptor, &fileStat) == 0 && fileStat.st_size >= (off_t)sizeof(SRGAnalyticsJournalSegmentHeader)) {
+        size = (size_t)fileStat.st_size;
+        bytes = [SRGAnalyticsJournalSegment mappedBytesForFileDescriptor:fileDescriptor size:size];
+    }
+    close(fileDescriptor);
+    
+    if (! bytes) {
+        return nil;
+    }
+    
+    const SRGAnalyticsJournalSegmentHeader *header = (const SRGAnalyticsJournalSegmentHeader *)bytes;
+    if (header->magic != SRGAnalyticsJournalSegmentMagic || header->version != SRGAnalyticsJournalVersion) {
+        munmap(bytes, size);
+        return nil;
+    }
+    
+    if (self = [super init]) {
+        self.fileURL = fileURL;
+        self.bytes = bytes;
+        self.size = size;
+        self.firstSequence = header->firstSequence;
+        self.recordOffsets = [NSMutableData data];
+        
+        // Scan records until the first invalid one, which marks the end of the data written before the segment was
+        // closed (or before the process was killed).
+        size_t offset = sizeof(SRGAnalyticsJournalSegmentHeader);
+        while (offset + sizeof(SRGAnalyticsJournalRecordHeader) <= size) {
+            const SRGAnalyticsJournalRecordHeader *recordHeader = (const SRGAnalyticsJournalRecordHeader *)(bytes + offset);
+            if (recordHeader->magic != SRGAnalyticsJournalRecordMagic
+                    || recordHeader->sequence != self.firstSequence + self.recordCount
+                    || offset + sizeof(SRGAnalyticsJournalRecordHeader) + recordHeader->length > size) {
+                break;
+            }
+            
+            const uint8_t *payload = bytes + offset + sizeof(SRGAnalyticsJournalRecordHeader);
+            if ((uint32_t)crc32(0, payload, recordHeader->length) != recordHeader->checksum) {
+                SRGAnalyticsLogWarning(@"journal", @"Corrupted record %@ found in %@. Ignored, as well as all subsequent records", @(recordHeader->sequence), fileURL.lastPathComponent);
+                break;
+            }
+            
+            [self.recordOffsets appendBytes:&offset length:sizeof(size_t)];
+            if (recordHeader->state == SRGAnalyticsJournalRecordStatePending) {
+                self.pendingCount += 1;
+            }
+            offset += SRGAnalyticsJournalAlignedSize(sizeof(SRGAnalyticsJournalRecordHeader) + recordHeader->length);
+        }
+        
+        // Never append to a segment from a previous session, its tail might be damaged
+        self.writeOffset = size;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    if (_bytes) {
+        munmap(_bytes, _size);
+    }
+}
+
+#pragma mark Getters and setters
+
+- (NSUInteger)recordCount
+{
+    return self.recordOffsets.length / sizeof(size_t);
+}
+
+- (uint64_t)endSequence
+{
+    return self.firstSequence + self.recordCount;
+}
+
+- (SRGAnalyticsJournalRecordHeader *)recordHeaderForSequence:(uint64_t)sequence
+{
+    if (sequence < self.firstSequence || sequence >= self.endSequence) {
+        return NULL;
+    }
+    
+    size_t offset = ((const size_t *)self.recordOffsets.bytes)[sequence - self.firstSequence];
+    return (SRGAnalyticsJournalRecordHeader *)(self.bytes + offset);
+}
+
+#pragma mark Records
+
+- (BOOL)canAppendRecordOfSize:(size_t)recordSize
+{
+    return self.writeOffset + recordSize <= self.size;
+}
+
+- (void)appendRecordWithBytes:(const void *)bytes length:(size_t)length sequence:(uint64_t)sequence
+{
+    size_t offset = self.writeOffset;
+    uint8_t *recordBytes = self.bytes + offset;
+    
+    SRGAnalyticsJournalRecordHeader *header = (SRGAnalyticsJournalRecordHeader *)recordBytes;
+    memcpy(recordBytes + sizeof(SRGAnalyticsJournalRecordHeader), bytes, length);
+    header->length = (uint32_t)length;
+    header->checksum = (uint32_t)crc32(0, bytes, (uInt)length);
+    header->state = SRGAnalyticsJournalRecordStatePending;
+    header->sequence = sequence;
+    
+    // Publish the record by writing its magic number last. A record interrupted while being written is never valid.
+    atomic_thread_fence(memory_order_release);
+    header->magic = SRGAnalyticsJournalRecordMagic;
+    
+    [self.recordOffsets appendBytes:&offset length:sizeof(size_t)];
+    self.writeOffset += SRGAnalyticsJournalAlignedSize(sizeof(SRGAnalyticsJournalRecordHeader) + length);
+    self.pendingCount += 1;
+}
+
+- (void)synchronizeWithFlags:(int)flags
+{
+    msync(self.bytes, self.size, flags);
+}
+
+- (void)remove
+{
+    munmap(self.bytes, self.size);
+    self.bytes = NULL;
+    
+    unlink(self.fileURL.fileSystemRepresentation);
+}
+
+@end
+
+#pragma mark Journal
+
+@interface SRGAnalyticsJournal ()
+
+@property (nonatomic) NSURL *directoryURL;
+@property (nonatomic) size_t segmentSize;
+@property (nonatomic) NSUInteger maximumSegmentCount;
+
+@property (nonatomic) NSMutableArray<SRGAnalyticsJournalSegment *> *segments;
+@property (nonatomic) SRGAnalyticsJournalSegment *activeSegment;
+
+@property (nonatomic) uint64_t nextSequence;
+@property (nonatomic) uint64_t replaySequence;
+@property (nonatomic) uint64_t replayEndSequence;
+
+@property (nonatomic) NSUInteger unsynchronizedRecordCount;
+
+@end
+
+@implementation SRGAnalyticsJournal
+
+#pragma mark Object lifecycle
+
+- (instancetype)initWithDirectoryURL:(NSURL *)directoryURL segmentSize:(size_t)segmentSize maximumSegmentCount:(NSUInteger)maximumSegmentCount
+{
+    NSParameterAssert(segmentSize > sizeof(SRGAnalyticsJournalSegmentHeader) + sizeof(SRGAnalyticsJournalRecordHeader));
+    NSParameterAssert(maximumSegmentCount > 0);
+    
+    NSError *error = nil;
+    if (! [NSFileManager.defaultManager createDirectoryAtURL:directoryURL withIntermediateDirectories:YES attributes:nil error:&error]) {
+        SRGAnalyticsLogError(@"journal", @"The journal directory could not be created. Reason: %@", error);
+        return nil;
+    }
+    
+    if (self = [super init]) {
+        self.directoryURL = directoryURL;
+        self.segmentSize = segmentSize;
+        self.maximumSegmentCount = maximumSegmentCount;
+        self.segments = [NSMutableArray array];
+        self.nextSequence = 1;
+        
+        [self loadSegments];
+    }
+    return self;
+}
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-implementations"
+
+- (instancetype)init
+{
+    [self doesNotRecognizeSelector:_cmd];
+    return [self initWithDirectoryURL:[NSURL fileURLWithPath:NSTemporaryDirectory()] segmentSize:0 maximumSegmentCount:0];
+}
+
+#pragma clang diagnostic pop
+
+- (void)dealloc
+{
+    [self synchronize];
+}
+
+#pragma mark Getters and setters
+
+- (NSUInteger)pendingRecordCount
+{
+    NSUInteger pendingRecordCount = 0;
+    for (SRGAnalyticsJournalSegment *segment in self.segments) {
+        pendingRecordCount += segment.pendingCount;
+    }
+    return pendingRecordCount;
+}
+
+- (NSUInteger)segmentCount
+{
+    return self.segments.count;
+}
+
+#pragma mark Segment management
+
+- (void)loadSegments
+{
+    NSArray<NSURL *> *fileURLs = [NSFileManager.defaultManager contentsOfDirectoryAtURL:self.directoryURL
+                                                             includingPropertiesForKeys:nil
+                                                                                options:NSDirectoryEnumerationSkipsHiddenFiles
+                                                                                  error:NULL];
+    NSPredicate *predicate = [NSPredicate predicateWithFormat:@"pathExtension == 'segment'"];
+    fileURLs = [[fileURLs filteredArrayUsingPredicate:predicate] sortedArrayUsingComparator:^NSComparisonResult(NSURL * _Nonnull fileURL1, NSURL * _Nonnull fileURL2) {
+        return [fileURL1.lastPathComponent compare:fileURL2.lastPathComponent];
+    }];
+    
+    for (NSURL *fileURL in fileURLs) {
+        SRGAnalyticsJournalSegment *segment = [[SRGAnalyticsJournalSegment alloc] initWithExistingFileURL:fileURL];
+        if (! segment || segment.pendingCount == 0 || segment.firstSequence < self.nextSequence) {
+            if (! segment) {
+                SRGAnalyticsLogWarning(@"journal", @"Invalid segment %@ discarded", fileURL.lastPathComponent);
+            }
+            [segment remove];
+            unlink(fileURL.fileSystemRepresentation);
+            continue;
+        }
+        
+        [self.segments addObject:segment];
+        self.nextSequence = segment.endSequence;
+    }
+    
+    self.replaySequence = (self.segments.count != 0) ? self.segments.firstObject.firstSequence : self.nextSequence;
+    self.replayEndSequence = self.nextSequence;
+}
+
+- (SRGAnalyticsJournalSegment *)createSegmentWithFirstSequence:(uint64_t)firstSequence
+{
+    while (self.segments.count >= self.maximumSegmentCount) {
+        SRGAnalyticsJournalSegment *oldestSegment = self.segments.firstObject;
+        SRGAnalyticsLogWarning(@"journal", @"Maximum journal size reached. %@ pending records discarded", @(oldestSegment.pendingCount));
+        [self removeSegment:oldestSegment];
+    }
+    
+    // Zero-padded first sequence numbers, so that lexicographical file order matches segment order
+    NSString *fileName = [NSString stringWithFormat:@"%020llu.segment", firstSequence];
+    NSURL *fileURL = [self.directoryURL URLByAppendingPathComponent:fileName];
+    SRGAnalyticsJournalSegment *segment = [[SRGAnalyticsJournalSegment alloc] initWithFileURL:fileURL size:self.segmentSize firstSequence:firstSequence];
+    if (! segment) {
+        SRGAnalyticsLogError(@"journal", @"Could not create segment %@. Reason: %s", fileName, strerror(errno));
+        return nil;
+    }
+    
+    [self.segments addObject:segment];
+    return segment;
+}
+
+- (void)removeSegment:(SRGAnalyticsJournalSegment *)segment
+{
+    if (segment == self.activeSegment) {
+        self.activeSegment = nil;
+    }
+    
+    [segment remove];
+    [self.segments removeObject:segment];
+}
+
+- (SRGAnalyticsJournalSegment *)segmentForSequence:(uint64_t)sequence
+{
+    // Usually only a few segments exist, and recent ones are searched first
+    for (SRGAnalyticsJournalSegment *segment in self.segments.reverseObjectEnumerator) {
+        if (sequence >= segment.firstSequence) {
+            return (sequence < segment.endSequence) ? segment : nil;
+        }
+    }
+    return nil;
+}
+
+#pragma mark Records
+
+- (uint64_t)appendRecordWithData:(NSData *)data
+{
+    return [self appendRecordWithBytes:data.bytes length:data.length];
+}
+
+- (uint64_t)appendRecordWithBytes:(const void *)bytes length:(size_t)length
+{
+    size_t recordSize = SRGAnalyticsJournalAlignedSize(sizeof(SRGAnalyticsJournalRecordHeader) + length);
+    if (recordSize > self.segmentSize - sizeof(SRGAnalyticsJournalSegmentHeader)) {
+        SRGAnalyticsLogWarning(@"journal", @"Record too large to be journaled (%@ bytes)", @(length));
+        return 0;
+    }
+    
+    SRGAnalyticsJournalSegment *segment = self.activeSegment;
+    if (! segment || ! [segment canAppendRecordOfSize:recordSize]) {
+        if (segment) {
+            [segment synchronizeWithFlags:MS_ASYNC];
+            self.activeSegment = nil;
+            
+            if (segment.pendingCount == 0) {
+                [self removeSegment:segment];
+            }
+        }
+        
+        segment = [self createSegmentWithFirstSequence:self.nextSequence];
+        if (! segment) {
+            return 0;
+        }
+        self.activeSegment = segment;
+    }
+    
+    uint64_t sequence = self.nextSequence;
+    [segment appendRecordWithBytes:bytes length:length sequence:sequence];
+    self.nextSequence += 1;
+    
+    self.unsynchronizedRecordCount += 1;
+    if (self.unsynchronizedRecordCount >= SRGAnalyticsJournalSynchronizationInterval) {
+        [segment synchronizeWithFlags:MS_ASYNC];
+        self.unsynchronizedRecordCount = 0;
+    }
+    
+    return sequence;
+}
+
+- (void)markRecordAsDelivered:(uint64_t)sequence
+{
+    SRGAnalyticsJournalSegment *segment = [self segmentForSequence:sequence];
+    SRGAnalyticsJournalRecordHeader *header = [segment recordHeaderForSequence:sequence];
+    if (! header || header->state == SRGAnalyticsJournalRecordStateDelivered) {
+        return;
+    }
+    
+    header->state = SRGAnalyticsJournalRecordStateDelivered;
+    segment.pendingCount -= 1;
+    
+    // Reclaim segments whose records have all been delivered, except the one currently being written
+    if (segment.pendingCount == 0 && segment != self.activeSegment) {
+        [self removeSegment:segment];
+    }
+}
+
+- (NSUInteger)replayRecordsWithMaximumCount:(NSUInteger)maximumCount block:(BOOL (NS_NOESCAPE ^)(NSData *data, uint64_t sequence))block
+{
+    NSUInteger replayedCount = 0;
+    
+    for (SRGAnalyticsJournalSegment *segment in self.segments.copy) {
+        if (segment.firstSequence >= self.replayEndSequence || replayedCount == maximumCount) {
+            break;
+        }
+        
+        // Segments can be removed (once delivered or discarded) between calls, so that resuming is based on sequences
+        for (uint64_t sequence = MAX(segment.firstSequence, self.replaySequence); sequence < segment.endSequence; ++sequence) {
+            if (replayedCount == maximumCount) {
+                break;
+            }
+            
+            SRGAnalyticsJournalRecordHeader *header = [segment recordHeaderForSequence:sequence];
+            if (header->state == SRGAnalyticsJournalRecordStatePending) {
+                BOOL accepted = NO;
+                @autoreleasepool {
+                    NSData *data = [NSData dataWithBytesNoCopy:(uint8_t *)header + sizeof(SRGAnalyticsJournalRecordHeader) length:header->length freeWhenDone:NO];
+                    accepted = block(data, sequence);
+                }
+                if (! accepted) {
+                    return replayedCount;
+                }
+                
+                replayedCount += 1;
+            }
+            
+            self.replaySequence = sequence + 1;
+            
+            // The segment has been removed if its last pending record was delivered by the block
+            if (! segment.bytes) {
+                break;
+            }
+        }
+    }
+    
+    if (replayedCount != maximumCount) {
+        self.replaySequence = self.replayEndSequence;
+    }
+    return replayedCount;
+}
+
+- (BOOL)isReplayCompleted
+{
+    return self.replaySequence >= self.replayEndSequence;
+}
+
+- (void)synchronize
+{
+    for (SRGAnalyticsJournalSegment *segment in self.segments) {
+        [segment synchronizeWithFlags:MS_SYNC];
+    }
+    self.unsynchronizedRecordCount = 0;
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; directoryURL = %@; segmentCount = %@; pendingRecordCount = %@>",
+            self.class,
+            self,
+            self.directoryURL,
+            @(self.segmentCount),
+            @(self.pendingRecordCount)];
+}
+
+@end
@@ -0,0 +1,103 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+// Generated by Scripts/SRGAnalyticsLabelCatalogGenerator.swift from Scripts/SRGAnalyticsLabelSchema.json. Do not edit.
+
+@import Foundation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Label value types.
+ */
+typedef NS_ENUM(NSInteger, SRGAnalyticsLabelType) {
+    /**
+     *  String.
+     */
+    SRGAnalyticsLabelTypeString = 0,
+    /**
+     *  Integer, formatted in base 10.
+     */
+    SRGAnalyticsLabelTypeInteger,
+    /**
+     *  Floating-point number, formatted like `NSNumber`.
+     */
+    SRGAnalyticsLabelTypeDouble,
+    /**
+     *  Boolean, formatted as `true` or `false`.
+     */
+    SRGAnalyticsLabelTypeBoolean
+};
+
+/**
+ *  Slots of labels known to the library.
+ */
+typedef NS_ENUM(NSInteger, SRGAnalyticsLabelSlot) {
+    SRGAnalyticsLabelSlotEventId = 0,
+    SRGAnalyticsLabelSlotEventName,
+    SRGAnalyticsLabelSlotNavigationPropertyType,
+    SRGAnalyticsLabelSlotNavigationBuDistributer,
+    SRGAnalyticsLabelSlotNavigationLevel1,
+    SRGAnalyticsLabelSlotNavigationLevel2,
+    SRGAnalyticsLabelSlotNavigationLevel3,
+    SRGAnalyticsLabelSlotNavigationLevel4,
+    SRGAnalyticsLabelSlotNavigationLevel5,
+    SRGAnalyticsLabelSlotNavigationLevel6,
+    SRGAnalyticsLabelSlotNavigationLevel7,
+    SRGAnalyticsLabelSlotNavigationLevel8,
+    SRGAnalyticsLabelSlotContentTitle,
+    SRGAnalyticsLabelSlotAccessedAfterPushNotification,
+    SRGAnalyticsLabelSlotMediaEmbeddingEnvironment,
+    SRGAnalyticsLabelSlotMediaPlayerDisplay,
+    SRGAnalyticsLabelSlotMediaPlayerVersion,
+    SRGAnalyticsLabelSlotMediaPosition,
+    SRGAnalyticsLabelSlotMediaVolume,
+    SRGAnalyticsLabelSlotMediaSubtitlesOn,
+    SRGAnalyticsLabelSlotMediaSubtitleSelection,
+    SRGAnalyticsLabelSlotMediaAudioTrack,
+    SRGAnalyticsLabelSlotMediaBandwidth,
+    SRGAnalyticsLabelSlotMediaBandwidthP50,
+    SRGAnalyticsLabelSlotMediaBandwidthP90,
+    SRGAnalyticsLabelSlotMediaIndicatedBitrate,
+    SRGAnalyticsLabelSlotMediaIndicatedBitrateP50,
+    SRGAnalyticsLabelSlotMediaIndicatedBitrateP90,
+    SRGAnalyticsLabelSlotMediaTimeshift,
+    SRGAnalyticsLabelSlotSrgTitle,
+    SRGAnalyticsLabelSlotSrgApPush,
+    SRGAnalyticsLabelSlotSrgN1,
+    SRGAnalyticsLabelSlotSrgN2,
+    SRGAnalyticsLabelSlotSrgN3,
+    SRGAnalyticsLabelSlotSrgN4,
+    SRGAnalyticsLabelSlotSrgN5,
+    SRGAnalyticsLabelSlotSrgN6,
+    SRGAnalyticsLabelSlotSrgN7,
+    SRGAnalyticsLabelSlotSrgN8,
+    SRGAnalyticsLabelSlotSrgN9,
+    SRGAnalyticsLabelSlotSrgN10,
+    SRGAnalyticsLabelSlotNsCategory,
+    SRGAnalyticsLabelSlotName,
+    SRGAnalyticsLabelSlotCount
+};
+
+static const NSUInteger SRGAnalyticsLabelNavigationLevelCount = 8;
+static const NSUInteger SRGAnalyticsLabelSrgNCount = 10;
+
+/**
+ *  Key of the label stored in the specified slot.
+ */
+OBJC_EXPORT NSString *SRGAnalyticsLabelKeyForSlot(SRGAnalyticsLabelSlot slot);
+
+/**
+ *  Type of the label stored in the specified slot.
+ */
+OBJC_EXPORT SRGAnalyticsLabelType SRGAnalyticsLabelTypeForSlot(SRGAnalyticsLabelSlot slot);
+
+/**
+ *  Slot of the label with the specified key, `NSNotFound` if the label is not known.
+ */
+OBJC_EXPORT NSInteger SRGAnalyticsLabelSlotForKey(NSString *key);
+
+NS_ASSUME_NONNULL_END
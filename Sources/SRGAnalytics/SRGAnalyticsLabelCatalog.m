@@ -0,0 +1,129 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+// Generated by Scripts/SRGAnalyticsLabelCatalogGenerator.swift from Scripts/SRGAnalyticsLabelSchema.json. Do not edit.
+
+#import "SRGAnalyticsLabelCatalog.h"
+
+static __unsafe_unretained NSString * const s_keys[SRGAnalyticsLabelSlotCount] = {
+    @"event_id",
+    @"event_name",
+    @"navigation_property_type",
+    @"navigation_bu_distributer",
+    @"navigation_level_1",
+    @"navigation_level_2",
+    @"navigation_level_3",
+    @"navigation_level_4",
+    @"navigation_level_5",
+    @"navigation_level_6",
+    @"navigation_level_7",
+    @"navigation_level_8",
+    @"content_title",
+    @"accessed_after_push_notification",
+    @"media_embedding_environment",
+    @"media_player_display",
+    @"media_player_version",
+    @"media_position",
+    @"media_volume",
+    @"media_subtitles_on",
+    @"media_subtitle_selection",
+    @"media_audio_track",
+    @"media_bandwidth",
+    @"media_bandwidth_p50",
+    @"media_bandwidth_p90",
+    @"media_indicated_bitrate",
+    @"media_indicated_bitrate_p50",
+    @"media_indicated_bitrate_p90",
+    @"media_timeshift",
+    @"srg_title",
+    @"srg_ap_push",
+    @"srg_n1",
+    @"srg_n2",
+    @"srg_n3",
+    @"srg_n4",
+    @"srg_n5",
+    @"srg_n6",
+    @"srg_n7",
+    @"srg_n8",
+    @"srg_n9",
+    @"srg_n10",
+    @"ns_category",
+    @"name",
+};
+
+static const SRGAnalyticsLabelType s_types[SRGAnalyticsLabelSlotCount] = {
+    SRGAnalyticsLabelTypeString,
+    SRGAnalyticsLabelTypeString,
+    SRGAnalyticsLabelTypeString,
+    SRGAnalyticsLabelTypeString,
+    SRGAnalyticsLabelTypeString,
+    SRGAnalyticsLabelTypeString,
+    SRGAnalyticsLabelTypeString,
+    SRGAnalyticsLabelTypeString,
+    SRGAnalyticsLabelTypeString,
+    SRGAnalyticsLabelTypeString,
+    SRGAnalyticsLabelTypeString,
+    SRGAnalyticsLabelTypeString,
+    SRGAnalyticsLabelTypeString,
+    SRGAnalyticsLabelTypeBoolean,
+    SRGAnalyticsLabelTypeString,
+    SRGAnalyticsLabelTypeString,
+    SRGAnalyticsLabelTypeString,
+    SRGAnalyticsLabelTypeInteger,
+    SRGAnalyticsLabelTypeInteger,
+    SRGAnalyticsLabelTypeBoolean,
+    SRGAnalyticsLabelTypeString,
+    SRGAnalyticsLabelTypeString,
+    SRGAnalyticsLabelTypeDouble,
+    SRGAnalyticsLabelTypeDouble,
+    SRGAnalyticsLabelTypeDouble,
+    SRGAnalyticsLabelTypeDouble,
+    SRGAnalyticsLabelTypeDouble,
+    SRGAnalyticsLabelTypeDouble,
+    SRGAnalyticsLabelTypeInteger,
+    SRGAnalyticsLabelTypeString,
+    SRGAnalyticsLabelTypeInteger,
+    SRGAnalyticsLabelTypeString,
+    SRGAnalyticsLabelTypeString,
+    SRGAnalyticsLabelTypeString,
+    SRGAnalyticsLabelTypeString,
+    SRGAnalyticsLabelTypeString,
+    SRGAnalyticsLabelTypeString,
+    SRGAnalyticsLabelTypeString,
+    SRGAnalyticsLabelTypeString,
+    SRGAnalyticsLabelTypeString,
+    SRGAnalyticsLabelTypeString,
+    SRGAnalyticsLabelTypeString,
+    SRGAnalyticsLabelTypeString,
+};
+
+NSString *SRGAnalyticsLabelKeyForSlot(SRGAnalyticsLabelSlot slot)
+{
+    NSCParameterAssert(slot >= 0 && slot < SRGAnalyticsLabelSlotCount);
+    return s_keys[slot];
+}
+
+SRGAnalyticsLabelType SRGAnalyticsLabelTypeForSlot(SRGAnalyticsLabelSlot slot)
+{
+    NSCParameterAssert(slot >= 0 && slot < SRGAnalyticsLabelSlotCount);
+    return s_types[slot];
+}
+
+NSInteger SRGAnalyticsLabelSlotForKey(NSString *key)
+{
+    static NSDictionary<NSString *, NSNumber *> *s_slots;
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        NSMutableDictionary<NSString *, NSNumber *> *slots = [NSMutableDictionary dictionaryWithCapacity:SRGAnalyticsLabelSlotCount];
+        for (NSInteger slot = 0; slot < SRGAnalyticsLabelSlotCount; ++slot) {
+            slots[s_keys[slot]] = @(slot);
+        }
+        s_slots = slots.copy;
+    });
+    
+    NSNumber *slot = s_slots[key];
+    return slot ? slot.integerValue : NSNotFound;
+}
@@ -0,0 +1,71 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsEventRecord.h"
+
+@import Foundation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Layered set of labels. A context stores its own labels as a layer on top of the ones of its parent context, labels
+ *  found in a layer overriding labels with the same keys found in parent layers. Lookups and enumeration resolve labels
+ *  through the layers, so that building a context never requires labels from parent layers to be copied.
+ *
+ *  The labels dictionary a context is created with is shared, not copied. A layer is copied only when written to.
+ *
+ *  @discussion A context is not thread-safe while being written to. Contexts used as parents are not expected to
+ *              be written to afterwards.
+ */
+@interface SRGAnalyticsLabelContext : NSObject
+
+/**
+ *  Create a context with the specified labels layered on top of an optional parent context.
+ */
+- (instancetype)initWithParentContext:(nullable SRGAnalyticsLabelContext *)parentContext
+                               labels:(nullable NSDictionary<NSString *, NSString *> *)labels NS_DESIGNATED_INITIALIZER;
+
+/**
+ *  Create a context with the labels of an event record layered on top of an optional parent context. The record
+ *  is shared, not copied.
+ */
+- (instancetype)initWithParentContext:(nullable SRGAnalyticsLabelContext *)parentContext
+                               record:(SRGAnalyticsEventRecord *)record;
+
+/**
+ *  The parent context, if any.
+ */
+@property (nonatomic, readonly, nullable) SRGAnalyticsLabelContext *parentContext;
+
+/**
+ *  Return the label for the specified key, resolved through the layers.
+ */
+- (nullable NSString *)labelForKey:(NSString *)key;
+
+/**
+ *  Set a label in the context own layer. Setting a `nil` label hides labels with the same key in parent layers.
+ */
+- (void)setLabel:(nullable NSString *)label forKey:(NSString *)key;
+
+/**
+ *  Enumerate all labels resolved through the layers, each key appearing once.
+ */
+- (void)enumerateLabelsUsingBlock:(void (NS_NOESCAPE ^)(NSString *key, NSString *label, BOOL *stop))block;
+
+/**
+ *  A flattened dictionary of all labels resolved through the layers.
+ */
+@property (nonatomic, readonly) NSDictionary<NSString *, NSString *> *dictionary;
+
+@end
+
+@interface SRGAnalyticsLabelContext (Unavailable)
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
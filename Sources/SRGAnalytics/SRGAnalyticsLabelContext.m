@@ -0,0 +1,157 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsLabelContext.h"
+
+@interface SRGAnalyticsLabelContext ()
+
+@property (nonatomic) SRGAnalyticsLabelContext *parentContext;
+
+// Labels of the context own layer. Removed labels are stored as `NSNull` so that they hide parent labels.
+@property (nonatomic) NSDictionary<NSString *, id> *labels;
+// Event record used as layer instead of a labels dictionary, if any
+@property (nonatomic) SRGAnalyticsEventRecord *record;
+@property (nonatomic, getter=isOwningLabels) BOOL owningLabels;
+
+@property (nonatomic, readonly, getter=isLayerEmpty) BOOL layerEmpty;
+
+@end
+
+@implementation SRGAnalyticsLabelContext
+
+#pragma mark Object lifecycle
+
+- (instancetype)initWithParentContext:(SRGAnalyticsLabelContext *)parentContext labels:(NSDictionary<NSString *, NSString *> *)labels
+{
+    if (self = [super init]) {
+        self.parentContext = parentContext;
+        self.labels = labels;
+    }
+    return self;
+}
+
+- (instancetype)initWithParentContext:(SRGAnalyticsLabelContext *)parentContext record:(SRGAnalyticsEventRecord *)record
+{
+    if (self = [self initWithParentContext:parentContext labels:nil]) {
+        self.record = record;
+    }
+    return self;
+}
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-implementations"
+
+- (instancetype)init
+{
+    [self doesNotRecognizeSelector:_cmd];
+    return [self initWithParentContext:nil labels:nil];
+}
+
+#pragma clang diagnostic pop
+
+#pragma mark Layer
+
+// Return the label for the specified key in the context own layer, `NSNull` if hidden by the layer
+- (id)layerLabelForKey:(NSString *)key
+{
+    return self.record ? [self.record labelForKey:key] : self.labels[key];
+}
+
+- (BOOL)layerContainsLabelForKey:(NSString *)key
+{
+    return self.record ? [self.record containsLabelForKey:key] : (self.labels[key] != nil);
+}
+
+- (BOOL)isLayerEmpty
+{
+    return ! self.record && self.labels.count == 0;
+}
+
+- (void)enumerateLayerLabelsUsingBlock:(void (NS_NOESCAPE ^)(NSString *key, id label, BOOL *stop))block
+{
+    if (self.record) {
+        [self.record enumerateLabelsUsingBlock:block];
+    }
+    else {
+        [self.labels enumerateKeysAndObjectsUsingBlock:block];
+    }
+}
+
+#pragma mark Labels
+
+- (NSString *)labelForKey:(NSString *)key
+{
+    for (SRGAnalyticsLabelContext *context = self; context; context = context.parentContext) {
+        id label = [context layerLabelForKey:key];
+        if (label) {
+            return (label != NSNull.null) ? label : nil;
+        }
+    }
+    return nil;
+}
+
+- (void)setLabel:(NSString *)label forKey:(NSString *)key
+{
+    // Copy on write
+    if (! self.owningLabels) {
+        self.labels = self.record.dictionary.mutableCopy ?: self.labels.mutableCopy ?: [NSMutableDictionary dictionary];
+        self.record = nil;
+        self.owningLabels = YES;
+    }
+    
+    NSMutableDictionary<NSString *, id> *labels = (NSMutableDictionary *)self.labels;
+    labels[key] = label ?: NSNull.null;
+}
+
+- (void)enumerateLabelsUsingBlock:(void (NS_NOESCAPE ^)(NSString *key, NSString *label, BOOL *stop))block
+{
+    __block BOOL stop = NO;
+    for (SRGAnalyticsLabelContext *context = self; context && ! stop; context = context.parentContext) {
+        [context enumerateLayerLabelsUsingBlock:^(NSString * _Nonnull key, id _Nonnull label, BOOL * _Nonnull innerStop) {
+            if (label == NSNull.null) {
+                return;
+            }
+            
+            // Skip labels overridden in upper layers
+            for (SRGAnalyticsLabelContext *upperContext = self; upperContext != context; upperContext = upperContext.parentContext) {
+                if (! upperContext.layerEmpty && [upperContext layerContainsLabelForKey:key]) {
+                    return;
+                }
+            }
+            
+            block(key, label, &stop);
+            if (stop) {
+                *innerStop = YES;
+            }
+        }];
+    }
+}
+
+- (NSDictionary<NSString *,NSString *> *)dictionary
+{
+    if (! self.parentContext && ! self.owningLabels && ! self.record && self.labels) {
+        return self.labels;
+    }
+    
+    NSMutableDictionary<NSString *, NSString *> *dictionary = [NSMutableDictionary dictionary];
+    [self enumerateLabelsUsingBlock:^(NSString * _Nonnull key, NSString * _Nonnull label, BOOL * _Nonnull stop) {
+        dictionary[key] = label;
+    }];
+    return dictionary.copy;
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; labels = %@; parentContext = %@>",
+            self.class,
+            self,
+            self.record ? self.record.dictionary : self.labels,
+            self.parentContext];
+}
+
+@end
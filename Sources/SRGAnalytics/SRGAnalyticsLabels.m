@@ -8,26 +8,15 @@
 
 @implementation SRGAnalyticsLabels
 
+// Custom information is copied when set and can therefore be returned as is
 - (NSDictionary<NSString *, NSString *> *)labelsDictionary
 {
-    NSMutableDictionary<NSString *, NSString *> *dictionary = [NSMutableDictionary dictionary];
-    
-    if (self.customInfo) {
-        [dictionary addEntriesFromDictionary:self.customInfo];
-    }
-    
-    return dictionary.copy;
+    return self.customInfo ?: @{};
 }
 
 - (NSDictionary<NSString *, NSString *> *)comScoreLabelsDictionary
 {
-    NSMutableDictionary<NSString *, NSString *> *dictionary = [NSMutableDictionary dictionary];
-    
-    if (self.comScoreCustomInfo) {
-        [dictionary addEntriesFromDictionary:self.comScoreCustomInfo];
-    }
-    
-    return dictionary.copy;
+    return self.comScoreCustomInfo ?: @{};
 }
 
 #pragma mark NSCopying protocol
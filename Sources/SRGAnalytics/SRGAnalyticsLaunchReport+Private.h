@@ -0,0 +1,31 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsLaunchReport.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Perform the specified block, adding the time it took to the duration of a launch step. Steps must not be nested.
+ *  Thread-safe.
+ */
+OBJC_EXPORT void SRGAnalyticsLaunchReportMeasureStep(SRGAnalyticsLaunchStep step, NS_NOESCAPE void (^block)(void));
+
+/**
+ *  Return a report of the steps measured so far.
+ */
+OBJC_EXPORT SRGAnalyticsLaunchReport *SRGAnalyticsLaunchReportSnapshot(void);
+
+@interface SRGAnalyticsLaunchReport (Private)
+
+/**
+ *  Create a report from step durations (in seconds), listed in order.
+ */
+- (instancetype)initWithSteps:(NSArray<SRGAnalyticsLaunchStep> *)steps durations:(NSDictionary<SRGAnalyticsLaunchStep, NSNumber *> *)durations;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,112 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsLaunchReport.h"
+
+#import "SRGAnalyticsClock.h"
+#import "SRGAnalyticsLaunchReport+Private.h"
+
+#import <pthread.h>
+
+SRGAnalyticsLaunchStep const SRGAnalyticsLaunchStepTrackerStart = @"tracker_start";
+SRGAnalyticsLaunchStep const SRGAnalyticsLaunchStepServicesStart = @"services_start";
+SRGAnalyticsLaunchStep const SRGAnalyticsLaunchStepViewControllerHooks = @"view_controller_hooks";
+SRGAnalyticsLaunchStep const SRGAnalyticsLaunchStepMediaPlayerHooks = @"media_player_hooks";
+
+// Statically initialized so that nothing needs to run when the library is loaded
+static pthread_mutex_t s_mutex = PTHREAD_MUTEX_INITIALIZER;
+static NSMutableArray<SRGAnalyticsLaunchStep> *s_steps = nil;
+static NSMutableDictionary<SRGAnalyticsLaunchStep, NSNumber *> *s_durations = nil;
+
+@interface SRGAnalyticsLaunchReport ()
+
+@property (nonatomic, copy) NSArray<SRGAnalyticsLaunchStep> *steps;
+@property (nonatomic, copy) NSDictionary<SRGAnalyticsLaunchStep, NSNumber *> *durations;
+
+@end
+
+@implementation SRGAnalyticsLaunchReport
+
+#pragma mark Object lifecycle
+
+- (instancetype)initWithSteps:(NSArray<SRGAnalyticsLaunchStep> *)steps durations:(NSDictionary<SRGAnalyticsLaunchStep, NSNumber *> *)durations
+{
+    if (self = [super init]) {
+        self.steps = steps;
+        self.durations = durations;
+    }
+    return self;
+}
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-implementations"
+
+- (instancetype)init
+{
+    [self doesNotRecognizeSelector:_cmd];
+    return [self initWithSteps:@[] durations:@{}];
+}
+
+#pragma clang diagnostic pop
+
+#pragma mark Getters and setters
+
+- (NSTimeInterval)durationForStep:(SRGAnalyticsLaunchStep)step
+{
+    return self.durations[step].doubleValue;
+}
+
+- (NSTimeInterval)totalDuration
+{
+    NSTimeInterval totalDuration = 0.;
+    for (NSNumber *duration in self.durations.allValues) {
+        totalDuration += duration.doubleValue;
+    }
+    return totalDuration;
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; steps = %@; durations = %@; totalDuration = %@>",
+            self.class,
+            self,
+            self.steps,
+            self.durations,
+            @(self.totalDuration)];
+}
+
+@end
+
+#pragma mark Functions
+
+void SRGAnalyticsLaunchReportMeasureStep(SRGAnalyticsLaunchStep step, void (^block)(void))
+{
+    uint64_t startTime = SRGAnalyticsMonotonicTime();
+    block();
+    NSTimeInterval duration = (NSTimeInterval)(SRGAnalyticsMonotonicTime() - startTime) / NSEC_PER_SEC;
+    
+    pthread_mutex_lock(&s_mutex);
+    if (! s_steps) {
+        s_steps = [NSMutableArray array];
+        s_durations = [NSMutableDictionary dictionary];
+    }
+    if (! s_durations[step]) {
+        [s_steps addObject:step];
+    }
+    s_durations[step] = @(s_durations[step].doubleValue + duration);
+    pthread_mutex_unlock(&s_mutex);
+}
+
+SRGAnalyticsLaunchReport *SRGAnalyticsLaunchReportSnapshot(void)
+{
+    pthread_mutex_lock(&s_mutex);
+    SRGAnalyticsLaunchReport *report = [[SRGAnalyticsLaunchReport alloc] initWithSteps:s_steps.copy ?: @[]
+                                                                              durations:s_durations.copy ?: @{}];
+    pthread_mutex_unlock(&s_mutex);
+    return report;
+}
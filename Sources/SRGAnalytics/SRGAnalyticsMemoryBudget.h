@@ -0,0 +1,126 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsConfiguration.h"
+#import "SRGAnalyticsEvent.h"
+
+@import Foundation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class SRGAnalyticsMemoryBudgetEntry;
+
+/**
+ *  Block called with entries evicted to make room for a new entry, oldest first.
+ */
+typedef void (^SRGAnalyticsMemoryBudgetEvictionHandler)(NSArray<SRGAnalyticsMemoryBudgetEntry *> *entries);
+
+/**
+ *  Block called when the budget enters or leaves backpressure.
+ */
+typedef void (^SRGAnalyticsMemoryBudgetBackpressureHandler)(BOOL underBackpressure);
+
+/**
+ *  Accounts for the memory used by pending events, within a fixed budget. Each admitted event is represented by an
+ *  entry, whose bytes are released exactly once, either when the last of its consumers is done with it, or when it
+ *  is evicted to make room for a new entry according to the drop policy. Evicted entries are only flagged, consumers
+ *  being responsible for skipping them.
+ *
+ *  The budget therefore bounds the memory of events pending delivery, not the memory of all events in flight: an
+ *  evicted event is never delivered, but remains referenced (and in memory) until the queue or sink buffer holding it
+ *  reaches and skips it.
+ *
+ *  The budget is under backpressure as soon as an entry has been dropped or when usage reaches 90% of the capacity,
+ *  until usage falls below 50% of the capacity.
+ *
+ *  All methods are thread-safe. Handlers are called outside any lock, on the thread which caused the change.
+ */
+@interface SRGAnalyticsMemoryBudget : NSObject
+
+/**
+ *  Create a budget with the specified capacity (in bytes). Use 0 for no limit.
+ */
+- (instancetype)initWithCapacity:(NSUInteger)capacity dropPolicy:(SRGAnalyticsPendingEventDropPolicy)dropPolicy NS_DESIGNATED_INITIALIZER;
+
+/**
+ *  Handlers, which must be set before the budget is used.
+ */
+@property (nonatomic, copy, nullable) SRGAnalyticsMemoryBudgetEvictionHandler evictionHandler;
+@property (nonatomic, copy, nullable) SRGAnalyticsMemoryBudgetBackpressureHandler backpressureHandler;
+
+/**
+ *  Admit an entry, evicting other entries first if needed. The entry has a single consumer, the caller. Return `nil`
+ *  if the entry cannot be admitted, in which case it is counted as dropped.
+ */
+- (nullable SRGAnalyticsMemoryBudgetEntry *)admitEntryWithByteCount:(NSUInteger)byteCount
+                                                           priority:(SRGAnalyticsEventPriority)priority
+                                                          eventType:(SRGAnalyticsEventType)eventType;
+
+@property (nonatomic, readonly) NSUInteger capacity;
+@property (nonatomic, readonly) SRGAnalyticsPendingEventDropPolicy dropPolicy;
+
+/**
+ *  The number of bytes and entries currently accounted for.
+ */
+@property (nonatomic, readonly) NSUInteger byteCount;
+@property (nonatomic, readonly) NSUInteger count;
+
+/**
+ *  The total number of entries evicted or which could not be admitted.
+ */
+@property (nonatomic, readonly) NSUInteger droppedCount;
+
+/**
+ *  Return the number of entries dropped since the last call, resetting it.
+ */
+- (NSUInteger)takeDroppedCount;
+
+/**
+ *  `YES` iff the budget is under backpressure.
+ */
+@property (nonatomic, readonly, getter=isUnderBackpressure) BOOL underBackpressure;
+
+@end
+
+/**
+ *  An event accounted for within a memory budget.
+ */
+@interface SRGAnalyticsMemoryBudgetEntry : NSObject
+
+@property (nonatomic, readonly) NSUInteger byteCount;
+@property (nonatomic, readonly) SRGAnalyticsEventPriority priority;
+@property (nonatomic, readonly) SRGAnalyticsEventType eventType;
+
+/**
+ *  `YES` iff the entry has been evicted. Consumers must skip evicted entries.
+ */
+@property (nonatomic, readonly, getter=isEvicted) BOOL evicted;
+
+/**
+ *  Add a consumer, which must later call `-removeConsumer`. Must be called by an existing consumer.
+ */
+- (void)addConsumer;
+
+/**
+ *  Remove a consumer. Bytes are released when the last consumer is removed, unless the entry was evicted.
+ */
+- (void)removeConsumer;
+
+@end
+
+@interface SRGAnalyticsMemoryBudget (Unavailable)
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+@interface SRGAnalyticsMemoryBudgetEntry (Unavailable)
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,472 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsMemoryBudget.h"
+
+#import <pthread.h>
+#import <stdatomic.h>
+
+@interface SRGAnalyticsMemoryBudgetEntry () {
+@public
+    // Linked in the FIFO list of its priority, guarded by the budget mutex
+    SRGAnalyticsMemoryBudgetEntry *_next;
+    __unsafe_unretained SRGAnalyticsMemoryBudgetEntry *_previous;
+    BOOL _linked;
+    BOOL _sampled;
+    uint64_t _sequence;
+    NSUInteger _consumerCount;
+    
+    __weak SRGAnalyticsMemoryBudget *_budget;
+    atomic_bool _evicted;
+}
+
+- (instancetype)initWithBudget:(SRGAnalyticsMemoryBudget *)budget
+                     byteCount:(NSUInteger)byteCount
+                      priority:(SRGAnalyticsEventPriority)priority
+                     eventType:(SRGAnalyticsEventType)eventType
+                      sequence:(uint64_t)sequence;
+
+@property (nonatomic) NSUInteger byteCount;
+@property (nonatomic) SRGAnalyticsEventPriority priority;
+@property (nonatomic) SRGAnalyticsEventType eventType;
+
+@end
+
+@interface SRGAnalyticsMemoryBudget () {
+@private
+    pthread_mutex_t _mutex;
+    
+    SRGAnalyticsMemoryBudgetEntry *_heads[SRGAnalyticsEventPriorityCount];
+    __unsafe_unretained SRGAnalyticsMemoryBudgetEntry *_tails[SRGAnalyticsEventPriorityCount];
+    NSUInteger _byteCounts[SRGAnalyticsEventPriorityCount];
+    
+    NSUInteger _byteCount;
+    NSUInteger _count;
+    NSUInteger _droppedCount;
+    NSUInteger _untakenDroppedCount;
+    uint64_t _nextSequence;
+    BOOL _underBackpressure;
+    
+    NSMutableArray<SRGAnalyticsMemoryBudgetEntry *> *_evictedEntries;
+}
+
+@property (nonatomic) NSUInteger capacity;
+@property (nonatomic) SRGAnalyticsPendingEventDropPolicy dropPolicy;
+
+@end
+
+@implementation SRGAnalyticsMemoryBudget
+
+#pragma mark Object lifecycle
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity dropPolicy:(SRGAnalyticsPendingEventDropPolicy)dropPolicy
+{
+    if (self = [super init]) {
+        pthread_mutex_init(&_mutex, NULL);
+        _evictedEntries = [NSMutableArray array];
+        
+        self.capacity = capacity;
+        self.dropPolicy = dropPolicy;
+    }
+    return self;
+}
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-implementations"
+
+- (instancetype)init
+{
+    [self doesNotRecognizeSelector:_cmd];
+    return [self initWithCapacity:0 dropPolicy:SRGAnalyticsPendingEventDropPolicyDropOldest];
+}
+
+#pragma clang diagnostic pop
+
+- (void)dealloc
+{
+    // Unlink iteratively to avoid deep recursion when releasing long lists
+    for (NSUInteger i = 0; i < SRGAnalyticsEventPriorityCount; ++i) {
+        SRGAnalyticsMemoryBudgetEntry *entry = _heads[i];
+        _heads[i] = nil;
+        while (entry) {
+            SRGAnalyticsMemoryBudgetEntry *next = entry->_next;
+            entry->_next = nil;
+            entry = next;
+        }
+    }
+    pthread_mutex_destroy(&_mutex);
+}
+
+#pragma mark Getters and setters
+
+- (NSUInteger)byteCount
+{
+    pthread_mutex_lock(&_mutex);
+    NSUInteger byteCount = _byteCount;
+    pthread_mutex_unlock(&_mutex);
+    return byteCount;
+}
+
+- (NSUInteger)count
+{
+    pthread_mutex_lock(&_mutex);
+    NSUInteger count = _count;
+    pthread_mutex_unlock(&_mutex);
+    return count;
+}
+
+- (NSUInteger)droppedCount
+{
+    pthread_mutex_lock(&_mutex);
+    NSUInteger droppedCount = _droppedCount;
+    pthread_mutex_unlock(&_mutex);
+    return droppedCount;
+}
+
+- (BOOL)isUnderBackpressure
+{
+    pthread_mutex_lock(&_mutex);
+    BOOL underBackpressure = _underBackpressure;
+    pthread_mutex_unlock(&_mutex);
+    return underBackpressure;
+}
+
+- (NSUInteger)takeDroppedCount
+{
+    pthread_mutex_lock(&_mutex);
+    NSUInteger droppedCount = _untakenDroppedCount;
+    _untakenDroppedCount = 0;
+    pthread_mutex_unlock(&_mutex);
+    return droppedCount;
+}
+
+#pragma mark Admission
+
+- (SRGAnalyticsMemoryBudgetEntry *)admitEntryWithByteCount:(NSUInteger)byteCount
+                                                  priority:(SRGAnalyticsEventPriority)priority
+                                                 eventType:(SRGAnalyticsEventType)eventType
+{
+    SRGAnalyticsMemoryBudgetEntry *entry = nil;
+    NSArray<SRGAnalyticsMemoryBudgetEntry *> *evictedEntries = nil;
+    
+    pthread_mutex_lock(&_mutex);
+    
+    if ([self makeRoomForByteCount:byteCount priority:priority]) {
+        entry = [[SRGAnalyticsMemoryBudgetEntry alloc] initWithBudget:self
+                                                            byteCount:byteCount
+                                                             priority:priority
+                                                            eventType:eventType
+                                                             sequence:_nextSequence++];
+        [self linkEntry:entry];
+    }
+    else {
+        _droppedCount++;
+        _untakenDroppedCount++;
+    }
+    
+    if (_evictedEntries.count != 0) {
+        evictedEntries = _evictedEntries.copy;
+        [_evictedEntries removeAllObjects];
+    }
+    
+    BOOL dropped = (! entry || evictedEntries != nil);
+    BOOL backpressureChanged = [self updateBackpressureWithDrop:dropped];
+    BOOL underBackpressure = _underBackpressure;
+    
+    pthread_mutex_unlock(&_mutex);
+    
+    if (evictedEntries) {
+        self.evictionHandler ? self.evictionHandler(evictedEntries) : nil;
+    }
+    if (backpressureChanged) {
+        self.backpressureHandler ? self.backpressureHandler(underBackpressure) : nil;
+    }
+    return entry;
+}
+
+// Must be called with the mutex held. Return `NO` if no room could be made, in which case no entry is evicted.
+- (BOOL)makeRoomForByteCount:(NSUInteger)byteCount priority:(SRGAnalyticsEventPriority)priority
+{
+    NSUInteger capacity = self.capacity;
+    if (capacity == 0) {
+        return YES;
+    }
+    else if (byteCount > capacity) {
+        return NO;
+    }
+    
+    switch (self.dropPolicy) {
+        case SRGAnalyticsPendingEventDropPolicyDropLowestPriority: {
+            NSUInteger evictableByteCount = 0;
+            for (NSInteger i = 0; i <= priority; ++i) {
+                evictableByteCount += _byteCounts[i];
+            }
+            if (_byteCount - evictableByteCount + byteCount > capacity) {
+                return NO;
+            }
+            
+            for (NSInteger i = 0; i <= priority && _byteCount + byteCount > capacity; ++i) {
+                while (_heads[i] && _byteCount + byteCount > capacity) {
+                    [self evictEntry:_heads[i]];
+                }
+            }
+            break;
+        }
+        
+        case SRGAnalyticsPendingEventDropPolicySampleHeartbeats: {
+            [self sampleHeartbeatEntriesForByteCount:byteCount];
+            [self evictOldestEntriesForByteCount:byteCount];
+            break;
+        }
+        
+        default: {
+            [self evictOldestEntriesForByteCount:byteCount];
+            break;
+        }
+    }
+    return YES;
+}
+
+// Must be called with the mutex held. Every other heartbeat is evicted, oldest first, so that sessions remain measured
+// at a lower resolution. Heartbeats kept are flagged so that subsequent calls resume where previous ones stopped. Once
+// all heartbeats have been sampled, another pass starts over from the oldest one.
+- (void)sampleHeartbeatEntriesForByteCount:(NSUInteger)byteCount
+{
+    for (NSInteger pass = 0; pass < 2 && _byteCount + byteCount > self.capacity; ++pass) {
+        SRGAnalyticsMemoryBudgetEntry *keptEntry = nil;
+        SRGAnalyticsMemoryBudgetEntry *entry = _heads[SRGAnalyticsEventPriorityLow];
+        while (entry && _byteCount + byteCount > self.capacity) {
+            SRGAnalyticsMemoryBudgetEntry *nextEntry = entry->_next;
+            if (! entry->_sampled) {
+                if (keptEntry) {
+                    [self evictEntry:entry];
+                    keptEntry = nil;
+                }
+                else {
+                    entry->_sampled = YES;
+                    keptEntry = entry;
+                }
+            }
+            entry = nextEntry;
+        }
+        
+        if (_byteCount + byteCount > self.capacity) {
+            for (SRGAnalyticsMemoryBudgetEntry *heartbeatEntry = _heads[SRGAnalyticsEventPriorityLow]; heartbeatEntry; heartbeatEntry = heartbeatEntry->_next) {
+                heartbeatEntry->_sampled = NO;
+            }
+        }
+    }
+}
+
+// Must be called with the mutex held
+- (void)evictOldestEntriesForByteCount:(NSUInteger)byteCount
+{
+    while (_byteCount + byteCount > self.capacity) {
+        SRGAnalyticsMemoryBudgetEntry *oldestEntry = nil;
+        for (NSUInteger i = 0; i < SRGAnalyticsEventPriorityCount; ++i) {
+            SRGAnalyticsMemoryBudgetEntry *head = _heads[i];
+            if (head && (! oldestEntry || head->_sequence < oldestEntry->_sequence)) {
+                oldestEntry = head;
+            }
+        }
+        if (! oldestEntry) {
+            break;
+        }
+        [self evictEntry:oldestEntry];
+    }
+}
+
+// Must be called with the mutex held. Backpressure starts as soon as an entry is dropped or when usage reaches 90%
+// of the capacity, and stops when usage falls below 50%. Return `YES` iff the state changed.
+- (BOOL)updateBackpressureWithDrop:(BOOL)dropped
+{
+    NSUInteger capacity = self.capacity;
+    if (capacity == 0) {
+        return NO;
+    }
+    
+    BOOL underBackpressure = _underBackpressure;
+    if (dropped || _byteCount >= capacity / 10 * 9) {
+        underBackpressure = YES;
+    }
+    else if (_byteCount < capacity / 2) {
+        underBackpressure = NO;
+    }
+    
+    if (underBackpressure == _underBackpressure) {
+        return NO;
+    }
+    _underBackpressure = underBackpressure;
+    return YES;
+}
+
+#pragma mark Lists (with the mutex held)
+
+- (void)linkEntry:(SRGAnalyticsMemoryBudgetEntry *)entry
+{
+    SRGAnalyticsEventPriority priority = entry.priority;
+    
+    entry->_previous = _tails[priority];
+    if (_tails[priority]) {
+        _tails[priority]->_next = entry;
+    }
+    else {
+        _heads[priority] = entry;
+    }
+    _tails[priority] = entry;
+    entry->_linked = YES;
+    
+    _byteCounts[priority] += entry.byteCount;
+    _byteCount += entry.byteCount;
+    _count++;
+}
+
+- (void)unlinkEntry:(SRGAnalyticsMemoryBudgetEntry *)entry
+{
+    SRGAnalyticsEventPriority priority = entry.priority;
+    
+    // Retain the entry while it is being unlinked, since the list might own the last reference to it
+    SRGAnalyticsMemoryBudgetEntry *unlinkedEntry = entry;
+    if (unlinkedEntry->_next) {
+        unlinkedEntry->_next->_previous = unlinkedEntry->_previous;
+    }
+    else {
+        _tails[priority] = unlinkedEntry->_previous;
+    }
+    if (unlinkedEntry->_previous) {
+        unlinkedEntry->_previous->_next = unlinkedEntry->_next;
+    }
+    else {
+        _heads[priority] = unlinkedEntry->_next;
+    }
+    unlinkedEntry->_next = nil;
+    unlinkedEntry->_previous = nil;
+    unlinkedEntry->_linked = NO;
+    
+    _byteCounts[priority] -= unlinkedEntry.byteCount;
+    _byteCount -= unlinkedEntry.byteCount;
+    _count--;
+}
+
+- (void)evictEntry:(SRGAnalyticsMemoryBudgetEntry *)entry
+{
+    [_evictedEntries addObject:entry];
+    atomic_store_explicit(&entry->_evicted, true, memory_order_relaxed);
+    [self unlinkEntry:entry];
+    
+    _droppedCount++;
+    _untakenDroppedCount++;
+}
+
+#pragma mark Consumers
+
+- (void)addConsumerToEntry:(SRGAnalyticsMemoryBudgetEntry *)entry
+{
+    pthread_mutex_lock(&_mutex);
+    entry->_consumerCount++;
+    pthread_mutex_unlock(&_mutex);
+}
+
+- (void)removeConsumerFromEntry:(SRGAnalyticsMemoryBudgetEntry *)entry
+{
+    pthread_mutex_lock(&_mutex);
+    
+    BOOL backpressureChanged = NO;
+    if (entry->_consumerCount != 0 && --entry->_consumerCount == 0 && entry->_linked) {
+        [self unlinkEntry:entry];
+        backpressureChanged = [self updateBackpressureWithDrop:NO];
+    }
+    BOOL underBackpressure = _underBackpressure;
+    
+    pthread_mutex_unlock(&_mutex);
+    
+    if (backpressureChanged) {
+        self.backpressureHandler ? self.backpressureHandler(underBackpressure) : nil;
+    }
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; capacity = %@; byteCount = %@; count = %@; droppedCount = %@; underBackpressure = %@>",
+            self.class,
+            self,
+            @(self.capacity),
+            @(self.byteCount),
+            @(self.count),
+            @(self.droppedCount),
+            self.underBackpressure ? @"YES" : @"NO"];
+}
+
+@end
+
+@implementation SRGAnalyticsMemoryBudgetEntry
+
+#pragma mark Object lifecycle
+
+- (instancetype)initWithBudget:(SRGAnalyticsMemoryBudget *)budget
+                     byteCount:(NSUInteger)byteCount
+                      priority:(SRGAnalyticsEventPriority)priority
+                     eventType:(SRGAnalyticsEventType)eventType
+                      sequence:(uint64_t)sequence
+{
+    if (self = [super init]) {
+        _budget = budget;
+        _sequence = sequence;
+        _consumerCount = 1;
+        atomic_init(&_evicted, false);
+        
+        self.byteCount = byteCount;
+        self.priority = priority;
+        self.eventType = eventType;
+    }
+    return self;
+}
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-implementations"
+
+- (instancetype)init
+{
+    [self doesNotRecognizeSelector:_cmd];
+    return [self initWithBudget:nil byteCount:0 priority:SRGAnalyticsEventPriorityNormal eventType:SRGAnalyticsEventTypeHiddenEvent sequence:0];
+}
+
+#pragma clang diagnostic pop
+
+#pragma mark Getters and setters
+
+- (BOOL)isEvicted
+{
+    return atomic_load_explicit(&_evicted, memory_order_relaxed);
+}
+
+#pragma mark Consumers
+
+- (void)addConsumer
+{
+    [_budget addConsumerToEntry:self];
+}
+
+- (void)removeConsumer
+{
+    [_budget removeConsumerFromEntry:self];
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; byteCount = %@; priority = %@; evicted = %@>",
+            self.class,
+            self,
+            @(self.byteCount),
+            @(self.priority),
+            self.evicted ? @"YES" : @"NO"];
+}
+
+@end
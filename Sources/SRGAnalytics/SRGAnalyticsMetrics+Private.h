@@ -0,0 +1,58 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsMetrics.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Latency histograms use 8 linear sub-buckets per power of two of nanoseconds, up to about 10 minutes.
+ */
+static const NSUInteger SRGAnalyticsLatencyBucketCount = 304;
+
+/**
+ *  Number of event types for which metrics are collected.
+ */
+static const NSUInteger SRGAnalyticsMetricsEventTypeCount = 3;
+
+/**
+ *  Bucket in which a latency (in nanoseconds) is recorded.
+ */
+OBJC_EXPORT NSUInteger SRGAnalyticsLatencyBucketIndex(uint64_t latency);
+
+/**
+ *  Smallest latency (in nanoseconds) exceeding all latencies recorded in a bucket.
+ */
+OBJC_EXPORT uint64_t SRGAnalyticsLatencyBucketUpperBound(NSUInteger index);
+
+@interface SRGAnalyticsLatencyHistogram (Private)
+
+/**
+ *  Create a histogram from bucket counts (`SRGAnalyticsLatencyBucketCount` values), as well as the sum and maximum
+ *  of recorded latencies (in nanoseconds).
+ */
+- (instancetype)initWithBucketCounts:(const uint64_t *)bucketCounts sum:(uint64_t)sum maximum:(uint64_t)maximum;
+
+@end
+
+@interface SRGAnalyticsMetrics (Private)
+
+/**
+ *  Create metrics. Event counts are arrays of `SRGAnalyticsMetricsEventTypeCount` values, indexed by event type.
+ */
+- (instancetype)initWithAcceptedEventCounts:(const uint64_t *)acceptedEventCounts
+                         droppedEventCounts:(const uint64_t *)droppedEventCounts
+                            sentEventCounts:(const uint64_t *)sentEventCounts
+                          pendingEventCount:(NSUInteger)pendingEventCount
+                      pendingEventByteCount:(NSUInteger)pendingEventByteCount
+                      liveMediaTrackerCount:(NSInteger)liveMediaTrackerCount
+                     labelBuildingLatencies:(SRGAnalyticsLatencyHistogram *)labelBuildingLatencies
+                          encodingLatencies:(SRGAnalyticsLatencyHistogram *)encodingLatencies
+                          dispatchLatencies:(SRGAnalyticsLatencyHistogram *)dispatchLatencies;
+
+@end
+
+NS_ASSUME_NONNULL_END
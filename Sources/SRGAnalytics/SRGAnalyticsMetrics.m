@@ -0,0 +1,204 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsMetrics.h"
+
+#import "SRGAnalyticsMetrics+Private.h"
+
+// Latencies below 2^SRGAnalyticsLatencySubBucketBits ns are recorded exactly, larger ones with this many bits of
+// precision
+static const NSUInteger SRGAnalyticsLatencySubBucketBits = 3;
+static const NSUInteger SRGAnalyticsLatencySubBucketCount = 1 << SRGAnalyticsLatencySubBucketBits;
+
+NSUInteger SRGAnalyticsLatencyBucketIndex(uint64_t latency)
+{
+    if (latency < SRGAnalyticsLatencySubBucketCount) {
+        return (NSUInteger)latency;
+    }
+    
+    NSUInteger exponent = 63 - __builtin_clzll(latency);
+    NSUInteger subBucket = (latency >> (exponent - SRGAnalyticsLatencySubBucketBits)) & (SRGAnalyticsLatencySubBucketCount - 1);
+    NSUInteger index = (exponent - SRGAnalyticsLatencySubBucketBits + 1) * SRGAnalyticsLatencySubBucketCount + subBucket;
+    return MIN(index, SRGAnalyticsLatencyBucketCount - 1);
+}
+
+uint64_t SRGAnalyticsLatencyBucketUpperBound(NSUInteger index)
+{
+    if (index < SRGAnalyticsLatencySubBucketCount) {
+        return index + 1;
+    }
+    
+    NSUInteger exponent = index / SRGAnalyticsLatencySubBucketCount + SRGAnalyticsLatencySubBucketBits - 1;
+    NSUInteger subBucket = index % SRGAnalyticsLatencySubBucketCount;
+    return (uint64_t)(SRGAnalyticsLatencySubBucketCount + subBucket + 1) << (exponent - SRGAnalyticsLatencySubBucketBits);
+}
+
+@implementation SRGAnalyticsLatencyHistogram {
+@private
+    uint64_t _bucketCounts[SRGAnalyticsLatencyBucketCount];
+    uint64_t _count;
+    uint64_t _sum;
+    uint64_t _maximum;
+}
+
+#pragma mark Object lifecycle
+
+- (instancetype)initWithBucketCounts:(const uint64_t *)bucketCounts sum:(uint64_t)sum maximum:(uint64_t)maximum
+{
+    if (self = [super init]) {
+        memcpy(_bucketCounts, bucketCounts, sizeof(_bucketCounts));
+        for (NSUInteger i = 0; i < SRGAnalyticsLatencyBucketCount; ++i) {
+            _count += bucketCounts[i];
+        }
+        _sum = sum;
+        _maximum = maximum;
+    }
+    return self;
+}
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-implementations"
+
+- (instancetype)init
+{
+    [self doesNotRecognizeSelector:_cmd];
+    return nil;
+}
+
+#pragma clang diagnostic pop
+
+#pragma mark Getters and setters
+
+- (NSUInteger)count
+{
+    return (NSUInteger)_count;
+}
+
+- (NSTimeInterval)mean
+{
+    return (_count != 0) ? (double)_sum / _count / NSEC_PER_SEC : 0.;
+}
+
+- (NSTimeInterval)maximum
+{
+    return (double)_maximum / NSEC_PER_SEC;
+}
+
+#pragma mark Percentiles
+
+- (NSTimeInterval)latencyAtPercentile:(double)percentile
+{
+    if (_count == 0) {
+        return 0.;
+    }
+    
+    uint64_t targetCount = (uint64_t)ceil(fmin(fmax(percentile, 0.), 100.) / 100. * _count);
+    uint64_t cumulatedCount = 0;
+    for (NSUInteger i = 0; i < SRGAnalyticsLatencyBucketCount; ++i) {
+        cumulatedCount += _bucketCounts[i];
+        if (cumulatedCount >= MAX(targetCount, 1)) {
+            return (double)MIN(SRGAnalyticsLatencyBucketUpperBound(i) - 1, _maximum) / NSEC_PER_SEC;
+        }
+    }
+    return self.maximum;
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; count = %@; mean = %@; p50 = %@; p99 = %@; maximum = %@>",
+            self.class,
+            self,
+            @(self.count),
+            @(self.mean),
+            @([self latencyAtPercentile:50.]),
+            @([self latencyAtPercentile:99.]),
+            @(self.maximum)];
+}
+
+@end
+
+@implementation SRGAnalyticsMetrics {
+@private
+    uint64_t _acceptedEventCounts[SRGAnalyticsMetricsEventTypeCount];
+    uint64_t _droppedEventCounts[SRGAnalyticsMetricsEventTypeCount];
+    uint64_t _sentEventCounts[SRGAnalyticsMetricsEventTypeCount];
+}
+
+#pragma mark Object lifecycle
+
+- (instancetype)initWithAcceptedEventCounts:(const uint64_t *)acceptedEventCounts
+                         droppedEventCounts:(const uint64_t *)droppedEventCounts
+                            sentEventCounts:(const uint64_t *)sentEventCounts
+                          pendingEventCount:(NSUInteger)pendingEventCount
+                      pendingEventByteCount:(NSUInteger)pendingEventByteCount
+                      liveMediaTrackerCount:(NSInteger)liveMediaTrackerCount
+                     labelBuildingLatencies:(SRGAnalyticsLatencyHistogram *)labelBuildingLatencies
+                          encodingLatencies:(SRGAnalyticsLatencyHistogram *)encodingLatencies
+                          dispatchLatencies:(SRGAnalyticsLatencyHistogram *)dispatchLatencies
+{
+    if (self = [super init]) {
+        memcpy(_acceptedEventCounts, acceptedEventCounts, sizeof(_acceptedEventCounts));
+        memcpy(_droppedEventCounts, droppedEventCounts, sizeof(_droppedEventCounts));
+        memcpy(_sentEventCounts, sentEventCounts, sizeof(_sentEventCounts));
+        _pendingEventCount = pendingEventCount;
+        _pendingEventByteCount = pendingEventByteCount;
+        _liveMediaTrackerCount = liveMediaTrackerCount;
+        _labelBuildingLatencies = labelBuildingLatencies;
+        _encodingLatencies = encodingLatencies;
+        _dispatchLatencies = dispatchLatencies;
+    }
+    return self;
+}
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-implementations"
+
+- (instancetype)init
+{
+    [self doesNotRecognizeSelector:_cmd];
+    return nil;
+}
+
+#pragma clang diagnostic pop
+
+#pragma mark Event counts
+
+- (NSUInteger)acceptedEventCountForType:(SRGAnalyticsMetricsEventType)type
+{
+    NSParameterAssert(type >= 0 && type < SRGAnalyticsMetricsEventTypeCount);
+    return (NSUInteger)_acceptedEventCounts[type];
+}
+
+- (NSUInteger)droppedEventCountForType:(SRGAnalyticsMetricsEventType)type
+{
+    NSParameterAssert(type >= 0 && type < SRGAnalyticsMetricsEventTypeCount);
+    return (NSUInteger)_droppedEventCounts[type];
+}
+
+- (NSUInteger)sentEventCountForType:(SRGAnalyticsMetricsEventType)type
+{
+    NSParameterAssert(type >= 0 && type < SRGAnalyticsMetricsEventTypeCount);
+    return (NSUInteger)_sentEventCounts[type];
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; pendingEventCount = %@; pendingEventByteCount = %@; liveMediaTrackerCount = %@; labelBuildingLatencies = %@; encodingLatencies = %@; dispatchLatencies = %@>",
+            self.class,
+            self,
+            @(self.pendingEventCount),
+            @(self.pendingEventByteCount),
+            @(self.liveMediaTrackerCount),
+            self.labelBuildingLatencies,
+            self.encodingLatencies,
+            self.dispatchLatencies];
+}
+
+@end
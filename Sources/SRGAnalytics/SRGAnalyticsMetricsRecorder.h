@@ -0,0 +1,73 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsMetrics.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Event outcomes.
+ */
+typedef NS_ENUM(NSInteger, SRGAnalyticsMetricsOutcome) {
+    /**
+     *  The event has been accepted for delivery.
+     */
+    SRGAnalyticsMetricsOutcomeAccepted = 0,
+    /**
+     *  The event has been dropped.
+     */
+    SRGAnalyticsMetricsOutcomeDropped,
+    /**
+     *  The event has been handed over to analytics services.
+     */
+    SRGAnalyticsMetricsOutcomeSent
+};
+
+/**
+ *  Measured latencies.
+ */
+typedef NS_ENUM(NSInteger, SRGAnalyticsMetricsLatency) {
+    /**
+     *  Label building.
+     */
+    SRGAnalyticsMetricsLatencyLabelBuilding = 0,
+    /**
+     *  Label encoding.
+     */
+    SRGAnalyticsMetricsLatencyEncoding,
+    /**
+     *  Dispatch to analytics services.
+     */
+    SRGAnalyticsMetricsLatencyDispatch
+};
+
+/**
+ *  Metrics are recorded into counters owned by the calling thread, without locks nor contended atomic operations,
+ *  and merged when a snapshot is taken. All functions can be called from any thread.
+ */
+
+/**
+ *  Record the outcome of an event of the specified type.
+ */
+OBJC_EXPORT void SRGAnalyticsMetricsRecordEvent(SRGAnalyticsMetricsEventType type, SRGAnalyticsMetricsOutcome outcome);
+
+/**
+ *  Record a latency, in nanoseconds.
+ */
+OBJC_EXPORT void SRGAnalyticsMetricsRecordLatency(SRGAnalyticsMetricsLatency latency, uint64_t nanoseconds);
+
+/**
+ *  Record the creation or destruction of a media tracker.
+ */
+OBJC_EXPORT void SRGAnalyticsMetricsRecordMediaTrackerCreation(void);
+OBJC_EXPORT void SRGAnalyticsMetricsRecordMediaTrackerDestruction(void);
+
+/**
+ *  Merge all counters into a snapshot.
+ */
+OBJC_EXPORT SRGAnalyticsMetrics *SRGAnalyticsMetricsSnapshot(NSUInteger pendingEventCount, NSUInteger pendingEventByteCount);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,161 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsMetricsRecorder.h"
+
+#import "SRGAnalyticsMetrics+Private.h"
+
+#import <pthread.h>
+#import <stdatomic.h>
+
+static const NSUInteger SRGAnalyticsMetricsOutcomeCount = 3;
+static const NSUInteger SRGAnalyticsMetricsLatencyCount = 3;
+
+// Counters of a single thread. Only the owning thread writes to a shard, so that counters can be updated with plain
+// (relaxed) loads and stores, while snapshots can read them concurrently. Shards are never freed: when a thread
+// exits, its shard is released for reuse by another thread, keeping its counts.
+typedef struct SRGAnalyticsMetricsShard {
+    _Atomic(uint64_t) eventCounts[SRGAnalyticsMetricsEventTypeCount][SRGAnalyticsMetricsOutcomeCount];
+    _Atomic(uint64_t) mediaTrackerCreationCount;
+    _Atomic(uint64_t) mediaTrackerDestructionCount;
+    _Atomic(uint64_t) latencyBucketCounts[SRGAnalyticsMetricsLatencyCount][SRGAnalyticsLatencyBucketCount];
+    _Atomic(uint64_t) latencySums[SRGAnalyticsMetricsLatencyCount];
+    _Atomic(uint64_t) latencyMaxima[SRGAnalyticsMetricsLatencyCount];
+    
+    atomic_bool inUse;
+    struct SRGAnalyticsMetricsShard *next;
+} SRGAnalyticsMetricsShard;
+
+static _Atomic(SRGAnalyticsMetricsShard *) s_shards;
+static pthread_key_t s_shardKey;
+
+static void SRGAnalyticsMetricsReleaseShard(void *value)
+{
+    SRGAnalyticsMetricsShard *shard = value;
+    atomic_store_explicit(&shard->inUse, false, memory_order_release);
+}
+
+static SRGAnalyticsMetricsShard *SRGAnalyticsMetricsCurrentShard(void)
+{
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        pthread_key_create(&s_shardKey, SRGAnalyticsMetricsReleaseShard);
+    });
+    
+    SRGAnalyticsMetricsShard *shard = pthread_getspecific(s_shardKey);
+    if (shard) {
+        return shard;
+    }
+    
+    // Reuse a shard released by an exited thread, if any
+    for (shard = atomic_load_explicit(&s_shards, memory_order_acquire); shard; shard = shard->next) {
+        bool inUse = false;
+        if (atomic_compare_exchange_strong_explicit(&shard->inUse, &inUse, true, memory_order_acquire, memory_order_relaxed)) {
+            pthread_setspecific(s_shardKey, shard);
+            return shard;
+        }
+    }
+    
+    shard = calloc(1, sizeof(SRGAnalyticsMetricsShard));
+    atomic_init(&shard->inUse, true);
+    
+    SRGAnalyticsMetricsShard *head = atomic_load_explicit(&s_shards, memory_order_relaxed);
+    do {
+        shard->next = head;
+    } while (! atomic_compare_exchange_weak_explicit(&s_shards, &head, shard, memory_order_release, memory_order_relaxed));
+    
+    pthread_setspecific(s_shardKey, shard);
+    return shard;
+}
+
+// Increment a counter owned by the current thread
+static inline void SRGAnalyticsMetricsAdd(_Atomic(uint64_t) *counter, uint64_t value)
+{
+    atomic_store_explicit(counter, atomic_load_explicit(counter, memory_order_relaxed) + value, memory_order_relaxed);
+}
+
+void SRGAnalyticsMetricsRecordEvent(SRGAnalyticsMetricsEventType type, SRGAnalyticsMetricsOutcome outcome)
+{
+    NSCParameterAssert(type >= 0 && type < SRGAnalyticsMetricsEventTypeCount);
+    NSCParameterAssert(outcome >= 0 && outcome < SRGAnalyticsMetricsOutcomeCount);
+    
+    SRGAnalyticsMetricsShard *shard = SRGAnalyticsMetricsCurrentShard();
+    SRGAnalyticsMetricsAdd(&shard->eventCounts[type][outcome], 1);
+}
+
+void SRGAnalyticsMetricsRecordLatency(SRGAnalyticsMetricsLatency latency, uint64_t nanoseconds)
+{
+    NSCParameterAssert(latency >= 0 && latency < SRGAnalyticsMetricsLatencyCount);
+    
+    SRGAnalyticsMetricsShard *shard = SRGAnalyticsMetricsCurrentShard();
+    SRGAnalyticsMetricsAdd(&shard->latencyBucketCounts[latency][SRGAnalyticsLatencyBucketIndex(nanoseconds)], 1);
+    SRGAnalyticsMetricsAdd(&shard->latencySums[latency], nanoseconds);
+    if (nanoseconds > atomic_load_explicit(&shard->latencyMaxima[latency], memory_order_relaxed)) {
+        atomic_store_explicit(&shard->latencyMaxima[latency], nanoseconds, memory_order_relaxed);
+    }
+}
+
+void SRGAnalyticsMetricsRecordMediaTrackerCreation(void)
+{
+    SRGAnalyticsMetricsShard *shard = SRGAnalyticsMetricsCurrentShard();
+    SRGAnalyticsMetricsAdd(&shard->mediaTrackerCreationCount, 1);
+}
+
+void SRGAnalyticsMetricsRecordMediaTrackerDestruction(void)
+{
+    SRGAnalyticsMetricsShard *shard = SRGAnalyticsMetricsCurrentShard();
+    SRGAnalyticsMetricsAdd(&shard->mediaTrackerDestructionCount, 1);
+}
+
+SRGAnalyticsMetrics *SRGAnalyticsMetricsSnapshot(NSUInteger pendingEventCount, NSUInteger pendingEventByteCount)
+{
+    uint64_t eventCounts[SRGAnalyticsMetricsOutcomeCount][SRGAnalyticsMetricsEventTypeCount] = { 0 };
+    uint64_t mediaTrackerCreationCount = 0;
+    uint64_t mediaTrackerDestructionCount = 0;
+    
+    // Large enough not to be allocated on the stack
+    uint64_t (*latencyBucketCounts)[SRGAnalyticsLatencyBucketCount] = calloc(SRGAnalyticsMetricsLatencyCount, sizeof(*latencyBucketCounts));
+    uint64_t latencySums[SRGAnalyticsMetricsLatencyCount] = { 0 };
+    uint64_t latencyMaxima[SRGAnalyticsMetricsLatencyCount] = { 0 };
+    
+    for (SRGAnalyticsMetricsShard *shard = atomic_load_explicit(&s_shards, memory_order_acquire); shard; shard = shard->next) {
+        for (NSUInteger type = 0; type < SRGAnalyticsMetricsEventTypeCount; ++type) {
+            for (NSUInteger outcome = 0; outcome < SRGAnalyticsMetricsOutcomeCount; ++outcome) {
+                eventCounts[outcome][type] += atomic_load_explicit(&shard->eventCounts[type][outcome], memory_order_relaxed);
+            }
+        }
+        
+        mediaTrackerCreationCount += atomic_load_explicit(&shard->mediaTrackerCreationCount, memory_order_relaxed);
+        mediaTrackerDestructionCount += atomic_load_explicit(&shard->mediaTrackerDestructionCount, memory_order_relaxed);
+        
+        for (NSUInteger latency = 0; latency < SRGAnalyticsMetricsLatencyCount; ++latency) {
+            for (NSUInteger i = 0; i < SRGAnalyticsLatencyBucketCount; ++i) {
+                latencyBucketCounts[latency][i] += atomic_load_explicit(&shard->latencyBucketCounts[latency][i], memory_order_relaxed);
+            }
+            latencySums[latency] += atomic_load_explicit(&shard->latencySums[latency], memory_order_relaxed);
+            latencyMaxima[latency] = MAX(latencyMaxima[latency], atomic_load_explicit(&shard->latencyMaxima[latency], memory_order_relaxed));
+        }
+    }
+    
+    NSMutableArray<SRGAnalyticsLatencyHistogram *> *histograms = [NSMutableArray arrayWithCapacity:SRGAnalyticsMetricsLatencyCount];
+    for (NSUInteger latency = 0; latency < SRGAnalyticsMetricsLatencyCount; ++latency) {
+        SRGAnalyticsLatencyHistogram *histogram = [[SRGAnalyticsLatencyHistogram alloc] initWithBucketCounts:latencyBucketCounts[latency]
+                                                                                                         sum:latencySums[latency]
+                                                                                                     maximum:latencyMaxima[latency]];
+        [histograms addObject:histogram];
+    }
+    free(latencyBucketCounts);
+    
+    return [[SRGAnalyticsMetrics alloc] initWithAcceptedEventCounts:eventCounts[SRGAnalyticsMetricsOutcomeAccepted]
+                                                 droppedEventCounts:eventCounts[SRGAnalyticsMetricsOutcomeDropped]
+                                                    sentEventCounts:eventCounts[SRGAnalyticsMetricsOutcomeSent]
+                                                  pendingEventCount:pendingEventCount
+                                              pendingEventByteCount:pendingEventByteCount
+                                              liveMediaTrackerCount:(NSInteger)(mediaTrackerCreationCount - mediaTrackerDestructionCount)
+                                             labelBuildingLatencies:histograms[SRGAnalyticsMetricsLatencyLabelBuilding]
+                                                  encodingLatencies:histograms[SRGAnalyticsMetricsLatencyEncoding]
+                                                  dispatchLatencies:histograms[SRGAnalyticsMetricsLatencyDispatch]];
+}
@@ -9,7 +9,7 @@
 NS_ASSUME_NONNULL_BEGIN
 
 /**
- *  Start intercepting analytics requests, emitting associated notifications, @see `SRGAnalyticsNotifications.h`.
+ *  Start intercepting comScore requests, emitting associated notifications, @see `SRGAnalyticsNotifications.h`.
  */
 OBJC_EXPORT void SRGAnalyticsEnableRequestInterceptor(void);
 
@@ -16,6 +16,12 @@ NSString * const SRGAnalyticsLabelsKey = @"SRGAnalyticsLabels";
 NSString * const SRGAnalyticsComScoreRequestNotification = @"SRGAnalyticsComScoreRequestNotification";
 NSString * const SRGAnalyticsComScoreLabelsKey = @"SRGAnalyticsComScoreLabels";
 
+NSString * const SRGAnalyticsMetricsNotification = @"SRGAnalyticsMetricsNotification";
+NSString * const SRGAnalyticsMetricsKey = @"SRGAnalyticsMetrics";
+
+NSString * const SRGAnalyticsBackpressureDidChangeNotification = @"SRGAnalyticsBackpressureDidChangeNotification";
+NSString * const SRGAnalyticsUnderBackpressureKey = @"SRGAnalyticsUnderBackpressure";
+
 static NSDictionary<NSString *, NSString *> *SRGAnalyticsProxyLabelsFromURLComponents(NSURLComponents *URLComponents)
 {
     NSMutableDictionary<NSString *, NSString *> *labels = [NSMutableDictionary dictionary];
@@ -49,30 +55,6 @@ static NSDictionary<NSString *, NSString *> *SRGAnalyticsProxyLabelsFromURLCompo
 
 @end
 
-@implementation NSURLConnection (SRGAnalyticsProxy)
-
-+ (void)srg_enableAnalyticsInterceptor
-{
-    method_exchangeImplementations(class_getClassMethod(self, @selector(sendSynchronousRequest:returningResponse:error:)),
-                                   class_getClassMethod(self, @selector(swizzled_sendSynchronousRequest:returningResponse:error:)));
-}
-
-+ (NSData *)swizzled_sendSynchronousRequest:(NSURLRequest *)request returningResponse:(NSURLResponse *__autoreleasing  _Nullable *)response error:(NSError * _Nullable __autoreleasing *)error
-{
-    NSURL *URL = request.URL;
-    if ([URL.host containsString:@"tagcommander"]) {
-        // The POST body contains URL encoded parameters. Use NSURLComponents for simple extraction
-        NSURLComponents *URLComponents = [NSURLComponents componentsWithURL:URL resolvingAgainstBaseURL:NO];
-        URLComponents.query = [[NSString alloc] initWithData:request.HTTPBody encoding:NSUTF8StringEncoding];
-        [NSNotificationCenter.defaultCenter postNotificationName:SRGAnalyticsRequestNotification
-                                                          object:nil
-                                                        userInfo:@{ SRGAnalyticsLabelsKey : SRGAnalyticsProxyLabelsFromURLComponents(URLComponents) }];
-    }
-    return [self swizzled_sendSynchronousRequest:request returningResponse:response error:error];
-}
-
-@end
-
 void SRGAnalyticsEnableRequestInterceptor(void)
 {
     if (s_interceptorEnabled) {
@@ -80,7 +62,6 @@ void SRGAnalyticsEnableRequestInterceptor(void)
     }
     
     [NSURLSession srg_enableAnalyticsInterceptor];
-    [NSURLConnection srg_enableAnalyticsInterceptor];
     
     s_interceptorEnabled = YES;
 }
@@ -0,0 +1,58 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsPageViewLabels.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Return a 64-bit fingerprint identifying a page view, computed from its raw parameters without building any label
+ *  dictionary.
+ */
+OBJC_EXPORT uint64_t SRGAnalyticsPageViewFingerprint(NSString *title,
+                                                     NSArray<NSString *> * _Nullable levels,
+                                                     SRGAnalyticsPageViewLabels * _Nullable labels,
+                                                     BOOL fromPushNotification);
+
+/**
+ *  Suppresses bursts of identical page views. A page view is suppressed if an identical page view (same title, levels,
+ *  labels and push notification origin) has been accepted less than a debounce interval before. Page views are looked
+ *  up by fingerprint first, then compared exactly. Thread-safe.
+ */
+@interface SRGAnalyticsPageViewDeduplicator : NSObject
+
+/**
+ *  Create a deduplicator with the specified debounce interval.
+ */
+- (instancetype)initWithDebounceInterval:(NSTimeInterval)debounceInterval NS_DESIGNATED_INITIALIZER;
+
+/**
+ *  Return `YES` iff a page view with the specified parameters must be tracked now.
+ */
+- (BOOL)shouldTrackPageViewWithTitle:(NSString *)title
+                              levels:(nullable NSArray<NSString *> *)levels
+                              labels:(nullable SRGAnalyticsPageViewLabels *)labels
+                fromPushNotification:(BOOL)fromPushNotification;
+
+/**
+ *  Return `YES` iff a page view with the specified parameters must be tracked at the specified time (in nanoseconds,
+ *  see `SRGAnalyticsMonotonicTime()`).
+ */
+- (BOOL)shouldTrackPageViewWithTitle:(NSString *)title
+                              levels:(nullable NSArray<NSString *> *)levels
+                              labels:(nullable SRGAnalyticsPageViewLabels *)labels
+                fromPushNotification:(BOOL)fromPushNotification
+                              atTime:(uint64_t)time;
+
+@end
+
+@interface SRGAnalyticsPageViewDeduplicator (Unavailable)
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
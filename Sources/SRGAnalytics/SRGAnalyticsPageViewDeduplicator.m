@@ -0,0 +1,202 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsPageViewDeduplicator.h"
+
+#import "SRGAnalyticsClock.h"
+
+#import <pthread.h>
+
+// Number of recently accepted page views remembered. Bursts involve a few distinct pages at most (the visible
+// view controller hierarchy of each scene).
+static const NSUInteger SRGAnalyticsPageViewHistoryCount = 16;
+
+typedef struct {
+    uint64_t fingerprint;
+    uint64_t time;
+} SRGAnalyticsPageViewHistoryEntry;
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Fingerprints are built from string hashes, which only consider part of long strings. Page view parameters are
+// therefore kept so that page views with identical fingerprints can be compared exactly.
+@interface SRGAnalyticsDeduplicatedPageView : NSObject
+
+- (instancetype)initWithTitle:(NSString *)title
+                       levels:(nullable NSArray<NSString *> *)levels
+                       labels:(nullable SRGAnalyticsPageViewLabels *)labels
+         fromPushNotification:(BOOL)fromPushNotification;
+
+@property (nonatomic, readonly, copy) NSString *title;
+@property (nonatomic, readonly, copy, nullable) NSArray<NSString *> *levels;
+@property (nonatomic, readonly, copy, nullable) NSDictionary<NSString *, NSString *> *customInfo;
+@property (nonatomic, readonly, copy, nullable) NSDictionary<NSString *, NSString *> *comScoreCustomInfo;
+@property (nonatomic, readonly, getter=isFromPushNotification) BOOL fromPushNotification;
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+static BOOL SRGAnalyticsDeduplicatedPageViewObjectsAreEqual(id object1, id object2)
+{
+    return object1 == object2 || [object1 isEqual:object2];
+}
+
+static uint64_t SRGAnalyticsFingerprintMix(uint64_t hash, uint64_t value)
+{
+    hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+// Order-independent combination of dictionary entry hashes
+static uint64_t SRGAnalyticsDictionaryFingerprint(NSDictionary<NSString *, NSString *> *dictionary)
+{
+    __block uint64_t fingerprint = dictionary.count;
+    [dictionary enumerateKeysAndObjectsUsingBlock:^(NSString * _Nonnull key, NSString * _Nonnull object, BOOL * _Nonnull stop) {
+        fingerprint += SRGAnalyticsFingerprintMix(key.hash, object.hash) * 0xbf58476d1ce4e5b9ULL;
+    }];
+    return fingerprint;
+}
+
+uint64_t SRGAnalyticsPageViewFingerprint(NSString *title, NSArray<NSString *> *levels, SRGAnalyticsPageViewLabels *labels, BOOL fromPushNotification)
+{
+    uint64_t fingerprint = SRGAnalyticsFingerprintMix(title.hash, fromPushNotification);
+    for (NSString *level in levels) {
+        fingerprint = SRGAnalyticsFingerprintMix(fingerprint, level.hash);
+    }
+    if (labels) {
+        fingerprint = SRGAnalyticsFingerprintMix(fingerprint, SRGAnalyticsDictionaryFingerprint(labels.customInfo));
+        fingerprint = SRGAnalyticsFingerprintMix(fingerprint, SRGAnalyticsDictionaryFingerprint(labels.comScoreCustomInfo));
+    }
+    return fingerprint;
+}
+
+@implementation SRGAnalyticsDeduplicatedPageView
+
+- (instancetype)initWithTitle:(NSString *)title levels:(NSArray<NSString *> *)levels labels:(SRGAnalyticsPageViewLabels *)labels fromPushNotification:(BOOL)fromPushNotification
+{
+    if (self = [super init]) {
+        _title = title.copy;
+        _levels = levels.copy;
+        _customInfo = labels.customInfo;
+        _comScoreCustomInfo = labels.comScoreCustomInfo;
+        _fromPushNotification = fromPushNotification;
+    }
+    return self;
+}
+
+- (BOOL)isEqual:(id)object
+{
+    if (! [object isKindOfClass:self.class]) {
+        return NO;
+    }
+    
+    SRGAnalyticsDeduplicatedPageView *otherPageView = object;
+    return [self.title isEqualToString:otherPageView.title]
+        && SRGAnalyticsDeduplicatedPageViewObjectsAreEqual(self.levels, otherPageView.levels)
+        && SRGAnalyticsDeduplicatedPageViewObjectsAreEqual(self.customInfo, otherPageView.customInfo)
+        && SRGAnalyticsDeduplicatedPageViewObjectsAreEqual(self.comScoreCustomInfo, otherPageView.comScoreCustomInfo)
+        && self.fromPushNotification == otherPageView.fromPushNotification;
+}
+
+- (NSUInteger)hash
+{
+    return (NSUInteger)SRGAnalyticsPageViewFingerprint(self.title, self.levels, nil, self.fromPushNotification);
+}
+
+@end
+
+@implementation SRGAnalyticsPageViewDeduplicator {
+@private
+    uint64_t _debounceInterval;
+    
+    pthread_mutex_t _mutex;
+    SRGAnalyticsPageViewHistoryEntry _history[SRGAnalyticsPageViewHistoryCount];
+    __strong SRGAnalyticsDeduplicatedPageView *_historyPageViews[SRGAnalyticsPageViewHistoryCount];
+    NSUInteger _nextHistoryIndex;
+}
+
+#pragma mark Object lifecycle
+
+- (instancetype)initWithDebounceInterval:(NSTimeInterval)debounceInterval
+{
+    if (self = [super init]) {
+        _debounceInterval = (uint64_t)(fmax(debounceInterval, 0.) * NSEC_PER_SEC);
+        pthread_mutex_init(&_mutex, NULL);
+    }
+    return self;
+}
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-implementations"
+
+- (instancetype)init
+{
+    [self doesNotRecognizeSelector:_cmd];
+    return [self initWithDebounceInterval:0.];
+}
+
+#pragma clang diagnostic pop
+
+- (void)dealloc
+{
+    pthread_mutex_destroy(&_mutex);
+}
+
+#pragma mark Deduplication
+
+- (BOOL)shouldTrackPageViewWithTitle:(NSString *)title
+                              levels:(NSArray<NSString *> *)levels
+                              labels:(SRGAnalyticsPageViewLabels *)labels
+                fromPushNotification:(BOOL)fromPushNotification
+{
+    return [self shouldTrackPageViewWithTitle:title levels:levels labels:labels fromPushNotification:fromPushNotification atTime:SRGAnalyticsMonotonicTime()];
+}
+
+- (BOOL)shouldTrackPageViewWithTitle:(NSString *)title
+                              levels:(NSArray<NSString *> *)levels
+                              labels:(SRGAnalyticsPageViewLabels *)labels
+                fromPushNotification:(BOOL)fromPushNotification
+                              atTime:(uint64_t)time
+{
+    if (_debounceInterval == 0) {
+        return YES;
+    }
+    
+    uint64_t fingerprint = SRGAnalyticsPageViewFingerprint(title, levels, labels, fromPushNotification);
+    SRGAnalyticsDeduplicatedPageView *pageView = [[SRGAnalyticsDeduplicatedPageView alloc] initWithTitle:title levels:levels labels:labels fromPushNotification:fromPushNotification];
+    
+    pthread_mutex_lock(&_mutex);
+    
+    BOOL shouldTrack = YES;
+    SRGAnalyticsPageViewHistoryEntry *entry = NULL;
+    for (NSUInteger i = 0; i < SRGAnalyticsPageViewHistoryCount; ++i) {
+        if (_history[i].time != 0 && _history[i].fingerprint == fingerprint && [_historyPageViews[i] isEqual:pageView]) {
+            entry = &_history[i];
+            break;
+        }
+    }
+    
+    if (entry) {
+        if (time - entry->time < _debounceInterval) {
+            shouldTrack = NO;
+        }
+        else {
+            entry->time = time;
+        }
+    }
+    else {
+        // Replace the entry least recently added
+        _history[_nextHistoryIndex] = (SRGAnalyticsPageViewHistoryEntry){ .fingerprint = fingerprint, .time = time };
+        _historyPageViews[_nextHistoryIndex] = pageView;
+        _nextHistoryIndex = (_nextHistoryIndex + 1) % SRGAnalyticsPageViewHistoryCount;
+    }
+    
+    pthread_mutex_unlock(&_mutex);
+    return shouldTrack;
+}
+
+@end
@@ -0,0 +1,81 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsEvent.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Outcomes of buffering attempts.
+ */
+typedef NS_ENUM(NSInteger, SRGAnalyticsPreStartBufferOutcome) {
+    /**
+     *  The event has been buffered.
+     */
+    SRGAnalyticsPreStartBufferOutcomeBuffered = 0,
+    /**
+     *  The event has been dropped, the buffer being full. Earlier events are kept.
+     */
+    SRGAnalyticsPreStartBufferOutcomeDropped,
+    /**
+     *  The buffer has already been released. The event must be handled by the caller.
+     */
+    SRGAnalyticsPreStartBufferOutcomeReleased
+};
+
+/**
+ *  Block called with buffered events, in the order they were buffered.
+ */
+typedef void (^SRGAnalyticsPreStartBufferReleaseBlock)(NSArray<SRGAnalyticsEvent *> *events);
+
+/**
+ *  Bounded buffer holding events emitted before the tracker is ready to process them. Once released, the buffer
+ *  does not accept events anymore, and callers must enqueue them directly.
+ *
+ *  @discussion Thread-safe. After release, buffering attempts only cost an atomic load.
+ */
+@interface SRGAnalyticsPreStartBuffer : NSObject
+
+/**
+ *  Create a buffer holding at most the specified number of events.
+ */
+- (instancetype)initWithCapacity:(NSUInteger)capacity NS_DESIGNATED_INITIALIZER;
+
+/**
+ *  Attempt to buffer an event.
+ */
+- (SRGAnalyticsPreStartBufferOutcome)bufferEvent:(SRGAnalyticsEvent *)event;
+
+/**
+ *  Release the buffer, calling the block with all buffered events. Events buffered concurrently are either part of
+ *  the released events, or rejected after the block has returned, so that order can be preserved.
+ */
+- (void)releaseWithBlock:(NS_NOESCAPE SRGAnalyticsPreStartBufferReleaseBlock)block;
+
+/**
+ *  `YES` iff the buffer has been released.
+ */
+@property (nonatomic, readonly, getter=isReleased) BOOL released;
+
+/**
+ *  The number of events currently buffered.
+ */
+@property (nonatomic, readonly) NSUInteger count;
+
+/**
+ *  The number of events dropped because the buffer was full.
+ */
+@property (nonatomic, readonly) NSUInteger droppedCount;
+
+@end
+
+@interface SRGAnalyticsPreStartBuffer (Unavailable)
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
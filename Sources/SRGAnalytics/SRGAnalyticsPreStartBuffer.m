@@ -0,0 +1,137 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsPreStartBuffer.h"
+
+#import <pthread.h>
+#import <stdatomic.h>
+
+@interface SRGAnalyticsPreStartBuffer () {
+@private
+    pthread_mutex_t _mutex;
+    atomic_bool _released;
+}
+
+@property (nonatomic) NSUInteger capacity;
+@property (nonatomic) NSMutableArray<SRGAnalyticsEvent *> *events;
+@property (nonatomic) NSUInteger droppedCount;
+
+@end
+
+@implementation SRGAnalyticsPreStartBuffer
+
+#pragma mark Object lifecycle
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity
+{
+    if (self = [super init]) {
+        self.capacity = capacity;
+        self.events = [NSMutableArray array];
+        pthread_mutex_init(&_mutex, NULL);
+        atomic_init(&_released, false);
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    pthread_mutex_destroy(&_mutex);
+}
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-implementations"
+
+- (instancetype)init
+{
+    [self doesNotRecognizeSelector:_cmd];
+    return [self initWithCapacity:0];
+}
+
+#pragma clang diagnostic pop
+
+#pragma mark Getters and setters
+
+- (BOOL)isReleased
+{
+    return atomic_load_explicit(&_released, memory_order_acquire);
+}
+
+- (NSUInteger)count
+{
+    pthread_mutex_lock(&_mutex);
+    NSUInteger count = self.events.count;
+    pthread_mutex_unlock(&_mutex);
+    return count;
+}
+
+- (NSUInteger)droppedCount
+{
+    pthread_mutex_lock(&_mutex);
+    NSUInteger droppedCount = _droppedCount;
+    pthread_mutex_unlock(&_mutex);
+    return droppedCount;
+}
+
+#pragma mark Buffering
+
+- (SRGAnalyticsPreStartBufferOutcome)bufferEvent:(SRGAnalyticsEvent *)event
+{
+    if (atomic_load_explicit(&_released, memory_order_acquire)) {
+        return SRGAnalyticsPreStartBufferOutcomeReleased;
+    }
+    
+    pthread_mutex_lock(&_mutex);
+    
+    SRGAnalyticsPreStartBufferOutcome outcome = SRGAnalyticsPreStartBufferOutcomeBuffered;
+    
+    // Check again, the buffer might have been released in the meantime
+    if (atomic_load_explicit(&_released, memory_order_relaxed)) {
+        outcome = SRGAnalyticsPreStartBufferOutcomeReleased;
+    }
+    else if (self.events.count < self.capacity) {
+        [self.events addObject:event];
+    }
+    else {
+        _droppedCount += 1;
+        outcome = SRGAnalyticsPreStartBufferOutcomeDropped;
+    }
+    
+    pthread_mutex_unlock(&_mutex);
+    return outcome;
+}
+
+- (void)releaseWithBlock:(SRGAnalyticsPreStartBufferReleaseBlock)block
+{
+    pthread_mutex_lock(&_mutex);
+    
+    if (atomic_load_explicit(&_released, memory_order_relaxed)) {
+        pthread_mutex_unlock(&_mutex);
+        return;
+    }
+    
+    // Events emitted while the block runs wait for the lock, those emitted afterwards see the buffer as released,
+    // and are therefore handled after buffered events
+    NSArray<SRGAnalyticsEvent *> *events = self.events.copy;
+    [self.events removeAllObjects];
+    block(events);
+    atomic_store_explicit(&_released, true, memory_order_release);
+    
+    pthread_mutex_unlock(&_mutex);
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; released = %@; count = %@; droppedCount = %@>",
+            self.class,
+            self,
+            self.released ? @"YES" : @"NO",
+            @(self.count),
+            @(self.droppedCount)];
+}
+
+@end
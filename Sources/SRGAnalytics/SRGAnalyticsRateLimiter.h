@@ -0,0 +1,42 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+@import Foundation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Lock-free token bucket rate limiter, implemented as a generic cell rate algorithm (GCRA). The limiter state is
+ *  a single atomic timestamp updated with compare-and-swap, making it safe and cheap to use from any thread.
+ */
+@interface SRGAnalyticsRateLimiter : NSObject
+
+/**
+ *  Create a limiter allowing the specified sustained rate (in events per second), with bursts of at most the
+ *  specified size.
+ */
+- (instancetype)initWithRate:(double)rate burstSize:(NSUInteger)burstSize NS_DESIGNATED_INITIALIZER;
+
+/**
+ *  Take a token, returning `NO` if none is available.
+ */
+- (BOOL)acquire;
+
+/**
+ *  Take a token at the specified time (in nanoseconds, see `SRGAnalyticsMonotonicTime()`), returning `NO` if none
+ *  is available.
+ */
+- (BOOL)acquireAtTime:(uint64_t)time;
+
+@end
+
+@interface SRGAnalyticsRateLimiter (Unavailable)
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
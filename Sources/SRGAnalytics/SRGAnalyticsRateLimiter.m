@@ -0,0 +1,81 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsRateLimiter.h"
+
+#import "SRGAnalyticsClock.h"
+
+#import <stdatomic.h>
+
+@implementation SRGAnalyticsRateLimiter {
+@private
+    // Theoretical arrival time of the next event, in nanoseconds
+    _Atomic(uint64_t) _theoreticalArrivalTime;
+    
+    uint64_t _emissionInterval;
+    uint64_t _burstInterval;
+}
+
+#pragma mark Object lifecycle
+
+- (instancetype)initWithRate:(double)rate burstSize:(NSUInteger)burstSize
+{
+    NSParameterAssert(rate > 0.);
+    
+    if (self = [super init]) {
+        _emissionInterval = (uint64_t)fmax(1e9 / rate, 1.);
+        _burstInterval = MAX(burstSize, 1) * _emissionInterval;
+        atomic_init(&_theoreticalArrivalTime, 0);
+    }
+    return self;
+}
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-implementations"
+
+- (instancetype)init
+{
+    [self doesNotRecognizeSelector:_cmd];
+    return [self initWithRate:1. burstSize:1];
+}
+
+#pragma clang diagnostic pop
+
+#pragma mark Tokens
+
+- (BOOL)acquire
+{
+    return [self acquireAtTime:SRGAnalyticsMonotonicTime()];
+}
+
+- (BOOL)acquireAtTime:(uint64_t)time
+{
+    uint64_t theoreticalArrivalTime = atomic_load_explicit(&_theoreticalArrivalTime, memory_order_relaxed);
+    while (1) {
+        uint64_t nextTheoreticalArrivalTime = MAX(theoreticalArrivalTime, time) + _emissionInterval;
+        if (nextTheoreticalArrivalTime - time > _burstInterval) {
+            return NO;
+        }
+        
+        if (atomic_compare_exchange_weak_explicit(&_theoreticalArrivalTime, &theoreticalArrivalTime, nextTheoreticalArrivalTime,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+            return YES;
+        }
+    }
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; rate = %@; burstSize = %@>",
+            self.class,
+            self,
+            @(1e9 / _emissionInterval),
+            @(_burstInterval / _emissionInterval)];
+}
+
+@end
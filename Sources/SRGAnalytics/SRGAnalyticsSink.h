@@ -0,0 +1,103 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsEvent.h"
+#import "SRGAnalyticsLabelContext.h"
+#import "SRGAnalyticsMemoryBudget.h"
+
+@import Foundation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Block called once TagCommander labels have been delivered.
+ */
+typedef void (^SRGAnalyticsSinkDeliveryHandler)(void);
+
+/**
+ *  Event fanned out to all sinks. A single instance is shared by all sinks, which must treat its label contexts as
+ *  read-only.
+ */
+@interface SRGAnalyticsSinkEvent : NSObject
+
+/**
+ *  Create an event with labels resolved for each service. A delivery handler can be provided to be notified when
+ *  TagCommander labels have been delivered.
+ */
+- (instancetype)initWithTagCommanderContext:(nullable SRGAnalyticsLabelContext *)tagCommanderContext
+                            comScoreContext:(nullable SRGAnalyticsLabelContext *)comScoreContext
+                                   replayed:(BOOL)replayed
+                            deliveryHandler:(nullable SRGAnalyticsSinkDeliveryHandler)deliveryHandler NS_DESIGNATED_INITIALIZER;
+
+/**
+ *  TagCommander labels, if the event must be sent to TagCommander.
+ */
+@property (nonatomic, readonly, nullable) SRGAnalyticsLabelContext *tagCommanderContext;
+
+/**
+ *  comScore labels, if the event must be sent to comScore.
+ */
+@property (nonatomic, readonly, nullable) SRGAnalyticsLabelContext *comScoreContext;
+
+/**
+ *  `YES` iff the event is replayed from a previous session.
+ */
+@property (nonatomic, readonly, getter=isReplayed) BOOL replayed;
+
+/**
+ *  The entry accounting for the event within the pending event memory budget, if any. Each pipeline the event is
+ *  enqueued into is a consumer of the entry until done with the event. Evicted events are not consumed.
+ */
+@property (nonatomic, nullable) SRGAnalyticsMemoryBudgetEntry *budgetEntry;
+
+/**
+ *  The lane of the event the sink event was built from, deciding how much of sink pipelines it can use.
+ *
+ *  Default value is `SRGAnalyticsEventLaneCritical`.
+ */
+@property (nonatomic) SRGAnalyticsEventLane lane;
+
+/**
+ *  Must be called by the sink delivering TagCommander labels once they have been delivered.
+ */
+- (void)notifyTagCommanderDelivery;
+
+@end
+
+/**
+ *  Destination of tracked events. Each sink is fed by its own pipeline (@see `SRGAnalyticsSinkPipeline`), so that a
+ *  slow or failing sink does not affect the others.
+ */
+@protocol SRGAnalyticsSink <NSObject>
+
+/**
+ *  The sink name, used for logging and queue naming.
+ */
+@property (nonatomic, readonly, copy) NSString *name;
+
+/**
+ *  Consume an event. Called serially on the sink pipeline queue, in the order events were tracked. Exceptions raised
+ *  are caught and counted as failures.
+ */
+- (void)consumeEvent:(SRGAnalyticsSinkEvent *)event;
+
+@optional
+
+/**
+ *  Send events the sink has buffered, if any, without waiting for them to be delivered. Called on the sink pipeline
+ *  queue when the tracker is flushed.
+ */
+- (void)flush;
+
+@end
+
+@interface SRGAnalyticsSinkEvent (Unavailable)
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,66 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsSink.h"
+
+@interface SRGAnalyticsSinkEvent ()
+
+@property (nonatomic) SRGAnalyticsLabelContext *tagCommanderContext;
+@property (nonatomic) SRGAnalyticsLabelContext *comScoreContext;
+@property (nonatomic, getter=isReplayed) BOOL replayed;
+@property (nonatomic, copy) SRGAnalyticsSinkDeliveryHandler deliveryHandler;
+
+@end
+
+@implementation SRGAnalyticsSinkEvent
+
+#pragma mark Object lifecycle
+
+- (instancetype)initWithTagCommanderContext:(SRGAnalyticsLabelContext *)tagCommanderContext
+                            comScoreContext:(SRGAnalyticsLabelContext *)comScoreContext
+                                   replayed:(BOOL)replayed
+                            deliveryHandler:(SRGAnalyticsSinkDeliveryHandler)deliveryHandler
+{
+    if (self = [super init]) {
+        self.tagCommanderContext = tagCommanderContext;
+        self.comScoreContext = comScoreContext;
+        self.replayed = replayed;
+        self.deliveryHandler = deliveryHandler;
+    }
+    return self;
+}
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-implementations"
+
+- (instancetype)init
+{
+    [self doesNotRecognizeSelector:_cmd];
+    return [self initWithTagCommanderContext:nil comScoreContext:nil replayed:NO deliveryHandler:nil];
+}
+
+#pragma clang diagnostic pop
+
+#pragma mark Delivery
+
+- (void)notifyTagCommanderDelivery
+{
+    self.deliveryHandler ? self.deliveryHandler() : nil;
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; tagCommanderContext = %@; comScoreContext = %@; replayed = %@>",
+            self.class,
+            self,
+            self.tagCommanderContext,
+            self.comScoreContext,
+            self.replayed ? @"YES" : @"NO"];
+}
+
+@end
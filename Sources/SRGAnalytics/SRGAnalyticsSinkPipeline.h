@@ -0,0 +1,74 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsSink.h"
+
+@import Foundation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Feeds a sink from its own serial queue, through a bounded buffer. Events enqueued while the buffer is full are
+ *  dropped, so that a sink unable to keep up never stalls event processing. Events of less important lanes can only
+ *  use part of the buffer (@see `SRGAnalyticsEventLanePolicy`), so that more important events are dropped last. Exceptions raised by the sink are caught
+ *  and counted, and do not prevent subsequent events from being consumed.
+ *
+ *  @discussion Events can be enqueued from any thread, though the pipeline only preserves order for events enqueued
+ *              from a single thread.
+ */
+@interface SRGAnalyticsSinkPipeline : NSObject
+
+/**
+ *  Create a pipeline feeding the specified sink, buffering at most `capacity` events.
+ */
+- (instancetype)initWithSink:(id<SRGAnalyticsSink>)sink capacity:(NSUInteger)capacity NS_DESIGNATED_INITIALIZER;
+
+/**
+ *  The sink.
+ */
+@property (nonatomic, readonly) id<SRGAnalyticsSink> sink;
+
+/**
+ *  Enqueue an event. Returns `NO` if the event was dropped because the part of the buffer available to its lane is
+ *  full.
+ */
+- (BOOL)enqueueEvent:(SRGAnalyticsSinkEvent *)event;
+
+/**
+ *  Perform a block on the pipeline queue, after all events enqueued so far have been consumed.
+ */
+- (void)performBlock:(void (^)(void))block;
+
+/**
+ *  Flush the sink on the pipeline queue, after all events enqueued so far have been consumed, then call the block on
+ *  the pipeline queue.
+ */
+- (void)flushWithCompletionBlock:(nullable void (^)(void))completionBlock;
+
+/**
+ *  The number of events enqueued but not consumed yet.
+ */
+@property (nonatomic, readonly) NSUInteger pendingCount;
+
+/**
+ *  The number of events dropped because the buffer was full.
+ */
+@property (nonatomic, readonly) NSUInteger droppedCount;
+
+/**
+ *  The number of events whose consumption raised an exception.
+ */
+@property (nonatomic, readonly) NSUInteger failureCount;
+
+@end
+
+@interface SRGAnalyticsSinkPipeline (Unavailable)
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,149 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsSinkPipeline.h"
+
+#import "SRGAnalyticsLogger.h"
+
+#import <stdatomic.h>
+
+@interface SRGAnalyticsSinkPipeline () {
+@private
+    atomic_ulong _pendingCount;
+    atomic_ulong _droppedCount;
+    atomic_ulong _failureCount;
+}
+
+@property (nonatomic) id<SRGAnalyticsSink> sink;
+@property (nonatomic) NSUInteger capacity;
+@property (nonatomic) dispatch_queue_t queue;
+
+@end
+
+@implementation SRGAnalyticsSinkPipeline
+
+#pragma mark Object lifecycle
+
+- (instancetype)initWithSink:(id<SRGAnalyticsSink>)sink capacity:(NSUInteger)capacity
+{
+    if (self = [super init]) {
+        atomic_init(&_pendingCount, 0);
+        atomic_init(&_droppedCount, 0);
+        atomic_init(&_failureCount, 0);
+        
+        self.sink = sink;
+        self.capacity = capacity;
+        
+        NSString *name = [NSString stringWithFormat:@"ch.srgssr.analytics.sink.%@", sink.name];
+        self.queue = dispatch_queue_create(name.UTF8String, DISPATCH_QUEUE_SERIAL);
+    }
+    return self;
+}
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-implementations"
+
+- (instancetype)init
+{
+    [self doesNotRecognizeSelector:_cmd];
+    return [self initWithSink:nil capacity:0];
+}
+
+#pragma clang diagnostic pop
+
+#pragma mark Getters and setters
+
+- (NSUInteger)pendingCount
+{
+    return atomic_load_explicit(&_pendingCount, memory_order_relaxed);
+}
+
+- (NSUInteger)droppedCount
+{
+    return atomic_load_explicit(&_droppedCount, memory_order_relaxed);
+}
+
+- (NSUInteger)failureCount
+{
+    return atomic_load_explicit(&_failureCount, memory_order_relaxed);
+}
+
+#pragma mark Event consumption
+
+- (BOOL)enqueueEvent:(SRGAnalyticsSinkEvent *)event
+{
+    // Reserve a slot first, so that concurrent producers cannot exceed the capacity
+    NSUInteger capacity = (NSUInteger)ceil(self.capacity * SRGAnalyticsEventLanePolicyForLane(event.lane).sinkCapacityRatio);
+    unsigned long pendingCount = atomic_fetch_add_explicit(&_pendingCount, 1, memory_order_relaxed);
+    if (pendingCount >= capacity) {
+        atomic_fetch_sub_explicit(&_pendingCount, 1, memory_order_relaxed);
+        
+        // Log on the first drop and then with decreasing frequency
+        unsigned long droppedCount = atomic_fetch_add_explicit(&_droppedCount, 1, memory_order_relaxed) + 1;
+        if ((droppedCount & (droppedCount - 1)) == 0) {
+            SRGAnalyticsLogWarning(@"tracker", @"The %@ sink cannot keep up. %@ events dropped so far", self.sink.name, @(droppedCount));
+        }
+        return NO;
+    }
+    
+    SRGAnalyticsMemoryBudgetEntry *budgetEntry = event.budgetEntry;
+    [budgetEntry addConsumer];
+    
+    dispatch_async(self.queue, ^{
+        // Events evicted under memory pressure while pending are skipped
+        if (! budgetEntry.evicted) {
+            @autoreleasepool {
+                @try {
+                    [self.sink consumeEvent:event];
+                }
+                @catch (NSException *exception) {
+                    atomic_fetch_add_explicit(&self->_failureCount, 1, memory_order_relaxed);
+                    SRGAnalyticsLogError(@"tracker", @"The %@ sink failed to consume an event. Reason: %@", self.sink.name, exception.reason);
+                }
+            }
+        }
+        [budgetEntry removeConsumer];
+        atomic_fetch_sub_explicit(&self->_pendingCount, 1, memory_order_relaxed);
+    });
+    return YES;
+}
+
+- (void)performBlock:(void (^)(void))block
+{
+    dispatch_async(self.queue, block);
+}
+
+- (void)flushWithCompletionBlock:(void (^)(void))completionBlock
+{
+    dispatch_async(self.queue, ^{
+        id<SRGAnalyticsSink> sink = self.sink;
+        if ([sink respondsToSelector:@selector(flush)]) {
+            @try {
+                [sink flush];
+            }
+            @catch (NSException *exception) {
+                atomic_fetch_add_explicit(&self->_failureCount, 1, memory_order_relaxed);
+                SRGAnalyticsLogError(@"tracker", @"The %@ sink failed to flush. Reason: %@", sink.name, exception.reason);
+            }
+        }
+        completionBlock ? completionBlock() : nil;
+    });
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; sink = %@; pendingCount = %@; droppedCount = %@; failureCount = %@>",
+            self.class,
+            self,
+            self.sink.name,
+            @(self.pendingCount),
+            @(self.droppedCount),
+            @(self.failureCount)];
+}
+
+@end
@@ -0,0 +1,89 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsCaptureSink.h"
+#import "SRGAnalyticsCollectorClient.h"
+#import "SRGAnalyticsSink.h"
+
+@import Foundation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Sink sending events to TagCommander. The TagCommander SDK is initialized when the first event is consumed.
+ */
+@interface SRGAnalyticsTagCommanderSink : NSObject <SRGAnalyticsSink>
+
+/**
+ *  Create a sink for the specified TagCommander site and container, sending permanent labels with all events.
+ */
+- (instancetype)initWithSite:(NSInteger)site
+                   container:(NSInteger)container
+             permanentLabels:(NSDictionary<NSString *, NSString *> *)permanentLabels NS_DESIGNATED_INITIALIZER;
+
+@end
+
+/**
+ *  Sink sending page views to comScore. The comScore SDK must have been started.
+ */
+@interface SRGAnalyticsComScoreSink : NSObject <SRGAnalyticsSink>
+
+@end
+
+/**
+ *  Sink sending events to a collector, in place of TagCommander and comScore (@see `SRGAnalyticsCollectorClient`).
+ */
+@interface SRGAnalyticsCollectorSink : NSObject <SRGAnalyticsSink>
+
+/**
+ *  Create a sink sending events with the specified client. TagCommander permanent labels are sent with all
+ *  TagCommander events.
+ *
+ *  If the batch interval (in seconds) is not 0, TagCommander events are batched (@see `SRGAnalyticsBatchEncoder`)
+ *  and sent when the first event of a batch is older than this interval, when a batch is full, or when the sink is
+ *  flushed. Otherwise each event is sent on its own.
+ */
+- (instancetype)initWithCollectorClient:(SRGAnalyticsCollectorClient *)collectorClient
+            tagCommanderPermanentLabels:(NSDictionary<NSString *, NSString *> *)tagCommanderPermanentLabels
+                          batchInterval:(NSTimeInterval)batchInterval NS_DESIGNATED_INITIALIZER;
+
+@end
+
+/**
+ *  Sink capturing events, as they would be sent to services, into a capture sink (@see `SRGAnalyticsCaptureSink`).
+ *  Events replayed from previous sessions are not captured.
+ */
+@interface SRGAnalyticsCaptureEventSink : NSObject <SRGAnalyticsSink>
+
+/**
+ *  Create a sink capturing events into the specified capture sink. If `postsRequestNotifications` is set to `YES`,
+ *  `SRGAnalyticsRequestNotification` is posted for each captured TagCommander event.
+ */
+- (instancetype)initWithCaptureSink:(SRGAnalyticsCaptureSink *)captureSink
+        tagCommanderPermanentLabels:(NSDictionary<NSString *, NSString *> *)tagCommanderPermanentLabels
+          postsRequestNotifications:(BOOL)postsRequestNotifications NS_DESIGNATED_INITIALIZER;
+
+@end
+
+@interface SRGAnalyticsTagCommanderSink (Unavailable)
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+@interface SRGAnalyticsCollectorSink (Unavailable)
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+@interface SRGAnalyticsCaptureEventSink (Unavailable)
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
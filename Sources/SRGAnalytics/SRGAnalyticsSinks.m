@@ -0,0 +1,355 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsSinks.h"
+
+#import "SRGAnalyticsBatchEncoder.h"
+#import "SRGAnalyticsByteBuffer.h"
+#import "SRGAnalyticsCaptureSink+Private.h"
+#import "SRGAnalyticsClock.h"
+#import "SRGAnalyticsEncoder.h"
+#import "SRGAnalyticsLogger.h"
+#import "SRGAnalyticsMetricsRecorder.h"
+#import "SRGAnalyticsNotifications.h"
+
+@import ComScore;
+@import TCCore;
+@import TCSDK;
+
+// Initial capacity of sink encoding buffers
+static const size_t SRGAnalyticsSinkBufferCapacity = 4 * 1024;
+
+// Collector batches are sent as soon as they reach either limit (size before compression)
+static const NSUInteger SRGAnalyticsCollectorBatchMaximumEventCount = 500;
+static const NSUInteger SRGAnalyticsCollectorBatchMaximumByteCount = 256 * 1024;
+
+// Permanent labels come first, so that event labels override them when decoded
+static void SRGAnalyticsSinkEncodeTagCommanderLabels(NSDictionary<NSString *, NSString *> *permanentLabels, SRGAnalyticsLabelContext *context, SRGAnalyticsByteBuffer *buffer)
+{
+    [buffer reset];
+    SRGAnalyticsEncodeLabels(permanentLabels, SRGAnalyticsEncodingFormatURL, buffer);
+    [buffer appendBytes:"&" length:1];
+    SRGAnalyticsEncodeLabelContext(context, SRGAnalyticsEncodingFormatURL, buffer);
+}
+
+static void SRGAnalyticsSinkEncodeComScoreLabels(SRGAnalyticsLabelContext *context, SRGAnalyticsByteBuffer *buffer)
+{
+    [buffer reset];
+    SRGAnalyticsEncodeLabelContext(context, SRGAnalyticsEncodingFormatURL, buffer);
+}
+
+#pragma mark TagCommander
+
+@interface SRGAnalyticsTagCommanderSink ()
+
+@property (nonatomic) NSInteger site;
+@property (nonatomic) NSInteger container;
+@property (nonatomic, copy) NSDictionary<NSString *, NSString *> *permanentLabels;
+
+@property (nonatomic) TagCommander *tagCommander;
+
+@end
+
+@implementation SRGAnalyticsTagCommanderSink
+
+- (instancetype)initWithSite:(NSInteger)site container:(NSInteger)container permanentLabels:(NSDictionary<NSString *, NSString *> *)permanentLabels
+{
+    if (self = [super init]) {
+        self.site = site;
+        self.container = container;
+        self.permanentLabels = permanentLabels;
+    }
+    return self;
+}
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-implementations"
+
+- (instancetype)init
+{
+    [self doesNotRecognizeSelector:_cmd];
+    return [self initWithSite:0 container:0 permanentLabels:@{}];
+}
+
+#pragma clang diagnostic pop
+
+- (NSString *)name
+{
+    return @"tagcommander";
+}
+
+- (void)consumeEvent:(SRGAnalyticsSinkEvent *)event
+{
+    SRGAnalyticsLabelContext *context = event.tagCommanderContext;
+    if (! context) {
+        return;
+    }
+    
+    if (! self.tagCommander) {
+        [TCDebug setDebugLevel:TCLogLevel_None];
+        self.tagCommander = [[TagCommander alloc] initWithSiteID:(int)self.site andContainerID:(int)self.container];
+        [self.tagCommander enableRunningInBackground];
+        [self.permanentLabels enumerateKeysAndObjectsUsingBlock:^(NSString * _Nonnull key, NSString * _Nonnull label, BOOL * _Nonnull stop) {
+            [self.tagCommander addPermanentData:key withValue:label];
+        }];
+    }
+    
+    uint64_t dispatchStartTime = SRGAnalyticsMonotonicTime();
+    [context enumerateLabelsUsingBlock:^(NSString * _Nonnull key, NSString * _Nonnull label, BOOL * _Nonnull stop) {
+        [self.tagCommander addData:key withValue:label];
+    }];
+    [self.tagCommander sendData];
+    SRGAnalyticsMetricsRecordLatency(SRGAnalyticsMetricsLatencyDispatch, SRGAnalyticsMonotonicTime() - dispatchStartTime);
+    
+    [event notifyTagCommanderDelivery];
+}
+
+@end
+
+#pragma mark comScore
+
+@implementation SRGAnalyticsComScoreSink
+
+- (NSString *)name
+{
+    return @"comscore";
+}
+
+- (void)consumeEvent:(SRGAnalyticsSinkEvent *)event
+{
+    SRGAnalyticsLabelContext *context = event.comScoreContext;
+    if (! context || event.replayed) {
+        return;
+    }
+    
+    uint64_t dispatchStartTime = SRGAnalyticsMonotonicTime();
+    [SCORAnalytics notifyViewEventWithLabels:context.dictionary];
+    SRGAnalyticsMetricsRecordLatency(SRGAnalyticsMetricsLatencyDispatch, SRGAnalyticsMonotonicTime() - dispatchStartTime);
+}
+
+@end
+
+#pragma mark Collector
+
+@interface SRGAnalyticsCollectorSink ()
+
+@property (nonatomic) SRGAnalyticsCollectorClient *collectorClient;
+@property (nonatomic, copy) NSDictionary<NSString *, NSString *> *tagCommanderPermanentLabels;
+@property (nonatomic) NSTimeInterval batchInterval;
+@property (nonatomic) SRGAnalyticsByteBuffer *buffer;
+
+// Batch state, only accessed on the batch queue, so that batch timers can fire between events
+@property (nonatomic) dispatch_queue_t batchQueue;
+@property (nonatomic) SRGAnalyticsBatchEncoder *batchEncoder;
+@property (nonatomic) NSMutableArray<SRGAnalyticsSinkEvent *> *batchEvents;
+@property (nonatomic) uint64_t batchGeneration;
+
+@end
+
+@implementation SRGAnalyticsCollectorSink
+
+- (instancetype)initWithCollectorClient:(SRGAnalyticsCollectorClient *)collectorClient
+            tagCommanderPermanentLabels:(NSDictionary<NSString *,NSString *> *)tagCommanderPermanentLabels
+                          batchInterval:(NSTimeInterval)batchInterval
+{
+    if (self = [super init]) {
+        self.collectorClient = collectorClient;
+        self.tagCommanderPermanentLabels = tagCommanderPermanentLabels;
+        self.batchInterval = batchInterval;
+        self.buffer = [[SRGAnalyticsByteBuffer alloc] initWithCapacity:SRGAnalyticsSinkBufferCapacity];
+        
+        if (batchInterval > 0.) {
+            self.batchQueue = dispatch_queue_create("ch.srgssr.analytics.sink.collector.batch", DISPATCH_QUEUE_SERIAL);
+            self.batchEncoder = [[SRGAnalyticsBatchEncoder alloc] initWithSharedLabels:tagCommanderPermanentLabels];
+            self.batchEvents = [NSMutableArray array];
+        }
+    }
+    return self;
+}
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-implementations"
+
+- (instancetype)init
+{
+    [self doesNotRecognizeSelector:_cmd];
+    return [self initWithCollectorClient:[[SRGAnalyticsCollectorClient alloc] initWithBaseURL:[NSURL URLWithString:@""] maximumAttemptCount:0]
+             tagCommanderPermanentLabels:@{}
+                           batchInterval:0.];
+}
+
+#pragma clang diagnostic pop
+
+- (NSString *)name
+{
+    return @"collector";
+}
+
+- (void)consumeEvent:(SRGAnalyticsSinkEvent *)event
+{
+    SRGAnalyticsByteBuffer *buffer = self.buffer;
+    
+    if (event.tagCommanderContext && self.batchQueue) {
+        uint64_t dispatchStartTime = SRGAnalyticsMonotonicTime();
+        dispatch_sync(self.batchQueue, ^{
+            [self addEventToBatch:event];
+        });
+        SRGAnalyticsMetricsRecordLatency(SRGAnalyticsMetricsLatencyDispatch, SRGAnalyticsMonotonicTime() - dispatchStartTime);
+    }
+    else if (event.tagCommanderContext) {
+        SRGAnalyticsSinkEncodeTagCommanderLabels(self.tagCommanderPermanentLabels, event.tagCommanderContext, buffer);
+        
+        // Events are only flagged as delivered once acknowledged by the collector
+        uint64_t dispatchStartTime = SRGAnalyticsMonotonicTime();
+        [self.collectorClient sendEventWithService:SRGAnalyticsCaptureServiceTagCommander encodedLabels:buffer.bytes length:buffer.length completionHandler:^(BOOL delivered) {
+            if (delivered) {
+                [event notifyTagCommanderDelivery];
+            }
+        }];
+        SRGAnalyticsMetricsRecordLatency(SRGAnalyticsMetricsLatencyDispatch, SRGAnalyticsMonotonicTime() - dispatchStartTime);
+    }
+    
+    if (event.comScoreContext && ! event.replayed) {
+        SRGAnalyticsSinkEncodeComScoreLabels(event.comScoreContext, buffer);
+        [self.collectorClient sendEventWithService:SRGAnalyticsCaptureServiceComScore encodedLabels:buffer.bytes length:buffer.length completionHandler:nil];
+    }
+}
+
+- (void)flush
+{
+    if (! self.batchQueue) {
+        return;
+    }
+    
+    dispatch_sync(self.batchQueue, ^{
+        [self sendBatch];
+    });
+}
+
+#pragma mark Batching
+
+// Must be called on the batch queue
+- (void)addEventToBatch:(SRGAnalyticsSinkEvent *)event
+{
+    SRGAnalyticsBatchEncoder *batchEncoder = self.batchEncoder;
+    [batchEncoder addEventWithLabelContext:event.tagCommanderContext];
+    [self.batchEvents addObject:event];
+    
+    if (batchEncoder.eventCount >= SRGAnalyticsCollectorBatchMaximumEventCount || batchEncoder.byteCount >= SRGAnalyticsCollectorBatchMaximumByteCount) {
+        [self sendBatch];
+    }
+    else if (batchEncoder.eventCount == 1) {
+        // Timers of batches sent early are ignored
+        uint64_t batchGeneration = self.batchGeneration;
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(self.batchInterval * NSEC_PER_SEC)), self.batchQueue, ^{
+            if (self.batchGeneration == batchGeneration) {
+                [self sendBatch];
+            }
+        });
+    }
+}
+
+// Must be called on the batch queue
+- (void)sendBatch
+{
+    if (self.batchEvents.count == 0) {
+        return;
+    }
+    
+    NSData *batch = [self.batchEncoder finishBatch];
+    NSArray<SRGAnalyticsSinkEvent *> *events = self.batchEvents.copy;
+    [self.batchEvents removeAllObjects];
+    self.batchGeneration += 1;
+    
+    if (! batch) {
+        SRGAnalyticsLogError(@"collector", @"A batch of %@ events could not be encoded", @(events.count));
+        return;
+    }
+    
+    // Events are only flagged as delivered once the whole batch has been acknowledged by the collector
+    [self.collectorClient sendTagCommanderBatch:batch completionHandler:^(BOOL delivered) {
+        if (delivered) {
+            for (SRGAnalyticsSinkEvent *event in events) {
+                [event notifyTagCommanderDelivery];
+            }
+        }
+    }];
+}
+
+@end
+
+#pragma mark Capture
+
+@interface SRGAnalyticsCaptureEventSink ()
+
+@property (nonatomic) SRGAnalyticsCaptureSink *captureSink;
+@property (nonatomic, copy) NSDictionary<NSString *, NSString *> *tagCommanderPermanentLabels;
+@property (nonatomic) BOOL postsRequestNotifications;
+@property (nonatomic) SRGAnalyticsByteBuffer *buffer;
+
+@end
+
+@implementation SRGAnalyticsCaptureEventSink
+
+- (instancetype)initWithCaptureSink:(SRGAnalyticsCaptureSink *)captureSink
+        tagCommanderPermanentLabels:(NSDictionary<NSString *,NSString *> *)tagCommanderPermanentLabels
+          postsRequestNotifications:(BOOL)postsRequestNotifications
+{
+    if (self = [super init]) {
+        self.captureSink = captureSink;
+        self.tagCommanderPermanentLabels = tagCommanderPermanentLabels;
+        self.postsRequestNotifications = postsRequestNotifications;
+        self.buffer = [[SRGAnalyticsByteBuffer alloc] initWithCapacity:SRGAnalyticsSinkBufferCapacity];
+    }
+    return self;
+}
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-implementations"
+
+- (instancetype)init
+{
+    [self doesNotRecognizeSelector:_cmd];
+    return [self initWithCaptureSink:[[SRGAnalyticsCaptureSink alloc] initWithCapacity:0] tagCommanderPermanentLabels:@{} postsRequestNotifications:NO];
+}
+
+#pragma clang diagnostic pop
+
+- (NSString *)name
+{
+    return @"capture";
+}
+
+- (void)consumeEvent:(SRGAnalyticsSinkEvent *)event
+{
+    if (event.replayed) {
+        return;
+    }
+    
+    SRGAnalyticsByteBuffer *buffer = self.buffer;
+    
+    if (event.tagCommanderContext) {
+        SRGAnalyticsSinkEncodeTagCommanderLabels(self.tagCommanderPermanentLabels, event.tagCommanderContext, buffer);
+        uint64_t sequence = [self.captureSink captureEventWithService:SRGAnalyticsCaptureServiceTagCommander encodedLabels:buffer.bytes length:buffer.length];
+        
+        // Replaces interception of TagCommander requests for unit tests
+        if (sequence != 0 && self.postsRequestNotifications) {
+            SRGAnalyticsCapturedEvent *capturedEvent = [self.captureSink eventsAfterSequence:sequence - 1 matchingFilter:nil].firstObject;
+            if (capturedEvent) {
+                [NSNotificationCenter.defaultCenter postNotificationName:SRGAnalyticsRequestNotification
+                                                                  object:nil
+                                                                userInfo:@{ SRGAnalyticsLabelsKey : capturedEvent.labels }];
+            }
+        }
+    }
+    
+    if (event.comScoreContext) {
+        SRGAnalyticsSinkEncodeComScoreLabels(event.comScoreContext, buffer);
+        [self.captureSink captureEventWithService:SRGAnalyticsCaptureServiceComScore encodedLabels:buffer.bytes length:buffer.length];
+    }
+}
+
+@end
@@ -8,9 +8,27 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+@class SRGAnalyticsEventRecord;
+
+/**
+ *  Protocol for classes of optional subframeworks which install hooks (e.g. notification observers) when the tracker
+ *  is started, rather than when the library is loaded.
+ */
+@protocol SRGAnalyticsHookInstalling <NSObject>
+
+/**
+ *  Install hooks. Must be idempotent and thread-safe.
+ */
++ (void)srg_installAnalyticsHooks;
+
+@end
+
 @interface SRGAnalyticsTracker (Private)
 
-@property (nonatomic, nullable) SRGAnalyticsLabels *globalLabels;
+/**
+ *  Labels sent with all events. Labels are copied.
+ */
+@property (nonatomic, copy, nullable) SRGAnalyticsLabels *globalLabels;
 
 - (void)trackPageViewWithTitle:(NSString *)title
                         levels:(nullable NSArray<NSString *> *)levels
@@ -18,7 +36,15 @@ NS_ASSUME_NONNULL_BEGIN
           fromPushNotification:(BOOL)fromPushNotification
         ignoreApplicationState:(BOOL)ignoreApplicationState;
 
-- (void)trackTagCommanderEventWithLabels:(nullable NSDictionary<NSString *, NSString *> *)labels;
+/**
+ *  Send an event with labels prebuilt as a record to TagCommander. The record must not be mutated afterwards. Session
+ *  labels, usually shared by all events of some session (e.g. a playback session), override record labels and are
+ *  not copied. Events sharing a non-zero session identifier are sent in the order they were tracked.
+ */
+- (void)trackTagCommanderEventWithRecord:(SRGAnalyticsEventRecord *)record
+                           sessionLabels:(nullable NSDictionary<NSString *, NSString *> *)sessionLabels
+                       sessionIdentifier:(NSUInteger)sessionIdentifier
+                   unitTestingIdentifier:(nullable NSString *)unitTestingIdentifier;
 
 @end
 
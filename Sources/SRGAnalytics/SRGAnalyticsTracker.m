@@ -6,23 +6,89 @@
 
 #import "SRGAnalyticsTracker.h"
 
-#import "NSMutableDictionary+SRGAnalytics.h"
 #import "NSString+SRGAnalytics.h"
 #import "SRGAnalytics.h"
+#import "SRGAnalyticsAggregator.h"
+#import "SRGAnalyticsApplicationListCache.h"
+#import "SRGAnalyticsCaptureSink+Private.h"
+#import "SRGAnalyticsClock.h"
+#import "SRGAnalyticsCollectorClient.h"
+#import "SRGAnalyticsEncoder.h"
+#import "SRGAnalyticsEventPolicy.h"
+#import "SRGAnalyticsEventQueue.h"
+#import "SRGAnalyticsEventRecord+Catalog.h"
+#import "SRGAnalyticsJournal.h"
+#import "SRGAnalyticsLabelContext.h"
 #import "SRGAnalyticsLabels+Private.h"
+#import "SRGAnalyticsLaunchReport+Private.h"
 #import "SRGAnalyticsLogger.h"
+#import "SRGAnalyticsMemoryBudget.h"
+#import "SRGAnalyticsMetricsRecorder.h"
+#import "SRGAnalyticsPageViewDeduplicator.h"
+#import "SRGAnalyticsPreStartBuffer.h"
 #import "SRGAnalyticsNotifications+Private.h"
-#import "UIViewController+SRGAnalytics.h"
+#import "SRGAnalyticsSinkPipeline.h"
+#import "SRGAnalyticsSinks.h"
+#import "UIViewController+SRGAnalytics+Private.h"
 
 @import ComScore;
-@import TCCore;
-@import TCSDK;
 
 static NSString * s_unitTestingIdentifier = nil;
 
-__attribute__((constructor)) static void SRGAnalyticsTrackerInit(void)
+// Journal settings (at most 4 MB on disk)
+static const size_t SRGAnalyticsJournalSegmentSize = 256 * 1024;
+static const NSUInteger SRGAnalyticsJournalMaximumSegmentCount = 16;
+
+// Number of journaled events replayed at once, well below the part of sink pipelines available to background events
+static const NSUInteger SRGAnalyticsJournalReplayChunkSize = 100;
+
+// Encoding buffer settings
+static const NSUInteger SRGAnalyticsEncodingBufferCount = 4;
+static const size_t SRGAnalyticsEncodingBufferCapacity = 4 * 1024;
+
+// Capture buffer capacity used in unit testing mode, if none has been configured
+static const NSUInteger SRGAnalyticsUnitTestingCaptureBufferCapacity = 4 * 1024 * 1024;
+
+// Maximum number of attempts made to deliver an event to a collector
+static const NSUInteger SRGAnalyticsCollectorMaximumAttemptCount = 6;
+
+// Maximum number of events buffered for each sink
+static const NSUInteger SRGAnalyticsSinkCapacity = 1000;
+
+// Maximum number of events buffered until the tracker has started
+static const NSUInteger SRGAnalyticsPreStartBufferCapacity = 100;
+
+// Application list settings (in seconds)
+static const NSTimeInterval SRGAnalyticsApplicationListTimeToLive = 24. * 60. * 60.;
+static const NSTimeInterval SRGAnalyticsApplicationListMeasurementDelay = 5.;
+
+// Name of the hidden event reporting events dropped by the event policy or under memory pressure
+static NSString * const SRGAnalyticsSummaryEventName = @"srg_analytics_summary";
+
+// Classes of optional subframeworks installing hooks when the tracker is started (@see `SRGAnalyticsHookInstalling`)
+static NSArray<NSString *> *SRGAnalyticsHookInstallingClassNames(void)
+{
+    return @[ @"SRGMediaPlayerTracker", @"SRGComScoreMediaPlayerTracker" ];
+}
+
+static SRGAnalyticsMetricsEventType SRGAnalyticsMetricsEventTypeForEventType(SRGAnalyticsEventType type)
 {
-    [TCDebug setDebugLevel:TCLogLevel_None];
+    switch (type) {
+        case SRGAnalyticsEventTypePageView: {
+            return SRGAnalyticsMetricsEventTypePageView;
+            break;
+        }
+            
+        case SRGAnalyticsEventTypeHiddenEvent: {
+            return SRGAnalyticsMetricsEventTypeHiddenEvent;
+            break;
+        }
+            
+        default: {
+            return SRGAnalyticsMetricsEventTypeMedia;
+            break;
+        }
+    }
 }
 
 NSString *SRGAnalyticsUnitTestingIdentifier(void)
@@ -42,10 +108,43 @@ void SRGAnalyticsRenewUnitTestingIdentifier(void)
 
 @property (nonatomic, copy) SRGAnalyticsConfiguration *configuration;
 
-@property (nonatomic) TagCommander *tagCommander;
+@property (nonatomic, copy) NSDictionary<NSString *, NSString *> *tagCommanderPermanentLabels;
 @property (nonatomic) SCORStreamingAnalytics *streamSense;
 
-@property (nonatomic) SRGAnalyticsLabels *globalLabels;
+@property (nonatomic, copy) SRGAnalyticsLabels *globalLabels;
+
+// Global labels are resolved once into immutable contexts, shared by all events as their bottom layer
+@property (atomic) SRGAnalyticsLabelContext *globalLabelContext;
+@property (atomic) SRGAnalyticsLabelContext *globalComScoreLabelContext;
+
+@property (nonatomic) SRGAnalyticsEventQueue *eventQueue;
+@property (nonatomic) SRGAnalyticsPreStartBuffer *preStartBuffer;
+@property (nonatomic) SRGAnalyticsMemoryBudget *memoryBudget;
+@property (nonatomic) SRGAnalyticsJournal *journal;
+@property (nonatomic) SRGAnalyticsByteBufferPool *bufferPool;
+@property (nonatomic) SRGAnalyticsCaptureSink *captureSink;
+@property (nonatomic) SRGAnalyticsCollectorClient *collectorClient;
+@property (nonatomic, copy) NSArray<SRGAnalyticsSinkPipeline *> *sinkPipelines;
+@property (nonatomic) SRGAnalyticsApplicationListCache *applicationListCache;
+
+@property (nonatomic) SRGAnalyticsPageViewDeduplicator *pageViewDeduplicator;
+@property (nonatomic) SRGAnalyticsEventPolicy *eventPolicy;
+@property (nonatomic) NSTimer *summaryTimer;
+
+@property (nonatomic) SRGAnalyticsAggregator *aggregator;
+@property (nonatomic) NSTimer *aggregationTimer;
+
+@property (nonatomic) NSTimer *metricsTimer;
+
+// Backpressure state last notified (on the main thread)
+@property (nonatomic, getter=isNotifiedUnderBackpressure) BOOL notifiedUnderBackpressure;
+
+// Time at which the worker started processing the current event
+@property (nonatomic) uint64_t eventProcessingStartTime;
+
+// Time (since 1970) at which services were started, and original time of the current event if it was buffered before
+@property (nonatomic) NSTimeInterval servicesStartTimestamp;
+@property (nonatomic) NSTimeInterval bufferedEventTimestamp;
 
 @end
 
@@ -63,6 +162,37 @@ void SRGAnalyticsRenewUnitTestingIdentifier(void)
     return s_sharedInstance;
 }
 
+#pragma mark Object lifecycle
+
+- (instancetype)init
+{
+    if (self = [super init]) {
+        self.globalLabelContext = [[SRGAnalyticsLabelContext alloc] initWithParentContext:nil labels:nil];
+        self.globalComScoreLabelContext = [[SRGAnalyticsLabelContext alloc] initWithParentContext:nil labels:nil];
+        self.aggregator = [[SRGAnalyticsAggregator alloc] init];
+        self.bufferPool = [[SRGAnalyticsByteBufferPool alloc] initWithMaximumBufferCount:SRGAnalyticsEncodingBufferCount
+                                                                          bufferCapacity:SRGAnalyticsEncodingBufferCapacity];
+        
+        self.preStartBuffer = [[SRGAnalyticsPreStartBuffer alloc] initWithCapacity:SRGAnalyticsPreStartBufferCapacity];
+        
+        __weak __typeof(self) weakSelf = self;
+        self.eventQueue = [[SRGAnalyticsEventQueue alloc] initWithName:@"ch.srgssr.analytics.events" handler:^(NSArray<SRGAnalyticsEvent *> *events) {
+            [weakSelf processEvents:events];
+        }];
+    }
+    return self;
+}
+
+#pragma mark Getters and setters
+
+- (void)setGlobalLabels:(SRGAnalyticsLabels *)globalLabels
+{
+    _globalLabels = globalLabels.copy;
+    
+    self.globalLabelContext = [[SRGAnalyticsLabelContext alloc] initWithParentContext:nil labels:_globalLabels.labelsDictionary];
+    self.globalComScoreLabelContext = [[SRGAnalyticsLabelContext alloc] initWithParentContext:nil labels:_globalLabels.comScoreLabelsDictionary];
+}
+
 #pragma mark Startup
 
 - (void)startWithConfiguration:(SRGAnalyticsConfiguration *)configuration
@@ -72,10 +202,145 @@ void SRGAnalyticsRenewUnitTestingIdentifier(void)
         return;
     }
     
-    self.configuration = configuration;
+    SRGAnalyticsLaunchReportMeasureStep(SRGAnalyticsLaunchStepTrackerStart, ^{
+        self.configuration = configuration;
+        self.pageViewDeduplicator = [[SRGAnalyticsPageViewDeduplicator alloc] initWithDebounceInterval:configuration.pageViewDebounceInterval];
+        self.eventPolicy = [[SRGAnalyticsEventPolicy alloc] initWithConfiguration:configuration samplingSeed:SRGAnalyticsEventPolicy.userSamplingSeed];
+        
+        self.tagCommanderPermanentLabels = @{ @"app_library_version" : SRGAnalyticsMarketingVersion(),
+                                              @"navigation_app_site_name" : configuration.siteName,
+                                              @"navigation_environment" : configuration.environment,
+                                              @"navigation_device" : [self device] };
+        
+        NSUInteger captureBufferCapacity = configuration.captureBufferCapacity;
+        if (captureBufferCapacity == 0 && configuration.unitTesting) {
+            captureBufferCapacity = SRGAnalyticsUnitTestingCaptureBufferCapacity;
+        }
+        if (captureBufferCapacity != 0) {
+            self.captureSink = [[SRGAnalyticsCaptureSink alloc] initWithCapacity:captureBufferCapacity];
+        }
+        
+        if (configuration.collectorURL) {
+            self.collectorClient = [[SRGAnalyticsCollectorClient alloc] initWithBaseURL:configuration.collectorURL
+                                                                    maximumAttemptCount:SRGAnalyticsCollectorMaximumAttemptCount];
+            SRGAnalyticsLogInfo(@"tracker", @"Events will be sent to the collector at %@", configuration.collectorURL);
+        }
+        
+        self.sinkPipelines = [self sinkPipelinesWithConfiguration:configuration];
+        self.memoryBudget = [self memoryBudgetWithConfiguration:configuration];
+        
+        // comScore requests, whose labels are mostly added by the comScore SDK, can only be intercepted
+        if (configuration.unitTesting) {
+            SRGAnalyticsEnableRequestInterceptor();
+        }
+    });
+    
+    [self installHooks];
+    
+    if (configuration.startDeferred) {
+        [self performWhenIdle:^{
+            [self startServices];
+        }];
+    }
+    else {
+        [self startServices];
+    }
+}
+
+// Each sink is fed by its own pipeline, so that sinks do not delay each other
+- (NSArray<SRGAnalyticsSinkPipeline *> *)sinkPipelinesWithConfiguration:(SRGAnalyticsConfiguration *)configuration
+{
+    NSMutableArray<id<SRGAnalyticsSink>> *sinks = [NSMutableArray array];
+    if (self.collectorClient) {
+        [sinks addObject:[[SRGAnalyticsCollectorSink alloc] initWithCollectorClient:self.collectorClient
+                                                        tagCommanderPermanentLabels:self.tagCommanderPermanentLabels
+                                                                      batchInterval:configuration.collectorBatchInterval]];
+    }
+    else {
+        [sinks addObject:[[SRGAnalyticsTagCommanderSink alloc] initWithSite:configuration.site
+                                                                  container:configuration.container
+                                                            permanentLabels:self.tagCommanderPermanentLabels]];
+        [sinks addObject:[[SRGAnalyticsComScoreSink alloc] init]];
+    }
+    
+    if (self.captureSink) {
+        [sinks addObject:[[SRGAnalyticsCaptureEventSink alloc] initWithCaptureSink:self.captureSink
+                                                       tagCommanderPermanentLabels:self.tagCommanderPermanentLabels
+                                                         postsRequestNotifications:configuration.unitTesting]];
+    }
+    
+    NSMutableArray<SRGAnalyticsSinkPipeline *> *sinkPipelines = [NSMutableArray array];
+    for (id<SRGAnalyticsSink> sink in sinks) {
+        [sinkPipelines addObject:[[SRGAnalyticsSinkPipeline alloc] initWithSink:sink capacity:SRGAnalyticsSinkCapacity]];
+    }
+    return sinkPipelines.copy;
+}
+
+// Pending events are accounted for from the moment they are admitted until all sinks are done with them
+- (SRGAnalyticsMemoryBudget *)memoryBudgetWithConfiguration:(SRGAnalyticsConfiguration *)configuration
+{
+    SRGAnalyticsMemoryBudget *memoryBudget = [[SRGAnalyticsMemoryBudget alloc] initWithCapacity:configuration.pendingEventMemoryBudget
+                                                                                    dropPolicy:configuration.pendingEventDropPolicy];
+    memoryBudget.evictionHandler = ^(NSArray<SRGAnalyticsMemoryBudgetEntry *> *entries) {
+        for (SRGAnalyticsMemoryBudgetEntry *entry in entries) {
+            SRGAnalyticsMetricsRecordEvent(SRGAnalyticsMetricsEventTypeForEventType(entry.eventType), SRGAnalyticsMetricsOutcomeDropped);
+        }
+    };
+    
+    __weak __typeof(self) weakSelf = self;
+    memoryBudget.backpressureHandler = ^(BOOL underBackpressure) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [weakSelf notifyBackpressureChange];
+        });
+    };
+    return memoryBudget;
+}
+
+// Hooks are installed lazily so that loading the library has no cost. Each hook measures its own launch step
+- (void)installHooks
+{
+    UIViewController_SRGAnalyticsInstallHooks();
+    
+    for (NSString *className in SRGAnalyticsHookInstallingClassNames()) {
+        Class<SRGAnalyticsHookInstalling> hookInstallingClass = NSClassFromString(className);
+        if ([hookInstallingClass respondsToSelector:@selector(srg_installAnalyticsHooks)]) {
+            [hookInstallingClass srg_installAnalyticsHooks];
+        }
+    }
+}
+
+// Start vendor SDKs and periodic tasks. Must be called on the main thread
+- (void)startServices
+{
+    SRGAnalyticsLaunchReportMeasureStep(SRGAnalyticsLaunchStepServicesStart, ^{
+        [self startServicesWithConfiguration:self.configuration];
+    });
+}
+
+- (void)startServicesWithConfiguration:(SRGAnalyticsConfiguration *)configuration
+{
+    if (configuration.eventSummaryInterval > 0.) {
+        self.summaryTimer = [NSTimer scheduledTimerWithTimeInterval:configuration.eventSummaryInterval
+                                                             target:self
+                                                           selector:@selector(sendSummary:)
+                                                           userInfo:nil
+                                                            repeats:YES];
+    }
+    
+    if (configuration.hiddenEventAggregationInterval > 0.) {
+        self.aggregationTimer = [NSTimer scheduledTimerWithTimeInterval:configuration.hiddenEventAggregationInterval
+                                                                 target:self
+                                                               selector:@selector(sendAggregatedHiddenEvents:)
+                                                               userInfo:nil
+                                                                repeats:YES];
+    }
     
-    if (configuration.unitTesting) {
-        SRGAnalyticsEnableRequestInterceptor();
+    if (configuration.metricsNotificationInterval > 0.) {
+        self.metricsTimer = [NSTimer scheduledTimerWithTimeInterval:configuration.metricsNotificationInterval
+                                                             target:self
+                                                           selector:@selector(postMetrics:)
+                                                           userInfo:nil
+                                                            repeats:YES];
     }
     
     SCORPublisherConfiguration *publisherConfiguration = [SCORPublisherConfiguration publisherConfigurationWithBuilderBlock:^(SCORPublisherConfigurationBuilder *builder) {
@@ -100,7 +365,77 @@ void SRGAnalyticsRenewUnitTestingIdentifier(void)
     
     [SCORAnalytics start];
     
+    if (configuration.eventJournalEnabled) {
+        [self.eventQueue performBlock:^{
+            [self openJournal];
+        }];
+    }
+    
+    [NSNotificationCenter.defaultCenter addObserver:self
+                                           selector:@selector(applicationDidEnterBackground:)
+                                               name:UIApplicationDidEnterBackgroundNotification
+                                             object:nil];
+    [NSNotificationCenter.defaultCenter addObserver:self
+                                           selector:@selector(applicationWillTerminate:)
+                                               name:UIApplicationWillTerminateNotification
+                                             object:nil];
+    
     [self sendApplicationList];
+    
+    // Events emitted until now are processed first, in order
+    self.servicesStartTimestamp = NSDate.date.timeIntervalSince1970;
+    [self.preStartBuffer releaseWithBlock:^(NSArray<SRGAnalyticsEvent *> * _Nonnull events) {
+        for (SRGAnalyticsEvent *event in events) {
+            if (event.filteringDeferred && ! [self shouldAdmitDeferredEvent:event]) {
+                SRGAnalyticsMetricsRecordEvent(SRGAnalyticsMetricsEventTypeForEventType(event.type), SRGAnalyticsMetricsOutcomeDropped);
+                continue;
+            }
+            [self admitEvent:event];
+        }
+        if (events.count != 0) {
+            SRGAnalyticsLogInfo(@"tracker", @"%@ events emitted before the tracker started are sent", @(events.count));
+        }
+    }];
+    
+    NSUInteger droppedCount = self.preStartBuffer.droppedCount;
+    if (droppedCount != 0) {
+        SRGAnalyticsLogWarning(@"tracker", @"%@ events emitted before the tracker started were dropped", @(droppedCount));
+    }
+}
+
+// Apply the filtering skipped when an event was emitted before the configuration was known
+- (BOOL)shouldAdmitDeferredEvent:(SRGAnalyticsEvent *)event
+{
+    switch (event.type) {
+        case SRGAnalyticsEventTypePageView: {
+            if (! [self.pageViewDeduplicator shouldTrackPageViewWithTitle:event.name levels:event.levels labels:event.labels fromPushNotification:event.fromPushNotification]) {
+                SRGAnalyticsLogDebug(@"tracker", @"Page view %@ tracked again within the debounce interval. Ignored", event.name);
+                return NO;
+            }
+            return [self.eventPolicy decisionForPageView] == SRGAnalyticsEventDecisionAccept;
+            break;
+        }
+            
+        case SRGAnalyticsEventTypeHiddenEvent: {
+            return [self.eventPolicy decisionForHiddenEventWithName:event.name] == SRGAnalyticsEventDecisionAccept;
+            break;
+        }
+            
+        default: {
+            return YES;
+            break;
+        }
+    }
+}
+
+// Perform a block once, during the next idle cycle of the main run loop
+- (void)performWhenIdle:(void (^)(void))block
+{
+    CFRunLoopObserverRef observer = CFRunLoopObserverCreateWithHandler(NULL, kCFRunLoopBeforeWaiting, false, 0, ^(CFRunLoopObserverRef observer, CFRunLoopActivity activity) {
+        block();
+    });
+    CFRunLoopAddObserver(CFRunLoopGetMain(), observer, kCFRunLoopDefaultMode);
+    CFRelease(observer);
 }
 
 #pragma mark Labels
@@ -113,31 +448,9 @@ void SRGAnalyticsRenewUnitTestingIdentifier(void)
     return labels.copy;
 }
 
-- (NSDictionary *)defaultComScoreLabels
+// The category is the one sent as `ns_category`, computed from levels
+- (NSString *)pageIdWithTitle:(NSString *)title category:(NSString *)category
 {
-    return self.globalLabels.comScoreLabelsDictionary.mutableCopy ?: [NSMutableDictionary dictionary];
-}
-
-- (NSDictionary *)defaultLabels
-{
-    return self.globalLabels.labelsDictionary.mutableCopy ?: [NSMutableDictionary dictionary];
-}
-
-- (NSString *)pageIdWithTitle:(NSString *)title levels:(NSArray<NSString *> *)levels
-{
-    NSString *category = @"app";
-    
-    if (levels.count > 0) {
-        __block NSMutableString *levelsComScoreFormattedString = [NSMutableString new];
-        [levels enumerateObjectsUsingBlock:^(NSString * _Nonnull level, NSUInteger idx, BOOL * _Nonnull stop) {
-            if (levelsComScoreFormattedString.length > 0) {
-                [levelsComScoreFormattedString appendString:@"."];
-            }
-            [levelsComScoreFormattedString appendString:level.srg_comScoreFormattedString];
-        }];
-        category = levelsComScoreFormattedString.copy;
-    }
-    
     return [NSString stringWithFormat:@"%@.%@", category, title.srg_comScoreFormattedString];
 }
 
@@ -159,26 +472,54 @@ void SRGAnalyticsRenewUnitTestingIdentifier(void)
 
 #pragma mark General event tracking (internal use only)
 
-- (void)trackTagCommanderEventWithLabels:(NSDictionary<NSString *, NSString *> *)labels
+- (void)trackTagCommanderEventWithRecord:(SRGAnalyticsEventRecord *)record
+                           sessionLabels:(NSDictionary<NSString *, NSString *> *)sessionLabels
+                       sessionIdentifier:(NSUInteger)sessionIdentifier
+                   unitTestingIdentifier:(NSString *)unitTestingIdentifier
 {
-    if ( ! self.tagCommander) {
-        SRGAnalyticsConfiguration *configuration = self.configuration;
-        NSAssert(configuration != nil, @"The tracker must be started");
-        
-        self.tagCommander = [[TagCommander alloc] initWithSiteID:(int)configuration.site andContainerID:(int)configuration.container];
-        [self.tagCommander enableRunningInBackground];
-        [self.tagCommander addPermanentData:@"app_library_version" withValue:SRGAnalyticsMarketingVersion()];
-        [self.tagCommander addPermanentData:@"navigation_app_site_name" withValue:configuration.siteName];
-        [self.tagCommander addPermanentData:@"navigation_environment" withValue:configuration.environment];
-        [self.tagCommander addPermanentData:@"navigation_device" withValue:[self device]];
-    }
-    
-    NSMutableDictionary<NSString *, NSString *> *fullLabels = [self defaultLabels].mutableCopy;
-    [fullLabels addEntriesFromDictionary:labels];
-    [fullLabels enumerateKeysAndObjectsUsingBlock:^(NSString * _Nonnull key, NSString * _Nonnull object, BOOL * _Nonnull stop) {
-        [self.tagCommander addData:key withValue:object];
-    }];
-    [self.tagCommander sendData];
+    [self enqueueEvent:[SRGAnalyticsEvent recordEventWithRecord:record
+                                                  sessionLabels:sessionLabels
+                                              sessionIdentifier:sessionIdentifier
+                                          unitTestingIdentifier:unitTestingIdentifier]];
+}
+
+#pragma mark Event enqueuing
+
+// Events are buffered until services have been started. Buffered events are counted once released
+- (void)enqueueEvent:(SRGAnalyticsEvent *)event
+{
+    switch ([self.preStartBuffer bufferEvent:event]) {
+        case SRGAnalyticsPreStartBufferOutcomeReleased: {
+            [self admitEvent:event];
+            break;
+        }
+            
+        case SRGAnalyticsPreStartBufferOutcomeDropped: {
+            SRGAnalyticsMetricsRecordEvent(SRGAnalyticsMetricsEventTypeForEventType(event.type), SRGAnalyticsMetricsOutcomeDropped);
+            break;
+        }
+            
+        default: {
+            break;
+        }
+    }
+}
+
+// Events are enqueued (and counted as accepted) only if they fit within the pending event memory budget, possibly
+// evicting other pending events
+- (void)admitEvent:(SRGAnalyticsEvent *)event
+{
+    SRGAnalyticsMemoryBudgetEntry *budgetEntry = [self.memoryBudget admitEntryWithByteCount:event.byteCount
+                                                                                   priority:event.priority
+                                                                                  eventType:event.type];
+    if (! budgetEntry) {
+        SRGAnalyticsMetricsRecordEvent(SRGAnalyticsMetricsEventTypeForEventType(event.type), SRGAnalyticsMetricsOutcomeDropped);
+        return;
+    }
+    
+    SRGAnalyticsMetricsRecordEvent(SRGAnalyticsMetricsEventTypeForEventType(event.type), SRGAnalyticsMetricsOutcomeAccepted);
+    event.budgetEntry = budgetEntry;
+    [self.eventQueue enqueueEvent:event];
 }
 
 #pragma mark Page view tracking
@@ -203,43 +544,248 @@ void SRGAnalyticsRenewUnitTestingIdentifier(void)
         ignoreApplicationState:(BOOL)ignoreApplicationState;
 
 {
-    if (! self.configuration) {
-        SRGAnalyticsLogWarning(@"tracker", @"The tracker has not been started yet");
+    if (title.length == 0 || (! ignoreApplicationState && UIApplication.sharedApplication.applicationState == UIApplicationStateBackground)) {
         return;
     }
     
-    if (title.length == 0 || (! ignoreApplicationState && UIApplication.sharedApplication.applicationState == UIApplicationStateBackground)) {
+    // Page views emitted before the configuration is known are filtered when released
+    if (self.configuration) {
+        if (! [self.pageViewDeduplicator shouldTrackPageViewWithTitle:title levels:levels labels:labels fromPushNotification:fromPushNotification]) {
+            SRGAnalyticsLogDebug(@"tracker", @"Page view %@ tracked again within the debounce interval. Ignored", title);
+            SRGAnalyticsMetricsRecordEvent(SRGAnalyticsMetricsEventTypePageView, SRGAnalyticsMetricsOutcomeDropped);
+            return;
+        }
+        
+        if ([self.eventPolicy decisionForPageView] != SRGAnalyticsEventDecisionAccept) {
+            SRGAnalyticsMetricsRecordEvent(SRGAnalyticsMetricsEventTypePageView, SRGAnalyticsMetricsOutcomeDropped);
+            return;
+        }
+    }
+    
+    SRGAnalyticsEvent *event = [SRGAnalyticsEvent pageViewEventWithTitle:title levels:levels labels:labels fromPushNotification:fromPushNotification];
+    event.filteringDeferred = ! self.configuration;
+    [self enqueueEvent:event];
+}
+
+#pragma mark Hidden event tracking
+
+- (void)trackHiddenEventWithName:(NSString *)name
+{
+    [self trackHiddenEventWithName:name labels:nil];
+}
+
+- (void)trackHiddenEventWithName:(NSString *)name
+                          labels:(SRGAnalyticsHiddenEventLabels *)labels
+{
+    if (name.length == 0) {
+        SRGAnalyticsLogWarning(@"tracker", @"Missing name. No event will be sent");
         return;
     }
     
-    [self trackTagCommanderPageViewWithTitle:title levels:levels labels:labels fromPushNotification:fromPushNotification];
-    [self trackComScorePageViewWithTitle:title levels:levels labels:labels fromPushNotification:fromPushNotification];
+    // Hidden events emitted before the configuration is known are filtered when released
+    if (self.configuration && [self.eventPolicy decisionForHiddenEventWithName:name] != SRGAnalyticsEventDecisionAccept) {
+        SRGAnalyticsMetricsRecordEvent(SRGAnalyticsMetricsEventTypeHiddenEvent, SRGAnalyticsMetricsOutcomeDropped);
+        return;
+    }
+    
+    SRGAnalyticsEvent *event = [SRGAnalyticsEvent hiddenEventWithName:name labels:labels];
+    event.filteringDeferred = ! self.configuration;
+    [self enqueueEvent:event];
+}
+
+#pragma mark Hidden event aggregation
+
+- (void)aggregateHiddenEventWithName:(NSString *)name dimensions:(NSDictionary<NSString *, NSString *> *)dimensions
+{
+    if (name.length == 0) {
+        SRGAnalyticsLogWarning(@"tracker", @"Missing name. The occurrence will be ignored");
+        return;
+    }
+    
+    [self.aggregator addOccurrenceWithName:name dimensions:dimensions];
+}
+
+- (void)aggregateHiddenEventWithName:(NSString *)name dimensions:(NSDictionary<NSString *, NSString *> *)dimensions value:(double)value
+{
+    if (name.length == 0) {
+        SRGAnalyticsLogWarning(@"tracker", @"Missing name. The occurrence will be ignored");
+        return;
+    }
+    
+    [self.aggregator addOccurrenceWithName:name dimensions:dimensions value:value];
+}
+
+- (void)flushAggregatedHiddenEvents
+{
+    for (SRGAnalyticsAggregate *aggregate in [self.aggregator takeAggregates]) {
+        SRGAnalyticsHiddenEventLabels *labels = [[SRGAnalyticsHiddenEventLabels alloc] init];
+        labels.customInfo = aggregate.labelsDictionary;
+        [self trackHiddenEventWithName:aggregate.name labels:labels];
+    }
+}
+
+- (void)sendAggregatedHiddenEvents:(NSTimer *)timer
+{
+    [self flushAggregatedHiddenEvents];
+}
+
+#pragma mark Event policy summary
+
+- (void)sendSummary:(NSTimer *)timer
+{
+    SRGAnalyticsEventPolicyCounts counts = [self.eventPolicy takeCounts];
+    NSUInteger memoryDroppedCount = [self.memoryBudget takeDroppedCount];
+    if (counts.sampledOutCount == 0 && counts.rateLimitedCount == 0 && memoryDroppedCount == 0) {
+        return;
+    }
+    
+    // Sent directly, bypassing the policy it reports about
+    SRGAnalyticsHiddenEventLabels *labels = [[SRGAnalyticsHiddenEventLabels alloc] init];
+    labels.customInfo = @{ @"srg_sampled_out_count" : @(counts.sampledOutCount).stringValue,
+                           @"srg_rate_limited_count" : @(counts.rateLimitedCount).stringValue,
+                           @"srg_memory_dropped_count" : @(memoryDroppedCount).stringValue };
+    [self enqueueEvent:[SRGAnalyticsEvent measurementEventWithName:SRGAnalyticsSummaryEventName labels:labels]];
+}
+
+#pragma mark Metrics
+
+- (SRGAnalyticsMetrics *)metrics
+{
+    return SRGAnalyticsMetricsSnapshot(self.eventQueue.pendingCount + self.preStartBuffer.count, self.memoryBudget.byteCount);
+}
+
+- (SRGAnalyticsLaunchReport *)launchReport
+{
+    return SRGAnalyticsLaunchReportSnapshot();
+}
+
+- (void)postMetrics:(NSTimer *)timer
+{
+    [NSNotificationCenter.defaultCenter postNotificationName:SRGAnalyticsMetricsNotification
+                                                      object:self
+                                                    userInfo:@{ SRGAnalyticsMetricsKey : self.metrics }];
+}
+
+#pragma mark Backpressure
+
+- (BOOL)isUnderBackpressure
+{
+    return self.memoryBudget.underBackpressure;
 }
 
-- (void)trackComScorePageViewWithTitle:(NSString *)title
-                                levels:(NSArray<NSString *> *)levels
-                                labels:(SRGAnalyticsPageViewLabels *)labels
-                  fromPushNotification:(BOOL)fromPushNotification
+// Changes can be reported from several threads. Only notify the current state if it differs from the last notified one
+- (void)notifyBackpressureChange
+{
+    BOOL underBackpressure = self.underBackpressure;
+    if (underBackpressure == self.notifiedUnderBackpressure) {
+        return;
+    }
+    
+    self.notifiedUnderBackpressure = underBackpressure;
+    if (underBackpressure) {
+        SRGAnalyticsLogWarning(@"tracker", @"Pending events exceed their memory budget. Events are being dropped");
+    }
+    [NSNotificationCenter.defaultCenter postNotificationName:SRGAnalyticsBackpressureDidChangeNotification
+                                                      object:self
+                                                    userInfo:@{ SRGAnalyticsUnderBackpressureKey : @(underBackpressure) }];
+}
+
+#pragma mark Event processing (on the event queue worker)
+
+- (void)processEvents:(NSArray<SRGAnalyticsEvent *> *)events
 {
+    BOOL flushesSinks = NO;
+    for (SRGAnalyticsEvent *event in events) {
+        // Events evicted under memory pressure are neither built nor delivered
+        SRGAnalyticsMemoryBudgetEntry *budgetEntry = event.budgetEntry;
+        if (budgetEntry.evicted) {
+            continue;
+        }
+        
+        self.eventProcessingStartTime = SRGAnalyticsMonotonicTime();
+        self.bufferedEventTimestamp = (event.timestamp < self.servicesStartTimestamp) ? event.timestamp : 0.;
+        
+        switch (event.type) {
+            case SRGAnalyticsEventTypePageView: {
+                [self dispatchTagCommanderContext:[self tagCommanderLabelContextForPageViewEvent:event]
+                                  comScoreContext:[self comScoreLabelContextForPageViewEvent:event]
+                                         forEvent:event];
+                SRGAnalyticsMetricsRecordEvent(SRGAnalyticsMetricsEventTypePageView, SRGAnalyticsMetricsOutcomeSent);
+                break;
+            }
+                
+            case SRGAnalyticsEventTypeHiddenEvent: {
+                [self dispatchTagCommanderContext:[self tagCommanderLabelContextForHiddenEvent:event] comScoreContext:nil forEvent:event];
+                SRGAnalyticsMetricsRecordEvent(SRGAnalyticsMetricsEventTypeHiddenEvent, SRGAnalyticsMetricsOutcomeSent);
+                break;
+            }
+                
+            case SRGAnalyticsEventTypeRecord: {
+                [self dispatchTagCommanderContext:[self tagCommanderLabelContextForRecordEvent:event] comScoreContext:nil forEvent:event];
+                SRGAnalyticsMetricsRecordEvent(SRGAnalyticsMetricsEventTypeMedia, SRGAnalyticsMetricsOutcomeSent);
+                break;
+            }
+                
+            default: {
+                break;
+            }
+        }
+        
+        // Sinks have become consumers of the event, if accepted
+        [budgetEntry removeConsumer];
+        
+        flushesSinks = flushesSinks || SRGAnalyticsEventLanePolicyForLane(event.lane).flushesSinks;
+    }
+    
+    // Events buffered by sinks go out along with important events
+    if (flushesSinks) {
+        for (SRGAnalyticsSinkPipeline *sinkPipeline in self.sinkPipelines) {
+            [sinkPipeline flushWithCompletionBlock:nil];
+        }
+    }
+}
+
+// Layer event-specific labels on top of some base context. Records and label dictionaries are shared, not copied.
+- (SRGAnalyticsLabelContext *)labelContextWithBaseContext:(SRGAnalyticsLabelContext *)baseContext
+                                              eventRecord:(SRGAnalyticsEventRecord *)eventRecord
+                                             customLabels:(NSDictionary<NSString *, NSString *> *)customLabels
+                                    unitTestingIdentifier:(NSString *)unitTestingIdentifier
+{
+    SRGAnalyticsLabelContext *eventContext = [[SRGAnalyticsLabelContext alloc] initWithParentContext:baseContext record:eventRecord];
+    SRGAnalyticsLabelContext *context = [[SRGAnalyticsLabelContext alloc] initWithParentContext:eventContext labels:customLabels];
+    if (unitTestingIdentifier) {
+        [context setLabel:unitTestingIdentifier forKey:@"srg_test_id"];
+    }
+    
+    // Events buffered before the tracker started carry their original time (in milliseconds since 1970)
+    if (self.bufferedEventTimestamp != 0.) {
+        [context setLabel:@((int64_t)(self.bufferedEventTimestamp * 1000.)).stringValue forKey:@"srg_event_timestamp"];
+    }
+    return context;
+}
+
+- (SRGAnalyticsLabelContext *)comScoreLabelContextForPageViewEvent:(SRGAnalyticsEvent *)event
+{
+    NSString *title = event.name;
+    NSArray<NSString *> *levels = event.levels;
     NSAssert(title.length != 0, @"A title is required");
     
-    NSMutableDictionary<NSString *, NSString *> *fullLabels = [self defaultComScoreLabels].mutableCopy;
-    [fullLabels srg_safelySetString:title forKey:@"srg_title"];
-    [fullLabels srg_safelySetString:@(fromPushNotification).stringValue forKey:@"srg_ap_push"];
+    SRGAnalyticsEventRecord *record = [[SRGAnalyticsEventRecord alloc] init];
+    [record setSrgTitle:title];
+    [record setSrgApPush:event.fromPushNotification];
     
     NSString *category = @"app";
     
     if (! levels) {
-        [fullLabels srg_safelySetString:category forKey:@"srg_n1"];
+        [record setSrgN:category atIndex:0];
     }
     else if (levels.count > 0) {
         __block NSMutableString *levelsComScoreFormattedString = [NSMutableString new];
         [levels enumerateObjectsUsingBlock:^(NSString * _Nonnull object, NSUInteger idx, BOOL * _Nonnull stop) {
-            NSString *levelKey = [NSString stringWithFormat:@"srg_n%@", @(idx + 1)];
             NSString *levelValue = [object description];
             
-            if (idx < 10) {
-                [fullLabels srg_safelySetString:levelValue forKey:levelKey];
+            if (idx < SRGAnalyticsLabelSrgNCount) {
+                [record setSrgN:levelValue atIndex:idx];
             }
             
             if (levelsComScoreFormattedString.length > 0) {
@@ -251,99 +797,207 @@ void SRGAnalyticsRenewUnitTestingIdentifier(void)
         category = levelsComScoreFormattedString.copy;
     }
     
-    [fullLabels srg_safelySetString:category forKey:@"ns_category"];
-    [fullLabels srg_safelySetString:[self pageIdWithTitle:title levels:levels] forKey:@"name"];
-    
-    NSDictionary<NSString *, NSString *> *comScoreLabelsDictionary = [labels comScoreLabelsDictionary];
-    if (comScoreLabelsDictionary) {
-        [fullLabels addEntriesFromDictionary:comScoreLabelsDictionary];
-    }
-    
-    if (self.configuration.unitTesting) {
-        fullLabels[@"srg_test_id"] = SRGAnalyticsUnitTestingIdentifier();
-    }
+    [record setNsCategory:category];
+    [record setName:[self pageIdWithTitle:title category:category]];
     
-    [SCORAnalytics notifyViewEventWithLabels:fullLabels.copy];
+    return [self labelContextWithBaseContext:self.globalComScoreLabelContext
+                                 eventRecord:record
+                                customLabels:[event.labels comScoreLabelsDictionary]
+                       unitTestingIdentifier:event.unitTestingIdentifier];
 }
 
-- (void)trackTagCommanderPageViewWithTitle:(NSString *)title
-                                    levels:(NSArray<NSString *> *)levels
-                                    labels:(SRGAnalyticsPageViewLabels *)labels
-                      fromPushNotification:(BOOL)fromPushNotification
+- (SRGAnalyticsLabelContext *)tagCommanderLabelContextForPageViewEvent:(SRGAnalyticsEvent *)event
 {
+    NSString *title = event.name;
     NSAssert(title.length != 0, @"A title is required");
     
-    NSMutableDictionary<NSString *, NSString *> *fullLabels = [NSMutableDictionary dictionary];
-    [fullLabels srg_safelySetString:@"screen" forKey:@"event_id"];
-    [fullLabels srg_safelySetString:@"app" forKey:@"navigation_property_type"];
-    [fullLabels srg_safelySetString:title forKey:@"content_title"];
-    [fullLabels srg_safelySetString:self.configuration.businessUnitIdentifier.uppercaseString forKey:@"navigation_bu_distributer"];
-    [fullLabels srg_safelySetString:fromPushNotification ? @"true" : @"false" forKey:@"accessed_after_push_notification"];
+    SRGAnalyticsEventRecord *record = [[SRGAnalyticsEventRecord alloc] init];
+    [record setEventId:@"screen"];
+    [record setNavigationPropertyType:@"app"];
+    [record setContentTitle:title];
+    [record setNavigationBuDistributer:self.configuration.businessUnitIdentifier.uppercaseString];
+    [record setAccessedAfterPushNotification:event.fromPushNotification];
     
-    [levels enumerateObjectsUsingBlock:^(NSString * _Nonnull object, NSUInteger idx, BOOL * _Nonnull stop) {
-        if (idx > 7) {
+    [event.levels enumerateObjectsUsingBlock:^(NSString * _Nonnull object, NSUInteger idx, BOOL * _Nonnull stop) {
+        if (idx >= SRGAnalyticsLabelNavigationLevelCount) {
             *stop = YES;
             return;
         }
         
-        NSString *levelKey = [NSString stringWithFormat:@"navigation_level_%@", @(idx + 1)];
-        [fullLabels srg_safelySetString:object forKey:levelKey];
+        [record setNavigationLevel:object atIndex:idx];
     }];
     
-    NSDictionary<NSString *, NSString *> *labelsDictionary = [labels labelsDictionary];
-    if (labelsDictionary) {
-        [fullLabels addEntriesFromDictionary:labelsDictionary];
-    }
+    return [self labelContextWithBaseContext:self.globalLabelContext
+                                 eventRecord:record
+                                customLabels:[event.labels labelsDictionary]
+                       unitTestingIdentifier:event.unitTestingIdentifier];
+}
+
+- (SRGAnalyticsLabelContext *)tagCommanderLabelContextForHiddenEvent:(SRGAnalyticsEvent *)event
+{
+    NSString *name = event.name;
+    NSAssert(name.length != 0, @"A name is required");
     
-    if (self.configuration.unitTesting) {
-        fullLabels[@"srg_test_id"] = SRGAnalyticsUnitTestingIdentifier();
-    }
+    SRGAnalyticsEventRecord *record = [[SRGAnalyticsEventRecord alloc] init];
+    [record setEventId:@"hidden_event"];
+    [record setEventName:name];
     
-    [self trackTagCommanderEventWithLabels:fullLabels.copy];
+    return [self labelContextWithBaseContext:self.globalLabelContext
+                                 eventRecord:record
+                                customLabels:[event.labels labelsDictionary]
+                       unitTestingIdentifier:event.unitTestingIdentifier];
 }
 
-#pragma mark Hidden event tracking
-
-- (void)trackHiddenEventWithName:(NSString *)name
+- (SRGAnalyticsLabelContext *)tagCommanderLabelContextForRecordEvent:(SRGAnalyticsEvent *)event
 {
-    [self trackHiddenEventWithName:name labels:nil];
+    return [self labelContextWithBaseContext:self.globalLabelContext
+                                 eventRecord:event.record
+                                customLabels:event.sessionLabels
+                       unitTestingIdentifier:event.unitTestingIdentifier];
 }
 
-- (void)trackHiddenEventWithName:(NSString *)name
-                          labels:(SRGAnalyticsHiddenEventLabels *)labels
+// Journal TagCommander labels, then fan a single event out to all sinks
+- (void)dispatchTagCommanderContext:(SRGAnalyticsLabelContext *)tagCommanderContext
+                    comScoreContext:(SRGAnalyticsLabelContext *)comScoreContext
+                           forEvent:(SRGAnalyticsEvent *)sourceEvent
 {
-    if (! self.configuration) {
-        SRGAnalyticsLogWarning(@"tracker", @"The tracker has not been started yet");
-        return;
-    }
+    NSAssert(self.eventQueue.currentQueue, @"Events must be dispatched from the event queue worker");
     
-    if (name.length == 0) {
-        SRGAnalyticsLogWarning(@"tracker", @"Missing name. No event will be sent");
-        return;
+    uint64_t labelBuildingEndTime = SRGAnalyticsMonotonicTime();
+    SRGAnalyticsMetricsRecordLatency(SRGAnalyticsMetricsLatencyLabelBuilding, labelBuildingEndTime - self.eventProcessingStartTime);
+    
+    // Labels are encoded straight into the journal format, without intermediate dictionary
+    SRGAnalyticsSinkDeliveryHandler deliveryHandler = sourceEvent.deliveryHandler;
+    if (self.journal) {
+        SRGAnalyticsByteBuffer *buffer = [self.bufferPool dequeueBuffer];
+        SRGAnalyticsEncodeLabelContext(tagCommanderContext, SRGAnalyticsEncodingFormatJSON, buffer);
+        SRGAnalyticsMetricsRecordLatency(SRGAnalyticsMetricsLatencyEncoding, SRGAnalyticsMonotonicTime() - labelBuildingEndTime);
+        
+        uint64_t sequence = [self.journal appendRecordWithBytes:buffer.bytes length:buffer.length];
+        [self.bufferPool recycleBuffer:buffer];
+        
+        if (sequence != 0) {
+            SRGAnalyticsSinkDeliveryHandler eventDeliveryHandler = deliveryHandler;
+            deliveryHandler = ^{
+                [self.eventQueue performBlock:^{
+                    [self.journal markRecordAsDelivered:sequence];
+                }];
+                eventDeliveryHandler ? eventDeliveryHandler() : nil;
+            };
+        }
     }
     
-    [self trackTagCommanderHiddenEventWithName:name labels:labels];
+    SRGAnalyticsSinkEvent *event = [[SRGAnalyticsSinkEvent alloc] initWithTagCommanderContext:tagCommanderContext
+                                                                              comScoreContext:comScoreContext
+                                                                                     replayed:NO
+                                                                              deliveryHandler:deliveryHandler];
+    event.budgetEntry = sourceEvent.budgetEntry;
+    event.lane = sourceEvent.lane;
+    [self fanOutEvent:event];
 }
 
-- (void)trackTagCommanderHiddenEventWithName:(NSString *)name labels:(SRGAnalyticsHiddenEventLabels *)labels
+// Return `YES` iff the event was accepted by the pipeline of the sink delivering TagCommander events (the first one)
+- (BOOL)fanOutEvent:(SRGAnalyticsSinkEvent *)event
 {
-    NSAssert(name.length != 0, @"A name is required");
-    NSAssert(self.configuration != nil, @"The tracker must be started");
-    
-    NSMutableDictionary<NSString *, NSString *> *fullLabels = [NSMutableDictionary dictionary];
-    [fullLabels srg_safelySetString:@"hidden_event" forKey:@"event_id"];
-    [fullLabels srg_safelySetString:name forKey:@"event_name"];
+    BOOL accepted = NO;
+    for (SRGAnalyticsSinkPipeline *sinkPipeline in self.sinkPipelines) {
+        BOOL enqueued = [sinkPipeline enqueueEvent:event];
+        if (sinkPipeline == self.sinkPipelines.firstObject) {
+            accepted = enqueued;
+        }
+    }
+    return accepted;
+}
+
+#pragma mark Journal (on the event queue worker)
+
+- (void)openJournal
+{
+#if TARGET_OS_TV
+    NSSearchPathDirectory directory = NSCachesDirectory;
+#else
+    NSSearchPathDirectory directory = NSApplicationSupportDirectory;
+#endif
+    NSURL *baseURL = [NSFileManager.defaultManager URLsForDirectory:directory inDomains:NSUserDomainMask].firstObject;
+    NSURL *directoryURL = [baseURL URLByAppendingPathComponent:@"ch.srgssr.analytics/journal" isDirectory:YES];
+    self.journal = [[SRGAnalyticsJournal alloc] initWithDirectoryURL:directoryURL
+                                                         segmentSize:SRGAnalyticsJournalSegmentSize
+                                                 maximumSegmentCount:SRGAnalyticsJournalMaximumSegmentCount];
     
-    NSDictionary<NSString *, NSString *> *labelsDictionary = [labels labelsDictionary];
-    if (labelsDictionary) {
-        [fullLabels addEntriesFromDictionary:labelsDictionary];
+    [self replayJournal];
+}
+
+// Replay events which could not be delivered during previous sessions. Records are flagged as delivered only once
+// delivered by the sink, and are replayed in chunks fitting in sink pipelines, the next chunk being replayed once the
+// previous one has been consumed
+- (void)replayJournal
+{
+    NSUInteger replayedCount = [self.journal replayRecordsWithMaximumCount:SRGAnalyticsJournalReplayChunkSize block:^BOOL(NSData *data, uint64_t sequence) {
+        id JSONObject = [NSJSONSerialization JSONObjectWithData:data options:0 error:NULL];
+        if (! [JSONObject isKindOfClass:NSDictionary.class]) {
+            [self.journal markRecordAsDelivered:sequence];
+            return YES;
+        }
+        
+        SRGAnalyticsLabelContext *context = [[SRGAnalyticsLabelContext alloc] initWithParentContext:nil labels:JSONObject];
+        SRGAnalyticsSinkEvent *event = [[SRGAnalyticsSinkEvent alloc] initWithTagCommanderContext:context
+                                                                                  comScoreContext:nil
+                                                                                         replayed:YES
+                                                                                  deliveryHandler:^{
+            [self.eventQueue performBlock:^{
+                [self.journal markRecordAsDelivered:sequence];
+            }];
+        }];
+        event.lane = SRGAnalyticsEventLaneBackground;
+        return [self fanOutEvent:event];
+    }];
+    if (replayedCount != 0) {
+        SRGAnalyticsLogInfo(@"tracker", @"%@ events from previous sessions were replayed", @(replayedCount));
     }
     
-    if (self.configuration.unitTesting) {
-        fullLabels[@"srg_test_id"] = SRGAnalyticsUnitTestingIdentifier();
+    if (! self.journal.replayCompleted) {
+        [self.sinkPipelines.firstObject performBlock:^{
+            [self.eventQueue performBlock:^{
+                [self replayJournal];
+            }];
+        }];
+    }
+}
+
+#pragma mark Event delivery
+
+- (void)flushWithCompletionHandler:(void (^)(void))completionHandler
+{
+    // Events are handed over to sinks on the event queue worker, after which sinks are flushed
+    [self.eventQueue performBlock:^{
+        dispatch_group_t group = dispatch_group_create();
+        for (SRGAnalyticsSinkPipeline *sinkPipeline in self.sinkPipelines) {
+            dispatch_group_enter(group);
+            [sinkPipeline flushWithCompletionBlock:^{
+                dispatch_group_leave(group);
+            }];
+        }
+        dispatch_group_notify(group, dispatch_get_main_queue(), ^{
+            completionHandler ? completionHandler() : nil;
+        });
+    }];
+}
+
+- (BOOL)drainWithTimeout:(NSTimeInterval)timeout
+{
+    dispatch_time_t deadline = dispatch_time(DISPATCH_TIME_NOW, (int64_t)(timeout * NSEC_PER_SEC));
+    if (! [self.eventQueue drainWithTimeout:timeout]) {
+        return NO;
     }
     
-    [self trackTagCommanderEventWithLabels:fullLabels.copy];
+    dispatch_group_t group = dispatch_group_create();
+    for (SRGAnalyticsSinkPipeline *sinkPipeline in self.sinkPipelines) {
+        dispatch_group_enter(group);
+        [sinkPipeline flushWithCompletionBlock:^{
+            dispatch_group_leave(group);
+        }];
+    }
+    return dispatch_group_wait(group, deadline) == 0;
 }
 
 #pragma mark Application list measurement
@@ -354,11 +1008,29 @@ void SRGAnalyticsRenewUnitTestingIdentifier(void)
     //
     // Specifications are available at: https://confluence.srg.beecollaboration.com/display/INTFORSCHUNG/App+Overlapping+Measurement
     //
-    // This measurement is not critical and is therefore performed only once the tracker starts. If it fails for some reason
-    // (no network, for example), the measurement will be attempted again the next time the application is started
-    NSURL *applicationListURL = [NSURL URLWithString:@"https://pastebin.com/raw/RnZYEWCA"];
-    [[[NSURLSession sharedSession] dataTaskWithURL:applicationListURL completionHandler:^(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error) {
-        if (error) {
+    // This measurement is not critical and therefore kept off the launch path: the list is cached on disk, the cache
+    // being loaded and probing performed when the main run loop is idle, some time after the tracker has started. If
+    // it fails for some reason (no network, for example), the measurement will be attempted again the next time the
+    // application is started. The result is only sent when installed applications have changed, or after some time
+    // has passed.
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(SRGAnalyticsApplicationListMeasurementDelay * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        [self performWhenIdle:^{
+            if (! self.applicationListCache) {
+                NSURL *applicationListURL = self.collectorClient.applicationListURL ?: [NSURL URLWithString:@"https://pastebin.com/raw/RnZYEWCA"];
+                NSURL *cachesDirectoryURL = [NSFileManager.defaultManager URLsForDirectory:NSCachesDirectory inDomains:NSUserDomainMask].firstObject;
+                self.applicationListCache = [[SRGAnalyticsApplicationListCache alloc] initWithURL:applicationListURL
+                                                                                     directoryURL:[cachesDirectoryURL URLByAppendingPathComponent:@"ch.srgssr.analytics/applications" isDirectory:YES]
+                                                                                       timeToLive:SRGAnalyticsApplicationListTimeToLive];
+            }
+            [self measureInstalledApplications];
+        }];
+    });
+}
+
+- (void)measureInstalledApplications
+{
+    [self.applicationListCache retrieveListWithSession:NSURLSession.sharedSession completionHandler:^(NSData * _Nullable data, NSError * _Nullable error) {
+        if (! data) {
             SRGAnalyticsLogError(@"tracker", @"The application list could not be retrieved. Reason: %@", error);
             return;
         }
@@ -371,54 +1043,100 @@ void SRGAnalyticsRenewUnitTestingIdentifier(void)
         }
         NSArray<NSDictionary *> *applicationDictionaries = JSONObject;
         
-        // -canOpenURL: should only be called from the main thread
-        dispatch_async(dispatch_get_main_queue(), ^{
-            // Extract URL schemes and installed applications
-            NSMutableSet<NSString *> *URLSchemes = [NSMutableSet set];
-            NSMutableSet<NSString *> *installedApplications = [NSMutableSet set];
-            for (NSDictionary *applicationDictionary in applicationDictionaries) {
-                NSString *application = applicationDictionary[@"code"];
-                NSString *URLScheme = applicationDictionary[@"ios"];
-                
-                if (URLScheme.length == 0 || ! application) {
-                    SRGAnalyticsLogInfo(@"tracker", @"URL scheme or application name missing in %@. Skipped", applicationDictionary);
-                    continue;
-                }
-                
-                [URLSchemes addObject:URLScheme];
-                
-                NSString *URLString = [NSString stringWithFormat:@"%@://probe-for-srganalytics", URLScheme];
-                if (! [[UIApplication sharedApplication] canOpenURL:[NSURL URLWithString:URLString]]) {
-                    continue;
-                }
-                
-                [installedApplications addObject:application];
-            }
+        // Extract URL schemes and installed applications. -canOpenURL: should only be called from the main thread
+        NSMutableSet<NSString *> *URLSchemes = [NSMutableSet set];
+        NSMutableSet<NSString *> *installedApplications = [NSMutableSet set];
+        for (NSDictionary *applicationDictionary in applicationDictionaries) {
+            NSString *application = applicationDictionary[@"code"];
+            NSString *URLScheme = applicationDictionary[@"ios"];
             
-            // To be able to open a URL in another application (and thus to be able to test for URL scheme support),
-            // the application must declare the schemes it supports via its Info.plist file (under the
-            // `LSApplicationQueriesSchemes` key). Check that the app list is consistent with the remote list, and
-            // log an error if this is not the case.
-            NSArray<NSString *> *declaredURLSchemesArray = NSBundle.mainBundle.infoDictionary[@"LSApplicationQueriesSchemes"];
-            NSSet<NSString *> *declaredURLSchemes = declaredURLSchemesArray ? [NSSet setWithArray:declaredURLSchemesArray] : [NSSet set];
-            if (! [URLSchemes isSubsetOfSet:declaredURLSchemes]) {
-                SRGAnalyticsLogError(@"tracker", @"The URL schemes declared in your application Info.plist file under the "
-                                     "'LSApplicationQueriesSchemes' key must at least contain the scheme list available at "
-                                     "https://pastebin.com/raw/RnZYEWCA (the schemes are found under the 'ios' key, or "
-                                     "a script is available in the SRGAnalytics repository to extract them). Please "
-                                     "update your Info.plist file accordingly to make this message disappear.");
+            if (URLScheme.length == 0 || ! application) {
+                SRGAnalyticsLogInfo(@"tracker", @"URL scheme or application name missing in %@. Skipped", applicationDictionary);
+                continue;
             }
             
-            NSArray<NSString *> *sortedInstalledApplications = [installedApplications.allObjects sortedArrayUsingSelector:@selector(localizedCaseInsensitiveCompare:)];
+            [URLSchemes addObject:URLScheme];
             
-            SRGAnalyticsHiddenEventLabels *labels = [[SRGAnalyticsHiddenEventLabels alloc] init];
-            labels.type = @"hidden";
-            labels.source = @"SRGAnalytics";
-            labels.value = [sortedInstalledApplications componentsJoinedByString:@";"];
+            NSString *URLString = [NSString stringWithFormat:@"%@://probe-for-srganalytics", URLScheme];
+            if (! [[UIApplication sharedApplication] canOpenURL:[NSURL URLWithString:URLString]]) {
+                continue;
+            }
             
-            [self trackHiddenEventWithName:@"Installed Apps" labels:labels];
-        });
-    }] resume];
+            [installedApplications addObject:application];
+        }
+        
+        // To be able to open a URL in another application (and thus to be able to test for URL scheme support),
+        // the application must declare the schemes it supports via its Info.plist file (under the
+        // `LSApplicationQueriesSchemes` key). Check that the app list is consistent with the remote list, and
+        // log an error if this is not the case.
+        NSArray<NSString *> *declaredURLSchemesArray = NSBundle.mainBundle.infoDictionary[@"LSApplicationQueriesSchemes"];
+        NSSet<NSString *> *declaredURLSchemes = declaredURLSchemesArray ? [NSSet setWithArray:declaredURLSchemesArray] : [NSSet set];
+        if (! [URLSchemes isSubsetOfSet:declaredURLSchemes]) {
+            SRGAnalyticsLogError(@"tracker", @"The URL schemes declared in your application Info.plist file under the "
+                                 "'LSApplicationQueriesSchemes' key must at least contain the scheme list available at "
+                                 "https://pastebin.com/raw/RnZYEWCA (the schemes are found under the 'ios' key, or "
+                                 "a script is available in the SRGAnalytics repository to extract them). Please "
+                                 "update your Info.plist file accordingly to make this message disappear.");
+        }
+        
+        NSArray<NSString *> *sortedInstalledApplications = [installedApplications.allObjects sortedArrayUsingSelector:@selector(localizedCaseInsensitiveCompare:)];
+        
+        NSDate *date = NSDate.date;
+        NSString *fingerprint = SRGAnalyticsInstalledApplicationsFingerprint(sortedInstalledApplications);
+        if (! [self.applicationListCache shouldReportFingerprint:fingerprint atDate:date minimumInterval:self.configuration.applicationListMeasurementInterval]) {
+            SRGAnalyticsLogDebug(@"tracker", @"Installed applications have not changed since last measurement");
+            return;
+        }
+        
+        SRGAnalyticsHiddenEventLabels *labels = [[SRGAnalyticsHiddenEventLabels alloc] init];
+        labels.type = @"hidden";
+        labels.source = @"SRGAnalytics";
+        labels.value = [sortedInstalledApplications componentsJoinedByString:@";"];
+        
+        // Sent directly, bypassing sampling and rate limiting. The fingerprint is only recorded once delivered, so that
+        // the measurement is attempted again if the event is lost.
+        SRGAnalyticsApplicationListCache *applicationListCache = self.applicationListCache;
+        SRGAnalyticsEvent *event = [SRGAnalyticsEvent measurementEventWithName:@"Installed Apps" labels:labels];
+        event.deliveryHandler = ^{
+            dispatch_async(dispatch_get_main_queue(), ^{
+                [applicationListCache setReportedFingerprint:fingerprint date:date];
+            });
+        };
+        [self enqueueEvent:event];
+    }];
+}
+
+#pragma mark Notifications
+
+- (void)applicationDidEnterBackground:(NSNotification *)notification
+{
+    [self flushAggregatedHiddenEvents];
+    
+    // Give pending events a chance to be delivered before the application is suspended
+    UIApplication *application = UIApplication.sharedApplication;
+    __block UIBackgroundTaskIdentifier backgroundTaskIdentifier = [application beginBackgroundTaskWithExpirationHandler:^{
+        [application endBackgroundTask:backgroundTaskIdentifier];
+        backgroundTaskIdentifier = UIBackgroundTaskInvalid;
+    }];
+    [self.eventQueue performBlock:^{
+        [self.journal synchronize];
+    }];
+    [self flushWithCompletionHandler:^{
+        if (backgroundTaskIdentifier != UIBackgroundTaskInvalid) {
+            [application endBackgroundTask:backgroundTaskIdentifier];
+            backgroundTaskIdentifier = UIBackgroundTaskInvalid;
+        }
+    }];
+}
+
+- (void)applicationWillTerminate:(NSNotification *)notification
+{
+    [self flushAggregatedHiddenEvents];
+    
+    [self.eventQueue performBlock:^{
+        [self.journal synchronize];
+    }];
+    [self drainWithTimeout:2.];
 }
 
 #pragma mark Description
@@ -0,0 +1,18 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "UIViewController+SRGAnalytics.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Install the hooks required for automatic page view tracking (view controller appearance, tab selection and
+ *  foreground observation). Only the first call has an effect. View controllers already visible when hooks are
+ *  installed are tracked as if they had just appeared. Must be called on the main thread.
+ */
+OBJC_EXPORT void UIViewController_SRGAnalyticsInstallHooks(void);
+
+NS_ASSUME_NONNULL_END
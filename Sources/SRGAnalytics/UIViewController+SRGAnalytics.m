@@ -6,7 +6,9 @@
 
 #import "UIViewController+SRGAnalytics.h"
 
+#import "SRGAnalyticsLaunchReport+Private.h"
 #import "SRGAnalyticsTracker+Private.h"
+#import "UIViewController+SRGAnalytics+Private.h"
 
 #import <objc/runtime.h>
 
@@ -14,7 +16,10 @@
 static void *s_appearedOnce = &s_appearedOnce;
 
 // Functions
+static void UIViewController_SRGAnalyticsInstallSwizzles(void);
+static void UIViewController_SRGAnalyticsInstallObservers(void);
 static void UIViewController_SRGAnalyticsUpdateAnalyticsForWindow(UIWindow *window);
+static void UIViewController_SRGAnalyticsTrackVisibleViewControllers(void);
 
 // Swizzled method original implementations
 static void (*s_UIViewController_viewDidAppear)(id, SEL, BOOL);
@@ -26,15 +31,6 @@ static void swizzled_UIViewController_setSelectedViewController(UITabBarControll
 
 @implementation UIViewController (SRGAnalytics)
 
-#pragma mark Class methods
-
-+ (void)load
-{
-    Method viewDidAppearMethod = class_getInstanceMethod(self, @selector(viewDidAppear:));
-    s_UIViewController_viewDidAppear = (__typeof__(s_UIViewController_viewDidAppear))method_getImplementation(viewDidAppearMethod);
-    method_setImplementation(viewDidAppearMethod, (IMP)swizzled_UIViewController_viewDidAppear);
-}
-
 #pragma mark Tracking
 
 - (void)srg_trackPageView
@@ -168,15 +164,6 @@ static void swizzled_UIViewController_setSelectedViewController(UITabBarControll
 
 @implementation UITabBarController (SRGAnalytics)
 
-#pragma mark Class methods
-
-+ (void)load
-{
-    Method setSelectedViewControllerMethod = class_getInstanceMethod(self, @selector(setSelectedViewController:));
-    s_UITabBarController_setSelectedViewController = (__typeof__(s_UITabBarController_setSelectedViewController))method_getImplementation(setSelectedViewControllerMethod);
-    method_setImplementation(setSelectedViewControllerMethod, (IMP)swizzled_UIViewController_setSelectedViewController);
-}
-
 #pragma mark SRGAnalyticsContainerViewTracking protocol
 
 - (NSArray<UIViewController *> *)srg_activeChildViewControllers
@@ -188,7 +175,32 @@ static void swizzled_UIViewController_setSelectedViewController(UITabBarControll
 
 #pragma mark Functions
 
-__attribute__((constructor)) static void UIViewController_SRGAnalyticsInit(void)
+void UIViewController_SRGAnalyticsInstallHooks(void)
+{
+    NSCAssert(NSThread.isMainThread, @"Hooks must be installed on the main thread");
+    
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        SRGAnalyticsLaunchReportMeasureStep(SRGAnalyticsLaunchStepViewControllerHooks, ^{
+            UIViewController_SRGAnalyticsInstallSwizzles();
+            UIViewController_SRGAnalyticsInstallObservers();
+            UIViewController_SRGAnalyticsTrackVisibleViewControllers();
+        });
+    });
+}
+
+static void UIViewController_SRGAnalyticsInstallSwizzles(void)
+{
+    Method viewDidAppearMethod = class_getInstanceMethod(UIViewController.class, @selector(viewDidAppear:));
+    s_UIViewController_viewDidAppear = (__typeof__(s_UIViewController_viewDidAppear))method_getImplementation(viewDidAppearMethod);
+    method_setImplementation(viewDidAppearMethod, (IMP)swizzled_UIViewController_viewDidAppear);
+    
+    Method setSelectedViewControllerMethod = class_getInstanceMethod(UITabBarController.class, @selector(setSelectedViewController:));
+    s_UITabBarController_setSelectedViewController = (__typeof__(s_UITabBarController_setSelectedViewController))method_getImplementation(setSelectedViewControllerMethod);
+    method_setImplementation(setSelectedViewControllerMethod, (IMP)swizzled_UIViewController_setSelectedViewController);
+}
+
+static void UIViewController_SRGAnalyticsInstallObservers(void)
 {
     if (@available(iOS 13, tvOS 13, *)) {
         // Scene support requires the `UIApplicationSceneManifest` key to be present in the Info.plist.
@@ -222,6 +234,50 @@ static void UIViewController_SRGAnalyticsUpdateAnalyticsForWindow(UIWindow *wind
     [topViewController srg_trackPageViewAutomatic:YES recursive:YES ignoreApplicationState:YES];
 }
 
+// Track view controllers whose first appearance could not be detected as they appeared before hooks were installed
+// (e.g. when the tracker is started after the first screen has been displayed), as the swizzled `-viewDidAppear:`
+// would have, i.e. children first
+static void UIViewController_SRGAnalyticsTrackAppearedViewController(UIViewController *viewController)
+{
+    for (UIViewController *childViewController in [viewController srg_childViewControllers]) {
+        UIViewController_SRGAnalyticsTrackAppearedViewController(childViewController);
+    }
+    
+    if (viewController.viewIfLoaded.window && ! [objc_getAssociatedObject(viewController, s_appearedOnce) boolValue]) {
+        [viewController srg_trackPageViewAutomatic:YES recursive:NO ignoreApplicationState:NO];
+        objc_setAssociatedObject(viewController, s_appearedOnce, @YES, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    }
+}
+
+static void UIViewController_SRGAnalyticsTrackVisibleViewControllers(void)
+{
+    NSMutableArray<UIWindow *> *windows = [NSMutableArray array];
+    if (@available(iOS 13, tvOS 13, *)) {
+        for (UIScene *scene in UIApplication.sharedApplication.connectedScenes) {
+            if ([scene isKindOfClass:UIWindowScene.class]) {
+                [windows addObjectsFromArray:((UIWindowScene *)scene).windows];
+            }
+        }
+    }
+    else if (UIApplication.sharedApplication.keyWindow) {
+        [windows addObject:UIApplication.sharedApplication.keyWindow];
+    }
+    
+    for (UIWindow *window in windows) {
+        if (window.hidden) {
+            continue;
+        }
+        
+        UIViewController *topViewController = window.rootViewController;
+        while (topViewController.presentedViewController) {
+            topViewController = topViewController.presentedViewController;
+        }
+        if (topViewController) {
+            UIViewController_SRGAnalyticsTrackAppearedViewController(topViewController);
+        }
+    }
+}
+
 static void swizzled_UIViewController_viewDidAppear(UIViewController *self, SEL _cmd, BOOL animated)
 {
     s_UIViewController_viewDidAppear(self, _cmd, animated);
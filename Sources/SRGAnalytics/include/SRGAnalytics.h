@@ -10,9 +10,12 @@
 FOUNDATION_EXPORT NSString * SRGAnalyticsMarketingVersion(void);
 
 // Public headers.
+#import "SRGAnalyticsCaptureSink.h"
 #import "SRGAnalyticsConfiguration.h"
 #import "SRGAnalyticsHiddenEventLabels.h"
 #import "SRGAnalyticsLabels.h"
+#import "SRGAnalyticsLaunchReport.h"
+#import "SRGAnalyticsMetrics.h"
 #import "SRGAnalyticsNotifications.h"
 #import "SRGAnalyticsPageViewLabels.h"
 #import "SRGAnalyticsTracker.h"
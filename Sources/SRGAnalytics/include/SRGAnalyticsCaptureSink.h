@@ -0,0 +1,109 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+@import Foundation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Services to which captured events are sent.
+ */
+typedef NS_ENUM(NSInteger, SRGAnalyticsCaptureService) {
+    /**
+     *  TagCommander.
+     */
+    SRGAnalyticsCaptureServiceTagCommander = 0,
+    /**
+     *  comScore (page views only, without labels added by the comScore SDK).
+     */
+    SRGAnalyticsCaptureServiceComScore
+};
+
+/**
+ *  An event captured right before it was handed over to an analytics service.
+ */
+@interface SRGAnalyticsCapturedEvent : NSObject
+
+/**
+ *  Sequence number, strictly increasing in capture order and starting at 1.
+ */
+@property (nonatomic, readonly) uint64_t sequence;
+
+/**
+ *  The date at which the event was captured.
+ */
+@property (nonatomic, readonly) NSDate *date;
+
+/**
+ *  The service to which the event was sent.
+ */
+@property (nonatomic, readonly) SRGAnalyticsCaptureService service;
+
+/**
+ *  The labels, URL-encoded.
+ */
+@property (nonatomic, readonly, copy) NSString *encodedLabels;
+
+/**
+ *  The labels, decoded.
+ */
+@property (nonatomic, readonly) NSDictionary<NSString *, NSString *> *labels;
+
+@end
+
+/**
+ *  Filter applied to captured events.
+ */
+typedef BOOL (^SRGAnalyticsCapturedEventFilter)(SRGAnalyticsCapturedEvent *event);
+
+/**
+ *  Records the final labels of events, right before they leave the process, into a bounded ring buffer. When the
+ *  buffer is full the oldest events are overwritten. Capture is lock-free and does not allocate memory, so that it can
+ *  be enabled in staging builds under load (@see `SRGAnalyticsConfiguration.captureBufferCapacity`).
+ *
+ *  All methods can be called from any thread.
+ */
+@interface SRGAnalyticsCaptureSink : NSObject
+
+/**
+ *  The capacity of the buffer, in bytes.
+ */
+@property (nonatomic, readonly) NSUInteger capacity;
+
+/**
+ *  The sequence number of the last captured event, 0 if none.
+ */
+@property (nonatomic, readonly) uint64_t lastSequence;
+
+/**
+ *  Return the events still available from the buffer and captured after the specified sequence number, in capture
+ *  order, optionally filtered.
+ */
+- (NSArray<SRGAnalyticsCapturedEvent *> *)eventsAfterSequence:(uint64_t)sequence matchingFilter:(nullable SRGAnalyticsCapturedEventFilter)filter;
+
+/**
+ *  Block the calling thread until an event matching the filter is captured after the specified sequence number, or
+ *  until the timeout (in seconds) expires. Return the first matching event, `nil` if none.
+ */
+- (nullable SRGAnalyticsCapturedEvent *)waitForEventAfterSequence:(uint64_t)sequence
+                                                   matchingFilter:(nullable SRGAnalyticsCapturedEventFilter)filter
+                                                          timeout:(NSTimeInterval)timeout;
+
+@end
+
+@interface SRGAnalyticsCapturedEvent (Unavailable)
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+@interface SRGAnalyticsCaptureSink (Unavailable)
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -47,6 +47,28 @@ typedef NS_ENUM(NSInteger, SRGAnalyticsEnvironmentMode) {
     SRGAnalyticsEnvironmentModeProduction
 };
 
+/**
+ *  Policies applied to make room for new events when pending events exceed their memory budget.
+ */
+typedef NS_ENUM(NSInteger, SRGAnalyticsPendingEventDropPolicy) {
+    /**
+     *  The oldest pending events are dropped first.
+     */
+    SRGAnalyticsPendingEventDropPolicyDropOldest = 0,
+    /**
+     *  The oldest pending events with the lowest priority are dropped first. Media heartbeats have the lowest priority,
+     *  followed by hidden events, page views and other media events. A new event is dropped if only events with
+     *  higher priority are pending.
+     */
+    SRGAnalyticsPendingEventDropPolicyDropLowestPriority,
+    /**
+     *  Pending media heartbeats are sampled down first, every other heartbeat being dropped (oldest first) in
+     *  successive passes, so that media sessions remain measured at a lower resolution. The oldest pending events are
+     *  dropped when heartbeats cannot be sampled down any further.
+     */
+    SRGAnalyticsPendingEventDropPolicySampleHeartbeats
+};
+
 @interface SRGAnalyticsConfiguration : NSObject <NSCopying>
 
 /**
@@ -77,6 +99,160 @@ typedef NS_ENUM(NSInteger, SRGAnalyticsEnvironmentMode) {
  */
 @property (nonatomic, getter=isUnitTesting) BOOL unitTesting;
 
+/**
+ *  When set to `YES`, events are journaled on disk until they have been handed over to TagCommander, so that events
+ *  which could not be delivered because the application was killed are sent the next time the tracker is started.
+ *
+ *  Default value is `YES`.
+ */
+@property (nonatomic, getter=isEventJournalEnabled) BOOL eventJournalEnabled;
+
+/**
+ *  When set to `YES`, the comScore and TagCommander SDKs are not initialized when the tracker is started, but during
+ *  the first idle run loop cycle afterwards, so that application launch is not delayed. Events tracked in the meantime
+ *  are buffered (up to 100 events, older events being kept) and sent in order with their original timestamp.
+ *
+ *  Default value is `NO`.
+ */
+@property (nonatomic, getter=isStartDeferred) BOOL startDeferred;
+
+/**
+ *  Identical page views (same title, levels, labels and push notification origin) tracked within this interval are
+ *  sent only once. This suppresses bursts of page views which automatic tracking might trigger, e.g. when several
+ *  scenes are brought to the foreground at the same time. Set to 0 to disable deduplication. A value of 0.5 seconds
+ *  is suitable for most applications.
+ *
+ *  Default value is 0 (no deduplication).
+ */
+@property (nonatomic) NSTimeInterval pageViewDebounceInterval;
+
+/**
+ *  Ratio (between 0 and 1) of users for which page views are sent. Sampling is deterministic per user, i.e. a given
+ *  user either always or never sends page views.
+ *
+ *  Default value is 1 (no sampling).
+ */
+@property (nonatomic) double pageViewSamplingRatio;
+
+/**
+ *  Ratio (between 0 and 1) of users for which hidden events are sent, unless a specific ratio has been set for some
+ *  event name (@see `-setSamplingRatio:forHiddenEventsWithName:`). Sampling is deterministic per user and event name,
+ *  i.e. a given user either always or never sends hidden events with a given name.
+ *
+ *  Default value is 1 (no sampling).
+ */
+@property (nonatomic) double hiddenEventSamplingRatio;
+
+/**
+ *  Set the sampling ratio (between 0 and 1) for hidden events with the specified name, overriding the default
+ *  `hiddenEventSamplingRatio`.
+ */
+- (void)setSamplingRatio:(double)samplingRatio forHiddenEventsWithName:(NSString *)name;
+
+/**
+ *  The sampling ratio applied to hidden events with the specified name.
+ */
+- (double)samplingRatioForHiddenEventsWithName:(NSString *)name;
+
+/**
+ *  Maximum sustained rate at which hidden events are sent, in events per second. Hidden events exceeding this rate
+ *  (after an initial burst of at most `hiddenEventBurstSize` events) are dropped. Set to 0 for no limit.
+ *
+ *  Default value is 0.
+ */
+@property (nonatomic) double maximumHiddenEventRate;
+
+/**
+ *  Maximum number of hidden events which can be sent in a burst when `maximumHiddenEventRate` is set.
+ *
+ *  Default value is 20.
+ */
+@property (nonatomic) NSUInteger hiddenEventBurstSize;
+
+/**
+ *  Interval at which a summary hidden event is sent to report how many events have been sampled out, dropped by
+ *  rate limiting or dropped under memory pressure during the interval, if any.
+ *
+ *  Default value is 300 seconds.
+ */
+@property (nonatomic) NSTimeInterval eventSummaryInterval;
+
+/**
+ *  Time window during which aggregated hidden events are accumulated before being sent as summary events
+ *  (@see `-[SRGAnalyticsTracker aggregateHiddenEventWithName:dimensions:]`).
+ *
+ *  Default value is 60 seconds.
+ */
+@property (nonatomic) NSTimeInterval hiddenEventAggregationInterval;
+
+/**
+ *  Interval at which `SRGAnalyticsMetricsNotification` is posted. Set to 0 to disable the notification. Metrics
+ *  can still be retrieved at any time from `SRGAnalyticsTracker.metrics`.
+ *
+ *  Default value is 0.
+ */
+@property (nonatomic) NSTimeInterval metricsNotificationInterval;
+
+/**
+ *  Capacity (in bytes) of the buffer into which events are captured right before being sent, @see
+ *  `SRGAnalyticsTracker.captureSink`. Set to 0 to disable capture, except in unit testing mode where a 4 MB buffer
+ *  is used by default.
+ *
+ *  Default value is 0.
+ */
+@property (nonatomic) NSUInteger captureBufferCapacity;
+
+/**
+ *  Memory budget (in bytes) for events tracked but not delivered yet, from the moment they are tracked until all
+ *  sinks are done with them. Event sizes are estimated when events are tracked. When the budget is exceeded, room is
+ *  made according to `pendingEventDropPolicy`, and the tracker signals backpressure (@see
+ *  `SRGAnalyticsTracker.underBackpressure`). Set to 0 for no limit.
+ *
+ *  @discussion The budget bounds events pending delivery. Events dropped to make room are never delivered, but are
+ *              only released from memory once the tracker reaches them in its internal queues.
+ *
+ *  Default value is 2 MB.
+ */
+@property (nonatomic) NSUInteger pendingEventMemoryBudget;
+
+/**
+ *  The policy applied when pending events exceed `pendingEventMemoryBudget`.
+ *
+ *  Default value is `SRGAnalyticsPendingEventDropPolicySampleHeartbeats`.
+ */
+@property (nonatomic) SRGAnalyticsPendingEventDropPolicy pendingEventDropPolicy;
+
+/**
+ *  Installed SRG SSR applications are measured after each start, when the application is idle, but only reported
+ *  when they have changed since the last report, or when the last report is older than this interval (in seconds).
+ *
+ *  Default value is 7 days.
+ */
+@property (nonatomic) NSTimeInterval applicationListMeasurementInterval;
+
+/**
+ *  Base URL of a collector to which events are sent instead of TagCommander and comScore, e.g. a loopback collector
+ *  used for load testing on a machine without network access (`http://127.0.0.1:8080`). TagCommander events are
+ *  posted to `<collectorURL>/tagcommander`, comScore page views sent to `<collectorURL>/comscore` and the application
+ *  list retrieved from `<collectorURL>/applications`. Failed requests are retried with exponential backoff.
+ *
+ *  @discussion comScore media measurements are still sent by the comScore SDK. Never set in production builds.
+ *
+ *  Default value is `nil`.
+ */
+@property (nonatomic, copy, nullable) NSURL *collectorURL;
+
+/**
+ *  Maximum time (in seconds) during which TagCommander events are batched before being posted to the collector, if
+ *  any. Batches use a compact dictionary-compressed format and are posted to `<collectorURL>/tagcommander/batch`,
+ *  which cuts bytes sent for heartbeat-heavy sessions by an order of magnitude. Batches are also sent when they are
+ *  full, or when the tracker is flushed (e.g. when the application enters the background). Set to 0 to post each
+ *  event on its own, URL-encoded.
+ *
+ *  Default value is 1 second.
+ */
+@property (nonatomic) NSTimeInterval collectorBatchInterval;
+
 /**
  *  Analytics environment mode. Determines how the analytics environment (production / pre-production) is resolved.
  *
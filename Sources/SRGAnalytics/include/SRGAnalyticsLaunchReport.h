@@ -0,0 +1,51 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+@import Foundation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Library initialization steps.
+ */
+typedef NSString * SRGAnalyticsLaunchStep NS_TYPED_ENUM;
+
+OBJC_EXPORT SRGAnalyticsLaunchStep const SRGAnalyticsLaunchStepTrackerStart;                // Configuration of the tracker when started.
+OBJC_EXPORT SRGAnalyticsLaunchStep const SRGAnalyticsLaunchStepServicesStart;               // Initialization of analytics services (possibly deferred).
+OBJC_EXPORT SRGAnalyticsLaunchStep const SRGAnalyticsLaunchStepViewControllerHooks;         // Installation of automatic page view tracking hooks.
+OBJC_EXPORT SRGAnalyticsLaunchStep const SRGAnalyticsLaunchStepMediaPlayerHooks;            // Installation of media player observers (SRGAnalyticsMediaPlayer only).
+
+/**
+ *  Report of the time spent initializing the library. No work is performed when the library is loaded: Hooks and
+ *  observers are installed when the tracker is started or, for media player observers, when a media player controller
+ *  is first prepared with analytics labels.
+ */
+@interface SRGAnalyticsLaunchReport : NSObject
+
+/**
+ *  Steps performed so far, in the order they were first performed.
+ */
+@property (nonatomic, readonly) NSArray<SRGAnalyticsLaunchStep> *steps;
+
+/**
+ *  Time spent (in seconds) performing the specified step, 0 if the step was not performed.
+ */
+- (NSTimeInterval)durationForStep:(SRGAnalyticsLaunchStep)step;
+
+/**
+ *  Total time spent (in seconds) performing all steps.
+ */
+@property (nonatomic, readonly) NSTimeInterval totalDuration;
+
+@end
+
+@interface SRGAnalyticsLaunchReport (Unavailable)
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,122 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+@import Foundation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Event types for which metrics are collected.
+ */
+typedef NS_ENUM(NSInteger, SRGAnalyticsMetricsEventType) {
+    /**
+     *  Page views.
+     */
+    SRGAnalyticsMetricsEventTypePageView = 0,
+    /**
+     *  Hidden events.
+     */
+    SRGAnalyticsMetricsEventTypeHiddenEvent,
+    /**
+     *  Media events.
+     */
+    SRGAnalyticsMetricsEventTypeMedia
+};
+
+/**
+ *  Histogram of latencies, with a relative precision of about 12%.
+ */
+@interface SRGAnalyticsLatencyHistogram : NSObject
+
+/**
+ *  The number of recorded latencies.
+ */
+@property (nonatomic, readonly) NSUInteger count;
+
+/**
+ *  The mean latency, in seconds.
+ */
+@property (nonatomic, readonly) NSTimeInterval mean;
+
+/**
+ *  The maximum latency, in seconds.
+ */
+@property (nonatomic, readonly) NSTimeInterval maximum;
+
+/**
+ *  The latency (in seconds) below which the specified percentage (between 0 and 100) of recorded latencies fall.
+ */
+- (NSTimeInterval)latencyAtPercentile:(double)percentile;
+
+@end
+
+/**
+ *  Snapshot of tracker metrics, cumulated since the application was launched.
+ */
+@interface SRGAnalyticsMetrics : NSObject
+
+/**
+ *  The number of events of the specified type accepted for delivery.
+ */
+- (NSUInteger)acceptedEventCountForType:(SRGAnalyticsMetricsEventType)type;
+
+/**
+ *  The number of events of the specified type dropped before delivery (sampling, rate limiting, deduplication or
+ *  memory pressure). Events accepted and later evicted from memory to make room for new events are counted as well.
+ */
+- (NSUInteger)droppedEventCountForType:(SRGAnalyticsMetricsEventType)type;
+
+/**
+ *  The number of events of the specified type handed over to analytics services.
+ */
+- (NSUInteger)sentEventCountForType:(SRGAnalyticsMetricsEventType)type;
+
+/**
+ *  The number of events accepted but not processed yet.
+ */
+@property (nonatomic, readonly) NSUInteger pendingEventCount;
+
+/**
+ *  The estimated memory (in bytes) used by events accepted but not delivered yet, @see
+ *  `SRGAnalyticsConfiguration.pendingEventMemoryBudget`.
+ */
+@property (nonatomic, readonly) NSUInteger pendingEventByteCount;
+
+/**
+ *  The number of media trackers currently alive.
+ */
+@property (nonatomic, readonly) NSInteger liveMediaTrackerCount;
+
+/**
+ *  Time spent building the labels of an event.
+ */
+@property (nonatomic, readonly) SRGAnalyticsLatencyHistogram *labelBuildingLatencies;
+
+/**
+ *  Time spent encoding the labels of an event.
+ */
+@property (nonatomic, readonly) SRGAnalyticsLatencyHistogram *encodingLatencies;
+
+/**
+ *  Time spent handing an event over to analytics services.
+ */
+@property (nonatomic, readonly) SRGAnalyticsLatencyHistogram *dispatchLatencies;
+
+@end
+
+@interface SRGAnalyticsLatencyHistogram (Unavailable)
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+@interface SRGAnalyticsMetrics (Unavailable)
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
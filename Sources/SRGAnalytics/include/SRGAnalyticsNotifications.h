@@ -16,6 +16,9 @@ NS_ASSUME_NONNULL_BEGIN
  *  `SRGAnalyticsConfiguration`.
  *
  *  Notifications may be received on background threads.
+ *
+ *  @discussion TagCommander labels are captured when events are emitted, without intercepting network requests. For
+ *              lower-overhead access to emitted events, use `SRGAnalyticsTracker.captureSink` instead.
  */
 
 // Notification sent when TagCommander analytics are sent.
@@ -30,6 +33,25 @@ OBJC_EXPORT NSString * const SRGAnalyticsComScoreRequestNotification;
 // Information available for `SRGAnalyticsComScoreRequestNotification`.
 OBJC_EXPORT NSString * const SRGAnalyticsComScoreLabelsKey;                 // Key for accessing the comScore labels (as an `NSDictionary<NSString *, NSString *>`) available from the user info.
 
+/**
+ *  Notification sent on the main thread at regular intervals with tracker metrics, if enabled (@see
+ *  `SRGAnalyticsConfiguration.metricsNotificationInterval`). Unlike the notifications above, this notification is
+ *  available in all builds.
+ */
+OBJC_EXPORT NSString * const SRGAnalyticsMetricsNotification;
+
+// Information available for `SRGAnalyticsMetricsNotification`.
+OBJC_EXPORT NSString * const SRGAnalyticsMetricsKey;                        // Key for accessing the metrics (as an `SRGAnalyticsMetrics`) available from the user info.
+
+/**
+ *  Notification sent on the main thread when the tracker enters or leaves backpressure (@see
+ *  `SRGAnalyticsTracker.underBackpressure`). Available in all builds.
+ */
+OBJC_EXPORT NSString * const SRGAnalyticsBackpressureDidChangeNotification;
+
+// Information available for `SRGAnalyticsBackpressureDidChangeNotification`.
+OBJC_EXPORT NSString * const SRGAnalyticsUnderBackpressureKey;              // Key for accessing whether the tracker is under backpressure (as an `NSNumber` boolean) available from the user info.
+
 /**
  *  Get the currrent unique identifier added to all measurements made in unit testing mode.
  */
@@ -4,8 +4,11 @@
 //  License information is available from the LICENSE file.
 //
 
+#import "SRGAnalyticsCaptureSink.h"
 #import "SRGAnalyticsConfiguration.h"
 #import "SRGAnalyticsHiddenEventLabels.h"
+#import "SRGAnalyticsLaunchReport.h"
+#import "SRGAnalyticsMetrics.h"
 #import "SRGAnalyticsPageViewLabels.h"
 
 @import Foundation;
@@ -71,8 +74,8 @@ NS_EXTENSION_UNAVAILABLE("SRG Analytics does not support application extensions"
 
 /**
  *  Start the tracker. This is required to specify for which business unit you are tracking events, as well as to
- *  where they must be sent on the comScore and TagCommander services. Attempting to track view, hidden or stream
- *  events without starting the tracker has no effect.
+ *  where they must be sent on the comScore and TagCommander services. View and hidden events tracked before the
+ *  tracker is started are buffered (up to 100 events) and sent in order once it has been started.
  *
  *  @param configuration The configuration to use. This configuration is copied and cannot be changed afterwards.
  */
@@ -85,6 +88,69 @@ NS_EXTENSION_UNAVAILABLE("SRG Analytics does not support application extensions"
 
 @end
 
+/**
+ *  @name Event delivery
+ *
+ *  Events are recorded on the thread they are emitted from, but labels are built and events delivered to analytics
+ *  services asynchronously, on a background worker. Pending events are automatically flushed when the application
+ *  enters background or is terminated.
+ */
+@interface SRGAnalyticsTracker (EventDelivery)
+
+/**
+ *  Process all events recorded so far, handing them over to analytics services, and call the completion handler on
+ *  the main thread when done.
+ */
+- (void)flushWithCompletionHandler:(nullable void (^)(void))completionHandler;
+
+/**
+ *  Process all events recorded so far, handing them over to analytics services, and block the calling thread until
+ *  done or until the specified timeout (in seconds) expires.
+ *
+ *  @return `YES` iff all events could be processed before the timeout expired.
+ */
+- (BOOL)drainWithTimeout:(NSTimeInterval)timeout;
+
+@end
+
+/**
+ *  @name Metrics
+ */
+@interface SRGAnalyticsTracker (Metrics)
+
+/**
+ *  Snapshot of tracker metrics (event counts, pending events, latencies and media trackers). Metrics are always
+ *  collected, even before the tracker is started.
+ */
+@property (nonatomic, readonly) SRGAnalyticsMetrics *metrics;
+
+/**
+ *  Report of the time spent initializing the library so far.
+ */
+@property (nonatomic, readonly) SRGAnalyticsLaunchReport *launchReport;
+
+/**
+ *  `YES` iff events tracked but not delivered yet are close to or exceed their memory budget, in which case events
+ *  are being dropped (@see `SRGAnalyticsConfiguration.pendingEventMemoryBudget`). Optional events should not be
+ *  tracked while under backpressure. Changes are notified with `SRGAnalyticsBackpressureDidChangeNotification`.
+ */
+@property (nonatomic, readonly, getter=isUnderBackpressure) BOOL underBackpressure;
+
+@end
+
+/**
+ *  @name Event capture
+ */
+@interface SRGAnalyticsTracker (Capture)
+
+/**
+ *  The sink into which events are captured right before being sent, if enabled (@see
+ *  `SRGAnalyticsConfiguration.captureBufferCapacity`). Available once the tracker has been started.
+ */
+@property (nonatomic, readonly, nullable) SRGAnalyticsCaptureSink *captureSink;
+
+@end
+
 /**
  *  @name Hidden event tracking
  */
@@ -112,6 +178,51 @@ NS_EXTENSION_UNAVAILABLE("SRG Analytics does not support application extensions"
 
 @end
 
+/**
+ *  @name Hidden event aggregation
+ *
+ *  @discussion High-frequency hidden events (e.g. impressions or taps) can be aggregated in memory rather than sent
+ *              individually. Occurrences are grouped by event name and dimension labels, and each group is sent as a
+ *              single hidden event with the same name at the end of each aggregation window (@see
+ *              `SRGAnalyticsConfiguration.hiddenEventAggregationInterval`), or when the application enters background.
+ *              Besides its dimensions, a summary event contains the following labels:
+ *                - `event_count`: The number of occurrences.
+ *                - `event_value_count`, `event_value_sum`, `event_value_min` and `event_value_max`: The number of
+ *                  occurrences with value and statistics about their values, if any.
+ */
+@interface SRGAnalyticsTracker (HiddenEventAggregation)
+
+/**
+ *  Record an occurrence of a hidden event with the specified name and dimension labels.
+ *
+ *  @param name       The event name.
+ *  @param dimensions Labels by which occurrences are grouped.
+ *
+ *  @discussion If the name is empty, the occurrence is ignored.
+ */
+- (void)aggregateHiddenEventWithName:(NSString *)name
+                          dimensions:(nullable NSDictionary<NSString *, NSString *> *)dimensions;
+
+/**
+ *  Record an occurrence of a hidden event with the specified name and dimension labels, with a numeric value.
+ *
+ *  @param name       The event name.
+ *  @param dimensions Labels by which occurrences are grouped.
+ *  @param value      The value associated with the occurrence.
+ *
+ *  @discussion If the name is empty, the occurrence is ignored.
+ */
+- (void)aggregateHiddenEventWithName:(NSString *)name
+                          dimensions:(nullable NSDictionary<NSString *, NSString *> *)dimensions
+                               value:(double)value;
+
+/**
+ *  Immediately send summary events for all occurrences aggregated so far.
+ */
+- (void)flushAggregatedHiddenEvents;
+
+@end
+
 /**
  *  @name Page view tracking
  */
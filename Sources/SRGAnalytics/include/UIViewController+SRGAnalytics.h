@@ -18,6 +18,8 @@ NS_ASSUME_NONNULL_BEGIN
  *  By default, if a view controller conforms to the `SRGAnalyticsViewTracking` protocol, a page view event will
  *  automatically be sent when it is presented for the first time (i.e. when `-viewDidAppear:` is called for
  *  the first time). In addition, automatic page views are sent when the application returns from background.
+ *  Automatic tracking is enabled when the tracker is started, which should therefore happen before the first view
+ *  controller appears.
  *
  *  If you need to precisely control when page view events are sent, however, you can implement the optional
  *  `-srg_isTrackedAutomatically` method to return `NO`, disabling the mechanisms described above. This is mostly
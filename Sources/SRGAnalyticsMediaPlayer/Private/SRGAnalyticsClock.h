@@ -0,0 +1 @@
+../../SRGAnalytics/SRGAnalyticsClock.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../SRGAnalytics/SRGAnalyticsEventRecord+Catalog.h
\ No newline at end of file
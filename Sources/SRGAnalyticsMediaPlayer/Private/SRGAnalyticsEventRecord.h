@@ -0,0 +1 @@
+../../SRGAnalytics/SRGAnalyticsEventRecord.h
\ No newline at end of file
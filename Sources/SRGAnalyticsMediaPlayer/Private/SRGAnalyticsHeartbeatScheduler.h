@@ -0,0 +1 @@
+../../SRGAnalytics/SRGAnalyticsHeartbeatScheduler.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../SRGAnalytics/SRGAnalyticsLabelCatalog.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../SRGAnalytics/SRGAnalyticsLaunchReport+Private.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../SRGAnalytics/SRGAnalyticsMetricsRecorder.h
\ No newline at end of file
@@ -4,11 +4,13 @@
 //  License information is available from the LICENSE file.
 //
 
+#import "SRGAnalyticsTracker+Private.h"
+
 @import Foundation;
 
 NS_ASSUME_NONNULL_BEGIN
 
-@interface SRGComScoreMediaPlayerTracker : NSObject
+@interface SRGComScoreMediaPlayerTracker : NSObject <SRGAnalyticsHookInstalling>
 
 @end
 
@@ -8,29 +8,21 @@
 
 #import "NSMutableDictionary+SRGAnalytics.h"
 #import "SRGAnalyticsLabels+Private.h"
+#import "SRGAnalyticsLaunchReport+Private.h"
 #import "SRGAnalyticsMediaPlayerLogger.h"
 #import "SRGAnalyticsStreamLabels.h"
 #import "SRGMediaAnalytics.h"
+#import "SRGMediaPlaybackHub.h"
+#import "SRGMediaTrackerStateMachine.h"
 #import "SRGMediaPlayerController+SRGAnalyticsMediaPlayer.h"
 
 @import ComScore;
-@import libextobjc;
-@import MAKVONotificationCenter;
 @import SRGAnalytics;
 @import SRGMediaPlayer;
 
-typedef NS_ENUM(NSInteger, ComScoreMediaPlayerTrackerEvent) {
-    ComScoreMediaPlayerTrackerEventPlay = 1,
-    ComScoreMediaPlayerTrackerEventPause,
-    ComScoreMediaPlayerTrackerEventEnd,
-    ComScoreMediaPlayerTrackerEventSeek,
-    ComScoreMediaPlayerTrackerEventBuffer
-};
-
 static NSInteger s_playbackActivityCount = 0;
-static NSMutableDictionary<NSValue *, SRGComScoreMediaPlayerTracker *> *s_trackers = nil;
 
-@interface SRGComScoreMediaPlayerTracker ()
+@interface SRGComScoreMediaPlayerTracker () <SRGMediaPlaybackBackend>
 
 @property (nonatomic, weak) SRGMediaPlayerController *mediaPlayerController;
 @property (nonatomic) SCORStreamingAnalytics *streamingAnalytics;
@@ -105,30 +97,6 @@ static NSMutableDictionary<NSValue *, SRGComScoreMediaPlayerTracker *> *s_tracke
         // (which our player does) suffices to implicitly finish the buffering phase. Buffer events are not required
         // to be sent when the player is seeking.
         [self.streamingAnalytics notifyBufferStart];
-        
-        [NSNotificationCenter.defaultCenter addObserver:self
-                                               selector:@selector(playbackStateDidChange:)
-                                                   name:SRGMediaPlayerPlaybackStateDidChangeNotification
-                                                 object:mediaPlayerController];
-        
-        @weakify(self)
-        [mediaPlayerController addObserver:self keyPath:@keypath(SRGMediaPlayerController.new, tracked) options:0 block:^(MAKVONotification *notification) {
-            @strongify(self)
-            
-            SRGMediaPlayerController *mediaPlayerController = self.mediaPlayerController;
-            if (mediaPlayerController.tracked) {
-                [self recordEventForPlaybackState:mediaPlayerController.playbackState
-                                   withStreamType:mediaPlayerController.streamType
-                                             time:mediaPlayerController.currentTime
-                                        timeRange:mediaPlayerController.timeRange];
-            }
-            else {
-                [self recordEvent:ComScoreMediaPlayerTrackerEventEnd
-                   withStreamType:mediaPlayerController.streamType
-                             time:mediaPlayerController.currentTime
-                        timeRange:mediaPlayerController.timeRange];
-            }
-        }];
     }
     return self;
 }
@@ -151,41 +119,29 @@ static NSMutableDictionary<NSValue *, SRGComScoreMediaPlayerTracker *> *s_tracke
                                time:(CMTime)time
                           timeRange:(CMTimeRange)timeRange
 {
-    static dispatch_once_t s_onceToken;
-    static NSDictionary<NSNumber *, NSNumber *> *s_events;
-    dispatch_once(&s_onceToken, ^{
-        s_events = @{ @(SRGMediaPlayerPlaybackStateIdle) : @(ComScoreMediaPlayerTrackerEventEnd),
-                      @(SRGMediaPlayerPlaybackStatePreparing) : @(ComScoreMediaPlayerTrackerEventBuffer),
-                      @(SRGMediaPlayerPlaybackStatePlaying) : @(ComScoreMediaPlayerTrackerEventPlay),
-                      @(SRGMediaPlayerPlaybackStateSeeking) : @(ComScoreMediaPlayerTrackerEventSeek),
-                      @(SRGMediaPlayerPlaybackStatePaused) : @(ComScoreMediaPlayerTrackerEventPause),
-                      @(SRGMediaPlayerPlaybackStateEnded) : @(ComScoreMediaPlayerTrackerEventEnd),
-                      @(SRGMediaPlayerPlaybackStateStalled) : @(ComScoreMediaPlayerTrackerEventBuffer) };
-    });
-    
-    NSNumber *event = s_events[@(playbackState)];
-    if (! event) {
+    SRGMediaTrackerEvent event = SRGMediaTrackerEventForPlaybackState(playbackState);
+    if (event == SRGMediaTrackerEventNone) {
         return;
     }
     
-    [self recordEvent:event.integerValue
+    [self recordEvent:event
        withStreamType:streamType
                  time:time
             timeRange:timeRange];
 }
 
-- (void)recordEvent:(ComScoreMediaPlayerTrackerEvent)event
+- (void)recordEvent:(SRGMediaTrackerEvent)event
      withStreamType:(SRGMediaPlayerStreamType)streamType
                time:(CMTime)time
           timeRange:(CMTimeRange)timeRange
 {
     SCORStreamingAnalytics *streamingAnalytics = self.streamingAnalytics;
     
-    if (! self.playing && event == ComScoreMediaPlayerTrackerEventPlay) {
+    if (! self.playing && event == SRGMediaTrackerEventPlay) {
         [SRGComScoreMediaPlayerTracker increasePlaybackActivityCount];
         self.playing = YES;
     }
-    else if (self.playing && (event == ComScoreMediaPlayerTrackerEventPause || event == ComScoreMediaPlayerTrackerEventEnd)) {
+    else if (self.playing && (event == SRGMediaTrackerEventPause || SRGMediaTrackerEventEndsSession(event))) {
         [SRGComScoreMediaPlayerTracker decreasePlaybackActivityCount];
         self.playing = NO;
     }
@@ -199,28 +155,29 @@ static NSMutableDictionary<NSValue *, SRGComScoreMediaPlayerTracker *> *s_tracke
     }
     
     switch (event) {
-        case ComScoreMediaPlayerTrackerEventPlay: {
+        case SRGMediaTrackerEventPlay: {
             [streamingAnalytics notifyPlay];
             break;
         }
             
-        case ComScoreMediaPlayerTrackerEventPause: {
+        case SRGMediaTrackerEventPause: {
             [streamingAnalytics notifyPause];
             break;
         }
             
-        case ComScoreMediaPlayerTrackerEventEnd: {
+        case SRGMediaTrackerEventEnd:
+        case SRGMediaTrackerEventStop: {
             [streamingAnalytics notifyEnd];
             self.streamingAnalytics = [SRGComScoreMediaPlayerTracker streamingAnalyticsForMediaPlayerController:self.mediaPlayerController];
             break;
         }
             
-        case ComScoreMediaPlayerTrackerEventSeek: {
+        case SRGMediaTrackerEventSeek: {
             [streamingAnalytics notifySeekStart];
             break;
         }
         
-        case ComScoreMediaPlayerTrackerEventBuffer: {
+        case SRGMediaTrackerEventBuffer: {
             [streamingAnalytics notifyBufferStart];
             break;
         }
@@ -231,83 +188,68 @@ static NSMutableDictionary<NSValue *, SRGComScoreMediaPlayerTracker *> *s_tracke
     }
 }
 
-#pragma mark Notifications
+#pragma mark SRGAnalyticsHookInstalling protocol
 
-+ (void)playbackStateDidChange:(NSNotification *)notification
++ (void)srg_installAnalyticsHooks
 {
-    if (! SRGAnalyticsTracker.sharedTracker.configuration) {
-        return;
-    }
-    
-    SRGMediaPlayerController *mediaPlayerController = notification.object;
-    NSValue *key = [NSValue valueWithNonretainedObject:mediaPlayerController];
-    
-    SRGMediaPlayerPlaybackState playbackState = [notification.userInfo[SRGMediaPlayerPlaybackStateKey] integerValue];
-    SRGMediaPlayerPlaybackState previousPlaybackState = [notification.userInfo[SRGMediaPlayerPreviousPlaybackStateKey] integerValue];
-    
-    // Always attach a tracker to a the player controller, whether or not it is actually tracked (otherwise we would
-    // be unable to attach to initially untracked controller later).
-    if (playbackState == SRGMediaPlayerPlaybackStatePreparing) {
-        SRGComScoreMediaPlayerTracker *tracker = [[SRGComScoreMediaPlayerTracker alloc] initWithMediaPlayerController:mediaPlayerController];
-        if (tracker) {
-            s_trackers[key] = tracker;
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        SRGAnalyticsLaunchReportMeasureStep(SRGAnalyticsLaunchStepMediaPlayerHooks, ^{
+            [SRGMediaPlaybackHub.sharedHub registerBackendClass:self];
+        });
+    });
+}
+
+#pragma mark SRGMediaPlaybackBackend protocol
+
++ (id<SRGMediaPlaybackBackend>)backendForMediaPlayerController:(SRGMediaPlayerController *)mediaPlayerController withSnapshot:(SRGMediaPlaybackSnapshot *)snapshot
+{
+    SRGComScoreMediaPlayerTracker *tracker = [[SRGComScoreMediaPlayerTracker alloc] initWithMediaPlayerController:mediaPlayerController];
+    if (tracker) {
+        [tracker recordEvent:SRGMediaTrackerEventBuffer
+              withStreamType:snapshot.streamType
+                        time:snapshot.time
+                   timeRange:snapshot.timeRange];
         
-            [tracker recordEvent:ComScoreMediaPlayerTrackerEventBuffer
-                  withStreamType:mediaPlayerController.streamType
-                            time:mediaPlayerController.currentTime
-                       timeRange:mediaPlayerController.timeRange];
-            
-            SRGAnalyticsMediaPlayerLogInfo(@"comScoreTracker", @"Started tracking for %@", key);
-        }
-    }
-    else if (playbackState == SRGMediaPlayerPlaybackStateIdle) {
-        SRGComScoreMediaPlayerTracker *tracker = s_trackers[key];
-        if (tracker) {
-            if (previousPlaybackState != SRGMediaPlayerPlaybackStatePreparing) {
-                SRGMediaPlayerStreamType streamType = [notification.userInfo[SRGMediaPlayerPreviousStreamTypeKey] integerValue];
-                CMTime time = [notification.userInfo[SRGMediaPlayerLastPlaybackTimeKey] CMTimeValue];
-                CMTimeRange timeRange = [notification.userInfo[SRGMediaPlayerPreviousTimeRangeKey] CMTimeRangeValue];
-                [tracker recordEvent:ComScoreMediaPlayerTrackerEventEnd
-                      withStreamType:streamType
-                                time:time
-                           timeRange:timeRange];
-            }
-            s_trackers[key] = nil;
-            
-            SRGAnalyticsMediaPlayerLogInfo(@"comScoreTracker", @"Stopped tracking for %@", key);
-        }
+        SRGAnalyticsMediaPlayerLogInfo(@"comScoreTracker", @"Started tracking for %p", mediaPlayerController);
     }
+    return tracker;
 }
 
-- (void)playbackStateDidChange:(NSNotification *)notification
+- (void)playbackDidChangeWithSnapshot:(SRGMediaPlaybackSnapshot *)snapshot
 {
-    SRGMediaPlayerController *mediaPlayerController = notification.object;
-    if (! mediaPlayerController.tracked) {
-        return;
+    [self recordEventForPlaybackState:snapshot.playbackState
+                       withStreamType:snapshot.streamType
+                                 time:snapshot.time
+                            timeRange:snapshot.timeRange];
+}
+
+- (void)trackingDidChangeWithSnapshot:(SRGMediaPlaybackSnapshot *)snapshot
+{
+    if (snapshot.tracked) {
+        [self recordEventForPlaybackState:snapshot.playbackState
+                           withStreamType:snapshot.streamType
+                                     time:snapshot.time
+                                timeRange:snapshot.timeRange];
     }
-    
-    SRGMediaPlayerPlaybackState playbackState = mediaPlayerController.playbackState;
-    if (playbackState == SRGMediaPlayerPlaybackStateIdle || playbackState == SRGMediaPlayerPlaybackStatePreparing) {
-        return;
+    else {
+        [self recordEvent:SRGMediaTrackerEventEnd
+           withStreamType:snapshot.streamType
+                     time:snapshot.time
+                timeRange:snapshot.timeRange];
     }
-    
-    [self recordEventForPlaybackState:playbackState
-                       withStreamType:mediaPlayerController.streamType
-                                 time:mediaPlayerController.currentTime
-                            timeRange:mediaPlayerController.timeRange];
 }
 
-@end
-
-#pragma mark Static functions
-
-__attribute__((constructor)) static void SRGMediaPlayerTrackerInit(void)
+- (void)playbackDidStopWithSnapshot:(SRGMediaPlaybackSnapshot *)snapshot
 {
-    // Observe state changes for all media player controllers to create and remove trackers on the fly
-    [NSNotificationCenter.defaultCenter addObserver:SRGComScoreMediaPlayerTracker.class
-                                           selector:@selector(playbackStateDidChange:)
-                                               name:SRGMediaPlayerPlaybackStateDidChangeNotification
-                                             object:nil];
+    if (snapshot.previousPlaybackState != SRGMediaPlayerPlaybackStatePreparing) {
+        [self recordEvent:SRGMediaTrackerEventEnd
+           withStreamType:snapshot.streamType
+                     time:snapshot.time
+                timeRange:snapshot.timeRange];
+    }
     
-    s_trackers = [NSMutableDictionary dictionary];
+    SRGAnalyticsMediaPlayerLogInfo(@"comScoreTracker", @"Stopped tracking for %p", self.mediaPlayerController);
 }
+
+@end
@@ -0,0 +1,67 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+@import Foundation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Incremental estimator of the observed (network throughput) and indicated (stream variant) bitrates of a playback
+ *  session, fed one access log sample at a time. For each bitrate, the estimator keeps:
+ *    - An exponentially weighted moving average (EWMA) of all samples.
+ *    - The latest samples in a fixed-size window, from which percentiles are calculated.
+ *
+ *  Memory is allocated once, when the estimator is created. Adding a sample is O(1). Percentiles sort the window
+ *  (whose size is fixed) lazily, and only once after a sample has been added.
+ *
+ *  @discussion Not thread-safe.
+ */
+@interface SRGMediaBandwidthEstimator : NSObject
+
+/**
+ *  Create an estimator with the specified EWMA smoothing factor (between 0 and 1, larger values giving more weight
+ *  to recent samples) and percentile window size.
+ */
+- (instancetype)initWithSmoothingFactor:(double)smoothingFactor windowSize:(NSUInteger)windowSize NS_DESIGNATED_INITIALIZER;
+
+/**
+ *  Create an estimator with default settings.
+ */
+- (instancetype)init;
+
+/**
+ *  Add a sample, with bitrates in bits per second. Invalid bitrates (zero, negative or NaN, as reported by
+ *  `AVFoundation` when unknown, e.g. for an access log entry which just started) are ignored.
+ */
+- (void)addObservedBitrate:(double)observedBitrate indicatedBitrate:(double)indicatedBitrate;
+
+/**
+ *  Discard all samples.
+ */
+- (void)reset;
+
+/**
+ *  The number of valid observed and indicated bitrate samples added since creation or the last reset.
+ */
+@property (nonatomic, readonly) NSUInteger observedBitrateSampleCount;
+@property (nonatomic, readonly) NSUInteger indicatedBitrateSampleCount;
+
+/**
+ *  Moving averages of the observed and indicated bitrates, in bits per second. `nil` if no sample is available.
+ */
+@property (nonatomic, readonly, nullable) NSNumber *observedBitrate;
+@property (nonatomic, readonly, nullable) NSNumber *indicatedBitrate;
+
+/**
+ *  Return the specified percentile (between 0 and 100, nearest-rank) of the latest observed or indicated bitrates,
+ *  in bits per second. `nil` if no sample is available.
+ */
+- (nullable NSNumber *)observedBitratePercentile:(double)percentile;
+- (nullable NSNumber *)indicatedBitratePercentile:(double)percentile;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,182 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGMediaBandwidthEstimator.h"
+
+#import <math.h>
+
+static const double SRGMediaBandwidthEstimatorDefaultSmoothingFactor = 0.3;
+static const NSUInteger SRGMediaBandwidthEstimatorDefaultWindowSize = 32;
+
+typedef struct {
+    double *samples;                // Ring buffer of the latest samples
+    double *sortedSamples;          // Sorted copy of the ring buffer, lazily updated
+    NSUInteger windowSize;
+    NSUInteger sampleCount;         // Total number of samples, possibly larger than the window size
+    NSUInteger nextIndex;
+    double average;
+    BOOL sorted;
+} SRGMediaBandwidthSeries;
+
+static void SRGMediaBandwidthSeriesInit(SRGMediaBandwidthSeries *series, NSUInteger windowSize)
+{
+    series->samples = calloc(windowSize, sizeof(double));
+    series->sortedSamples = calloc(windowSize, sizeof(double));
+    series->windowSize = windowSize;
+    series->sampleCount = 0;
+    series->nextIndex = 0;
+    series->average = 0.;
+    series->sorted = NO;
+}
+
+static void SRGMediaBandwidthSeriesDestroy(SRGMediaBandwidthSeries *series)
+{
+    free(series->samples);
+    free(series->sortedSamples);
+}
+
+static void SRGMediaBandwidthSeriesReset(SRGMediaBandwidthSeries *series)
+{
+    series->sampleCount = 0;
+    series->nextIndex = 0;
+    series->average = 0.;
+    series->sorted = NO;
+}
+
+static void SRGMediaBandwidthSeriesAdd(SRGMediaBandwidthSeries *series, double sample, double smoothingFactor)
+{
+    if (isnan(sample) || sample <= 0.) {
+        return;
+    }
+    
+    series->average = (series->sampleCount == 0) ? sample : smoothingFactor * sample + (1. - smoothingFactor) * series->average;
+    series->samples[series->nextIndex] = sample;
+    series->nextIndex = (series->nextIndex + 1) % series->windowSize;
+    series->sampleCount += 1;
+    series->sorted = NO;
+}
+
+static int SRGMediaBandwidthCompare(const void *value1, const void *value2)
+{
+    double sample1 = *(const double *)value1;
+    double sample2 = *(const double *)value2;
+    return (sample1 > sample2) - (sample1 < sample2);
+}
+
+static NSNumber *SRGMediaBandwidthSeriesPercentile(SRGMediaBandwidthSeries *series, double percentile)
+{
+    NSCParameterAssert(percentile >= 0. && percentile <= 100.);
+    
+    if (series->sampleCount == 0) {
+        return nil;
+    }
+    
+    NSUInteger count = MIN(series->sampleCount, series->windowSize);
+    if (! series->sorted) {
+        memcpy(series->sortedSamples, series->samples, count * sizeof(double));
+        qsort(series->sortedSamples, count, sizeof(double), SRGMediaBandwidthCompare);
+        series->sorted = YES;
+    }
+    
+    // Nearest-rank method
+    NSUInteger rank = (NSUInteger)ceil(percentile / 100. * count);
+    return @(series->sortedSamples[MAX(rank, 1) - 1]);
+}
+
+@implementation SRGMediaBandwidthEstimator {
+@private
+    SRGMediaBandwidthSeries _observedBitrates;
+    SRGMediaBandwidthSeries _indicatedBitrates;
+    double _smoothingFactor;
+}
+
+#pragma mark Object lifecycle
+
+- (instancetype)initWithSmoothingFactor:(double)smoothingFactor windowSize:(NSUInteger)windowSize
+{
+    NSParameterAssert(smoothingFactor > 0. && smoothingFactor <= 1.);
+    NSParameterAssert(windowSize > 0);
+    
+    if (self = [super init]) {
+        _smoothingFactor = smoothingFactor;
+        SRGMediaBandwidthSeriesInit(&_observedBitrates, MAX(windowSize, 1));
+        SRGMediaBandwidthSeriesInit(&_indicatedBitrates, MAX(windowSize, 1));
+    }
+    return self;
+}
+
+- (instancetype)init
+{
+    return [self initWithSmoothingFactor:SRGMediaBandwidthEstimatorDefaultSmoothingFactor windowSize:SRGMediaBandwidthEstimatorDefaultWindowSize];
+}
+
+- (void)dealloc
+{
+    SRGMediaBandwidthSeriesDestroy(&_observedBitrates);
+    SRGMediaBandwidthSeriesDestroy(&_indicatedBitrates);
+}
+
+#pragma mark Getters and setters
+
+- (NSUInteger)observedBitrateSampleCount
+{
+    return _observedBitrates.sampleCount;
+}
+
+- (NSUInteger)indicatedBitrateSampleCount
+{
+    return _indicatedBitrates.sampleCount;
+}
+
+- (NSNumber *)observedBitrate
+{
+    return (_observedBitrates.sampleCount != 0) ? @(_observedBitrates.average) : nil;
+}
+
+- (NSNumber *)indicatedBitrate
+{
+    return (_indicatedBitrates.sampleCount != 0) ? @(_indicatedBitrates.average) : nil;
+}
+
+#pragma mark Samples
+
+- (void)addObservedBitrate:(double)observedBitrate indicatedBitrate:(double)indicatedBitrate
+{
+    SRGMediaBandwidthSeriesAdd(&_observedBitrates, observedBitrate, _smoothingFactor);
+    SRGMediaBandwidthSeriesAdd(&_indicatedBitrates, indicatedBitrate, _smoothingFactor);
+}
+
+- (void)reset
+{
+    SRGMediaBandwidthSeriesReset(&_observedBitrates);
+    SRGMediaBandwidthSeriesReset(&_indicatedBitrates);
+}
+
+#pragma mark Percentiles
+
+- (NSNumber *)observedBitratePercentile:(double)percentile
+{
+    return SRGMediaBandwidthSeriesPercentile(&_observedBitrates, percentile);
+}
+
+- (NSNumber *)indicatedBitratePercentile:(double)percentile
+{
+    return SRGMediaBandwidthSeriesPercentile(&_indicatedBitrates, percentile);
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; observedBitrate = %@; indicatedBitrate = %@; observedBitrateSampleCount = %@>",
+            self.class,
+            self,
+            self.observedBitrate,
+            self.indicatedBitrate,
+            @(self.observedBitrateSampleCount)];
+}
+
+@end
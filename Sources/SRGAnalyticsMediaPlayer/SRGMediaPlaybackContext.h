@@ -0,0 +1,70 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGMediaBandwidthEstimator.h"
+
+@import Foundation;
+@import SRGMediaPlayer;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Playback information of a media player controller which is costly to query from AVFoundation, cached and updated
+ *  incrementally from change notifications and key-value observation rather than read for each event:
+ *    - The volume is updated when the system output volume or the player mute status change.
+ *    - Bandwidth estimates are updated with the final values of an access log entry when the next one is added to the
+ *      current item, and reset when the current item changes. Until an entry has been completed, the observed bitrate
+ *      of the first entry is read on demand instead.
+ *    - Media selections are resolved again only after a media selection change, or when the current item changes.
+ *      Before iOS / tvOS 13, where no media selection change notification is available, they are resolved each time
+ *      they are read.
+ *
+ *  @discussion Must be used from the main thread.
+ */
+@interface SRGMediaPlaybackContext : NSObject
+
+/**
+ *  Create a context for the specified controller, which is weakly referenced.
+ */
+- (instancetype)initWithMediaPlayerController:(SRGMediaPlayerController *)mediaPlayerController NS_DESIGNATED_INITIALIZER;
+
+/**
+ *  The player volume, in percent. `nil` if there is no player or if it is muted.
+ */
+@property (nonatomic, readonly, nullable) NSNumber *volumeInPercent;
+
+/**
+ *  Bandwidth estimates for the current item.
+ */
+@property (nonatomic, readonly) SRGMediaBandwidthEstimator *bandwidthEstimator;
+
+/**
+ *  The observed bitrate of the first access log entry of the current item, in bits per second, available until this
+ *  entry has been completed and fed to the bandwidth estimator. `nil` if unknown.
+ *
+ *  @discussion The access log is only read while it holds its first entry, and until a valid value has been found.
+ */
+@property (nonatomic, readonly, nullable) NSNumber *initialObservedBitrate;
+
+/**
+ *  The uppercase language code of the selected subtitles (`UND` if unknown), `nil` if none.
+ */
+@property (nonatomic, readonly, copy, nullable) NSString *subtitlesLanguageCode;
+
+/**
+ *  The uppercase language code of the selected audio track (`UND` if unknown), `nil` if none.
+ */
+@property (nonatomic, readonly, copy, nullable) NSString *audioTrackLanguageCode;
+
+@end
+
+@interface SRGMediaPlaybackContext (Unavailable)
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
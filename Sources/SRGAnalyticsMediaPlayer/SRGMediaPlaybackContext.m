@@ -0,0 +1,246 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGMediaPlaybackContext.h"
+
+#import "AVPlayerItem+SRGAnalyticsMediaPlayer.h"
+#import "SRGMediaBandwidthEstimator.h"
+
+@import AVFoundation;
+@import libextobjc;
+@import MAKVONotificationCenter;
+
+static NSString *SRGMediaPlaybackContextLanguageCode(AVMediaSelectionOption *option)
+{
+    if (! option) {
+        return nil;
+    }
+    
+    NSString *languageCode = [option.locale objectForKey:NSLocaleLanguageCode] ?: @"und";
+    return languageCode.uppercaseString;
+}
+
+@interface SRGMediaPlaybackContext ()
+
+@property (nonatomic, weak) SRGMediaPlayerController *mediaPlayerController;
+@property (nonatomic, weak) AVPlayerItem *playerItem;
+
+@property (nonatomic) NSNumber *volumeInPercent;
+@property (nonatomic) SRGMediaBandwidthEstimator *bandwidthEstimator;
+@property (nonatomic) NSNumber *cachedInitialObservedBitrate;
+@property (nonatomic, getter=isAccessLogEntryCompleted) BOOL accessLogEntryCompleted;
+
+@property (nonatomic, copy) NSString *cachedSubtitlesLanguageCode;
+@property (nonatomic, copy) NSString *cachedAudioTrackLanguageCode;
+@property (nonatomic, getter=isMediaSelectionResolved) BOOL mediaSelectionResolved;
+
+@end
+
+@implementation SRGMediaPlaybackContext
+
+#pragma mark Object lifecycle
+
+- (instancetype)initWithMediaPlayerController:(SRGMediaPlayerController *)mediaPlayerController
+{
+    if (self = [super init]) {
+        self.mediaPlayerController = mediaPlayerController;
+        self.bandwidthEstimator = [[SRGMediaBandwidthEstimator alloc] init];
+        
+        @weakify(self)
+        [mediaPlayerController addObserver:self keyPath:@keypath(SRGMediaPlayerController.new, player.muted) options:0 block:^(MAKVONotification *notification) {
+            @strongify(self)
+            [self updateVolume];
+        }];
+        [mediaPlayerController addObserver:self keyPath:@keypath(SRGMediaPlayerController.new, player.currentItem) options:0 block:^(MAKVONotification *notification) {
+            @strongify(self)
+            [self updatePlayerItem];
+        }];
+        
+        [AVAudioSession.sharedInstance addObserver:self keyPath:@keypath(AVAudioSession.new, outputVolume) options:0 block:^(MAKVONotification *notification) {
+            dispatch_async(dispatch_get_main_queue(), ^{
+                @strongify(self)
+                [self updateVolume];
+            });
+        }];
+        
+        [self updateVolume];
+        [self updatePlayerItem];
+    }
+    return self;
+}
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-implementations"
+
+- (instancetype)init
+{
+    [self doesNotRecognizeSelector:_cmd];
+    return [self initWithMediaPlayerController:SRGMediaPlayerController.new];
+}
+
+#pragma clang diagnostic pop
+
+- (void)dealloc
+{
+    [NSNotificationCenter.defaultCenter removeObserver:self];
+}
+
+#pragma mark Getters and setters
+
+- (NSString *)subtitlesLanguageCode
+{
+    [self resolveMediaSelectionIfNeeded];
+    return self.cachedSubtitlesLanguageCode;
+}
+
+- (NSString *)audioTrackLanguageCode
+{
+    [self resolveMediaSelectionIfNeeded];
+    return self.cachedAudioTrackLanguageCode;
+}
+
+- (NSNumber *)initialObservedBitrate
+{
+    if (self.accessLogEntryCompleted) {
+        return nil;
+    }
+    
+    // The log holds a single entry at most, reading it is cheap
+    if (! self.cachedInitialObservedBitrate) {
+        double observedBitrate = self.playerItem.accessLog.events.firstObject.observedBitrate;
+        if (observedBitrate > 0.) {
+            self.cachedInitialObservedBitrate = @(observedBitrate);
+        }
+    }
+    return self.cachedInitialObservedBitrate;
+}
+
+#pragma mark Updates
+
+- (void)updateVolume
+{
+    // AVPlayer has a volume property, but its purpose is NOT end-user volume control (see documentation). This volume is
+    // therefore not relevant for our calculations.
+    AVPlayer *player = self.mediaPlayerController.player;
+    if (! player || player.muted) {
+        self.volumeInPercent = nil;
+    }
+    // When we have a non-muted player, its volume is simply the system volume (note that this volume does not take
+    // into account the ringer status).
+    else {
+        NSInteger volume = AVAudioSession.sharedInstance.outputVolume * 100;
+        self.volumeInPercent = @(volume);
+    }
+}
+
+- (void)updatePlayerItem
+{
+    AVPlayerItem *playerItem = self.mediaPlayerController.player.currentItem;
+    if (playerItem == self.playerItem) {
+        return;
+    }
+    
+    NSNotificationCenter *notificationCenter = NSNotificationCenter.defaultCenter;
+    [notificationCenter removeObserver:self name:AVPlayerItemNewAccessLogEntryNotification object:nil];
+    if (@available(iOS 13, tvOS 13, *)) {
+        [notificationCenter removeObserver:self name:AVPlayerItemMediaSelectionDidChangeNotification object:nil];
+    }
+    
+    self.playerItem = playerItem;
+    self.mediaSelectionResolved = NO;
+    self.cachedSubtitlesLanguageCode = nil;
+    self.cachedAudioTrackLanguageCode = nil;
+    [self.bandwidthEstimator reset];
+    self.cachedInitialObservedBitrate = nil;
+    self.accessLogEntryCompleted = NO;
+    
+    if (playerItem) {
+        [notificationCenter addObserver:self
+                               selector:@selector(playerItemNewAccessLogEntry:)
+                                   name:AVPlayerItemNewAccessLogEntryNotification
+                                 object:playerItem];
+        if (@available(iOS 13, tvOS 13, *)) {
+            [notificationCenter addObserver:self
+                                   selector:@selector(playerItemMediaSelectionDidChange:)
+                                       name:AVPlayerItemMediaSelectionDidChangeNotification
+                                     object:playerItem];
+        }
+    }
+}
+
+// Reading the access log copies all of its entries, which is why it is only done when a new entry is available, each
+// completed entry being fed to the estimator once
+- (void)updateBandwidthWithCompletedEntry
+{
+    NSArray<AVPlayerItemAccessLogEvent *> *events = self.playerItem.accessLog.events;
+    if (events.count < 2) {
+        return;
+    }
+    
+    // When a new entry starts, the previous one is complete and its values final
+    self.accessLogEntryCompleted = YES;
+    AVPlayerItemAccessLogEvent *event = events[events.count - 2];
+    [self.bandwidthEstimator addObservedBitrate:event.observedBitrate indicatedBitrate:event.indicatedBitrate];
+}
+
+- (void)resolveMediaSelectionIfNeeded
+{
+    if (self.mediaSelectionResolved) {
+        return;
+    }
+    
+    AVPlayerItem *playerItem = self.playerItem;
+    AVAsset *asset = playerItem.asset;
+    if ([asset statusOfValueForKey:@keypath(asset.availableMediaCharacteristicsWithMediaSelectionOptions) error:NULL] != AVKeyValueStatusLoaded) {
+        self.cachedSubtitlesLanguageCode = nil;
+        self.cachedAudioTrackLanguageCode = nil;
+        return;
+    }
+    
+    AVMediaSelectionGroup *legibleGroup = [asset mediaSelectionGroupForMediaCharacteristic:AVMediaCharacteristicLegible];
+    self.cachedSubtitlesLanguageCode = SRGMediaPlaybackContextLanguageCode([playerItem srganalytics_selectedMediaOptionInMediaSelectionGroup:legibleGroup]);
+    
+    AVMediaSelectionGroup *audibleGroup = [asset mediaSelectionGroupForMediaCharacteristic:AVMediaCharacteristicAudible];
+    self.cachedAudioTrackLanguageCode = SRGMediaPlaybackContextLanguageCode([playerItem srganalytics_selectedMediaOptionInMediaSelectionGroup:audibleGroup]);
+    
+    // Without change notifications, selections must be resolved each time
+    if (@available(iOS 13, tvOS 13, *)) {
+        self.mediaSelectionResolved = YES;
+    }
+}
+
+#pragma mark Notifications
+
+- (void)playerItemNewAccessLogEntry:(NSNotification *)notification
+{
+    dispatch_async(dispatch_get_main_queue(), ^{
+        if (notification.object == self.playerItem) {
+            [self updateBandwidthWithCompletedEntry];
+        }
+    });
+}
+
+- (void)playerItemMediaSelectionDidChange:(NSNotification *)notification
+{
+    dispatch_async(dispatch_get_main_queue(), ^{
+        if (notification.object == self.playerItem) {
+            self.mediaSelectionResolved = NO;
+        }
+    });
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; volumeInPercent = %@; bandwidthEstimator = %@>",
+            self.class,
+            self,
+            self.volumeInPercent,
+            self.bandwidthEstimator];
+}
+
+@end
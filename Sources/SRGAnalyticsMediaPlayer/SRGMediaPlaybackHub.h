@@ -0,0 +1,120 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+@import Foundation;
+@import SRGMediaPlayer;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Playback information of a media player controller, captured once per transition and shared by all tracker backends.
+ */
+@interface SRGMediaPlaybackSnapshot : NSObject
+
+/**
+ *  The playback state, and the state before the transition.
+ */
+@property (nonatomic, readonly) SRGMediaPlayerPlaybackState playbackState;
+@property (nonatomic, readonly) SRGMediaPlayerPlaybackState previousPlaybackState;
+
+/**
+ *  The stream type, time and time range. When playback stops, values of the stopped playback.
+ */
+@property (nonatomic, readonly) SRGMediaPlayerStreamType streamType;
+@property (nonatomic, readonly) CMTime time;
+@property (nonatomic, readonly) CMTimeRange timeRange;
+
+/**
+ *  The timeshift in milliseconds (@see `SRGMediaAnalyticsTimeshiftInMilliseconds()`), `nil` if not a livestream.
+ */
+@property (nonatomic, readonly, nullable) NSNumber *timeshift;
+
+/**
+ *  The controller user information. When playback stops, the user information of the stopped playback.
+ */
+@property (nonatomic, readonly, nullable) NSDictionary *userInfo;
+
+/**
+ *  Whether the controller is tracked.
+ */
+@property (nonatomic, readonly, getter=isTracked) BOOL tracked;
+
+@end
+
+/**
+ *  A tracker backend, attached to a media player controller by the hub for the duration of a playback.
+ */
+@protocol SRGMediaPlaybackBackend <NSObject>
+
+/**
+ *  Return a backend for a controller preparing to play (whether tracked or not), or `nil` if the playback must not be
+ *  tracked by the backend.
+ */
++ (nullable id<SRGMediaPlaybackBackend>)backendForMediaPlayerController:(SRGMediaPlayerController *)mediaPlayerController
+                                                           withSnapshot:(SRGMediaPlaybackSnapshot *)snapshot;
+
+/**
+ *  Called when the playback state of a tracked controller changes, except for transitions to the idle or preparing
+ *  states.
+ */
+- (void)playbackDidChangeWithSnapshot:(SRGMediaPlaybackSnapshot *)snapshot;
+
+/**
+ *  Called when the `tracked` property of the controller changes.
+ */
+- (void)trackingDidChangeWithSnapshot:(SRGMediaPlaybackSnapshot *)snapshot;
+
+/**
+ *  Called when the controller returns to the idle state after preparation, whether tracked or not. The backend is
+ *  released afterwards.
+ */
+- (void)playbackDidStopWithSnapshot:(SRGMediaPlaybackSnapshot *)snapshot;
+
+@optional
+
+/**
+ *  Called when a segment is selected while a tracked controller plays.
+ */
+- (void)segmentDidStartWithSnapshot:(SRGMediaPlaybackSnapshot *)snapshot selectionReason:(SRGMediaPlayerSelectionReason)selectionReason;
+
+@end
+
+/**
+ *  Observes media player controllers once on behalf of all tracker backends. For each playback transition, a single
+ *  snapshot is captured and dispatched to the backends attached to the controller, in backend class registration
+ *  order.
+ *
+ *  Backends are attached when a controller prepares to play and released when it returns to the idle state or is
+ *  deallocated. The controller registry holds controllers weakly.
+ *
+ *  @discussion Thread-safe. Backends are called on the thread controller notifications are posted on (the main thread).
+ */
+@interface SRGMediaPlaybackHub : NSObject
+
+/**
+ *  The hub instance.
+ */
+@property (class, nonatomic, readonly) SRGMediaPlaybackHub *sharedHub;
+
+/**
+ *  Register a backend class. Backends of this class are attached to controllers preparing to play afterwards.
+ *  Registering a class several times has no effect.
+ */
+- (void)registerBackendClass:(Class<SRGMediaPlaybackBackend>)backendClass;
+
+/**
+ *  The backends currently attached to the specified controller.
+ */
+- (NSArray<id<SRGMediaPlaybackBackend>> *)backendsForMediaPlayerController:(SRGMediaPlayerController *)mediaPlayerController;
+
+/**
+ *  The number of controllers with attached backends.
+ */
+@property (nonatomic, readonly) NSUInteger mediaPlayerControllerCount;
+
+@end
+
+NS_ASSUME_NONNULL_END
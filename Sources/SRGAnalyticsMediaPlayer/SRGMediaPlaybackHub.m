@@ -0,0 +1,327 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGMediaPlaybackHub.h"
+
+#import "SRGAnalyticsTracker+Private.h"
+#import "SRGMediaAnalytics.h"
+#import "SRGMediaPlayerController+SRGAnalyticsMediaPlayer.h"
+
+@import libextobjc;
+@import MAKVONotificationCenter;
+
+#import <objc/runtime.h>
+#import <pthread.h>
+
+static void *s_playbackSessionKey = &s_playbackSessionKey;
+
+@interface SRGMediaPlaybackSnapshot ()
+
+@property (nonatomic) SRGMediaPlayerPlaybackState playbackState;
+@property (nonatomic) SRGMediaPlayerPlaybackState previousPlaybackState;
+@property (nonatomic) SRGMediaPlayerStreamType streamType;
+@property (nonatomic) CMTime time;
+@property (nonatomic) CMTimeRange timeRange;
+@property (nonatomic) NSNumber *timeshift;
+@property (nonatomic) NSDictionary *userInfo;
+@property (nonatomic, getter=isTracked) BOOL tracked;
+
+@end
+
+/**
+ *  Backends attached to a controller for a playback. Retained by the controller itself, so that backends never outlive
+ *  it.
+ */
+@interface SRGMediaPlaybackSession : NSObject
+
+@property (nonatomic, copy) NSArray<id<SRGMediaPlaybackBackend>> *backends;
+
+@end
+
+@interface SRGMediaPlaybackHub () {
+@private
+    pthread_mutex_t _mutex;
+}
+
+// Guarded by the mutex
+@property (nonatomic) NSArray<Class<SRGMediaPlaybackBackend>> *backendClasses;
+@property (nonatomic) NSMapTable<SRGMediaPlayerController *, SRGMediaPlaybackSession *> *sessions;
+
+@end
+
+@implementation SRGMediaPlaybackHub
+
+#pragma mark Class methods
+
++ (SRGMediaPlaybackHub *)sharedHub
+{
+    static SRGMediaPlaybackHub *s_sharedHub = nil;
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        s_sharedHub = [SRGMediaPlaybackHub new];
+    });
+    return s_sharedHub;
+}
+
+#pragma mark Object lifecycle
+
+- (instancetype)init
+{
+    if (self = [super init]) {
+        pthread_mutex_init(&_mutex, NULL);
+        
+        self.backendClasses = @[];
+        
+        // Sessions are owned by their controller, the registry only references both weakly
+        self.sessions = [NSMapTable weakToWeakObjectsMapTable];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [NSNotificationCenter.defaultCenter removeObserver:self];
+    pthread_mutex_destroy(&_mutex);
+}
+
+#pragma mark Getters and setters
+
+- (NSUInteger)mediaPlayerControllerCount
+{
+    pthread_mutex_lock(&_mutex);
+    NSUInteger count = self.sessions.keyEnumerator.allObjects.count;
+    pthread_mutex_unlock(&_mutex);
+    return count;
+}
+
+#pragma mark Registration
+
+- (void)registerBackendClass:(Class<SRGMediaPlaybackBackend>)backendClass
+{
+    pthread_mutex_lock(&_mutex);
+    BOOL registered = [self.backendClasses containsObject:backendClass];
+    BOOL firstRegistration = (self.backendClasses.count == 0);
+    if (! registered) {
+        self.backendClasses = [self.backendClasses arrayByAddingObject:backendClass];
+    }
+    pthread_mutex_unlock(&_mutex);
+    
+    // Observe all media player controllers to attach and release backends on the fly
+    if (! registered && firstRegistration) {
+        [NSNotificationCenter.defaultCenter addObserver:self
+                                               selector:@selector(playbackStateDidChange:)
+                                                   name:SRGMediaPlayerPlaybackStateDidChangeNotification
+                                                 object:nil];
+        [NSNotificationCenter.defaultCenter addObserver:self
+                                               selector:@selector(segmentDidStart:)
+                                                   name:SRGMediaPlayerSegmentDidStartNotification
+                                                 object:nil];
+    }
+}
+
+- (NSArray<id<SRGMediaPlaybackBackend>> *)backendsForMediaPlayerController:(SRGMediaPlayerController *)mediaPlayerController
+{
+    pthread_mutex_lock(&_mutex);
+    NSArray<id<SRGMediaPlaybackBackend>> *backends = [self.sessions objectForKey:mediaPlayerController].backends;
+    pthread_mutex_unlock(&_mutex);
+    return backends ?: @[];
+}
+
+#pragma mark Sessions
+
+- (void)startSessionForMediaPlayerController:(SRGMediaPlayerController *)mediaPlayerController
+{
+    pthread_mutex_lock(&_mutex);
+    NSArray<Class<SRGMediaPlaybackBackend>> *backendClasses = self.backendClasses;
+    pthread_mutex_unlock(&_mutex);
+    
+    SRGMediaPlaybackSnapshot *snapshot = [self snapshotForMediaPlayerController:mediaPlayerController];
+    NSMutableArray<id<SRGMediaPlaybackBackend>> *backends = [NSMutableArray array];
+    for (Class<SRGMediaPlaybackBackend> backendClass in backendClasses) {
+        id<SRGMediaPlaybackBackend> backend = [backendClass backendForMediaPlayerController:mediaPlayerController withSnapshot:snapshot];
+        if (backend) {
+            [backends addObject:backend];
+        }
+    }
+    
+    if (backends.count == 0) {
+        [self stopSessionForMediaPlayerController:mediaPlayerController];
+        return;
+    }
+    
+    SRGMediaPlaybackSession *session = [[SRGMediaPlaybackSession alloc] init];
+    session.backends = backends;
+    objc_setAssociatedObject(mediaPlayerController, s_playbackSessionKey, session, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    
+    pthread_mutex_lock(&_mutex);
+    [self.sessions setObject:session forKey:mediaPlayerController];
+    pthread_mutex_unlock(&_mutex);
+    
+    @weakify(self, mediaPlayerController)
+    [mediaPlayerController addObserver:session keyPath:@keypath(SRGMediaPlayerController.new, tracked) options:0 block:^(MAKVONotification *notification) {
+        @strongify(self, mediaPlayerController)
+        
+        SRGMediaPlaybackSnapshot *snapshot = [self snapshotForMediaPlayerController:mediaPlayerController];
+        for (id<SRGMediaPlaybackBackend> backend in [self backendsForMediaPlayerController:mediaPlayerController]) {
+            [backend trackingDidChangeWithSnapshot:snapshot];
+        }
+    }];
+}
+
+- (SRGMediaPlaybackSession *)stopSessionForMediaPlayerController:(SRGMediaPlayerController *)mediaPlayerController
+{
+    pthread_mutex_lock(&_mutex);
+    SRGMediaPlaybackSession *session = [self.sessions objectForKey:mediaPlayerController];
+    [self.sessions removeObjectForKey:mediaPlayerController];
+    pthread_mutex_unlock(&_mutex);
+    
+    // Keep the session alive until the caller is done with it
+    objc_setAssociatedObject(mediaPlayerController, s_playbackSessionKey, nil, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    return session;
+}
+
+#pragma mark Snapshots
+
+- (SRGMediaPlaybackSnapshot *)snapshotForMediaPlayerController:(SRGMediaPlayerController *)mediaPlayerController
+{
+    SRGMediaPlaybackSnapshot *snapshot = [[SRGMediaPlaybackSnapshot alloc] init];
+    snapshot.playbackState = mediaPlayerController.playbackState;
+    snapshot.previousPlaybackState = mediaPlayerController.playbackState;
+    snapshot.streamType = mediaPlayerController.streamType;
+    snapshot.time = mediaPlayerController.currentTime;
+    snapshot.timeRange = mediaPlayerController.timeRange;
+    snapshot.timeshift = SRGMediaAnalyticsTimeshiftInMilliseconds(snapshot.streamType, snapshot.timeRange, snapshot.time, mediaPlayerController.liveTolerance);
+    snapshot.userInfo = mediaPlayerController.userInfo;
+    snapshot.tracked = mediaPlayerController.tracked;
+    return snapshot;
+}
+
+- (SRGMediaPlaybackSnapshot *)snapshotForMediaPlayerController:(SRGMediaPlayerController *)mediaPlayerController notification:(NSNotification *)notification
+{
+    NSDictionary *userInfo = notification.userInfo;
+    SRGMediaPlayerPlaybackState playbackState = [userInfo[SRGMediaPlayerPlaybackStateKey] integerValue];
+    
+    SRGMediaPlaybackSnapshot *snapshot = nil;
+    
+    // Once idle, the controller has been reset. Use values of the playback which just stopped.
+    if (playbackState == SRGMediaPlayerPlaybackStateIdle) {
+        snapshot = [[SRGMediaPlaybackSnapshot alloc] init];
+        snapshot.playbackState = playbackState;
+        snapshot.streamType = [userInfo[SRGMediaPlayerPreviousStreamTypeKey] integerValue];
+        snapshot.time = [userInfo[SRGMediaPlayerLastPlaybackTimeKey] CMTimeValue];
+        snapshot.timeRange = [userInfo[SRGMediaPlayerPreviousTimeRangeKey] CMTimeRangeValue];
+        snapshot.timeshift = SRGMediaAnalyticsTimeshiftInMilliseconds(snapshot.streamType, snapshot.timeRange, snapshot.time, mediaPlayerController.liveTolerance);
+        snapshot.userInfo = userInfo[SRGMediaPlayerPreviousUserInfoKey];
+        snapshot.tracked = mediaPlayerController.tracked;
+    }
+    else {
+        snapshot = [self snapshotForMediaPlayerController:mediaPlayerController];
+    }
+    snapshot.previousPlaybackState = [userInfo[SRGMediaPlayerPreviousPlaybackStateKey] integerValue];
+    return snapshot;
+}
+
+#pragma mark Notifications
+
+- (void)playbackStateDidChange:(NSNotification *)notification
+{
+    SRGMediaPlayerController *mediaPlayerController = notification.object;
+    SRGMediaPlayerPlaybackState playbackState = [notification.userInfo[SRGMediaPlayerPlaybackStateKey] integerValue];
+    
+    // Always attach backends to the player controller, whether or not it is actually tracked (otherwise we would be
+    // unable to attach to initially untracked controllers later).
+    if (playbackState == SRGMediaPlayerPlaybackStatePreparing) {
+        if (SRGAnalyticsTracker.sharedTracker.configuration) {
+            [self startSessionForMediaPlayerController:mediaPlayerController];
+        }
+    }
+    else if (playbackState == SRGMediaPlayerPlaybackStateIdle) {
+        if (! SRGAnalyticsTracker.sharedTracker.configuration) {
+            return;
+        }
+        
+        SRGMediaPlaybackSession *session = [self stopSessionForMediaPlayerController:mediaPlayerController];
+        if (session.backends.count == 0) {
+            return;
+        }
+        
+        SRGMediaPlaybackSnapshot *snapshot = [self snapshotForMediaPlayerController:mediaPlayerController notification:notification];
+        for (id<SRGMediaPlaybackBackend> backend in session.backends) {
+            [backend playbackDidStopWithSnapshot:snapshot];
+        }
+    }
+    else {
+        NSArray<id<SRGMediaPlaybackBackend>> *backends = [self backendsForMediaPlayerController:mediaPlayerController];
+        if (backends.count == 0 || ! mediaPlayerController.tracked) {
+            return;
+        }
+        
+        SRGMediaPlaybackSnapshot *snapshot = [self snapshotForMediaPlayerController:mediaPlayerController notification:notification];
+        for (id<SRGMediaPlaybackBackend> backend in backends) {
+            [backend playbackDidChangeWithSnapshot:snapshot];
+        }
+    }
+}
+
+- (void)segmentDidStart:(NSNotification *)notification
+{
+    SRGMediaPlayerController *mediaPlayerController = notification.object;
+    if (! mediaPlayerController.tracked || ! [notification.userInfo[SRGMediaPlayerSelectionKey] boolValue]) {
+        return;
+    }
+    
+    NSArray<id<SRGMediaPlaybackBackend>> *backends = [self backendsForMediaPlayerController:mediaPlayerController];
+    if (backends.count == 0) {
+        return;
+    }
+    
+    SRGMediaPlaybackSnapshot *snapshot = [self snapshotForMediaPlayerController:mediaPlayerController];
+    SRGMediaPlayerSelectionReason selectionReason = [notification.userInfo[SRGMediaPlayerSelectionReasonKey] integerValue];
+    for (id<SRGMediaPlaybackBackend> backend in backends) {
+        if ([backend respondsToSelector:@selector(segmentDidStartWithSnapshot:selectionReason:)]) {
+            [backend segmentDidStartWithSnapshot:snapshot selectionReason:selectionReason];
+        }
+    }
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    pthread_mutex_lock(&_mutex);
+    NSArray<Class<SRGMediaPlaybackBackend>> *backendClasses = self.backendClasses;
+    pthread_mutex_unlock(&_mutex);
+    
+    return [NSString stringWithFormat:@"<%@: %p; backendClasses = %@; mediaPlayerControllerCount = %@>",
+            self.class,
+            self,
+            backendClasses,
+            @(self.mediaPlayerControllerCount)];
+}
+
+@end
+
+@implementation SRGMediaPlaybackSnapshot
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; playbackState = %@; streamType = %@; time = %@; timeshift = %@; tracked = %@>",
+            self.class,
+            self,
+            @(self.playbackState),
+            @(self.streamType),
+            @(CMTimeGetSeconds(self.time)),
+            self.timeshift,
+            self.tracked ? @"YES" : @"NO"];
+}
+
+@end
+
+@implementation SRGMediaPlaybackSession
+
+@end
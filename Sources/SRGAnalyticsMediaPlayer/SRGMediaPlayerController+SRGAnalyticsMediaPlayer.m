@@ -6,6 +6,7 @@
 
 #import "SRGMediaPlayerController+SRGAnalyticsMediaPlayer.h"
 
+#import "SRGComScoreMediaPlayerTracker.h"
 #import "SRGMediaAnalytics.h"
 #import "SRGMediaPlayerTracker.h"
 
@@ -22,6 +23,11 @@ static void *s_analyticsPlayerVersionKey = &s_analyticsPlayerVersionKey;
 + (NSDictionary *)fullInfoWithAnalyticsLabels:(SRGAnalyticsStreamLabels *)analyticsLabels
                                      userInfo:(NSDictionary *)userInfo
 {
+    // All playback methods with analytics labels end up here, which is the latest time at which trackers must
+    // observe players to catch their preparation
+    [SRGMediaPlayerTracker srg_installAnalyticsHooks];
+    [SRGComScoreMediaPlayerTracker srg_installAnalyticsHooks];
+    
     NSMutableDictionary *fullUserInfo = [NSMutableDictionary dictionary];
     fullUserInfo[SRGAnalyticsMediaPlayerLabelsKey] = analyticsLabels.copy;
     if (userInfo) {
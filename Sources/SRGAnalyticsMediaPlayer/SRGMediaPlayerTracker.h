@@ -4,16 +4,19 @@
 //  License information is available from the LICENSE file.
 //
 
+#import "SRGAnalyticsTracker+Private.h"
+
 @import Foundation;
 
 NS_ASSUME_NONNULL_BEGIN
 
 /**
- *  The media player tracker class internally listens to SRG MediaPlayer controller notifications to provide automatic
- *  tracking of media consumption. A tracker is automatically associated with a player controller when it prepares
- *  to play, and is removed when the player returns to the idle state.
+ *  The media player tracker class is a playback hub backend (@see `SRGMediaPlaybackHub`) providing automatic tracking
+ *  of media consumption. A tracker is automatically associated with a player controller when it prepares to play, and
+ *  is removed when the player returns to the idle state. The tracker is registered with the hub once hooks have been
+ *  installed, either when the analytics tracker is started or when a player is prepared with analytics labels.
  */
-@interface SRGMediaPlayerTracker : NSObject
+@interface SRGMediaPlayerTracker : NSObject <SRGAnalyticsHookInstalling>
 
 @end
 
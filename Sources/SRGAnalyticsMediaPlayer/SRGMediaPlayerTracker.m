@@ -6,51 +6,48 @@
 
 #import "SRGMediaPlayerTracker.h"
 
-#import "AVPlayerItem+SRGAnalyticsMediaPlayer.h"
-#import "NSMutableDictionary+SRGAnalytics.h"
+#import "SRGAnalyticsClock.h"
+#import "SRGAnalyticsEventRecord+Catalog.h"
+#import "SRGAnalyticsHeartbeatScheduler.h"
 #import "SRGAnalyticsLabels+Private.h"
+#import "SRGAnalyticsLaunchReport+Private.h"
 #import "SRGAnalyticsMediaPlayerLogger.h"
+#import "SRGAnalyticsMetricsRecorder.h"
 #import "SRGAnalyticsTracker+Private.h"
 #import "SRGMediaAnalytics.h"
+#import "SRGMediaPlaybackContext.h"
+#import "SRGMediaPlaybackHub.h"
+#import "SRGMediaTrackerStateMachine.h"
 #import "SRGMediaPlayerController+SRGAnalyticsMediaPlayer.h"
 
 @import libextobjc;
-@import MAKVONotificationCenter;
 
 #import <math.h>
-
-typedef NSString * MediaPlayerTrackerEvent NS_TYPED_ENUM;
-
-static MediaPlayerTrackerEvent const MediaPlayerTrackerEventPlay = @"play";
-static MediaPlayerTrackerEvent const MediaPlayerTrackerEventPause = @"pause";
-static MediaPlayerTrackerEvent const MediaPlayerTrackerEventSeek = @"seek";
-static MediaPlayerTrackerEvent const MediaPlayerTrackerEventEnd = @"eof";
-static MediaPlayerTrackerEvent const MediaPlayerTrackerEventStop = @"stop";
-static MediaPlayerTrackerEvent const MediaPlayerTrackerEventPosition = @"pos";
-static MediaPlayerTrackerEvent const MediaPlayerTrackerEventUptime = @"uptime";
-static MediaPlayerTrackerEvent const MediaPlayerTrackerEventSegment = @"segment";
-
-static NSMutableDictionary<NSValue *, SRGMediaPlayerTracker *> *s_trackers = nil;
+#import <stdatomic.h>
 
 static NSString *SRGMediaPlayerTrackerLabelForSelectionReason(SRGMediaPlayerSelectionReason reason);
 
-@interface SRGMediaPlayerTracker ()
+@interface SRGMediaPlayerTracker () <SRGMediaPlaybackBackend>
 
 @property (nonatomic, weak) SRGMediaPlayerController *mediaPlayerController;
 
 @property (nonatomic) NSTimeInterval playbackDuration;
-@property (nonatomic) NSDate *previousPlaybackDurationUpdateDate;
+@property (nonatomic) uint64_t previousPlaybackDurationUpdateTime;      // Monotonic, 0 if none
 
-@property (nonatomic) NSTimer *heartbeatTimer;
+@property (nonatomic) SRGAnalyticsHeartbeat *heartbeat;
 @property (nonatomic) NSUInteger heartbeatCount;
 
-@property (nonatomic, copy) MediaPlayerTrackerEvent lastEvent;
+@property (nonatomic) SRGMediaTrackerEvent lastEvent;
 
-@property (nonatomic) AVMediaSelectionOption *lastSubtitlesMediaOption;
-@property (nonatomic) AVMediaSelectionOption *lastAudioTrackMediaOption;
+@property (nonatomic) SRGMediaPlaybackContext *playbackContext;
+
+@property (nonatomic, copy) NSString *lastSubtitlesLanguageCode;
+@property (nonatomic, copy) NSString *lastAudioTrackLanguageCode;
 
 @property (nonatomic, copy) NSString *unitTestingIdentifier;
 
+@property (nonatomic) NSUInteger sessionIdentifier;                     // Keeps events of the tracker in order
+
 @end
 
 @implementation SRGMediaPlayerTracker
@@ -60,46 +57,21 @@ static NSString *SRGMediaPlayerTrackerLabelForSelectionReason(SRGMediaPlayerSele
 - (instancetype)initWithMediaPlayerController:(SRGMediaPlayerController *)mediaPlayerController
 {
     if (self = [super init]) {
+        // Balanced in -dealloc, also called when initialization fails
+        SRGAnalyticsMetricsRecordMediaTrackerCreation();
+        
         SRGAnalyticsStreamLabels *mainLabels = mediaPlayerController.userInfo[SRGAnalyticsMediaPlayerLabelsKey];
         if (mainLabels.labelsDictionary.count == 0) {
             return nil;
         }
         
         self.mediaPlayerController = mediaPlayerController;
-        self.lastEvent = MediaPlayerTrackerEventStop;
+        self.playbackContext = [[SRGMediaPlaybackContext alloc] initWithMediaPlayerController:mediaPlayerController];
+        self.lastEvent = SRGMediaTrackerEventStop;
         self.unitTestingIdentifier = SRGAnalyticsUnitTestingIdentifier();
         
-        [NSNotificationCenter.defaultCenter addObserver:self
-                                               selector:@selector(playbackStateDidChange:)
-                                                   name:SRGMediaPlayerPlaybackStateDidChangeNotification
-                                                 object:mediaPlayerController];
-        [NSNotificationCenter.defaultCenter addObserver:self
-                                               selector:@selector(segmentDidStart:)
-                                                   name:SRGMediaPlayerSegmentDidStartNotification
-                                                 object:mediaPlayerController];
-        
-        @weakify(self)
-        [mediaPlayerController addObserver:self keyPath:@keypath(SRGMediaPlayerController.new, tracked) options:0 block:^(MAKVONotification *notification) {
-            @strongify(self)
-            
-            SRGMediaPlayerController *mediaPlayerController = self.mediaPlayerController;
-            if (mediaPlayerController.tracked) {
-                [self recordEventForPlaybackState:mediaPlayerController.playbackState
-                                   withStreamType:mediaPlayerController.streamType
-                                             time:mediaPlayerController.currentTime
-                                        timeshift:SRGMediaAnalyticsPlayerTimeshiftInMilliseconds(mediaPlayerController)
-                                  analyticsLabels:nil
-                                         userInfo:mediaPlayerController.userInfo];
-            }
-            else {
-                [self recordEvent:MediaPlayerTrackerEventStop
-                   withStreamType:mediaPlayerController.streamType
-                             time:mediaPlayerController.currentTime
-                        timeshift:SRGMediaAnalyticsPlayerTimeshiftInMilliseconds(mediaPlayerController)
-                  analyticsLabels:nil
-                         userInfo:mediaPlayerController.userInfo];
-            }
-        }];
+        static atomic_ulong s_lastSessionIdentifier = 0;
+        self.sessionIdentifier = atomic_fetch_add_explicit(&s_lastSessionIdentifier, 1, memory_order_relaxed) + 1;
     }
     return self;
 }
@@ -115,17 +87,19 @@ static NSString *SRGMediaPlayerTrackerLabelForSelectionReason(SRGMediaPlayerSele
 
 - (void)dealloc
 {
-    self.heartbeatTimer = nil;      // Invalidate timer
+    self.heartbeat = nil;           // Invalidate heartbeat
+    
+    SRGAnalyticsMetricsRecordMediaTrackerDestruction();
 }
 
 #pragma clang diagnostic pop
 
 #pragma mark Getters and setters
 
-- (void)setHeartbeatTimer:(NSTimer *)heartbeatTimer
+- (void)setHeartbeat:(SRGAnalyticsHeartbeat *)heartbeat
 {
-    [_heartbeatTimer invalidate];
-    _heartbeatTimer = heartbeatTimer;
+    [_heartbeat invalidate];
+    _heartbeat = heartbeat;
 }
 
 #pragma mark Tracking
@@ -137,299 +111,234 @@ static NSString *SRGMediaPlayerTrackerLabelForSelectionReason(SRGMediaPlayerSele
                     analyticsLabels:(NSDictionary<NSString *, NSString *> *)analyticsLabels
                            userInfo:(NSDictionary *)userInfo
 {
-    static dispatch_once_t s_onceToken;
-    static NSDictionary<NSNumber *, NSString *> *s_events;
-    dispatch_once(&s_onceToken, ^{
-        s_events = @{ @(SRGMediaPlayerPlaybackStateIdle) : MediaPlayerTrackerEventStop,
-                      @(SRGMediaPlayerPlaybackStatePlaying) : MediaPlayerTrackerEventPlay,
-                      @(SRGMediaPlayerPlaybackStateSeeking) : MediaPlayerTrackerEventSeek,
-                      @(SRGMediaPlayerPlaybackStatePaused) : MediaPlayerTrackerEventPause,
-                      @(SRGMediaPlayerPlaybackStateEnded) : MediaPlayerTrackerEventEnd };
-    });
-    
-    NSString *event = s_events[@(playbackState)];
-    if (! event) {
+    SRGMediaTrackerEvent event = SRGMediaTrackerEventForPlaybackState(playbackState);
+    if (event == SRGMediaTrackerEventNone) {
         return;
     }
     
     [self recordEvent:event withStreamType:streamType time:time timeshift:timeshift analyticsLabels:analyticsLabels userInfo:userInfo];
 }
 
-- (void)recordEvent:(MediaPlayerTrackerEvent)event
+- (void)recordEvent:(SRGMediaTrackerEvent)event
      withStreamType:(SRGMediaPlayerStreamType)streamType
                time:(CMTime)time
           timeshift:(NSNumber *)timeshift
     analyticsLabels:(NSDictionary<NSString *, NSString *> *)analyticsLabels
            userInfo:(NSDictionary *)userInfo
 {
-    NSAssert(event.length != 0, @"An event is required");
+    // Ensure a play is emitted before events requiring a session to be opened
+    if (SRGMediaTrackerEventRequiresPlay(self.lastEvent, event)) {
+        [self recordEvent:SRGMediaTrackerEventPlay withStreamType:streamType time:time timeshift:timeshift analyticsLabels:analyticsLabels userInfo:userInfo];
+    }
     
-    // Ensure a play is emitted before events requiring a session to be opened (the Tag Commander SDK does not open sessions
-    // automatically)
-    if ([self.lastEvent isEqualToString:MediaPlayerTrackerEventStop] && ([event isEqualToString:MediaPlayerTrackerEventPause] || [event isEqualToString:MediaPlayerTrackerEventSeek])) {
-        [self recordEvent:MediaPlayerTrackerEventPlay withStreamType:streamType time:time timeshift:timeshift analyticsLabels:analyticsLabels userInfo:userInfo];
+    if (! SRGMediaTrackerEventIsAllowed(self.lastEvent, event)) {
+        return;
     }
     
-    if (! [event isEqualToString:MediaPlayerTrackerEventPosition] && ! [event isEqualToString:MediaPlayerTrackerEventUptime] && ! [event isEqualToString:MediaPlayerTrackerEventSegment]) {
-        static dispatch_once_t s_onceToken;
-        static NSDictionary<NSString *, NSArray<NSString *> *> *s_transitions;
-        dispatch_once(&s_onceToken, ^{
-            s_transitions = @{ MediaPlayerTrackerEventPlay : @[ MediaPlayerTrackerEventPause, MediaPlayerTrackerEventSeek, MediaPlayerTrackerEventStop, MediaPlayerTrackerEventEnd ],
-                               MediaPlayerTrackerEventPause : @[ MediaPlayerTrackerEventPlay, MediaPlayerTrackerEventSeek, MediaPlayerTrackerEventStop, MediaPlayerTrackerEventEnd ],
-                               MediaPlayerTrackerEventSeek : @[ MediaPlayerTrackerEventPlay, MediaPlayerTrackerEventPause, MediaPlayerTrackerEventStop, MediaPlayerTrackerEventEnd ],
-                               MediaPlayerTrackerEventStop : @[ MediaPlayerTrackerEventPlay ],
-                               MediaPlayerTrackerEventEnd : @[ MediaPlayerTrackerEventPlay ] };
-        });
-        
-        if (! [s_transitions[self.lastEvent] containsObject:event]) {
-            return;
-        }
-        
+    if (SRGMediaTrackerEventIsPlaybackStateEvent(event)) {
         self.lastEvent = event;
         
-        // Restore the heartbeat timer when transitioning to play again. We can use a simple `NSTimer` here since
-        // it needs to run while playing content (even in background), but will otherwise be inactive.
-        if ([event isEqualToString:MediaPlayerTrackerEventPlay]) {
-            if (! self.heartbeatTimer) {
+        // Restore the heartbeat when transitioning to play again. Heartbeats of all trackers are driven by a shared
+        // scheduler, aligning them so that players started around the same time share their wakeups.
+        if (event == SRGMediaTrackerEventPlay) {
+            if (! self.heartbeat) {
                 SRGAnalyticsConfiguration *configuration = SRGAnalyticsTracker.sharedTracker.configuration;
                 NSTimeInterval heartbeatInterval = configuration.unitTesting ? 3. : 30.;
-                self.heartbeatTimer = [NSTimer scheduledTimerWithTimeInterval:heartbeatInterval
-                                                                       target:self
-                                                                     selector:@selector(heartbeat:)
-                                                                     userInfo:nil
-                                                                      repeats:YES];
-                // Use the recommended 10% tolerance as default, see `tolerance` documentation
-                self.heartbeatTimer.tolerance = heartbeatInterval / 10.;
+                
+                @weakify(self)
+                self.heartbeat = [SRGAnalyticsHeartbeatScheduler.sharedScheduler scheduleHeartbeatWithInterval:heartbeatInterval handler:^{
+                    @strongify(self)
+                    [self sendHeartbeat];
+                }];
                 self.heartbeatCount = 0;
             }
         }
         // Remove the heartbeat when not playing
         else {
-            self.heartbeatTimer = nil;
+            self.heartbeat = nil;
         }
     }
     
-    NSMutableDictionary<NSString *, NSString *> *labels = [NSMutableDictionary dictionary];
+    SRGAnalyticsEventRecord *record = [[SRGAnalyticsEventRecord alloc] init];
     
-    [labels srg_safelySetString:SRGAnalyticsTracker.sharedTracker.configuration.environment forKey:@"media_embedding_environment"];
+    [record setMediaEmbeddingEnvironment:SRGAnalyticsTracker.sharedTracker.configuration.environment];
     
-    [labels srg_safelySetString:self.mediaPlayerController.analyticsPlayerName forKey:@"media_player_display"];
-    [labels srg_safelySetString:self.mediaPlayerController.analyticsPlayerVersion forKey:@"media_player_version"];
+    [record setMediaPlayerDisplay:self.mediaPlayerController.analyticsPlayerName];
+    [record setMediaPlayerVersion:self.mediaPlayerController.analyticsPlayerVersion];
     
-    [labels srg_safelySetString:event forKey:@"event_id"];
+    NSString *eventId = SRGMediaTrackerEventIdentifier(event);
+    NSAssert(eventId.length != 0, @"Only events which can be sent are allowed");
+    [record setEventId:eventId];
     
     // Use current duration as media position for livestreams, raw position otherwise
     NSTimeInterval mediaPosition = SRGMediaAnalyticsIsLiveStreamType(streamType) ? [self updatedPlaybackDurationWithEvent:event] : SRGMediaAnalyticsCMTimeToMilliseconds(time);
-    [labels srg_safelySetString:@(round(mediaPosition / 1000)).stringValue forKey:@"media_position"];
+    [record setMediaPosition:(int64_t)round(mediaPosition / 1000)];
     
-    [labels srg_safelySetString:self.playerVolumeInPercent.stringValue ?: @"0" forKey:@"media_volume"];
+    SRGMediaPlaybackContext *playbackContext = self.playbackContext;
+    [record setMediaVolume:playbackContext.volumeInPercent.longLongValue];
     
-    if (! [event isEqualToString:MediaPlayerTrackerEventStop]) {
-        self.lastSubtitlesMediaOption = [self selectedMediaOptionForMediaCharacteristic:AVMediaCharacteristicLegible];
+    // Media selections are not available anymore when stopped. Keep the last ones.
+    if (event != SRGMediaTrackerEventStop) {
+        self.lastSubtitlesLanguageCode = playbackContext.subtitlesLanguageCode;
+        self.lastAudioTrackLanguageCode = playbackContext.audioTrackLanguageCode;
     }
-    [labels srg_safelySetString:self.lastSubtitlesMediaOption != nil ? @"true" : @"false" forKey:@"media_subtitles_on"];
-    if (self.lastSubtitlesMediaOption) {
-        NSString *subtitlesLanguageCode = [self.lastSubtitlesMediaOption.locale objectForKey:NSLocaleLanguageCode] ?: @"und";
-        [labels srg_safelySetString:subtitlesLanguageCode.uppercaseString forKey:@"media_subtitle_selection"];
+    
+    [record setMediaSubtitlesOn:self.lastSubtitlesLanguageCode != nil];
+    if (self.lastSubtitlesLanguageCode) {
+        [record setMediaSubtitleSelection:self.lastSubtitlesLanguageCode];
+    }
+    if (self.lastAudioTrackLanguageCode) {
+        [record setMediaAudioTrack:self.lastAudioTrackLanguageCode];
     }
     
-    if (! [event isEqualToString:MediaPlayerTrackerEventStop]) {
-        self.lastAudioTrackMediaOption = [self selectedMediaOptionForMediaCharacteristic:AVMediaCharacteristicAudible];
+    // Bandwidth estimates are available once an access log entry has been completed. Until then, the observed bitrate
+    // of the first entry is sent
+    SRGMediaBandwidthEstimator *bandwidthEstimator = playbackContext.bandwidthEstimator;
+    NSNumber *bandwidth = bandwidthEstimator.observedBitrate;
+    if (bandwidth) {
+        [record setMediaBandwidth:bandwidth.doubleValue];
+        [record setMediaBandwidthP50:[bandwidthEstimator observedBitratePercentile:50.].doubleValue];
+        [record setMediaBandwidthP90:[bandwidthEstimator observedBitratePercentile:90.].doubleValue];
     }
-    if (self.lastAudioTrackMediaOption) {
-        NSString *audioTrackLanguageCode = [self.lastAudioTrackMediaOption.locale objectForKey:NSLocaleLanguageCode] ?: @"und";
-        [labels srg_safelySetString:audioTrackLanguageCode.uppercaseString forKey:@"media_audio_track"];
+    else {
+        NSNumber *initialBandwidth = playbackContext.initialObservedBitrate;
+        if (initialBandwidth) {
+            [record setMediaBandwidth:initialBandwidth.doubleValue];
+        }
     }
     
-    [labels srg_safelySetString:self.bandwidthInBitsPerSecond.stringValue forKey:@"media_bandwidth"];
+    NSNumber *indicatedBitrate = bandwidthEstimator.indicatedBitrate;
+    if (indicatedBitrate) {
+        [record setMediaIndicatedBitrate:indicatedBitrate.doubleValue];
+        [record setMediaIndicatedBitrateP50:[bandwidthEstimator indicatedBitratePercentile:50.].doubleValue];
+        [record setMediaIndicatedBitrateP90:[bandwidthEstimator indicatedBitratePercentile:90.].doubleValue];
+    }
     
     if (timeshift) {
-        [labels srg_safelySetString:@(timeshift.integerValue / 1000).stringValue forKey:@"media_timeshift"];
+        [record setMediaTimeshift:timeshift.integerValue / 1000];
     }
     
-    if (analyticsLabels) {
-        [labels addEntriesFromDictionary:analyticsLabels];
-    }
+    // Analytics labels override record labels
+    record.overflowLabels = analyticsLabels.copy;
     
+    // Stream labels are shared by all events of the playback session and layered on top of event labels without merging
     SRGAnalyticsStreamLabels *mainLabels = userInfo[SRGAnalyticsMediaPlayerLabelsKey];
-    [labels addEntriesFromDictionary:mainLabels.labelsDictionary];
-    
-    if (SRGAnalyticsTracker.sharedTracker.configuration.unitTesting) {
-        labels[@"srg_test_id"] = self.unitTestingIdentifier;
-    }
-    
-    [SRGAnalyticsTracker.sharedTracker trackTagCommanderEventWithLabels:labels.copy];
+    NSString *unitTestingIdentifier = SRGAnalyticsTracker.sharedTracker.configuration.unitTesting ? self.unitTestingIdentifier : nil;
+    [SRGAnalyticsTracker.sharedTracker trackTagCommanderEventWithRecord:record
+                                                          sessionLabels:mainLabels.labelsDictionary
+                                                      sessionIdentifier:self.sessionIdentifier
+                                                  unitTestingIdentifier:unitTestingIdentifier];
 }
 
 #pragma mark Heartbeats
 
-- (NSTimeInterval)updatedPlaybackDurationWithEvent:(MediaPlayerTrackerEvent)event
+- (NSTimeInterval)updatedPlaybackDurationWithEvent:(SRGMediaTrackerEvent)event
 {
-    if (self.previousPlaybackDurationUpdateDate) {
-        self.playbackDuration -= [self.previousPlaybackDurationUpdateDate timeIntervalSinceNow] * 1000.;
+    // Use a monotonic clock, unaffected by wall clock changes
+    uint64_t now = SRGAnalyticsMonotonicTime();
+    if (self.previousPlaybackDurationUpdateTime != 0) {
+        self.playbackDuration += (NSTimeInterval)(now - self.previousPlaybackDurationUpdateTime) / NSEC_PER_MSEC;
     }
     
-    if ([event isEqualToString:MediaPlayerTrackerEventPlay] || [event isEqualToString:MediaPlayerTrackerEventPosition] || [event isEqualToString:MediaPlayerTrackerEventUptime]) {
-        self.previousPlaybackDurationUpdateDate = NSDate.date;
+    if (SRGMediaTrackerEventIsPlaying(event)) {
+        self.previousPlaybackDurationUpdateTime = now;
     }
     else {
-        self.previousPlaybackDurationUpdateDate = nil;
+        self.previousPlaybackDurationUpdateTime = 0;
     }
     
     NSTimeInterval playbackDuration = self.playbackDuration;
     
-    if ([event isEqualToString:MediaPlayerTrackerEventStop] || [event isEqualToString:MediaPlayerTrackerEventEnd]) {
+    if (SRGMediaTrackerEventEndsSession(event)) {
         self.playbackDuration = 0;
     }
     
     return playbackDuration;
 }
 
-#pragma mark Playback information
+#pragma mark SRGAnalyticsHookInstalling protocol
 
-- (NSNumber *)bandwidthInBitsPerSecond
++ (void)srg_installAnalyticsHooks
 {
-    AVPlayerItem *currentItem = self.mediaPlayerController.player.currentItem;
-    if (! currentItem) {
-        return nil;
-    }
-    
-    NSArray<AVPlayerItemAccessLogEvent *> *events = currentItem.accessLog.events;
-    if (! events.lastObject) {
-        return nil;
-    }
-    
-    double observedBitrate = events.lastObject.observedBitrate;
-    if (isnan(observedBitrate) || observedBitrate < 0.) {
-        return nil;
-    }
-    
-    return @(observedBitrate);
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        SRGAnalyticsLaunchReportMeasureStep(SRGAnalyticsLaunchStepMediaPlayerHooks, ^{
+            [SRGMediaPlaybackHub.sharedHub registerBackendClass:self];
+        });
+    });
 }
 
-- (NSNumber *)playerVolumeInPercent
+#pragma mark SRGMediaPlaybackBackend protocol
+
++ (id<SRGMediaPlaybackBackend>)backendForMediaPlayerController:(SRGMediaPlayerController *)mediaPlayerController withSnapshot:(SRGMediaPlaybackSnapshot *)snapshot
 {
-    // AVPlayer has a volume property, but its purpose is NOT end-user volume control (see documentation). This volume is
-    // therefore not relevant for our calculations.
-    AVPlayer *player = self.mediaPlayerController.player;
-    if (! player || player.muted) {
-        return nil;
-    }
-    // When we have a non-muted player, its volume is simply the system volume (note that this volume does not take
-    // into account the ringer status).
-    else {
-        NSInteger volume = [AVAudioSession sharedInstance].outputVolume * 100;
-        return @(volume);
+    SRGMediaPlayerTracker *tracker = [[SRGMediaPlayerTracker alloc] initWithMediaPlayerController:mediaPlayerController];
+    if (tracker) {
+        SRGAnalyticsMediaPlayerLogInfo(@"tracker", @"Started tracking for %p", mediaPlayerController);
     }
+    return tracker;
 }
 
-- (AVMediaSelectionOption *)selectedMediaOptionForMediaCharacteristic:(AVMediaCharacteristic)mediaCharacteristic
+- (void)playbackDidChangeWithSnapshot:(SRGMediaPlaybackSnapshot *)snapshot
 {
-    AVPlayerItem *playerItem = self.mediaPlayerController.player.currentItem;
-    AVAsset *asset = playerItem.asset;
-    if ([asset statusOfValueForKey:@keypath(asset.availableMediaCharacteristicsWithMediaSelectionOptions) error:NULL] == AVKeyValueStatusLoaded) {
-        AVMediaSelectionGroup *legibleGroup = [playerItem.asset mediaSelectionGroupForMediaCharacteristic:mediaCharacteristic];
-        return [playerItem srganalytics_selectedMediaOptionInMediaSelectionGroup:legibleGroup];
-    }
-    else {
-        return nil;
-    }
+    [self recordEventForPlaybackState:snapshot.playbackState
+                       withStreamType:snapshot.streamType
+                                 time:snapshot.time
+                            timeshift:snapshot.timeshift
+                      analyticsLabels:nil
+                             userInfo:snapshot.userInfo];
 }
 
-#pragma mark Notifications
-
-+ (void)playbackStateDidChange:(NSNotification *)notification
+- (void)trackingDidChangeWithSnapshot:(SRGMediaPlaybackSnapshot *)snapshot
 {
-    if (! SRGAnalyticsTracker.sharedTracker.configuration) {
-        return;
-    }
-    
-    SRGMediaPlayerController *mediaPlayerController = notification.object;
-    NSValue *key = [NSValue valueWithNonretainedObject:mediaPlayerController];
-    
-    SRGMediaPlayerPlaybackState playbackState = [notification.userInfo[SRGMediaPlayerPlaybackStateKey] integerValue];
-    SRGMediaPlayerPlaybackState previousPlaybackState = [notification.userInfo[SRGMediaPlayerPreviousPlaybackStateKey] integerValue];
-    
-    // Always attach a tracker to a the player controller, whether or not it is actually tracked (otherwise we would
-    // be unable to attach to initially untracked controller later).
-    if (playbackState == SRGMediaPlayerPlaybackStatePreparing) {
-        SRGMediaPlayerTracker *tracker = [[SRGMediaPlayerTracker alloc] initWithMediaPlayerController:mediaPlayerController];
-        if (tracker) {
-            s_trackers[key] = tracker;
-        
-            SRGAnalyticsMediaPlayerLogInfo(@"tracker", @"Started tracking for %@", key);
-        }
+    if (snapshot.tracked) {
+        [self recordEventForPlaybackState:snapshot.playbackState
+                           withStreamType:snapshot.streamType
+                                     time:snapshot.time
+                                timeshift:snapshot.timeshift
+                          analyticsLabels:nil
+                                 userInfo:snapshot.userInfo];
     }
-    else if (playbackState == SRGMediaPlayerPlaybackStateIdle) {
-        SRGMediaPlayerTracker *tracker = s_trackers[key];
-        if (tracker) {
-            if (previousPlaybackState != SRGMediaPlayerPlaybackStatePreparing) {
-                SRGMediaPlayerStreamType streamType = [notification.userInfo[SRGMediaPlayerPreviousStreamTypeKey] integerValue];
-                CMTime time = [notification.userInfo[SRGMediaPlayerLastPlaybackTimeKey] CMTimeValue];
-                NSNumber *timeshift = SRGMediaAnalyticsTimeshiftInMilliseconds(streamType,
-                                                                               [notification.userInfo[SRGMediaPlayerPreviousTimeRangeKey] CMTimeRangeValue],
-                                                                               [notification.userInfo[SRGMediaPlayerLastPlaybackTimeKey] CMTimeValue],
-                                                                               mediaPlayerController.liveTolerance);
-                [tracker recordEvent:MediaPlayerTrackerEventStop
-                      withStreamType:streamType
-                                time:time
-                           timeshift:timeshift
-                     analyticsLabels:nil
-                            userInfo:notification.userInfo[SRGMediaPlayerPreviousUserInfoKey]];
-            }
-            s_trackers[key] = nil;
-            
-            SRGAnalyticsMediaPlayerLogInfo(@"tracker", @"Stopped tracking for %@", key);
-        }
+    else {
+        [self recordEvent:SRGMediaTrackerEventStop
+           withStreamType:snapshot.streamType
+                     time:snapshot.time
+                timeshift:snapshot.timeshift
+          analyticsLabels:nil
+                 userInfo:snapshot.userInfo];
     }
 }
 
-- (void)playbackStateDidChange:(NSNotification *)notification
+- (void)playbackDidStopWithSnapshot:(SRGMediaPlaybackSnapshot *)snapshot
 {
-    SRGMediaPlayerController *mediaPlayerController = notification.object;
-    if (! mediaPlayerController.tracked) {
-        return;
-    }
-    
-    SRGMediaPlayerPlaybackState playbackState = mediaPlayerController.playbackState;
-    if (playbackState == SRGMediaPlayerPlaybackStateIdle || playbackState == SRGMediaPlayerPlaybackStatePreparing) {
-        return;
+    if (snapshot.previousPlaybackState != SRGMediaPlayerPlaybackStatePreparing) {
+        [self recordEvent:SRGMediaTrackerEventStop
+           withStreamType:snapshot.streamType
+                     time:snapshot.time
+                timeshift:snapshot.timeshift
+          analyticsLabels:nil
+                 userInfo:snapshot.userInfo];
     }
     
-    [self recordEventForPlaybackState:playbackState
-                       withStreamType:mediaPlayerController.streamType
-                                 time:mediaPlayerController.currentTime
-                            timeshift:SRGMediaAnalyticsPlayerTimeshiftInMilliseconds(mediaPlayerController)
-                      analyticsLabels:nil
-                             userInfo:mediaPlayerController.userInfo];
+    SRGAnalyticsMediaPlayerLogInfo(@"tracker", @"Stopped tracking for %p", self.mediaPlayerController);
 }
 
-- (void)segmentDidStart:(NSNotification *)notification
+- (void)segmentDidStartWithSnapshot:(SRGMediaPlaybackSnapshot *)snapshot selectionReason:(SRGMediaPlayerSelectionReason)selectionReason
 {
-    SRGMediaPlayerController *mediaPlayerController = notification.object;
-    if (! mediaPlayerController.tracked) {
-        return;
-    }
-    
-    if ([notification.userInfo[SRGMediaPlayerSelectionKey] boolValue]) {
-        NSMutableDictionary<NSString *, NSString *> *analyticsLabels = [NSMutableDictionary dictionary];
-        
-        SRGMediaPlayerSelectionReason selectionReason = [notification.userInfo[SRGMediaPlayerSelectionReasonKey] integerValue];
-        NSString *selectionReasonLabel = SRGMediaPlayerTrackerLabelForSelectionReason(selectionReason);
-        analyticsLabels[@"segment_change_origin"] = selectionReasonLabel;
-        
-        [self recordEvent:MediaPlayerTrackerEventSegment
-           withStreamType:mediaPlayerController.streamType
-                     time:mediaPlayerController.currentTime
-                timeshift:SRGMediaAnalyticsPlayerTimeshiftInMilliseconds(mediaPlayerController)
-          analyticsLabels:analyticsLabels.copy
-                 userInfo:mediaPlayerController.userInfo];
-    }
+    NSMutableDictionary<NSString *, NSString *> *analyticsLabels = [NSMutableDictionary dictionary];
+    analyticsLabels[@"segment_change_origin"] = SRGMediaPlayerTrackerLabelForSelectionReason(selectionReason);
+    
+    [self recordEvent:SRGMediaTrackerEventSegment
+       withStreamType:snapshot.streamType
+                 time:snapshot.time
+            timeshift:snapshot.timeshift
+      analyticsLabels:analyticsLabels.copy
+             userInfo:snapshot.userInfo];
 }
 
-#pragma mark Timers
+#pragma mark Heartbeat handling
 
-- (void)heartbeat:(NSTimer *)timer
+- (void)sendHeartbeat
 {
     SRGMediaPlayerController *mediaPlayerController = self.mediaPlayerController;
     if (! mediaPlayerController.tracked) {
@@ -439,7 +348,7 @@ static NSString *SRGMediaPlayerTrackerLabelForSelectionReason(SRGMediaPlayerSele
     SRGMediaPlayerStreamType streamType = mediaPlayerController.streamType;
     NSNumber *timeshift = SRGMediaAnalyticsPlayerTimeshiftInMilliseconds(mediaPlayerController);
     
-    [self recordEvent:MediaPlayerTrackerEventPosition
+    [self recordEvent:SRGMediaTrackerEventPosition
        withStreamType:streamType
                  time:mediaPlayerController.currentTime
             timeshift:timeshift
@@ -448,7 +357,7 @@ static NSString *SRGMediaPlayerTrackerLabelForSelectionReason(SRGMediaPlayerSele
     
     // Send a live heartbeat each minute
     if (self.mediaPlayerController.live && self.heartbeatCount % 2 != 0) {
-        [self recordEvent:MediaPlayerTrackerEventUptime
+        [self recordEvent:SRGMediaTrackerEventUptime
            withStreamType:streamType
                      time:mediaPlayerController.currentTime
                 timeshift:timeshift
@@ -463,17 +372,6 @@ static NSString *SRGMediaPlayerTrackerLabelForSelectionReason(SRGMediaPlayerSele
 
 #pragma mark Static functions
 
-__attribute__((constructor)) static void SRGMediaPlayerTrackerInit(void)
-{
-    // Observe state changes for all media player controllers to create and remove trackers on the fly
-    [NSNotificationCenter.defaultCenter addObserver:SRGMediaPlayerTracker.class
-                                           selector:@selector(playbackStateDidChange:)
-                                               name:SRGMediaPlayerPlaybackStateDidChangeNotification
-                                             object:nil];
-    
-    s_trackers = [NSMutableDictionary dictionary];
-}
-
 static NSString *SRGMediaPlayerTrackerLabelForSelectionReason(SRGMediaPlayerSelectionReason reason)
 {
     static dispatch_once_t s_onceToken;
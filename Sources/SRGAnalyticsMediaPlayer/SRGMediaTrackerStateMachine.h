@@ -0,0 +1,81 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+@import Foundation;
+@import SRGMediaPlayer;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Media tracker events.
+ */
+typedef NS_ENUM(NSInteger, SRGMediaTrackerEvent) {
+    /**
+     *  No event.
+     */
+    SRGMediaTrackerEventNone = 0,
+    /**
+     *  Playback state events.
+     */
+    SRGMediaTrackerEventPlay,
+    SRGMediaTrackerEventPause,
+    SRGMediaTrackerEventSeek,
+    SRGMediaTrackerEventBuffer,
+    SRGMediaTrackerEventEnd,
+    SRGMediaTrackerEventStop,
+    /**
+     *  Events sent during playback, not changing the playback state.
+     */
+    SRGMediaTrackerEventPosition,
+    SRGMediaTrackerEventUptime,
+    SRGMediaTrackerEventSegment
+};
+
+/**
+ *  The number of events, `SRGMediaTrackerEventNone` included.
+ */
+OBJC_EXPORT const NSInteger SRGMediaTrackerEventCount;
+
+/**
+ *  Return the event corresponding to a playback state, `SRGMediaTrackerEventNone` if none.
+ */
+OBJC_EXPORT SRGMediaTrackerEvent SRGMediaTrackerEventForPlaybackState(SRGMediaPlayerPlaybackState playbackState);
+
+/**
+ *  Return the identifier sent for an event, `nil` if the event is never sent as is.
+ */
+OBJC_EXPORT NSString * _Nullable SRGMediaTrackerEventIdentifier(SRGMediaTrackerEvent event);
+
+/**
+ *  Return `YES` iff an event is allowed after the specified playback state event. Events not changing the playback
+ *  state are allowed after any playback state event except `SRGMediaTrackerEventNone`.
+ *
+ *  @discussion Transitions are looked up in a compile-time table of allowed event bitmasks.
+ */
+OBJC_EXPORT BOOL SRGMediaTrackerEventIsAllowed(SRGMediaTrackerEvent lastEvent, SRGMediaTrackerEvent event);
+
+/**
+ *  Return `YES` iff a play event must be sent before the specified event, so that a playback session is opened first
+ *  (e.g. when pausing or seeking after a stop).
+ */
+OBJC_EXPORT BOOL SRGMediaTrackerEventRequiresPlay(SRGMediaTrackerEvent lastEvent, SRGMediaTrackerEvent event);
+
+/**
+ *  Return `YES` iff an event changes the playback state.
+ */
+OBJC_EXPORT BOOL SRGMediaTrackerEventIsPlaybackStateEvent(SRGMediaTrackerEvent event);
+
+/**
+ *  Return `YES` iff an event is sent while content is being played.
+ */
+OBJC_EXPORT BOOL SRGMediaTrackerEventIsPlaying(SRGMediaTrackerEvent event);
+
+/**
+ *  Return `YES` iff an event ends the playback session.
+ */
+OBJC_EXPORT BOOL SRGMediaTrackerEventEndsSession(SRGMediaTrackerEvent event);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,162 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGMediaTrackerStateMachine.h"
+
+typedef uint32_t SRGMediaTrackerEventMask;
+
+#define SRGMediaTrackerEventMaskMake(event) ((SRGMediaTrackerEventMask)1 << (event))
+
+const NSInteger SRGMediaTrackerEventCount = SRGMediaTrackerEventSegment + 1;
+
+// Event sets (an enum so that they can be used in static table initializers)
+enum {
+    SRGMediaTrackerEventMaskPlaybackState = SRGMediaTrackerEventMaskMake(SRGMediaTrackerEventPlay)
+        | SRGMediaTrackerEventMaskMake(SRGMediaTrackerEventPause)
+        | SRGMediaTrackerEventMaskMake(SRGMediaTrackerEventSeek)
+        | SRGMediaTrackerEventMaskMake(SRGMediaTrackerEventBuffer)
+        | SRGMediaTrackerEventMaskMake(SRGMediaTrackerEventEnd)
+        | SRGMediaTrackerEventMaskMake(SRGMediaTrackerEventStop),
+    SRGMediaTrackerEventMaskDuringPlayback = SRGMediaTrackerEventMaskMake(SRGMediaTrackerEventPosition)
+        | SRGMediaTrackerEventMaskMake(SRGMediaTrackerEventUptime)
+        | SRGMediaTrackerEventMaskMake(SRGMediaTrackerEventSegment),
+    SRGMediaTrackerEventMaskPlaying = SRGMediaTrackerEventMaskMake(SRGMediaTrackerEventPlay)
+        | SRGMediaTrackerEventMaskMake(SRGMediaTrackerEventPosition)
+        | SRGMediaTrackerEventMaskMake(SRGMediaTrackerEventUptime),
+    SRGMediaTrackerEventMaskSessionEnd = SRGMediaTrackerEventMaskMake(SRGMediaTrackerEventEnd)
+        | SRGMediaTrackerEventMaskMake(SRGMediaTrackerEventStop)
+};
+
+// Events allowed after each playback state event. Buffer events are never sent by the Tag Commander tracker.
+static const SRGMediaTrackerEventMask s_transitions[] = {
+    [SRGMediaTrackerEventNone] = 0,
+    [SRGMediaTrackerEventPlay] = SRGMediaTrackerEventMaskMake(SRGMediaTrackerEventPause)
+        | SRGMediaTrackerEventMaskMake(SRGMediaTrackerEventSeek)
+        | SRGMediaTrackerEventMaskMake(SRGMediaTrackerEventStop)
+        | SRGMediaTrackerEventMaskMake(SRGMediaTrackerEventEnd)
+        | SRGMediaTrackerEventMaskDuringPlayback,
+    [SRGMediaTrackerEventPause] = SRGMediaTrackerEventMaskMake(SRGMediaTrackerEventPlay)
+        | SRGMediaTrackerEventMaskMake(SRGMediaTrackerEventSeek)
+        | SRGMediaTrackerEventMaskMake(SRGMediaTrackerEventStop)
+        | SRGMediaTrackerEventMaskMake(SRGMediaTrackerEventEnd)
+        | SRGMediaTrackerEventMaskDuringPlayback,
+    [SRGMediaTrackerEventSeek] = SRGMediaTrackerEventMaskMake(SRGMediaTrackerEventPlay)
+        | SRGMediaTrackerEventMaskMake(SRGMediaTrackerEventPause)
+        | SRGMediaTrackerEventMaskMake(SRGMediaTrackerEventStop)
+        | SRGMediaTrackerEventMaskMake(SRGMediaTrackerEventEnd)
+        | SRGMediaTrackerEventMaskDuringPlayback,
+    [SRGMediaTrackerEventBuffer] = 0,
+    [SRGMediaTrackerEventEnd] = SRGMediaTrackerEventMaskMake(SRGMediaTrackerEventPlay)
+        | SRGMediaTrackerEventMaskDuringPlayback,
+    [SRGMediaTrackerEventStop] = SRGMediaTrackerEventMaskMake(SRGMediaTrackerEventPlay)
+        | SRGMediaTrackerEventMaskDuringPlayback,
+    [SRGMediaTrackerEventPosition] = 0,
+    [SRGMediaTrackerEventUptime] = 0,
+    [SRGMediaTrackerEventSegment] = 0
+};
+
+// Events requiring a play event to be sent first after each playback state event (the Tag Commander SDK does not open
+// sessions automatically)
+static const SRGMediaTrackerEventMask s_implicitPlayTransitions[] = {
+    [SRGMediaTrackerEventStop] = SRGMediaTrackerEventMaskMake(SRGMediaTrackerEventPause)
+        | SRGMediaTrackerEventMaskMake(SRGMediaTrackerEventSeek),
+    [SRGMediaTrackerEventSegment] = 0
+};
+
+_Static_assert(sizeof(s_transitions) / sizeof(*s_transitions) == SRGMediaTrackerEventSegment + 1, "One transition mask per event is required");
+_Static_assert(sizeof(s_implicitPlayTransitions) / sizeof(*s_implicitPlayTransitions) == SRGMediaTrackerEventSegment + 1, "One transition mask per event is required");
+
+static BOOL SRGMediaTrackerEventIsValid(SRGMediaTrackerEvent event)
+{
+    return event >= 0 && event < SRGMediaTrackerEventCount;
+}
+
+SRGMediaTrackerEvent SRGMediaTrackerEventForPlaybackState(SRGMediaPlayerPlaybackState playbackState)
+{
+    switch (playbackState) {
+        case SRGMediaPlayerPlaybackStateIdle: {
+            return SRGMediaTrackerEventStop;
+            break;
+        }
+        
+        case SRGMediaPlayerPlaybackStatePreparing:
+        case SRGMediaPlayerPlaybackStateStalled: {
+            return SRGMediaTrackerEventBuffer;
+            break;
+        }
+        
+        case SRGMediaPlayerPlaybackStatePlaying: {
+            return SRGMediaTrackerEventPlay;
+            break;
+        }
+        
+        case SRGMediaPlayerPlaybackStateSeeking: {
+            return SRGMediaTrackerEventSeek;
+            break;
+        }
+        
+        case SRGMediaPlayerPlaybackStatePaused: {
+            return SRGMediaTrackerEventPause;
+            break;
+        }
+        
+        case SRGMediaPlayerPlaybackStateEnded: {
+            return SRGMediaTrackerEventEnd;
+            break;
+        }
+        
+        default: {
+            return SRGMediaTrackerEventNone;
+            break;
+        }
+    }
+}
+
+NSString *SRGMediaTrackerEventIdentifier(SRGMediaTrackerEvent event)
+{
+    static NSString * const s_identifiers[] = {
+        [SRGMediaTrackerEventPlay] = @"play",
+        [SRGMediaTrackerEventPause] = @"pause",
+        [SRGMediaTrackerEventSeek] = @"seek",
+        [SRGMediaTrackerEventEnd] = @"eof",
+        [SRGMediaTrackerEventStop] = @"stop",
+        [SRGMediaTrackerEventPosition] = @"pos",
+        [SRGMediaTrackerEventUptime] = @"uptime",
+        [SRGMediaTrackerEventSegment] = @"segment"
+    };
+    return SRGMediaTrackerEventIsValid(event) ? s_identifiers[event] : nil;
+}
+
+BOOL SRGMediaTrackerEventIsAllowed(SRGMediaTrackerEvent lastEvent, SRGMediaTrackerEvent event)
+{
+    if (! SRGMediaTrackerEventIsValid(lastEvent) || ! SRGMediaTrackerEventIsValid(event)) {
+        return NO;
+    }
+    return (s_transitions[lastEvent] & SRGMediaTrackerEventMaskMake(event)) != 0;
+}
+
+BOOL SRGMediaTrackerEventRequiresPlay(SRGMediaTrackerEvent lastEvent, SRGMediaTrackerEvent event)
+{
+    if (! SRGMediaTrackerEventIsValid(lastEvent) || ! SRGMediaTrackerEventIsValid(event)) {
+        return NO;
+    }
+    return (s_implicitPlayTransitions[lastEvent] & SRGMediaTrackerEventMaskMake(event)) != 0;
+}
+
+BOOL SRGMediaTrackerEventIsPlaybackStateEvent(SRGMediaTrackerEvent event)
+{
+    return SRGMediaTrackerEventIsValid(event) && (SRGMediaTrackerEventMaskPlaybackState & SRGMediaTrackerEventMaskMake(event)) != 0;
+}
+
+BOOL SRGMediaTrackerEventIsPlaying(SRGMediaTrackerEvent event)
+{
+    return SRGMediaTrackerEventIsValid(event) && (SRGMediaTrackerEventMaskPlaying & SRGMediaTrackerEventMaskMake(event)) != 0;
+}
+
+BOOL SRGMediaTrackerEventEndsSession(SRGMediaTrackerEvent event)
+{
+    return SRGMediaTrackerEventIsValid(event) && (SRGMediaTrackerEventMaskSessionEnd & SRGMediaTrackerEventMaskMake(event)) != 0;
+}
@@ -0,0 +1,27 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "StubURLProtocol.h"
+
+@import SRGAnalytics;
+
+// The singleton can be only setup once. Do not perform in a test case setup
+__attribute__((constructor)) static void SetupBenchmarkSingletonTracker(void)
+{
+    // Requests made with `NSURLConnection` or the shared session never leave the process. Sessions with custom
+    // configurations are not affected.
+    [NSURLProtocol registerClass:StubURLProtocol.class];
+    
+    SRGAnalyticsConfiguration *configuration = [[SRGAnalyticsConfiguration alloc] initWithBusinessUnitIdentifier:SRGAnalyticsBusinessUnitIdentifierRTS
+                                                                                                       container:10
+                                                                                                        siteName:@"rts-app-test-v"];
+    
+    // Measure every event, without deduplication nor periodic events
+    configuration.pageViewDebounceInterval = 0.;
+    configuration.eventSummaryInterval = 0.;
+    configuration.hiddenEventAggregationInterval = 0.;
+    [SRGAnalyticsTracker.sharedTracker startWithConfiguration:configuration];
+}
@@ -0,0 +1,91 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "NSString+SRGAnalytics.h"
+#import "SRGAnalyticsEncoder.h"
+#import "SRGAnalyticsEventRecord+Catalog.h"
+#import "SRGAnalyticsLabelContext.h"
+#import "XCTestCase+Benchmarks.h"
+
+@interface LabelBenchmarkTestCase : XCTestCase
+
+@end
+
+@implementation LabelBenchmarkTestCase
+
+#pragma mark Tests
+
+- (void)testLabelMerging
+{
+    NSMutableDictionary<NSString *, NSString *> *globalLabels = [NSMutableDictionary dictionary];
+    for (NSUInteger i = 0; i < 20; ++i) {
+        globalLabels[[NSString stringWithFormat:@"global_%@", @(i)]] = [NSString stringWithFormat:@"value_%@", @(i)];
+    }
+    SRGAnalyticsLabelContext *globalContext = [[SRGAnalyticsLabelContext alloc] initWithParentContext:nil labels:globalLabels];
+    NSDictionary<NSString *, NSString *> *customLabels = @{ @"custom_label" : @"custom_value", @"global_3" : @"overridden" };
+    
+    __block NSUInteger count = 0;
+    [self benchmarkWithName:@"labels.merge" sampleCount:50 operationCountPerSample:1000 block:^(NSUInteger firstOperationIndex, NSUInteger operationCount) {
+        for (NSUInteger i = 0; i < operationCount; ++i) {
+            SRGAnalyticsEventRecord *record = [[SRGAnalyticsEventRecord alloc] init];
+            [record setEventId:@"hidden_event"];
+            [record setEventName:@"Hidden event"];
+            
+            SRGAnalyticsLabelContext *eventContext = [[SRGAnalyticsLabelContext alloc] initWithParentContext:globalContext record:record];
+            SRGAnalyticsLabelContext *context = [[SRGAnalyticsLabelContext alloc] initWithParentContext:eventContext labels:customLabels];
+            [context enumerateLabelsUsingBlock:^(NSString * _Nonnull key, NSString * _Nonnull label, BOOL * _Nonnull stop) {
+                count++;
+            }];
+        }
+    }];
+    XCTAssertGreaterThan(count, 0);
+}
+
+- (void)testLabelEncoding
+{
+    NSMutableDictionary<NSString *, NSString *> *labels = [NSMutableDictionary dictionary];
+    for (NSUInteger i = 0; i < 30; ++i) {
+        labels[[NSString stringWithFormat:@"label_%@", @(i)]] = [NSString stringWithFormat:@"Value %@ with some \"text\"", @(i)];
+    }
+    SRGAnalyticsLabelContext *context = [[SRGAnalyticsLabelContext alloc] initWithParentContext:nil labels:labels];
+    SRGAnalyticsByteBuffer *buffer = [[SRGAnalyticsByteBuffer alloc] initWithCapacity:4096];
+    
+    [self benchmarkWithName:@"labels.encode_json" sampleCount:50 operationCountPerSample:1000 block:^(NSUInteger firstOperationIndex, NSUInteger operationCount) {
+        for (NSUInteger i = 0; i < operationCount; ++i) {
+            [buffer reset];
+            SRGAnalyticsEncodeLabelContext(context, SRGAnalyticsEncodingFormatJSON, buffer);
+        }
+    }];
+}
+
+- (void)testStringNormalizationCached
+{
+    NSArray<NSString *> *strings = @[ @"Le 19h30", @"Météo régionale", @"Sport + Musique", @"Kassensturz & Espresso" ];
+    
+    [self benchmarkWithName:@"strings.normalize.cached" sampleCount:50 operationCountPerSample:1000 block:^(NSUInteger firstOperationIndex, NSUInteger operationCount) {
+        for (NSUInteger i = firstOperationIndex; i < firstOperationIndex + operationCount; ++i) {
+            (void)strings[i % strings.count].srg_comScoreFormattedString;
+        }
+    }];
+}
+
+- (void)testStringNormalizationUncached
+{
+    // Unique strings, never found in the cache
+    [self benchmarkWithName:@"strings.normalize.ascii" sampleCount:50 operationCountPerSample:1000 block:^(NSUInteger firstOperationIndex, NSUInteger operationCount) {
+        for (NSUInteger i = firstOperationIndex; i < firstOperationIndex + operationCount; ++i) {
+            (void)[NSString stringWithFormat:@"Show title %@ - Episode", @(i)].srg_comScoreFormattedString;
+        }
+    }];
+    
+    [self benchmarkWithName:@"strings.normalize.non_ascii" sampleCount:50 operationCountPerSample:1000 block:^(NSUInteger firstOperationIndex, NSUInteger operationCount) {
+        for (NSUInteger i = firstOperationIndex; i < firstOperationIndex + operationCount; ++i) {
+            (void)[NSString stringWithFormat:@"Émission spéciale %@ à Genève", @(i)].srg_comScoreFormattedString;
+        }
+    }];
+}
+
+@end
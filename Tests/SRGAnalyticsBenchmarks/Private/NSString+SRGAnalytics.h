@@ -0,0 +1 @@
+../../../Sources/SRGAnalytics/NSString+SRGAnalytics.h
\ No newline at end of file
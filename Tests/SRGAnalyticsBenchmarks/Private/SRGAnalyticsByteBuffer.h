@@ -0,0 +1 @@
+../../../Sources/SRGAnalytics/SRGAnalyticsByteBuffer.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../Sources/SRGAnalytics/SRGAnalyticsEncoder.h
\ No newline at end of file
@@ -0,0 +1,19 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+@import Foundation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  URL protocol answering all HTTP requests locally with an empty successful response, so that benchmarks do not
+ *  depend on the network.
+ */
+@interface StubURLProtocol : NSURLProtocol
+
+@end
+
+NS_ASSUME_NONNULL_END
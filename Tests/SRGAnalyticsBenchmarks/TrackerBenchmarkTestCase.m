@@ -0,0 +1,132 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsEventRecord+Catalog.h"
+#import "SRGAnalyticsTracker+Private.h"
+#import "XCTestCase+Benchmarks.h"
+
+@import SRGAnalytics;
+
+static NSDictionary<NSString *, NSString *> *SessionLabels(NSUInteger playerIndex)
+{
+    return @{ @"media_urn" : [NSString stringWithFormat:@"urn:rts:video:%@", @(playerIndex)],
+              @"media_title" : @"Le 19h30",
+              @"media_show" : @"19h30",
+              @"media_type" : @"Video",
+              @"media_duration" : @"1800",
+              @"media_is_livestream" : @"false",
+              @"media_segment" : @"Le 19h30",
+              @"media_channel_name" : @"RTS 1" };
+}
+
+static SRGAnalyticsEventRecord *MediaRecord(NSString *eventId, NSUInteger position)
+{
+    SRGAnalyticsEventRecord *record = [[SRGAnalyticsEventRecord alloc] init];
+    [record setMediaEmbeddingEnvironment:@"preprod"];
+    [record setMediaPlayerDisplay:@"SRGMediaPlayer"];
+    [record setMediaPlayerVersion:@"6.1.0"];
+    [record setEventId:eventId];
+    [record setMediaPosition:position];
+    [record setMediaVolume:80];
+    [record setMediaSubtitlesOn:NO];
+    [record setMediaTimeshift:0];
+    [record setMediaBandwidth:5e6];
+    return record;
+}
+
+@interface TrackerBenchmarkTestCase : XCTestCase
+
+@end
+
+@implementation TrackerBenchmarkTestCase
+
+#pragma mark Tests
+
+// Measures the complete cost of events, from the emitting thread to the hand over to analytics services, by draining
+// the event queue at the end of each sample
+
+- (void)testPageViews
+{
+    SRGAnalyticsPageViewLabels *labels = [[SRGAnalyticsPageViewLabels alloc] init];
+    labels.customInfo = @{ @"custom_label" : @"custom_value" };
+    
+    [self benchmarkWithName:@"tracker.page_view" sampleCount:50 operationCountPerSample:100 block:^(NSUInteger firstOperationIndex, NSUInteger operationCount) {
+        for (NSUInteger i = firstOperationIndex; i < firstOperationIndex + operationCount; ++i) {
+            [SRGAnalyticsTracker.sharedTracker trackPageViewWithTitle:[NSString stringWithFormat:@"Page %@", @(i % 50)]
+                                                               levels:@[ @"Level 1", @"Level 2" ]
+                                                               labels:labels
+                                                 fromPushNotification:NO
+                                               ignoreApplicationState:YES];
+        }
+        [SRGAnalyticsTracker.sharedTracker drainWithTimeout:60.];
+    }];
+}
+
+- (void)testHiddenEvents
+{
+    SRGAnalyticsHiddenEventLabels *labels = [[SRGAnalyticsHiddenEventLabels alloc] init];
+    labels.type = @"toggle";
+    labels.source = @"favorite_list";
+    labels.value = @"true";
+    
+    [self benchmarkWithName:@"tracker.hidden_event" sampleCount:50 operationCountPerSample:100 block:^(NSUInteger firstOperationIndex, NSUInteger operationCount) {
+        for (NSUInteger i = 0; i < operationCount; ++i) {
+            [SRGAnalyticsTracker.sharedTracker trackHiddenEventWithName:@"Hidden event" labels:labels];
+        }
+        [SRGAnalyticsTracker.sharedTracker drainWithTimeout:60.];
+    }];
+}
+
+- (void)testHiddenEventEmission
+{
+    // Cost on the emitting thread only
+    [self benchmarkWithName:@"tracker.hidden_event.emission" sampleCount:50 operationCountPerSample:1000 block:^(NSUInteger firstOperationIndex, NSUInteger operationCount) {
+        for (NSUInteger i = 0; i < operationCount; ++i) {
+            [SRGAnalyticsTracker.sharedTracker trackHiddenEventWithName:@"Hidden event"];
+        }
+    }];
+    [SRGAnalyticsTracker.sharedTracker drainWithTimeout:60.];
+}
+
+- (void)testMediaEvents
+{
+    NSDictionary<NSString *, NSString *> *sessionLabels = SessionLabels(0);
+    [self benchmarkWithName:@"tracker.media_event" sampleCount:50 operationCountPerSample:100 block:^(NSUInteger firstOperationIndex, NSUInteger operationCount) {
+        for (NSUInteger i = firstOperationIndex; i < firstOperationIndex + operationCount; ++i) {
+            [SRGAnalyticsTracker.sharedTracker trackTagCommanderEventWithRecord:MediaRecord(@"play", i)
+                                                                  sessionLabels:sessionLabels
+                                                              sessionIdentifier:1
+                                                          unitTestingIdentifier:nil];
+        }
+        [SRGAnalyticsTracker.sharedTracker drainWithTimeout:60.];
+    }];
+}
+
+- (void)testHeartbeatFanOut
+{
+    for (NSNumber *playerCount in @[ @1, @10, @50 ]) {
+        NSMutableArray<NSDictionary<NSString *, NSString *> *> *sessionLabels = [NSMutableArray array];
+        for (NSUInteger i = 0; i < playerCount.unsignedIntegerValue; ++i) {
+            [sessionLabels addObject:SessionLabels(i)];
+        }
+        
+        // One operation is one heartbeat tick, sent by all players
+        NSString *name = [NSString stringWithFormat:@"tracker.heartbeat.%@_players", playerCount];
+        [self benchmarkWithName:name sampleCount:20 operationCountPerSample:10 block:^(NSUInteger firstOperationIndex, NSUInteger operationCount) {
+            for (NSUInteger i = firstOperationIndex; i < firstOperationIndex + operationCount; ++i) {
+                [sessionLabels enumerateObjectsUsingBlock:^(NSDictionary<NSString *, NSString *> * _Nonnull labels, NSUInteger idx, BOOL * _Nonnull stop) {
+                    [SRGAnalyticsTracker.sharedTracker trackTagCommanderEventWithRecord:MediaRecord(@"pos", i * 30)
+                                                                          sessionLabels:labels
+                                                                      sessionIdentifier:idx + 1
+                                                                  unitTestingIdentifier:nil];
+                }];
+            }
+            [SRGAnalyticsTracker.sharedTracker drainWithTimeout:60.];
+        }];
+    }
+}
+
+@end
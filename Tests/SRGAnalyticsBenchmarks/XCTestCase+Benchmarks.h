@@ -0,0 +1,35 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+@import XCTest;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Block performing a number of operations for a benchmark. The operation index is monotonically increasing across
+ *  calls and can be used to vary inputs.
+ */
+typedef void (^BenchmarkBlock)(NSUInteger firstOperationIndex, NSUInteger operationCount);
+
+@interface XCTestCase (Benchmarks)
+
+/**
+ *  Run a benchmark, measuring the block over a number of samples (each performing the specified number of operations)
+ *  after a warm-up sample.
+ *
+ *  Results (ns/op mean and percentiles, allocations/op) are printed on the standard output as a single JSON object
+ *  prefixed with `SRG_BENCHMARK `, and appended to `benchmarks.jsonl` in the temporary directory.
+ *
+ *  @discussion Allocations are counted in the default malloc zone for all threads, including the event queue worker.
+ */
+- (void)benchmarkWithName:(NSString *)name
+              sampleCount:(NSUInteger)sampleCount
+  operationCountPerSample:(NSUInteger)operationCountPerSample
+                    block:(BenchmarkBlock)block;
+
+@end
+
+NS_ASSUME_NONNULL_END
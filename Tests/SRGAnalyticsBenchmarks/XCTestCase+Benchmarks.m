@@ -0,0 +1,140 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "XCTestCase+Benchmarks.h"
+
+@import SRGAnalytics;
+
+#import <mach/mach.h>
+#import <mach/mach_time.h>
+#import <malloc/malloc.h>
+#import <stdatomic.h>
+
+static _Atomic(uint64_t) s_allocationCount;
+
+static void *(*s_malloc)(struct _malloc_zone_t *zone, size_t size);
+static void *(*s_calloc)(struct _malloc_zone_t *zone, size_t count, size_t size);
+static void *(*s_realloc)(struct _malloc_zone_t *zone, void *pointer, size_t size);
+
+static void *CountingMalloc(struct _malloc_zone_t *zone, size_t size)
+{
+    atomic_fetch_add_explicit(&s_allocationCount, 1, memory_order_relaxed);
+    return s_malloc(zone, size);
+}
+
+static void *CountingCalloc(struct _malloc_zone_t *zone, size_t count, size_t size)
+{
+    atomic_fetch_add_explicit(&s_allocationCount, 1, memory_order_relaxed);
+    return s_calloc(zone, count, size);
+}
+
+static void *CountingRealloc(struct _malloc_zone_t *zone, void *pointer, size_t size)
+{
+    atomic_fetch_add_explicit(&s_allocationCount, 1, memory_order_relaxed);
+    return s_realloc(zone, pointer, size);
+}
+
+// Count allocations by wrapping the functions of the default malloc zone, whose structure is write-protected
+static void InstallAllocationCounter(void)
+{
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        malloc_zone_t *zone = malloc_default_zone();
+        vm_address_t page = trunc_page((vm_address_t)zone);
+        vm_size_t size = round_page((vm_address_t)zone + sizeof(malloc_zone_t)) - page;
+        if (vm_protect(mach_task_self(), page, size, 0, VM_PROT_READ | VM_PROT_WRITE) != KERN_SUCCESS) {
+            return;
+        }
+        
+        s_malloc = zone->malloc;
+        s_calloc = zone->calloc;
+        s_realloc = zone->realloc;
+        
+        zone->malloc = CountingMalloc;
+        zone->calloc = CountingCalloc;
+        zone->realloc = CountingRealloc;
+        
+        vm_protect(mach_task_self(), page, size, 0, VM_PROT_READ);
+    });
+}
+
+static uint64_t Nanoseconds(void)
+{
+    static mach_timebase_info_data_t s_timebaseInfo;
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        mach_timebase_info(&s_timebaseInfo);
+    });
+    return mach_absolute_time() * s_timebaseInfo.numer / s_timebaseInfo.denom;
+}
+
+static double Percentile(NSArray<NSNumber *> *sortedValues, double percentile)
+{
+    NSUInteger index = MIN((NSUInteger)ceil(percentile / 100. * sortedValues.count), sortedValues.count) - 1;
+    return sortedValues[index].doubleValue;
+}
+
+@implementation XCTestCase (Benchmarks)
+
+- (void)benchmarkWithName:(NSString *)name
+              sampleCount:(NSUInteger)sampleCount
+  operationCountPerSample:(NSUInteger)operationCountPerSample
+                    block:(BenchmarkBlock)block
+{
+    NSParameterAssert(sampleCount > 0 && operationCountPerSample > 0);
+    
+    InstallAllocationCounter();
+    
+    NSUInteger operationIndex = 0;
+    
+    // Warm up caches, pools and lazily created objects
+    @autoreleasepool {
+        block(operationIndex, operationCountPerSample);
+        operationIndex += operationCountPerSample;
+    }
+    
+    NSMutableArray<NSNumber *> *samples = [NSMutableArray arrayWithCapacity:sampleCount];
+    uint64_t totalDuration = 0;
+    uint64_t initialAllocationCount = atomic_load(&s_allocationCount);
+    
+    for (NSUInteger i = 0; i < sampleCount; ++i) {
+        @autoreleasepool {
+            uint64_t startTime = Nanoseconds();
+            block(operationIndex, operationCountPerSample);
+            uint64_t duration = Nanoseconds() - startTime;
+            
+            totalDuration += duration;
+            [samples addObject:@((double)duration / operationCountPerSample)];
+            operationIndex += operationCountPerSample;
+        }
+    }
+    
+    uint64_t allocationCount = atomic_load(&s_allocationCount) - initialAllocationCount;
+    NSUInteger operationCount = sampleCount * operationCountPerSample;
+    
+    NSArray<NSNumber *> *sortedSamples = [samples sortedArrayUsingSelector:@selector(compare:)];
+    NSDictionary<NSString *, id> *result = @{ @"name" : name,
+                                              @"version" : SRGAnalyticsMarketingVersion(),
+                                              @"operations" : @(operationCount),
+                                              @"ns_per_op" : @((double)totalDuration / operationCount),
+                                              @"p50_ns_per_op" : @(Percentile(sortedSamples, 50.)),
+                                              @"p90_ns_per_op" : @(Percentile(sortedSamples, 90.)),
+                                              @"p99_ns_per_op" : @(Percentile(sortedSamples, 99.)),
+                                              @"allocations_per_op" : s_malloc ? @((double)allocationCount / operationCount) : NSNull.null };
+    
+    NSData *data = [NSJSONSerialization dataWithJSONObject:result options:0 error:NULL];
+    NSString *line = [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
+    printf("SRG_BENCHMARK %s\n", line.UTF8String);
+    
+    NSString *filePath = [NSTemporaryDirectory() stringByAppendingPathComponent:@"benchmarks.jsonl"];
+    FILE *file = fopen(filePath.fileSystemRepresentation, "a");
+    if (file) {
+        fprintf(file, "%s\n", line.UTF8String);
+        fclose(file);
+    }
+}
+
+@end
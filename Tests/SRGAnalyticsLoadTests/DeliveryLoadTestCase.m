@@ -0,0 +1,145 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "LoadTestTrackerSetup.h"
+#import "SRGAnalyticsClock.h"
+#import "SRGAnalyticsTracker+Private.h"
+
+@import SRGAnalytics;
+@import XCTest;
+
+static double Percentile(NSArray<NSNumber *> *sortedValues, double percentile)
+{
+    if (sortedValues.count == 0) {
+        return 0.;
+    }
+    NSUInteger index = MIN((NSUInteger)ceil(percentile / 100. * sortedValues.count), sortedValues.count) - 1;
+    return sortedValues[index].doubleValue;
+}
+
+@interface DeliveryLoadTestCase : XCTestCase
+
+@end
+
+@implementation DeliveryLoadTestCase
+
+#pragma mark Helpers
+
+// Track the specified number of hidden events and wait until the collector has received them, reporting throughput
+// and end-to-end latencies as a single JSON line prefixed with `SRG_LOAD_TEST `
+- (void)runLoadTestWithName:(NSString *)name eventCount:(NSUInteger)eventCount timeout:(NSTimeInterval)timeout
+{
+    LoopbackCollector *collector = LoadTestCollector();
+    NSString *runIdentifier = NSUUID.UUID.UUIDString;
+    
+    uint64_t *emissionTimes = calloc(eventCount, sizeof(uint64_t));
+    NSUInteger initialEventCount = collector.eventCount;
+    
+    uint64_t startTime = SRGAnalyticsMonotonicTime();
+    for (NSUInteger i = 0; i < eventCount; ++i) {
+        SRGAnalyticsHiddenEventLabels *labels = [[SRGAnalyticsHiddenEventLabels alloc] init];
+        labels.customInfo = @{ @"load_test_run" : runIdentifier,
+                               @"load_test_index" : @(i).stringValue };
+        
+        emissionTimes[i] = SRGAnalyticsMonotonicTime();
+        [SRGAnalyticsTracker.sharedTracker trackHiddenEventWithName:name labels:labels];
+    }
+    
+    XCTAssertTrue([collector waitForEventCount:initialEventCount + eventCount timeout:timeout]);
+    uint64_t duration = SRGAnalyticsMonotonicTime() - startTime;
+    
+    NSMutableIndexSet *receivedIndexes = [NSMutableIndexSet indexSet];
+    NSMutableArray<NSNumber *> *latencies = [NSMutableArray arrayWithCapacity:eventCount];
+    for (LoopbackCollectedEvent *event in collector.events) {
+        if (! [event.labels[@"load_test_run"] isEqualToString:runIdentifier]) {
+            continue;
+        }
+        
+        NSUInteger index = (NSUInteger)event.labels[@"load_test_index"].integerValue;
+        XCTAssertLessThan(index, eventCount);
+        XCTAssertFalse([receivedIndexes containsIndex:index]);
+        [receivedIndexes addIndex:index];
+        [latencies addObject:@((double)(event.receptionTime - emissionTimes[index]) / 1e6)];
+    }
+    free(emissionTimes);
+    
+    XCTAssertEqual(receivedIndexes.count, eventCount);
+    
+    NSArray<NSNumber *> *sortedLatencies = [latencies sortedArrayUsingSelector:@selector(compare:)];
+    NSDictionary<NSString *, id> *result = @{ @"name" : name,
+                                              @"version" : SRGAnalyticsMarketingVersion(),
+                                              @"events" : @(eventCount),
+                                              @"events_per_second" : @((double)eventCount * 1e9 / duration),
+                                              @"p50_latency_ms" : @(Percentile(sortedLatencies, 50.)),
+                                              @"p90_latency_ms" : @(Percentile(sortedLatencies, 90.)),
+                                              @"p99_latency_ms" : @(Percentile(sortedLatencies, 99.)),
+                                              @"requests" : @(collector.requestCount),
+                                              @"bytes" : @(collector.byteCount),
+                                              @"failed_requests" : @(collector.failedRequestCount),
+                                              @"throttled_requests" : @(collector.throttledRequestCount) };
+    
+    NSData *data = [NSJSONSerialization dataWithJSONObject:result options:0 error:NULL];
+    NSString *line = [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
+    printf("SRG_LOAD_TEST %s\n", line.UTF8String);
+}
+
+#pragma mark Setup and teardown
+
+- (void)setUp
+{
+    [LoadTestCollector() reset];
+}
+
+#pragma mark Tests
+
+- (void)testThroughput
+{
+    [self runLoadTestWithName:@"delivery.throughput" eventCount:2000 timeout:60.];
+}
+
+- (void)testSlowCollector
+{
+    LoadTestCollector().responseDelay = 0.05;
+    [self runLoadTestWithName:@"delivery.slow_collector" eventCount:300 timeout:60.];
+}
+
+- (void)testRetryOnFailures
+{
+    LoadTestCollector().failureRatio = 0.2;
+    [self runLoadTestWithName:@"delivery.failures" eventCount:300 timeout:120.];
+    XCTAssertGreaterThan(LoadTestCollector().failedRequestCount, 0);
+}
+
+- (void)testRetryOnThrottling
+{
+    LoadTestCollector().maximumRequestRate = 100.;
+    [self runLoadTestWithName:@"delivery.throttling" eventCount:300 timeout:120.];
+    XCTAssertGreaterThan(LoadTestCollector().throttledRequestCount, 0);
+}
+
+- (void)testPageViews
+{
+    LoopbackCollector *collector = LoadTestCollector();
+    NSString *title = NSUUID.UUID.UUIDString;
+    
+    [SRGAnalyticsTracker.sharedTracker trackPageViewWithTitle:title levels:@[ @"Load test" ] labels:nil fromPushNotification:NO ignoreApplicationState:YES];
+    XCTAssertTrue([collector waitForEventCount:2 timeout:20.]);
+    
+    NSPredicate *tagCommanderPredicate = [NSPredicate predicateWithBlock:^BOOL(LoopbackCollectedEvent * _Nullable event, NSDictionary<NSString *,id> * _Nullable bindings) {
+        return [event.service isEqualToString:@"tagcommander"] && [event.labels[@"content_title"] isEqualToString:title];
+    }];
+    LoopbackCollectedEvent *tagCommanderEvent = [collector.events filteredArrayUsingPredicate:tagCommanderPredicate].firstObject;
+    XCTAssertEqualObjects(tagCommanderEvent.labels[@"event_id"], @"screen");
+    XCTAssertEqualObjects(tagCommanderEvent.labels[@"navigation_app_site_name"], @"rts-app-test-v");
+    
+    NSPredicate *comScorePredicate = [NSPredicate predicateWithBlock:^BOOL(LoopbackCollectedEvent * _Nullable event, NSDictionary<NSString *,id> * _Nullable bindings) {
+        return [event.service isEqualToString:@"comscore"] && [event.labels[@"srg_title"] isEqualToString:title];
+    }];
+    LoopbackCollectedEvent *comScoreEvent = [collector.events filteredArrayUsingPredicate:comScorePredicate].firstObject;
+    XCTAssertEqualObjects(comScoreEvent.labels[@"ns_category"], @"load-test");
+}
+
+@end
@@ -0,0 +1,16 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "LoopbackCollector.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  The loopback collector to which the shared tracker sends its events.
+ */
+OBJC_EXPORT LoopbackCollector *LoadTestCollector(void);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,34 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "LoadTestTrackerSetup.h"
+
+@import SRGAnalytics;
+
+static LoopbackCollector *s_collector;
+
+LoopbackCollector *LoadTestCollector(void)
+{
+    return s_collector;
+}
+
+// The singleton can be only setup once. Do not perform in a test case setup
+__attribute__((constructor)) static void SetupLoadTestSingletonTracker(void)
+{
+    s_collector = [[LoopbackCollector alloc] initWithPort:0];
+    NSCAssert(s_collector != nil, @"The loopback collector could not be started");
+    
+    SRGAnalyticsConfiguration *configuration = [[SRGAnalyticsConfiguration alloc] initWithBusinessUnitIdentifier:SRGAnalyticsBusinessUnitIdentifierRTS
+                                                                                                       container:10
+                                                                                                        siteName:@"rts-app-test-v"];
+    configuration.collectorURL = s_collector.URL;
+    
+    // Deliver every event, without deduplication nor periodic events
+    configuration.pageViewDebounceInterval = 0.;
+    configuration.eventSummaryInterval = 0.;
+    configuration.hiddenEventAggregationInterval = 0.;
+    [SRGAnalyticsTracker.sharedTracker startWithConfiguration:configuration];
+}
@@ -0,0 +1,139 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+@import Foundation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  An event received by a loopback collector.
+ */
+@interface LoopbackCollectedEvent : NSObject
+
+/**
+ *  The service the event was sent to (`tagcommander` or `comscore`).
+ */
+@property (nonatomic, readonly, copy) NSString *service;
+
+/**
+ *  The decoded labels.
+ */
+@property (nonatomic, readonly) NSDictionary<NSString *, NSString *> *labels;
+
+/**
+ *  The time at which the event was received, in nanoseconds (see `SRGAnalyticsMonotonicTime()`).
+ */
+@property (nonatomic, readonly) uint64_t receptionTime;
+
+@end
+
+/**
+ *  Local HTTP server standing in for the TagCommander and comScore collection hosts, so that event delivery can be
+ *  tested end to end without network access (@see `SRGAnalyticsConfiguration.collectorURL`). It listens on the
+ *  loopback interface and answers:
+ *    - `POST /tagcommander`, whose body contains URL-encoded labels (one event per line).
+ *    - `POST /tagcommander/batch`, whose body contains a batch of events (@see `SRGAnalyticsBatchEncoder`).
+ *    - `GET /comscore`, whose query contains URL-encoded labels.
+ *    - `GET /applications`, returning the application list, if any.
+ *
+ *  Received events are decoded and stored. Latency, errors and throttling can be injected to test delivery under
+ *  adverse conditions. All properties and methods are thread-safe.
+ */
+@interface LoopbackCollector : NSObject
+
+/**
+ *  Start a collector listening on the specified port. Use 0 to listen on an available port. Return `nil` if the
+ *  collector could not be started.
+ */
+- (nullable instancetype)initWithPort:(uint16_t)port NS_DESIGNATED_INITIALIZER;
+
+/**
+ *  The collector base URL.
+ */
+@property (nonatomic, readonly) NSURL *URL;
+
+/**
+ *  Delay (in seconds) applied before answering each request.
+ *
+ *  Default value is 0.
+ */
+@property (atomic) NSTimeInterval responseDelay;
+
+/**
+ *  Ratio (between 0 and 1) of requests randomly failed with a 503 status, without storing their events.
+ *
+ *  Default value is 0.
+ */
+@property (atomic) double failureRatio;
+
+/**
+ *  Maximum number of requests accepted per second. Requests in excess are answered with a 429 status and a
+ *  `Retry-After` header. Set to 0 for no limit.
+ *
+ *  Default value is 0.
+ */
+@property (atomic) double maximumRequestRate;
+
+/**
+ *  The application list JSON returned by `/applications`. If `nil`, a 404 status is returned.
+ *
+ *  Default value is `nil`.
+ */
+@property (atomic, copy, nullable) NSData *applicationList;
+
+/**
+ *  Number of requests received, failed and throttled.
+ */
+@property (nonatomic, readonly) NSUInteger requestCount;
+@property (nonatomic, readonly) NSUInteger failedRequestCount;
+@property (nonatomic, readonly) NSUInteger throttledRequestCount;
+
+/**
+ *  Number of request body bytes received.
+ */
+@property (nonatomic, readonly) NSUInteger byteCount;
+
+/**
+ *  Events received so far, in reception order.
+ */
+@property (nonatomic, readonly) NSArray<LoopbackCollectedEvent *> *events;
+
+/**
+ *  Number of events received so far.
+ */
+@property (nonatomic, readonly) NSUInteger eventCount;
+
+/**
+ *  Block the calling thread until at least the specified number of events have been received, or until the timeout
+ *  (in seconds) expires. Return `YES` iff the count was reached.
+ */
+- (BOOL)waitForEventCount:(NSUInteger)eventCount timeout:(NSTimeInterval)timeout;
+
+/**
+ *  Discard received events, reset counters and injection settings.
+ */
+- (void)reset;
+
+/**
+ *  Stop listening and close all connections.
+ */
+- (void)stop;
+
+@end
+
+@interface LoopbackCollectedEvent (Unavailable)
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+@interface LoopbackCollector (Unavailable)
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,538 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "LoopbackCollector.h"
+
+#import "SRGAnalyticsBatchEncoder.h"
+#import "SRGAnalyticsCaptureSink+Private.h"
+#import "SRGAnalyticsClock.h"
+
+#import <arpa/inet.h>
+#import <fcntl.h>
+#import <netinet/in.h>
+#import <sys/socket.h>
+
+static const uint64_t kNanosecondsPerSecond = 1000000000ULL;
+
+@interface LoopbackCollectedEvent ()
+
+- (instancetype)initWithService:(NSString *)service labels:(NSDictionary<NSString *, NSString *> *)labels receptionTime:(uint64_t)receptionTime;
+
+@end
+
+@interface LoopbackConnection : NSObject
+
+@property (nonatomic) dispatch_queue_t queue;
+@property (nonatomic) dispatch_io_t channel;
+@property (nonatomic) NSMutableData *buffer;
+@property (nonatomic, getter=isClosed) BOOL closed;
+
+@end
+
+@interface LoopbackCollector ()
+
+@property (nonatomic) NSURL *URL;
+@property (nonatomic) dispatch_source_t acceptSource;
+
+// Protects all state below
+@property (nonatomic) NSCondition *condition;
+
+@property (nonatomic) NSMutableArray<LoopbackCollectedEvent *> *receivedEvents;
+@property (nonatomic) NSMutableSet<LoopbackConnection *> *connections;
+
+@property (nonatomic) NSUInteger receivedRequestCount;
+@property (nonatomic) NSUInteger receivedFailedRequestCount;
+@property (nonatomic) NSUInteger receivedThrottledRequestCount;
+@property (nonatomic) NSUInteger receivedByteCount;
+
+// Throttling uses fixed one-second windows
+@property (nonatomic) uint64_t throttlingWindowStartTime;
+@property (nonatomic) NSUInteger throttlingWindowRequestCount;
+
+@end
+
+@implementation LoopbackCollector
+
+#pragma mark Object lifecycle
+
+- (instancetype)initWithPort:(uint16_t)port
+{
+    if (self = [super init]) {
+        int listeningSocket = socket(AF_INET, SOCK_STREAM, 0);
+        if (listeningSocket < 0) {
+            return nil;
+        }
+        
+        int enabled = 1;
+        setsockopt(listeningSocket, SOL_SOCKET, SO_REUSEADDR, &enabled, sizeof(enabled));
+        
+        struct sockaddr_in address = { 0 };
+        address.sin_len = sizeof(address);
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        
+        socklen_t addressLength = sizeof(address);
+        if (bind(listeningSocket, (struct sockaddr *)&address, sizeof(address)) != 0
+                || listen(listeningSocket, SOMAXCONN) != 0
+                || getsockname(listeningSocket, (struct sockaddr *)&address, &addressLength) != 0) {
+            close(listeningSocket);
+            return nil;
+        }
+        fcntl(listeningSocket, F_SETFL, O_NONBLOCK);
+        
+        self.URL = [NSURL URLWithString:[NSString stringWithFormat:@"http://127.0.0.1:%@", @(ntohs(address.sin_port))]];
+        self.condition = [[NSCondition alloc] init];
+        self.receivedEvents = [NSMutableArray array];
+        self.connections = [NSMutableSet set];
+        
+        dispatch_queue_t queue = dispatch_queue_create("ch.srgssr.analytics.collector", DISPATCH_QUEUE_SERIAL);
+        self.acceptSource = dispatch_source_create(DISPATCH_SOURCE_TYPE_READ, (uintptr_t)listeningSocket, 0, queue);
+        
+        __weak __typeof(self) weakSelf = self;
+        dispatch_source_set_event_handler(self.acceptSource, ^{
+            int connectionSocket = -1;
+            while ((connectionSocket = accept(listeningSocket, NULL, NULL)) >= 0) {
+                [weakSelf openConnectionWithSocket:connectionSocket];
+            }
+        });
+        dispatch_source_set_cancel_handler(self.acceptSource, ^{
+            close(listeningSocket);
+        });
+        dispatch_resume(self.acceptSource);
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [self stop];
+}
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-implementations"
+
+- (instancetype)init
+{
+    [self doesNotRecognizeSelector:_cmd];
+    return [self initWithPort:0];
+}
+
+#pragma clang diagnostic pop
+
+#pragma mark Getters and setters
+
+- (NSUInteger)requestCount
+{
+    [self.condition lock];
+    NSUInteger requestCount = self.receivedRequestCount;
+    [self.condition unlock];
+    return requestCount;
+}
+
+- (NSUInteger)failedRequestCount
+{
+    [self.condition lock];
+    NSUInteger failedRequestCount = self.receivedFailedRequestCount;
+    [self.condition unlock];
+    return failedRequestCount;
+}
+
+- (NSUInteger)throttledRequestCount
+{
+    [self.condition lock];
+    NSUInteger throttledRequestCount = self.receivedThrottledRequestCount;
+    [self.condition unlock];
+    return throttledRequestCount;
+}
+
+- (NSUInteger)byteCount
+{
+    [self.condition lock];
+    NSUInteger byteCount = self.receivedByteCount;
+    [self.condition unlock];
+    return byteCount;
+}
+
+- (NSArray<LoopbackCollectedEvent *> *)events
+{
+    [self.condition lock];
+    NSArray<LoopbackCollectedEvent *> *events = self.receivedEvents.copy;
+    [self.condition unlock];
+    return events;
+}
+
+- (NSUInteger)eventCount
+{
+    [self.condition lock];
+    NSUInteger eventCount = self.receivedEvents.count;
+    [self.condition unlock];
+    return eventCount;
+}
+
+#pragma mark Control
+
+- (BOOL)waitForEventCount:(NSUInteger)eventCount timeout:(NSTimeInterval)timeout
+{
+    NSDate *limitDate = [NSDate dateWithTimeIntervalSinceNow:timeout];
+    
+    [self.condition lock];
+    while (self.receivedEvents.count < eventCount && [self.condition waitUntilDate:limitDate]);
+    BOOL reached = (self.receivedEvents.count >= eventCount);
+    [self.condition unlock];
+    return reached;
+}
+
+- (void)reset
+{
+    self.responseDelay = 0.;
+    self.failureRatio = 0.;
+    self.maximumRequestRate = 0.;
+    self.applicationList = nil;
+    
+    [self.condition lock];
+    [self.receivedEvents removeAllObjects];
+    self.receivedRequestCount = 0;
+    self.receivedFailedRequestCount = 0;
+    self.receivedThrottledRequestCount = 0;
+    self.receivedByteCount = 0;
+    self.throttlingWindowStartTime = 0;
+    self.throttlingWindowRequestCount = 0;
+    [self.condition unlock];
+}
+
+- (void)stop
+{
+    if (self.acceptSource) {
+        dispatch_source_cancel(self.acceptSource);
+        self.acceptSource = nil;
+    }
+    
+    [self.condition lock];
+    NSSet<LoopbackConnection *> *connections = self.connections.copy;
+    [self.connections removeAllObjects];
+    [self.condition unlock];
+    
+    // Also called from -dealloc, self must not be captured
+    for (LoopbackConnection *connection in connections) {
+        dispatch_async(connection.queue, ^{
+            if (! connection.closed) {
+                connection.closed = YES;
+                dispatch_io_close(connection.channel, DISPATCH_IO_STOP);
+            }
+        });
+    }
+}
+
+#pragma mark Connections
+
+- (void)openConnectionWithSocket:(int)connectionSocket
+{
+    int enabled = 1;
+    setsockopt(connectionSocket, SOL_SOCKET, SO_NOSIGPIPE, &enabled, sizeof(enabled));
+    
+    LoopbackConnection *connection = [[LoopbackConnection alloc] init];
+    connection.queue = dispatch_queue_create("ch.srgssr.analytics.collector.connection", DISPATCH_QUEUE_SERIAL);
+    connection.buffer = [NSMutableData data];
+    connection.channel = dispatch_io_create(DISPATCH_IO_STREAM, connectionSocket, connection.queue, ^(int error) {
+        close(connectionSocket);
+    });
+    dispatch_io_set_low_water(connection.channel, 1);
+    
+    [self.condition lock];
+    [self.connections addObject:connection];
+    [self.condition unlock];
+    
+    __weak __typeof(self) weakSelf = self;
+    dispatch_io_read(connection.channel, 0, SIZE_MAX, connection.queue, ^(bool done, dispatch_data_t _Nullable data, int error) {
+        __strong __typeof(weakSelf) strongSelf = weakSelf;
+        if (data && ! connection.closed) {
+            [connection.buffer appendData:(NSData *)data];
+            [strongSelf processRequestsForConnection:connection];
+        }
+        if (done) {
+            [strongSelf closeConnection:connection];
+        }
+    });
+}
+
+// Must be called on the connection queue
+- (void)closeConnection:(LoopbackConnection *)connection
+{
+    if (connection.closed) {
+        return;
+    }
+    
+    connection.closed = YES;
+    dispatch_io_close(connection.channel, DISPATCH_IO_STOP);
+    
+    [self.condition lock];
+    [self.connections removeObject:connection];
+    [self.condition unlock];
+}
+
+#pragma mark Requests
+
+// Must be called on the connection queue
+- (void)processRequestsForConnection:(LoopbackConnection *)connection
+{
+    static NSData *s_headerSeparator;
+    static dispatch_once_t s_onceToken;
+    dispatch_once(&s_onceToken, ^{
+        s_headerSeparator = [@"\r\n\r\n" dataUsingEncoding:NSASCIIStringEncoding];
+    });
+    
+    NSMutableData *buffer = connection.buffer;
+    while (! connection.closed) {
+        NSRange separatorRange = [buffer rangeOfData:s_headerSeparator options:0 range:NSMakeRange(0, buffer.length)];
+        if (separatorRange.location == NSNotFound) {
+            return;
+        }
+        
+        NSString *header = [[NSString alloc] initWithBytes:buffer.bytes length:separatorRange.location encoding:NSISOLatin1StringEncoding];
+        NSArray<NSString *> *lines = [header componentsSeparatedByString:@"\r\n"];
+        NSArray<NSString *> *requestLineComponents = [lines.firstObject componentsSeparatedByString:@" "];
+        if (requestLineComponents.count < 2) {
+            [self closeConnection:connection];
+            return;
+        }
+        
+        NSUInteger contentLength = 0;
+        BOOL keepAlive = YES;
+        for (NSString *line in [lines subarrayWithRange:NSMakeRange(1, lines.count - 1)]) {
+            NSRange colonRange = [line rangeOfString:@":"];
+            if (colonRange.location == NSNotFound) {
+                continue;
+            }
+            
+            NSString *name = [line substringToIndex:colonRange.location].lowercaseString;
+            NSString *value = [[line substringFromIndex:NSMaxRange(colonRange)] stringByTrimmingCharactersInSet:NSCharacterSet.whitespaceCharacterSet];
+            if ([name isEqualToString:@"content-length"]) {
+                contentLength = (NSUInteger)MAX(value.longLongValue, 0);
+            }
+            else if ([name isEqualToString:@"connection"] && [value.lowercaseString isEqualToString:@"close"]) {
+                keepAlive = NO;
+            }
+        }
+        
+        NSUInteger requestLength = NSMaxRange(separatorRange) + contentLength;
+        if (buffer.length < requestLength) {
+            return;
+        }
+        
+        NSData *body = [buffer subdataWithRange:NSMakeRange(NSMaxRange(separatorRange), contentLength)];
+        [buffer replaceBytesInRange:NSMakeRange(0, requestLength) withBytes:NULL length:0];
+        
+        [self handleRequestWithMethod:requestLineComponents[0] target:requestLineComponents[1] body:body connection:connection keepAlive:keepAlive];
+    }
+}
+
+- (void)handleRequestWithMethod:(NSString *)method
+                         target:(NSString *)target
+                           body:(NSData *)body
+                     connection:(LoopbackConnection *)connection
+                      keepAlive:(BOOL)keepAlive
+{
+    uint64_t receptionTime = SRGAnalyticsMonotonicTime();
+    double maximumRequestRate = self.maximumRequestRate;
+    
+    [self.condition lock];
+    self.receivedRequestCount += 1;
+    self.receivedByteCount += body.length;
+    
+    BOOL throttled = NO;
+    if (maximumRequestRate > 0.) {
+        if (receptionTime - self.throttlingWindowStartTime >= kNanosecondsPerSecond) {
+            self.throttlingWindowStartTime = receptionTime;
+            self.throttlingWindowRequestCount = 0;
+        }
+        
+        if (self.throttlingWindowRequestCount >= maximumRequestRate) {
+            self.receivedThrottledRequestCount += 1;
+            throttled = YES;
+        }
+        else {
+            self.throttlingWindowRequestCount += 1;
+        }
+    }
+    
+    BOOL failed = ! throttled && (double)arc4random_uniform(1000000) / 1000000. < self.failureRatio;
+    if (failed) {
+        self.receivedFailedRequestCount += 1;
+    }
+    [self.condition unlock];
+    
+    NSInteger statusCode = 204;
+    NSDictionary<NSString *, NSString *> *headers = nil;
+    NSData *responseBody = nil;
+    
+    NSRange queryRange = [target rangeOfString:@"?"];
+    NSString *path = (queryRange.location != NSNotFound) ? [target substringToIndex:queryRange.location] : target;
+    NSString *query = (queryRange.location != NSNotFound) ? [target substringFromIndex:NSMaxRange(queryRange)] : @"";
+    
+    if (throttled) {
+        statusCode = 429;
+        headers = @{ @"Retry-After" : @"1" };
+    }
+    else if (failed) {
+        statusCode = 503;
+    }
+    else if ([path isEqualToString:@"/tagcommander"] && [method isEqualToString:@"POST"]) {
+        NSString *encodedEvents = [[NSString alloc] initWithData:body encoding:NSASCIIStringEncoding] ?: @"";
+        [self receiveEncodedEvents:[encodedEvents componentsSeparatedByString:@"\n"] service:@"tagcommander" receptionTime:receptionTime];
+    }
+    else if ([path isEqualToString:@"/tagcommander/batch"] && [method isEqualToString:@"POST"]) {
+        NSArray<NSDictionary<NSString *, NSString *> *> *batchLabels = SRGAnalyticsDecodeBatch(body);
+        if (batchLabels) {
+            [self receiveEventsWithLabels:batchLabels service:@"tagcommander" receptionTime:receptionTime];
+        }
+        else {
+            statusCode = 400;
+        }
+    }
+    else if ([path isEqualToString:@"/comscore"]) {
+        [self receiveEncodedEvents:@[ query ] service:@"comscore" receptionTime:receptionTime];
+    }
+    else if ([path isEqualToString:@"/applications"] && self.applicationList) {
+        statusCode = 200;
+        headers = @{ @"Content-Type" : @"application/json" };
+        responseBody = self.applicationList;
+    }
+    else {
+        statusCode = 404;
+    }
+    
+    NSTimeInterval responseDelay = self.responseDelay;
+    if (responseDelay > 0.) {
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(responseDelay * NSEC_PER_SEC)), connection.queue, ^{
+            [self respondWithStatusCode:statusCode headers:headers body:responseBody connection:connection keepAlive:keepAlive];
+        });
+    }
+    else {
+        [self respondWithStatusCode:statusCode headers:headers body:responseBody connection:connection keepAlive:keepAlive];
+    }
+}
+
+- (void)receiveEncodedEvents:(NSArray<NSString *> *)encodedEvents service:(NSString *)service receptionTime:(uint64_t)receptionTime
+{
+    NSMutableArray<LoopbackCollectedEvent *> *events = [NSMutableArray arrayWithCapacity:encodedEvents.count];
+    for (NSString *encodedEvent in encodedEvents) {
+        if (encodedEvent.length == 0) {
+            continue;
+        }
+        
+        NSDictionary<NSString *, NSString *> *labels = [SRGAnalyticsCapturedEvent labelsFromEncodedLabels:encodedEvent];
+        [events addObject:[[LoopbackCollectedEvent alloc] initWithService:service labels:labels receptionTime:receptionTime]];
+    }
+    [self receiveEvents:events];
+}
+
+- (void)receiveEventsWithLabels:(NSArray<NSDictionary<NSString *, NSString *> *> *)labelsArray service:(NSString *)service receptionTime:(uint64_t)receptionTime
+{
+    NSMutableArray<LoopbackCollectedEvent *> *events = [NSMutableArray arrayWithCapacity:labelsArray.count];
+    for (NSDictionary<NSString *, NSString *> *labels in labelsArray) {
+        [events addObject:[[LoopbackCollectedEvent alloc] initWithService:service labels:labels receptionTime:receptionTime]];
+    }
+    [self receiveEvents:events];
+}
+
+- (void)receiveEvents:(NSArray<LoopbackCollectedEvent *> *)events
+{
+    [self.condition lock];
+    [self.receivedEvents addObjectsFromArray:events];
+    [self.condition broadcast];
+    [self.condition unlock];
+}
+
+// Must be called on the connection queue
+- (void)respondWithStatusCode:(NSInteger)statusCode
+                      headers:(NSDictionary<NSString *, NSString *> *)headers
+                         body:(NSData *)body
+                   connection:(LoopbackConnection *)connection
+                    keepAlive:(BOOL)keepAlive
+{
+    if (connection.closed) {
+        return;
+    }
+    
+    NSMutableString *head = [NSMutableString stringWithFormat:@"HTTP/1.1 %@ %@\r\nContent-Length: %@\r\nConnection: %@\r\n",
+                             @(statusCode),
+                             [NSHTTPURLResponse localizedStringForStatusCode:statusCode],
+                             @(body.length),
+                             keepAlive ? @"keep-alive" : @"close"];
+    [headers enumerateKeysAndObjectsUsingBlock:^(NSString * _Nonnull name, NSString * _Nonnull value, BOOL * _Nonnull stop) {
+        [head appendFormat:@"%@: %@\r\n", name, value];
+    }];
+    [head appendString:@"\r\n"];
+    
+    NSMutableData *response = [[head dataUsingEncoding:NSISOLatin1StringEncoding] mutableCopy];
+    if (body) {
+        [response appendData:body];
+    }
+    
+    dispatch_data_t data = dispatch_data_create(response.bytes, response.length, connection.queue, DISPATCH_DATA_DESTRUCTOR_DEFAULT);
+    dispatch_io_write(connection.channel, 0, data, connection.queue, ^(bool done, dispatch_data_t _Nullable remainingData, int error) {
+        if (done && (error != 0 || ! keepAlive)) {
+            [self closeConnection:connection];
+        }
+    });
+}
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; URL = %@; eventCount = %@; requestCount = %@>",
+            self.class,
+            self,
+            self.URL,
+            @(self.eventCount),
+            @(self.requestCount)];
+}
+
+@end
+
+@implementation LoopbackCollectedEvent
+
+#pragma mark Object lifecycle
+
+- (instancetype)initWithService:(NSString *)service labels:(NSDictionary<NSString *, NSString *> *)labels receptionTime:(uint64_t)receptionTime
+{
+    if (self = [super init]) {
+        _service = service.copy;
+        _labels = labels;
+        _receptionTime = receptionTime;
+    }
+    return self;
+}
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-implementations"
+
+- (instancetype)init
+{
+    [self doesNotRecognizeSelector:_cmd];
+    return [self initWithService:@"" labels:@{} receptionTime:0];
+}
+
+#pragma clang diagnostic pop
+
+#pragma mark Description
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; service = %@; labels = %@>",
+            self.class,
+            self,
+            self.service,
+            self.labels];
+}
+
+@end
+
+@implementation LoopbackConnection
+
+@end
@@ -0,0 +1 @@
+../../../Sources/SRGAnalytics/SRGAnalyticsClock.h
\ No newline at end of file
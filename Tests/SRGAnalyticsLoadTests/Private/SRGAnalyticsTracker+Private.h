@@ -0,0 +1 @@
+../../../Sources/SRGAnalytics/SRGAnalyticsTracker+Private.h
\ No newline at end of file
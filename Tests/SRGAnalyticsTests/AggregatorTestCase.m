@@ -0,0 +1,65 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsAggregator.h"
+
+@import XCTest;
+
+@interface AggregatorTestCase : XCTestCase
+
+@end
+
+@implementation AggregatorTestCase
+
+#pragma mark Tests
+
+- (void)testAggregation
+{
+    SRGAnalyticsAggregator *aggregator = [[SRGAnalyticsAggregator alloc] init];
+    [aggregator addOccurrenceWithName:@"impression" dimensions:@{ @"row" : @"1" }];
+    [aggregator addOccurrenceWithName:@"impression" dimensions:@{ @"row" : @"1" }];
+    [aggregator addOccurrenceWithName:@"impression" dimensions:@{ @"row" : @"2" }];
+    [aggregator addOccurrenceWithName:@"swipe" dimensions:nil value:3.];
+    [aggregator addOccurrenceWithName:@"swipe" dimensions:@{} value:-1.5];
+    [aggregator addOccurrenceWithName:@"swipe" dimensions:nil];
+    
+    NSArray<SRGAnalyticsAggregate *> *aggregates = [[aggregator takeAggregates] sortedArrayUsingDescriptors:@[ [NSSortDescriptor sortDescriptorWithKey:@"name" ascending:YES],
+                                                                                                                [NSSortDescriptor sortDescriptorWithKey:@"count" ascending:NO] ]];
+    XCTAssertEqual(aggregates.count, 3);
+    
+    XCTAssertEqualObjects(aggregates[0].name, @"impression");
+    XCTAssertEqualObjects(aggregates[0].dimensions, @{ @"row" : @"1" });
+    XCTAssertEqualObjects(aggregates[0].labelsDictionary, (@{ @"row" : @"1", @"event_count" : @"2" }));
+    
+    XCTAssertEqualObjects(aggregates[1].dimensions, @{ @"row" : @"2" });
+    XCTAssertEqual(aggregates[1].count, 1);
+    
+    XCTAssertEqualObjects(aggregates[2].name, @"swipe");
+    XCTAssertEqualObjects(aggregates[2].labelsDictionary, (@{ @"event_count" : @"3",
+                                                              @"event_value_count" : @"2",
+                                                              @"event_value_sum" : @"1.5",
+                                                              @"event_value_min" : @"-1.5",
+                                                              @"event_value_max" : @"3" }));
+    
+    XCTAssertEqual([aggregator takeAggregates].count, 0);
+}
+
+- (void)testConcurrentAggregation
+{
+    SRGAnalyticsAggregator *aggregator = [[SRGAnalyticsAggregator alloc] init];
+    dispatch_apply(10000, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t iteration) {
+        [aggregator addOccurrenceWithName:@"tap" dimensions:@{ @"parity" : (iteration % 2 == 0) ? @"even" : @"odd" } value:iteration];
+    });
+    
+    NSArray<SRGAnalyticsAggregate *> *aggregates = [aggregator takeAggregates];
+    XCTAssertEqual(aggregates.count, 2);
+    XCTAssertEqual(aggregates[0].count + aggregates[1].count, 10000);
+    XCTAssertEqual(aggregates[0].sum + aggregates[1].sum, 10000. * 9999. / 2.);
+    XCTAssertEqual(fmin(aggregates[0].minimum, aggregates[1].minimum), 0.);
+    XCTAssertEqual(fmax(aggregates[0].maximum, aggregates[1].maximum), 9999.);
+}
+
+@end
@@ -0,0 +1,139 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsApplicationListCache.h"
+
+@import XCTest;
+
+@interface ApplicationListCacheTestCase : XCTestCase
+
+@property (nonatomic) NSURL *directoryURL;
+@property (nonatomic) NSURL *listURL;
+
+@end
+
+@implementation ApplicationListCacheTestCase
+
+#pragma mark Setup and teardown
+
+- (void)setUp
+{
+    NSURL *temporaryDirectoryURL = [NSURL fileURLWithPath:NSTemporaryDirectory() isDirectory:YES];
+    self.directoryURL = [temporaryDirectoryURL URLByAppendingPathComponent:NSUUID.UUID.UUIDString isDirectory:YES];
+    self.listURL = [temporaryDirectoryURL URLByAppendingPathComponent:[NSString stringWithFormat:@"%@.json", NSUUID.UUID.UUIDString]];
+    
+    NSData *data = [@"[{\"code\":\"playrts\",\"ios\":\"playrts\"}]" dataUsingEncoding:NSUTF8StringEncoding];
+    [data writeToURL:self.listURL atomically:YES];
+}
+
+- (void)tearDown
+{
+    [NSFileManager.defaultManager removeItemAtURL:self.directoryURL error:NULL];
+    [NSFileManager.defaultManager removeItemAtURL:self.listURL error:NULL];
+}
+
+#pragma mark Tests
+
+- (void)testFingerprint
+{
+    XCTAssertEqualObjects(SRGAnalyticsInstalledApplicationsFingerprint(@[ @"playrts", @"playsrf" ]), SRGAnalyticsInstalledApplicationsFingerprint(@[ @"playsrf", @"playrts" ]));
+    XCTAssertNotEqualObjects(SRGAnalyticsInstalledApplicationsFingerprint(@[ @"playrts" ]), SRGAnalyticsInstalledApplicationsFingerprint(@[ @"playrts", @"playsrf" ]));
+    XCTAssertNotEqualObjects(SRGAnalyticsInstalledApplicationsFingerprint(@[]), SRGAnalyticsInstalledApplicationsFingerprint(@[ @"playrts" ]));
+}
+
+- (void)testReporting
+{
+    SRGAnalyticsApplicationListCache *cache = [[SRGAnalyticsApplicationListCache alloc] initWithURL:self.listURL directoryURL:self.directoryURL timeToLive:60.];
+    
+    NSDate *date = NSDate.date;
+    XCTAssertTrue([cache shouldReportFingerprint:@"a" atDate:date minimumInterval:100.]);
+    
+    [cache setReportedFingerprint:@"a" date:date];
+    XCTAssertFalse([cache shouldReportFingerprint:@"a" atDate:[date dateByAddingTimeInterval:99.] minimumInterval:100.]);
+    XCTAssertTrue([cache shouldReportFingerprint:@"a" atDate:[date dateByAddingTimeInterval:100.] minimumInterval:100.]);
+    XCTAssertTrue([cache shouldReportFingerprint:@"b" atDate:[date dateByAddingTimeInterval:1.] minimumInterval:100.]);
+    
+    // Reports are persisted
+    SRGAnalyticsApplicationListCache *otherCache = [[SRGAnalyticsApplicationListCache alloc] initWithURL:self.listURL directoryURL:self.directoryURL timeToLive:60.];
+    XCTAssertFalse([otherCache shouldReportFingerprint:@"a" atDate:[date dateByAddingTimeInterval:1.] minimumInterval:100.]);
+}
+
+- (void)testRetrieval
+{
+    SRGAnalyticsApplicationListCache *cache = [[SRGAnalyticsApplicationListCache alloc] initWithURL:self.listURL directoryURL:self.directoryURL timeToLive:60.];
+    XCTAssertNil(cache.cachedData);
+    XCTAssertTrue([cache needsRevalidationAtDate:NSDate.date]);
+    
+    XCTestExpectation *retrievalExpectation = [self expectationWithDescription:@"List retrieved"];
+    [cache retrieveListWithSession:NSURLSession.sharedSession completionHandler:^(NSData * _Nullable data, NSError * _Nullable error) {
+        XCTAssertTrue(NSThread.isMainThread);
+        XCTAssertNotNil(data);
+        XCTAssertNil(error);
+        [retrievalExpectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10. handler:nil];
+    
+    XCTAssertNotNil(cache.cachedData);
+    XCTAssertFalse([cache needsRevalidationAtDate:NSDate.date]);
+    XCTAssertTrue([cache needsRevalidationAtDate:[NSDate dateWithTimeIntervalSinceNow:60.]]);
+    
+    // Fresh lists are read from the cache, also after the cache has been reopened
+    [NSFileManager.defaultManager removeItemAtURL:self.listURL error:NULL];
+    
+    SRGAnalyticsApplicationListCache *otherCache = [[SRGAnalyticsApplicationListCache alloc] initWithURL:self.listURL directoryURL:self.directoryURL timeToLive:60.];
+    XCTAssertFalse([otherCache needsRevalidationAtDate:NSDate.date]);
+    
+    XCTestExpectation *cachedRetrievalExpectation = [self expectationWithDescription:@"List retrieved from the cache"];
+    [otherCache retrieveListWithSession:NSURLSession.sharedSession completionHandler:^(NSData * _Nullable data, NSError * _Nullable error) {
+        XCTAssertEqualObjects(data, cache.cachedData);
+        [cachedRetrievalExpectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10. handler:nil];
+}
+
+- (void)testStaleListFallback
+{
+    SRGAnalyticsApplicationListCache *cache = [[SRGAnalyticsApplicationListCache alloc] initWithURL:self.listURL directoryURL:self.directoryURL timeToLive:0.];
+    
+    XCTestExpectation *retrievalExpectation = [self expectationWithDescription:@"List retrieved"];
+    [cache retrieveListWithSession:NSURLSession.sharedSession completionHandler:^(NSData * _Nullable data, NSError * _Nullable error) {
+        [retrievalExpectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10. handler:nil];
+    
+    // The list cannot be revalidated anymore. The stale copy is used
+    [NSFileManager.defaultManager removeItemAtURL:self.listURL error:NULL];
+    XCTAssertTrue([cache needsRevalidationAtDate:NSDate.date]);
+    
+    XCTestExpectation *staleRetrievalExpectation = [self expectationWithDescription:@"Stale list retrieved"];
+    [cache retrieveListWithSession:NSURLSession.sharedSession completionHandler:^(NSData * _Nullable data, NSError * _Nullable error) {
+        XCTAssertNotNil(data);
+        XCTAssertEqualObjects(data, cache.cachedData);
+        [staleRetrievalExpectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10. handler:nil];
+}
+
+- (void)testURLChange
+{
+    SRGAnalyticsApplicationListCache *cache = [[SRGAnalyticsApplicationListCache alloc] initWithURL:self.listURL directoryURL:self.directoryURL timeToLive:60.];
+    
+    XCTestExpectation *retrievalExpectation = [self expectationWithDescription:@"List retrieved"];
+    [cache retrieveListWithSession:NSURLSession.sharedSession completionHandler:^(NSData * _Nullable data, NSError * _Nullable error) {
+        [retrievalExpectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10. handler:nil];
+    [cache setReportedFingerprint:@"a" date:NSDate.date];
+    
+    // Cached lists are bound to their URL, reported fingerprints are not
+    NSURL *otherListURL = [self.listURL URLByAppendingPathExtension:@"other"];
+    SRGAnalyticsApplicationListCache *otherCache = [[SRGAnalyticsApplicationListCache alloc] initWithURL:otherListURL directoryURL:self.directoryURL timeToLive:60.];
+    XCTAssertNil(otherCache.cachedData);
+    XCTAssertTrue([otherCache needsRevalidationAtDate:NSDate.date]);
+    XCTAssertFalse([otherCache shouldReportFingerprint:@"a" atDate:NSDate.date minimumInterval:100.]);
+}
+
+@end
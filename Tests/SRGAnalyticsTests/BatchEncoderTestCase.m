@@ -0,0 +1,111 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsBatchEncoder.h"
+#import "SRGAnalyticsEncoder.h"
+
+@import XCTest;
+
+static NSDictionary<NSString *, NSString *> *HeartbeatLabels(NSInteger index)
+{
+    return @{ @"event_id" : @"pos",
+              @"event_name" : @"media_position",
+              @"media_position" : @(index * 30).stringValue,
+              @"media_urn" : @"urn:rts:video:12345678",
+              @"media_title" : @"Le 19h30",
+              @"media_player_display" : @"default",
+              @"media_player_version" : @"3.0.0",
+              @"media_volume" : @"80",
+              @"media_bandwidth" : @"5000000",
+              @"media_subtitles_on" : @"false",
+              @"media_timeshift" : @"0" };
+}
+
+@interface BatchEncoderTestCase : XCTestCase
+
+@end
+
+@implementation BatchEncoderTestCase
+
+#pragma mark Tests
+
+- (void)testRoundTrip
+{
+    SRGAnalyticsBatchEncoder *encoder = [[SRGAnalyticsBatchEncoder alloc] initWithSharedLabels:@{ @"app" : @"test", @"shared" : @"value" }];
+    [encoder addEventWithLabels:@{ @"event_name" : @"first", @"key" : @"été & hiver" }];
+    [encoder addEventWithLabels:@{ @"event_name" : @"second", @"shared" : @"override", @"empty" : @"" }];
+    
+    SRGAnalyticsLabelContext *parentContext = [[SRGAnalyticsLabelContext alloc] initWithParentContext:nil labels:@{ @"event_name" : @"parent", @"parent" : @"1" }];
+    SRGAnalyticsLabelContext *context = [[SRGAnalyticsLabelContext alloc] initWithParentContext:parentContext labels:@{ @"event_name" : @"third" }];
+    [encoder addEventWithLabelContext:context];
+    XCTAssertEqual(encoder.eventCount, 3);
+    
+    NSData *batch = [encoder finishBatch];
+    XCTAssertNotNil(batch);
+    XCTAssertEqual(encoder.eventCount, 0);
+    
+    // Event labels override shared labels
+    NSArray<NSDictionary<NSString *, NSString *> *> *events = SRGAnalyticsDecodeBatch(batch);
+    XCTAssertEqualObjects(events, (@[ @{ @"app" : @"test", @"shared" : @"value", @"event_name" : @"first", @"key" : @"été & hiver" },
+                                      @{ @"app" : @"test", @"shared" : @"override", @"event_name" : @"second", @"empty" : @"" },
+                                      @{ @"app" : @"test", @"shared" : @"value", @"event_name" : @"third", @"parent" : @"1" } ]));
+}
+
+- (void)testSuccessiveBatches
+{
+    SRGAnalyticsBatchEncoder *encoder = [[SRGAnalyticsBatchEncoder alloc] initWithSharedLabels:@{ @"app" : @"test" }];
+    XCTAssertNil([encoder finishBatch]);
+    
+    [encoder addEventWithLabels:@{ @"event_name" : @"first" }];
+    NSData *batch1 = [encoder finishBatch];
+    XCTAssertNil([encoder finishBatch]);
+    
+    // Each batch has its own string table
+    [encoder addEventWithLabels:@{ @"event_name" : @"second" }];
+    NSData *batch2 = [encoder finishBatch];
+    
+    XCTAssertEqualObjects(SRGAnalyticsDecodeBatch(batch1), (@[ @{ @"app" : @"test", @"event_name" : @"first" } ]));
+    XCTAssertEqualObjects(SRGAnalyticsDecodeBatch(batch2), (@[ @{ @"app" : @"test", @"event_name" : @"second" } ]));
+}
+
+- (void)testHeartbeatCompression
+{
+    NSDictionary<NSString *, NSString *> *sharedLabels = @{ @"app_library_version" : @"8.0.0",
+                                                            @"navigation_app_site_name" : @"rts-app-test-v",
+                                                            @"navigation_environment" : @"preprod",
+                                                            @"navigation_device" : @"phone" };
+    SRGAnalyticsBatchEncoder *encoder = [[SRGAnalyticsBatchEncoder alloc] initWithSharedLabels:sharedLabels];
+    SRGAnalyticsByteBuffer *buffer = [[SRGAnalyticsByteBuffer alloc] initWithCapacity:1024];
+    
+    size_t encodedLength = 0;
+    for (NSInteger i = 0; i < 100; ++i) {
+        NSDictionary<NSString *, NSString *> *labels = HeartbeatLabels(i);
+        [encoder addEventWithLabels:labels];
+        
+        // Size of the same event, URL-encoded with permanent labels
+        [buffer reset];
+        SRGAnalyticsEncodeLabels(sharedLabels, SRGAnalyticsEncodingFormatURL, buffer);
+        SRGAnalyticsEncodeLabels(labels, SRGAnalyticsEncodingFormatURL, buffer);
+        encodedLength += buffer.length + 1;
+    }
+    
+    NSData *batch = [encoder finishBatch];
+    XCTAssertLessThan(batch.length * 10, encodedLength);
+    XCTAssertEqual(SRGAnalyticsDecodeBatch(batch).count, 100);
+}
+
+- (void)testInvalidBatches
+{
+    XCTAssertNil(SRGAnalyticsDecodeBatch([NSData data]));
+    XCTAssertNil(SRGAnalyticsDecodeBatch([@"key=value" dataUsingEncoding:NSUTF8StringEncoding]));
+    
+    SRGAnalyticsBatchEncoder *encoder = [[SRGAnalyticsBatchEncoder alloc] initWithSharedLabels:@{}];
+    [encoder addEventWithLabels:@{ @"event_name" : @"event" }];
+    NSData *batch = [encoder finishBatch];
+    XCTAssertNil(SRGAnalyticsDecodeBatch([batch subdataWithRange:NSMakeRange(0, batch.length - 1)]));
+}
+
+@end
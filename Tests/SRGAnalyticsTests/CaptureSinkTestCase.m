@@ -0,0 +1,153 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsCaptureSink+Private.h"
+#import "XCTestCase+Tests.h"
+
+static uint64_t CaptureString(SRGAnalyticsCaptureSink *captureSink, NSString *string)
+{
+    const char *bytes = string.UTF8String;
+    return [captureSink captureEventWithService:SRGAnalyticsCaptureServiceTagCommander encodedLabels:(const uint8_t *)bytes length:strlen(bytes)];
+}
+
+@interface CaptureSinkTestCase : XCTestCase
+
+@end
+
+@implementation CaptureSinkTestCase
+
+#pragma mark Setup and teardown
+
+- (void)setUp
+{
+    SRGAnalyticsRenewUnitTestingIdentifier();
+}
+
+#pragma mark Tests
+
+- (void)testCapture
+{
+    SRGAnalyticsCaptureSink *captureSink = [[SRGAnalyticsCaptureSink alloc] initWithCapacity:4096];
+    XCTAssertEqual(captureSink.lastSequence, 0);
+    XCTAssertEqual([captureSink eventsAfterSequence:0 matchingFilter:nil].count, 0);
+    
+    XCTAssertEqual(CaptureString(captureSink, @"event_id=screen&event_name=first"), 1);
+    XCTAssertEqual(CaptureString(captureSink, @"event_id=click&event_name=second"), 2);
+    XCTAssertEqual(captureSink.lastSequence, 2);
+    
+    NSArray<SRGAnalyticsCapturedEvent *> *events = [captureSink eventsAfterSequence:0 matchingFilter:nil];
+    XCTAssertEqual(events.count, 2);
+    XCTAssertEqual(events[0].sequence, 1);
+    XCTAssertEqual(events[0].service, SRGAnalyticsCaptureServiceTagCommander);
+    XCTAssertEqualObjects(events[0].encodedLabels, @"event_id=screen&event_name=first");
+    XCTAssertEqual(events[1].sequence, 2);
+    XCTAssertEqualObjects(events[1].encodedLabels, @"event_id=click&event_name=second");
+    
+    NSArray<SRGAnalyticsCapturedEvent *> *lastEvents = [captureSink eventsAfterSequence:1 matchingFilter:nil];
+    XCTAssertEqual(lastEvents.count, 1);
+    XCTAssertEqual(lastEvents.firstObject.sequence, 2);
+}
+
+- (void)testOverwrite
+{
+    SRGAnalyticsCaptureSink *captureSink = [[SRGAnalyticsCaptureSink alloc] initWithCapacity:1024];
+    for (NSInteger i = 0; i < 100; ++i) {
+        CaptureString(captureSink, [NSString stringWithFormat:@"event_id=click&event_name=event-%@", @(i)]);
+    }
+    XCTAssertEqual(captureSink.lastSequence, 100);
+    
+    // Only the most recent events remain available, in order and without gaps
+    NSArray<SRGAnalyticsCapturedEvent *> *events = [captureSink eventsAfterSequence:0 matchingFilter:nil];
+    XCTAssertGreaterThan(events.count, 0);
+    XCTAssertLessThan(events.count, 100);
+    XCTAssertEqual(events.lastObject.sequence, 100);
+    [events enumerateObjectsUsingBlock:^(SRGAnalyticsCapturedEvent * _Nonnull event, NSUInteger idx, BOOL * _Nonnull stop) {
+        XCTAssertEqual(event.sequence, 100 - events.count + idx + 1);
+        NSString *name = [NSString stringWithFormat:@"event-%@", @(event.sequence - 1)];
+        XCTAssertEqualObjects(event.labels[@"event_name"], name);
+    }];
+}
+
+- (void)testOversizedEvent
+{
+    SRGAnalyticsCaptureSink *captureSink = [[SRGAnalyticsCaptureSink alloc] initWithCapacity:1024];
+    NSString *value = [@"" stringByPaddingToLength:1024 withString:@"a" startingAtIndex:0];
+    XCTAssertEqual(CaptureString(captureSink, [NSString stringWithFormat:@"event_name=%@", value]), 0);
+    XCTAssertEqual(captureSink.lastSequence, 0);
+}
+
+- (void)testFilter
+{
+    SRGAnalyticsCaptureSink *captureSink = [[SRGAnalyticsCaptureSink alloc] initWithCapacity:4096];
+    CaptureString(captureSink, @"event_id=screen");
+    CaptureString(captureSink, @"event_id=click");
+    CaptureString(captureSink, @"event_id=screen");
+    
+    NSArray<SRGAnalyticsCapturedEvent *> *events = [captureSink eventsAfterSequence:0 matchingFilter:^BOOL(SRGAnalyticsCapturedEvent * _Nonnull event) {
+        return [event.labels[@"event_id"] isEqualToString:@"screen"];
+    }];
+    XCTAssertEqual(events.count, 2);
+    XCTAssertEqual(events[0].sequence, 1);
+    XCTAssertEqual(events[1].sequence, 3);
+}
+
+- (void)testLabelDecoding
+{
+    NSDictionary<NSString *, NSString *> *labels = [SRGAnalyticsCapturedEvent labelsFromEncodedLabels:@"a=1&b=%C3%A9t%C3%A9%20%26%20hiver&c=&a=2"];
+    NSDictionary<NSString *, NSString *> *expectedLabels = @{ @"a" : @"2",
+                                                             @"b" : @"été & hiver",
+                                                             @"c" : @"" };
+    XCTAssertEqualObjects(labels, expectedLabels);
+}
+
+- (void)testWait
+{
+    SRGAnalyticsCaptureSink *captureSink = [[SRGAnalyticsCaptureSink alloc] initWithCapacity:4096];
+    CaptureString(captureSink, @"event_id=screen");
+    
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.5 * NSEC_PER_SEC)), dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ^{
+        CaptureString(captureSink, @"event_id=click");
+        CaptureString(captureSink, @"event_id=screen");
+    });
+    
+    SRGAnalyticsCapturedEvent *event = [captureSink waitForEventAfterSequence:1 matchingFilter:^BOOL(SRGAnalyticsCapturedEvent * _Nonnull event) {
+        return [event.labels[@"event_id"] isEqualToString:@"screen"];
+    } timeout:10.];
+    XCTAssertEqual(event.sequence, 3);
+}
+
+- (void)testWaitTimeout
+{
+    SRGAnalyticsCaptureSink *captureSink = [[SRGAnalyticsCaptureSink alloc] initWithCapacity:4096];
+    CaptureString(captureSink, @"event_id=screen");
+    
+    NSDate *startDate = NSDate.date;
+    XCTAssertNil([captureSink waitForEventAfterSequence:1 matchingFilter:nil timeout:0.5]);
+    XCTAssertGreaterThanOrEqual([NSDate.date timeIntervalSinceDate:startDate], 0.4);
+}
+
+- (void)testTrackerCapture
+{
+    SRGAnalyticsCaptureSink *captureSink = SRGAnalyticsTracker.sharedTracker.captureSink;
+    XCTAssertNotNil(captureSink);
+    
+    uint64_t sequence = captureSink.lastSequence;
+    NSString *unitTestingIdentifier = SRGAnalyticsUnitTestingIdentifier();
+    
+    [SRGAnalyticsTracker.sharedTracker trackHiddenEventWithName:@"Captured event"];
+    
+    SRGAnalyticsCapturedEvent *event = [captureSink waitForEventAfterSequence:sequence matchingFilter:^BOOL(SRGAnalyticsCapturedEvent * _Nonnull event) {
+        return [event.labels[@"srg_test_id"] isEqualToString:unitTestingIdentifier];
+    } timeout:20.];
+    XCTAssertNotNil(event);
+    XCTAssertEqual(event.service, SRGAnalyticsCaptureServiceTagCommander);
+    XCTAssertEqualObjects(event.labels[@"event_id"], @"click");
+    XCTAssertEqualObjects(event.labels[@"event_name"], @"Captured event");
+    XCTAssertEqualObjects(event.labels[@"navigation_app_site_name"], @"rts-app-test-v");
+    XCTAssertEqualObjects(event.labels[@"navigation_environment"], @"preprod");
+}
+
+@end
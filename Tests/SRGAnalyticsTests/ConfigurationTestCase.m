@@ -104,6 +104,14 @@
                                                                                                         siteName:@"site-name"];
     configuration.centralized = YES;
     configuration.unitTesting = YES;
+    configuration.hiddenEventSamplingRatio = 0.5;
+    [configuration setSamplingRatio:0.1 forHiddenEventsWithName:@"event"];
+    configuration.maximumHiddenEventRate = 2.;
+    configuration.collectorURL = [NSURL URLWithString:@"http://127.0.0.1:8080"];
+    configuration.collectorBatchInterval = 5.;
+    configuration.startDeferred = YES;
+    configuration.pendingEventMemoryBudget = 1024;
+    configuration.pendingEventDropPolicy = SRGAnalyticsPendingEventDropPolicyDropLowestPriority;
     
     SRGAnalyticsConfiguration *configurationCopy = configuration.copy;
     XCTAssertEqual(configuration.centralized, configurationCopy.centralized);
@@ -114,6 +122,35 @@
     XCTAssertEqualObjects(configuration.siteName, configurationCopy.siteName);
     XCTAssertEqual(configuration.environmentMode, configurationCopy.environmentMode);
     XCTAssertEqualObjects(configuration.environment, configurationCopy.environment);
+    XCTAssertEqual(configuration.hiddenEventSamplingRatio, configurationCopy.hiddenEventSamplingRatio);
+    XCTAssertEqual([configuration samplingRatioForHiddenEventsWithName:@"event"], [configurationCopy samplingRatioForHiddenEventsWithName:@"event"]);
+    XCTAssertEqual(configuration.maximumHiddenEventRate, configurationCopy.maximumHiddenEventRate);
+    XCTAssertEqualObjects(configuration.collectorURL, configurationCopy.collectorURL);
+    XCTAssertEqual(configuration.collectorBatchInterval, configurationCopy.collectorBatchInterval);
+    XCTAssertEqual(configuration.startDeferred, configurationCopy.startDeferred);
+    XCTAssertEqual(configuration.pendingEventMemoryBudget, configurationCopy.pendingEventMemoryBudget);
+    XCTAssertEqual(configuration.pendingEventDropPolicy, configurationCopy.pendingEventDropPolicy);
+    
+    // Sampling ratios set on the copy do not affect the original configuration
+    [configurationCopy setSamplingRatio:0.2 forHiddenEventsWithName:@"event"];
+    XCTAssertEqual([configuration samplingRatioForHiddenEventsWithName:@"event"], 0.1);
+}
+
+- (void)testSamplingRatios
+{
+    SRGAnalyticsConfiguration *configuration = [[SRGAnalyticsConfiguration alloc] initWithBusinessUnitIdentifier:SRGAnalyticsBusinessUnitIdentifierSRF
+                                                                                                       container:7
+                                                                                                        siteName:@"site-name"];
+    XCTAssertEqual(configuration.pageViewSamplingRatio, 1.);
+    XCTAssertEqual(configuration.hiddenEventSamplingRatio, 1.);
+    XCTAssertEqual(configuration.maximumHiddenEventRate, 0.);
+    
+    configuration.hiddenEventSamplingRatio = 2.;
+    XCTAssertEqual(configuration.hiddenEventSamplingRatio, 1.);
+    
+    [configuration setSamplingRatio:-1. forHiddenEventsWithName:@"event"];
+    XCTAssertEqual([configuration samplingRatioForHiddenEventsWithName:@"event"], 0.);
+    XCTAssertEqual([configuration samplingRatioForHiddenEventsWithName:@"other"], 1.);
 }
 
 @end
@@ -0,0 +1,106 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsEncoder.h"
+#import "SRGAnalyticsEventRecord+Catalog.h"
+
+@import XCTest;
+
+static NSString *EncodedString(NSDictionary<NSString *, NSString *> *labels, SRGAnalyticsEncodingFormat format)
+{
+    SRGAnalyticsByteBuffer *buffer = [[SRGAnalyticsByteBuffer alloc] initWithCapacity:16];
+    SRGAnalyticsEncodeLabels(labels, format, buffer);
+    return [[NSString alloc] initWithBytes:buffer.bytes length:buffer.length encoding:NSUTF8StringEncoding];
+}
+
+@interface EncoderTestCase : XCTestCase
+
+@end
+
+@implementation EncoderTestCase
+
+#pragma mark Tests
+
+- (void)testJSONEncoding
+{
+    XCTAssertEqualObjects(EncodedString(@{}, SRGAnalyticsEncodingFormatJSON), @"{}");
+    XCTAssertEqualObjects(EncodedString(@{ @"b" : @"2", @"a" : @"1" }, SRGAnalyticsEncodingFormatJSON), @"{\"a\":\"1\",\"b\":\"2\"}");
+    XCTAssertEqualObjects(EncodedString(@{ @"key" : @"\"quoted\" \\ back\nline" }, SRGAnalyticsEncodingFormatJSON), @"{\"key\":\"\\\"quoted\\\" \\\\ back\\u000Aline\"}");
+}
+
+- (void)testJSONRoundTrip
+{
+    NSDictionary<NSString *, NSString *> *labels = @{ @"event_id" : @"screen",
+                                                      @"content_title" : @"Vue aérienne de la zone \"potentielle\" 😀",
+                                                      @"control" : @"\t\r\n\x01",
+                                                      @"long" : [@"" stringByPaddingToLength:2000 withString:@"abcdé" startingAtIndex:0] };
+    
+    SRGAnalyticsByteBuffer *buffer = [[SRGAnalyticsByteBuffer alloc] initWithCapacity:16];
+    SRGAnalyticsEncodeLabels(labels, SRGAnalyticsEncodingFormatJSON, buffer);
+    
+    NSData *data = [NSData dataWithBytes:buffer.bytes length:buffer.length];
+    id JSONObject = [NSJSONSerialization JSONObjectWithData:data options:0 error:NULL];
+    XCTAssertEqualObjects(JSONObject, labels);
+}
+
+- (void)testURLEncoding
+{
+    XCTAssertEqualObjects(EncodedString(@{}, SRGAnalyticsEncodingFormatURL), @"");
+    XCTAssertEqualObjects(EncodedString(@{ @"b" : @"2", @"a" : @"1" }, SRGAnalyticsEncodingFormatURL), @"a=1&b=2");
+    XCTAssertEqualObjects(EncodedString(@{ @"key" : @"a b&c=d/é~" }, SRGAnalyticsEncodingFormatURL), @"key=a%20b%26c%3Dd%2F%C3%A9~");
+}
+
+- (void)testStableOrder
+{
+    NSMutableDictionary<NSString *, NSString *> *labels1 = [NSMutableDictionary dictionary];
+    NSMutableDictionary<NSString *, NSString *> *labels2 = [NSMutableDictionary dictionary];
+    for (NSInteger i = 0; i < 100; ++i) {
+        labels1[[NSString stringWithFormat:@"key_%@", @(i)]] = @(i).stringValue;
+        labels2[[NSString stringWithFormat:@"key_%@", @(99 - i)]] = @(99 - i).stringValue;
+    }
+    
+    XCTAssertEqualObjects(EncodedString(labels1, SRGAnalyticsEncodingFormatJSON), EncodedString(labels2, SRGAnalyticsEncodingFormatJSON));
+    XCTAssertEqualObjects(EncodedString(labels1, SRGAnalyticsEncodingFormatURL), EncodedString(labels2, SRGAnalyticsEncodingFormatURL));
+}
+
+- (void)testLabelContextEncoding
+{
+    SRGAnalyticsLabelContext *globalContext = [[SRGAnalyticsLabelContext alloc] initWithParentContext:nil labels:@{ @"global_key" : @"global_value" }];
+    
+    SRGAnalyticsEventRecord *record = [[SRGAnalyticsEventRecord alloc] init];
+    [record setEventId:@"play"];
+    [record setMediaPosition:42];
+    SRGAnalyticsLabelContext *context = [[SRGAnalyticsLabelContext alloc] initWithParentContext:globalContext record:record];
+    
+    SRGAnalyticsByteBuffer *buffer = [[SRGAnalyticsByteBuffer alloc] initWithCapacity:16];
+    SRGAnalyticsEncodeLabelContext(context, SRGAnalyticsEncodingFormatURL, buffer);
+    NSString *string = [[NSString alloc] initWithBytes:buffer.bytes length:buffer.length encoding:NSUTF8StringEncoding];
+    XCTAssertEqualObjects(string, @"event_id=play&global_key=global_value&media_position=42");
+}
+
+- (void)testBufferPool
+{
+    SRGAnalyticsByteBufferPool *pool = [[SRGAnalyticsByteBufferPool alloc] initWithMaximumBufferCount:1 bufferCapacity:16];
+    
+    SRGAnalyticsByteBuffer *buffer = [pool dequeueBuffer];
+    [buffer appendBytes:"0123456789012345678901234567890123456789" length:40];
+    XCTAssertEqual(buffer.length, 40);
+    XCTAssertGreaterThanOrEqual(buffer.capacity, 40);
+    [pool recycleBuffer:buffer];
+    XCTAssertEqual(pool.availableBufferCount, 1);
+    
+    SRGAnalyticsByteBuffer *reusedBuffer = [pool dequeueBuffer];
+    XCTAssertEqual(reusedBuffer, buffer);
+    XCTAssertEqual(reusedBuffer.length, 0);
+    XCTAssertEqual(pool.availableBufferCount, 0);
+    
+    // Buffers exceeding the pool capacity are discarded
+    [pool recycleBuffer:reusedBuffer];
+    [pool recycleBuffer:[[SRGAnalyticsByteBuffer alloc] initWithCapacity:16]];
+    XCTAssertEqual(pool.availableBufferCount, 1);
+}
+
+@end
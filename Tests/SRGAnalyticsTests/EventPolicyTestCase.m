@@ -0,0 +1,141 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsEventPolicy.h"
+#import "SRGAnalyticsRateLimiter.h"
+
+@import XCTest;
+
+static const uint64_t kSecond = 1000000000ULL;
+
+@interface EventPolicyTestCase : XCTestCase
+
+@end
+
+@implementation EventPolicyTestCase
+
+#pragma mark Tests
+
+- (void)testRateLimiterBurst
+{
+    SRGAnalyticsRateLimiter *rateLimiter = [[SRGAnalyticsRateLimiter alloc] initWithRate:10. burstSize:5];
+    
+    uint64_t time = 100 * kSecond;
+    for (NSUInteger i = 0; i < 5; ++i) {
+        XCTAssertTrue([rateLimiter acquireAtTime:time]);
+    }
+    XCTAssertFalse([rateLimiter acquireAtTime:time]);
+    
+    // One token is recovered every 100 ms
+    XCTAssertFalse([rateLimiter acquireAtTime:time + kSecond / 20]);
+    XCTAssertTrue([rateLimiter acquireAtTime:time + kSecond / 10]);
+    XCTAssertFalse([rateLimiter acquireAtTime:time + kSecond / 10]);
+    
+    // The bucket is full again after a long pause, but never holds more than the burst size
+    time += 10 * kSecond;
+    for (NSUInteger i = 0; i < 5; ++i) {
+        XCTAssertTrue([rateLimiter acquireAtTime:time]);
+    }
+    XCTAssertFalse([rateLimiter acquireAtTime:time]);
+}
+
+- (void)testRateLimiterSustainedRate
+{
+    SRGAnalyticsRateLimiter *rateLimiter = [[SRGAnalyticsRateLimiter alloc] initWithRate:100. burstSize:1];
+    
+    // Attempts every millisecond during 10 seconds
+    NSUInteger acceptedCount = 0;
+    for (uint64_t time = kSecond; time < 11 * kSecond; time += kSecond / 1000) {
+        if ([rateLimiter acquireAtTime:time]) {
+            acceptedCount++;
+        }
+    }
+    XCTAssertEqual(acceptedCount, 1000);
+}
+
+- (void)testRateLimiterConcurrency
+{
+    SRGAnalyticsRateLimiter *rateLimiter = [[SRGAnalyticsRateLimiter alloc] initWithRate:1. burstSize:100];
+    
+    __block _Atomic(NSUInteger) acceptedCount = 0;
+    uint64_t time = 100 * kSecond;
+    dispatch_apply(1000, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t iteration) {
+        if ([rateLimiter acquireAtTime:time]) {
+            acceptedCount++;
+        }
+    });
+    XCTAssertEqual(acceptedCount, 100);
+}
+
+- (void)testSamplingRatios
+{
+    SRGAnalyticsConfiguration *configuration = [[SRGAnalyticsConfiguration alloc] initWithBusinessUnitIdentifier:SRGAnalyticsBusinessUnitIdentifierRTS
+                                                                                                        container:10
+                                                                                                         siteName:@"rts-app-test-v"];
+    configuration.hiddenEventSamplingRatio = 0.;
+    [configuration setSamplingRatio:1. forHiddenEventsWithName:@"always"];
+    
+    SRGAnalyticsEventPolicy *policy = [[SRGAnalyticsEventPolicy alloc] initWithConfiguration:configuration samplingSeed:42];
+    XCTAssertEqual([policy decisionForPageView], SRGAnalyticsEventDecisionAccept);
+    XCTAssertEqual([policy decisionForHiddenEventWithName:@"always"], SRGAnalyticsEventDecisionAccept);
+    XCTAssertEqual([policy decisionForHiddenEventWithName:@"never"], SRGAnalyticsEventDecisionSampledOut);
+    
+    SRGAnalyticsEventPolicyCounts counts = [policy takeCounts];
+    XCTAssertEqual(counts.sampledOutCount, 1);
+    XCTAssertEqual(counts.rateLimitedCount, 0);
+    
+    counts = [policy takeCounts];
+    XCTAssertEqual(counts.sampledOutCount, 0);
+}
+
+- (void)testSamplingDeterminism
+{
+    SRGAnalyticsConfiguration *configuration = [[SRGAnalyticsConfiguration alloc] initWithBusinessUnitIdentifier:SRGAnalyticsBusinessUnitIdentifierRTS
+                                                                                                        container:10
+                                                                                                         siteName:@"rts-app-test-v"];
+    configuration.hiddenEventSamplingRatio = 0.25;
+    
+    // A given user always gets the same decision for a given name
+    SRGAnalyticsEventPolicy *policy1 = [[SRGAnalyticsEventPolicy alloc] initWithConfiguration:configuration samplingSeed:42];
+    SRGAnalyticsEventPolicy *policy2 = [[SRGAnalyticsEventPolicy alloc] initWithConfiguration:configuration samplingSeed:42];
+    for (NSUInteger i = 0; i < 100; ++i) {
+        NSString *name = [NSString stringWithFormat:@"event-%@", @(i)];
+        XCTAssertEqual([policy1 decisionForHiddenEventWithName:name], [policy2 decisionForHiddenEventWithName:name]);
+        XCTAssertEqual([policy1 decisionForHiddenEventWithName:name], [policy1 decisionForHiddenEventWithName:name]);
+    }
+    
+    // Across users, the ratio of users sampled in matches the configured ratio
+    NSUInteger acceptedCount = 0;
+    for (uint64_t seed = 0; seed < 10000; ++seed) {
+        SRGAnalyticsEventPolicy *policy = [[SRGAnalyticsEventPolicy alloc] initWithConfiguration:configuration samplingSeed:seed];
+        if ([policy decisionForHiddenEventWithName:@"event"] == SRGAnalyticsEventDecisionAccept) {
+            acceptedCount++;
+        }
+    }
+    XCTAssertEqualWithAccuracy(acceptedCount / 10000., 0.25, 0.02);
+}
+
+- (void)testRateLimitedHiddenEvents
+{
+    SRGAnalyticsConfiguration *configuration = [[SRGAnalyticsConfiguration alloc] initWithBusinessUnitIdentifier:SRGAnalyticsBusinessUnitIdentifierRTS
+                                                                                                        container:10
+                                                                                                         siteName:@"rts-app-test-v"];
+    configuration.maximumHiddenEventRate = 0.001;
+    configuration.hiddenEventBurstSize = 3;
+    
+    SRGAnalyticsEventPolicy *policy = [[SRGAnalyticsEventPolicy alloc] initWithConfiguration:configuration samplingSeed:42];
+    for (NSUInteger i = 0; i < 3; ++i) {
+        XCTAssertEqual([policy decisionForHiddenEventWithName:@"event"], SRGAnalyticsEventDecisionAccept);
+    }
+    XCTAssertEqual([policy decisionForHiddenEventWithName:@"event"], SRGAnalyticsEventDecisionRateLimited);
+    XCTAssertEqual([policy decisionForPageView], SRGAnalyticsEventDecisionAccept);
+    
+    SRGAnalyticsEventPolicyCounts counts = [policy takeCounts];
+    XCTAssertEqual(counts.sampledOutCount, 0);
+    XCTAssertEqual(counts.rateLimitedCount, 1);
+}
+
+@end
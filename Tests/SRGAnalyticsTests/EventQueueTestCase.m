@@ -0,0 +1,210 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsEventQueue.h"
+
+@import XCTest;
+
+static SRGAnalyticsEvent *SessionMediaEvent(NSString *eventId, NSUInteger sessionIdentifier)
+{
+    SRGAnalyticsEventRecord *record = [[SRGAnalyticsEventRecord alloc] init];
+    [record setEventId:eventId];
+    return [SRGAnalyticsEvent recordEventWithRecord:record sessionLabels:nil sessionIdentifier:sessionIdentifier unitTestingIdentifier:nil];
+}
+
+static SRGAnalyticsEvent *MediaEvent(NSString *eventId)
+{
+    return SessionMediaEvent(eventId, 0);
+}
+
+@interface EventQueueTestCase : XCTestCase
+
+@end
+
+@implementation EventQueueTestCase
+
+#pragma mark Tests
+
+- (void)testOrdering
+{
+    NSMutableArray<NSString *> *names = [NSMutableArray array];
+    SRGAnalyticsEventQueue *queue = [[SRGAnalyticsEventQueue alloc] initWithName:@"ch.srgssr.analytics.tests" handler:^(NSArray<SRGAnalyticsEvent *> *events) {
+        for (SRGAnalyticsEvent *event in events) {
+            [names addObject:event.name];
+        }
+    }];
+    
+    for (NSInteger i = 0; i < 1000; ++i) {
+        [queue enqueueEvent:[SRGAnalyticsEvent hiddenEventWithName:@(i).stringValue labels:nil]];
+    }
+    
+    XCTAssertTrue([queue drainWithTimeout:10.]);
+    XCTAssertEqual(queue.pendingCount, 0);
+    XCTAssertEqual(names.count, 1000);
+    
+    [names enumerateObjectsUsingBlock:^(NSString * _Nonnull name, NSUInteger idx, BOOL * _Nonnull stop) {
+        XCTAssertEqualObjects(name, @(idx).stringValue);
+    }];
+}
+
+- (void)testMultipleProducers
+{
+    static const NSInteger kProducerCount = 8;
+    static const NSInteger kEventCount = 10000;
+    
+    NSMutableDictionary<NSString *, NSNumber *> *lastIndexes = [NSMutableDictionary dictionary];
+    __block NSInteger count = 0;
+    __block BOOL ordered = YES;
+    SRGAnalyticsEventQueue *queue = [[SRGAnalyticsEventQueue alloc] initWithName:@"ch.srgssr.analytics.tests" handler:^(NSArray<SRGAnalyticsEvent *> *events) {
+        for (SRGAnalyticsEvent *event in events) {
+            // Events from a single producer must be processed in the order they were enqueued
+            NSArray<NSString *> *components = [event.name componentsSeparatedByString:@"-"];
+            NSString *producer = components.firstObject;
+            NSInteger index = components.lastObject.integerValue;
+            NSNumber *lastIndex = lastIndexes[producer];
+            if (lastIndex && lastIndex.integerValue >= index) {
+                ordered = NO;
+            }
+            lastIndexes[producer] = @(index);
+            ++count;
+        }
+    }];
+    
+    dispatch_apply(kProducerCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t producer) {
+        for (NSInteger i = 0; i < kEventCount; ++i) {
+            NSString *name = [NSString stringWithFormat:@"%@-%@", @(producer), @(i)];
+            [queue enqueueEvent:[SRGAnalyticsEvent hiddenEventWithName:name labels:nil]];
+        }
+    });
+    
+    XCTAssertTrue([queue drainWithTimeout:30.]);
+    XCTAssertEqual(count, kProducerCount * kEventCount);
+    XCTAssertTrue(ordered);
+}
+
+- (void)testFlush
+{
+    __block NSInteger count = 0;
+    SRGAnalyticsEventQueue *queue = [[SRGAnalyticsEventQueue alloc] initWithName:@"ch.srgssr.analytics.tests" handler:^(NSArray<SRGAnalyticsEvent *> *events) {
+        count += events.count;
+    }];
+    
+    [queue enqueueEvent:[SRGAnalyticsEvent recordEventWithRecord:[[SRGAnalyticsEventRecord alloc] init] sessionLabels:@{ @"key" : @"value" } sessionIdentifier:0 unitTestingIdentifier:nil]];
+    [queue enqueueEvent:[SRGAnalyticsEvent recordEventWithRecord:[[SRGAnalyticsEventRecord alloc] init] sessionLabels:nil sessionIdentifier:0 unitTestingIdentifier:nil]];
+    
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Flushed"];
+    [queue flushWithCompletionHandler:^{
+        XCTAssertTrue(NSThread.isMainThread);
+        XCTAssertEqual(count, 2);
+        [expectation fulfill];
+    }];
+    
+    [self waitForExpectationsWithTimeout:10. handler:nil];
+}
+
+- (void)testLanes
+{
+    NSMutableArray<NSNumber *> *lanes = [NSMutableArray array];
+    SRGAnalyticsEventQueue *queue = [[SRGAnalyticsEventQueue alloc] initWithName:@"ch.srgssr.analytics.tests" handler:^(NSArray<SRGAnalyticsEvent *> *events) {
+        for (SRGAnalyticsEvent *event in events) {
+            [lanes addObject:@(event.lane)];
+        }
+    }];
+    
+    // Block the worker so that all events are processed in a single batch
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    [queue performBlock:^{
+        dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+    }];
+    
+    [queue enqueueEvent:[SRGAnalyticsEvent measurementEventWithName:@"measurement" labels:nil]];
+    [queue enqueueEvent:MediaEvent(@"pos")];
+    [queue enqueueEvent:[SRGAnalyticsEvent pageViewEventWithTitle:@"title" levels:nil labels:nil fromPushNotification:NO]];
+    [queue enqueueEvent:MediaEvent(@"play")];
+    [queue enqueueEvent:MediaEvent(@"uptime")];
+    [queue enqueueEvent:MediaEvent(@"stop")];
+    [queue enqueueEvent:[SRGAnalyticsEvent hiddenEventWithName:@"hidden" labels:nil]];
+    dispatch_semaphore_signal(semaphore);
+    
+    XCTAssertTrue([queue drainWithTimeout:10.]);
+    XCTAssertEqualObjects(lanes, (@[ @(SRGAnalyticsEventLaneCritical), @(SRGAnalyticsEventLaneCritical),
+                                     @(SRGAnalyticsEventLanePageView), @(SRGAnalyticsEventLanePageView),
+                                     @(SRGAnalyticsEventLaneBackground),
+                                     @(SRGAnalyticsEventLaneHeartbeat), @(SRGAnalyticsEventLaneHeartbeat) ]));
+}
+
+- (void)testSessionOrdering
+{
+    NSMutableArray<NSString *> *eventIds = [NSMutableArray array];
+    SRGAnalyticsEventQueue *queue = [[SRGAnalyticsEventQueue alloc] initWithName:@"ch.srgssr.analytics.tests" handler:^(NSArray<SRGAnalyticsEvent *> *events) {
+        for (SRGAnalyticsEvent *event in events) {
+            [eventIds addObject:[NSString stringWithFormat:@"%@-%@", @(event.sessionIdentifier), [event.record labelForKey:@"event_id"]]];
+        }
+    }];
+    
+    // Block the worker so that all events are processed in a single batch
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    [queue performBlock:^{
+        dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+    }];
+    
+    [queue enqueueEvent:SessionMediaEvent(@"pos", 1)];
+    [queue enqueueEvent:SessionMediaEvent(@"pos", 2)];
+    [queue enqueueEvent:SessionMediaEvent(@"uptime", 1)];
+    [queue enqueueEvent:SessionMediaEvent(@"stop", 1)];
+    [queue enqueueEvent:SessionMediaEvent(@"pos", 1)];
+    [queue enqueueEvent:SessionMediaEvent(@"play", 2)];
+    dispatch_semaphore_signal(semaphore);
+    
+    // Heartbeats enqueued before a critical event of the same session are processed before it. Other heartbeats
+    // are processed afterwards, as usual.
+    XCTAssertTrue([queue drainWithTimeout:10.]);
+    XCTAssertEqualObjects(eventIds, (@[ @"1-pos", @"2-pos", @"1-uptime", @"1-stop", @"2-play", @"1-pos" ]));
+}
+
+- (void)testDeadline
+{
+    __block NSDate *processingDate = nil;
+    SRGAnalyticsEventQueue *queue = [[SRGAnalyticsEventQueue alloc] initWithName:@"ch.srgssr.analytics.tests" handler:^(NSArray<SRGAnalyticsEvent *> *events) {
+        processingDate = NSDate.date;
+    }];
+    
+    // Background events wait for their deadline
+    NSDate *startDate = NSDate.date;
+    [queue enqueueEvent:[SRGAnalyticsEvent measurementEventWithName:@"measurement" labels:nil]];
+    
+    [NSThread sleepForTimeInterval:SRGAnalyticsEventLanePolicyForLane(SRGAnalyticsEventLaneBackground).deadline / 2.];
+    XCTAssertEqual(queue.pendingCount, 1);
+    
+    [NSThread sleepForTimeInterval:SRGAnalyticsEventLanePolicyForLane(SRGAnalyticsEventLaneBackground).deadline];
+    XCTAssertEqual(queue.pendingCount, 0);
+    XCTAssertGreaterThanOrEqual([processingDate timeIntervalSinceDate:startDate], SRGAnalyticsEventLanePolicyForLane(SRGAnalyticsEventLaneBackground).deadline);
+    
+    // Events without deadline are processed immediately, along with pending events of other lanes
+    [queue enqueueEvent:[SRGAnalyticsEvent measurementEventWithName:@"measurement" labels:nil]];
+    [queue enqueueEvent:MediaEvent(@"play")];
+    [NSThread sleepForTimeInterval:0.2];
+    XCTAssertEqual(queue.pendingCount, 0);
+}
+
+- (void)testByteCount
+{
+    // Hidden event label strings are accounted for
+    SRGAnalyticsEvent *event = [SRGAnalyticsEvent hiddenEventWithName:@"name" labels:nil];
+    SRGAnalyticsHiddenEventLabels *labels = [[SRGAnalyticsHiddenEventLabels alloc] init];
+    labels.type = @"type";
+    labels.extraValue5 = @"extra_value_5";
+    SRGAnalyticsEvent *labeledEvent = [SRGAnalyticsEvent hiddenEventWithName:@"name" labels:labels];
+    XCTAssertGreaterThanOrEqual(labeledEvent.byteCount, event.byteCount + SRGAnalyticsStringByteCount(@"type") + SRGAnalyticsStringByteCount(@"extra_value_5"));
+    
+    // Session labels are accounted for
+    SRGAnalyticsEventRecord *record = [[SRGAnalyticsEventRecord alloc] init];
+    SRGAnalyticsEvent *mediaEvent = [SRGAnalyticsEvent recordEventWithRecord:record sessionLabels:nil sessionIdentifier:1 unitTestingIdentifier:nil];
+    SRGAnalyticsEvent *sessionMediaEvent = [SRGAnalyticsEvent recordEventWithRecord:record sessionLabels:@{ @"key" : @"value" } sessionIdentifier:1 unitTestingIdentifier:nil];
+    XCTAssertEqual(sessionMediaEvent.byteCount, mediaEvent.byteCount + SRGAnalyticsLabelsByteCount(@{ @"key" : @"value" }));
+}
+
+@end
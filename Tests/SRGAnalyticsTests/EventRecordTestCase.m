@@ -0,0 +1,138 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsEventRecord+Catalog.h"
+#import "SRGAnalyticsLabelContext.h"
+
+@import XCTest;
+
+@interface EventRecordTestCase : XCTestCase
+
+@end
+
+@implementation EventRecordTestCase
+
+#pragma mark Tests
+
+- (void)testCatalog
+{
+    for (NSInteger slot = 0; slot < SRGAnalyticsLabelSlotCount; ++slot) {
+        NSString *key = SRGAnalyticsLabelKeyForSlot(slot);
+        XCTAssertEqual(SRGAnalyticsLabelSlotForKey(key), slot);
+    }
+    
+    XCTAssertEqualObjects(SRGAnalyticsLabelKeyForSlot(SRGAnalyticsLabelSlotNavigationLevel3), @"navigation_level_3");
+    XCTAssertEqualObjects(SRGAnalyticsLabelKeyForSlot(SRGAnalyticsLabelSlotSrgN10), @"srg_n10");
+    XCTAssertEqual(SRGAnalyticsLabelTypeForSlot(SRGAnalyticsLabelSlotMediaPosition), SRGAnalyticsLabelTypeInteger);
+    XCTAssertEqual(SRGAnalyticsLabelSlotForKey(@"unknown_key"), NSNotFound);
+}
+
+- (void)testFormatting
+{
+    SRGAnalyticsEventRecord *record = [[SRGAnalyticsEventRecord alloc] init];
+    [record setEventId:@"play"];
+    [record setMediaPosition:(int64_t)round(1234567. / 1000)];
+    [record setMediaVolume:0];
+    [record setMediaBandwidth:1234567.89];
+    [record setMediaSubtitlesOn:YES];
+    [record setSrgApPush:NO];
+    [record setNavigationLevel:@"level1" atIndex:0];
+    [record setNavigationLevel:@"level8" atIndex:7];
+    
+    // Formatting must match the one of string labels built eagerly
+    NSDictionary<NSString *, NSString *> *expectedLabels = @{ @"event_id" : @"play",
+                                                              @"media_position" : @(round(1234567. / 1000)).stringValue,
+                                                              @"media_volume" : @"0",
+                                                              @"media_bandwidth" : @(1234567.89).stringValue,
+                                                              @"media_subtitles_on" : @"true",
+                                                              @"srg_ap_push" : @(NO).stringValue,
+                                                              @"navigation_level_1" : @"level1",
+                                                              @"navigation_level_8" : @"level8" };
+    XCTAssertEqualObjects(record.dictionary, expectedLabels);
+    XCTAssertEqualObjects([record labelForKey:@"media_position"], @"1235");
+    XCTAssertNil([record labelForKey:@"media_timeshift"]);
+}
+
+- (void)testRemoval
+{
+    SRGAnalyticsEventRecord *record = [[SRGAnalyticsEventRecord alloc] init];
+    [record setEventId:@"play"];
+    [record setMediaPosition:12];
+    
+    [record setEventId:nil];
+    [record removeValueForSlot:SRGAnalyticsLabelSlotMediaPosition];
+    XCTAssertEqualObjects(record.dictionary, @{});
+    XCTAssertFalse([record containsLabelForKey:@"event_id"]);
+}
+
+- (void)testOverflowLabels
+{
+    SRGAnalyticsEventRecord *record = [[SRGAnalyticsEventRecord alloc] init];
+    [record setEventId:@"play"];
+    [record setMediaPosition:12];
+    record.overflowLabels = @{ @"media_position" : @"42",
+                               @"custom_key" : @"custom_value" };
+    
+    NSDictionary<NSString *, NSString *> *expectedLabels = @{ @"event_id" : @"play",
+                                                              @"media_position" : @"42",
+                                                              @"custom_key" : @"custom_value" };
+    XCTAssertEqualObjects(record.dictionary, expectedLabels);
+    XCTAssertEqualObjects([record labelForKey:@"media_position"], @"42");
+    XCTAssertTrue([record containsLabelForKey:@"custom_key"]);
+}
+
+- (void)testByteCount
+{
+    SRGAnalyticsEventRecord *record = [[SRGAnalyticsEventRecord alloc] init];
+    NSUInteger emptyByteCount = record.byteCount;
+    XCTAssertGreaterThan(emptyByteCount, 0);
+    
+    // Native values are stored in fixed slots
+    [record setMediaPosition:12];
+    [record setMediaBandwidth:1234567.89];
+    XCTAssertEqual(record.byteCount, emptyByteCount);
+    
+    [record setEventId:@"play"];
+    XCTAssertEqual(record.byteCount, emptyByteCount + SRGAnalyticsStringByteCount(@"play"));
+    
+    [record setEventId:@"stop"];
+    XCTAssertEqual(record.byteCount, emptyByteCount + SRGAnalyticsStringByteCount(@"stop"));
+    
+    record.overflowLabels = @{ @"key" : @"value" };
+    XCTAssertEqual(record.byteCount, emptyByteCount + SRGAnalyticsStringByteCount(@"stop") + SRGAnalyticsStringByteCount(@"key") + SRGAnalyticsStringByteCount(@"value"));
+    
+    [record removeValueForSlot:SRGAnalyticsLabelSlotEventId];
+    record.overflowLabels = nil;
+    XCTAssertEqual(record.byteCount, emptyByteCount);
+}
+
+- (void)testLabelContext
+{
+    SRGAnalyticsLabelContext *globalContext = [[SRGAnalyticsLabelContext alloc] initWithParentContext:nil labels:@{ @"event_id" : @"global",
+                                                                                                                     @"global_key" : @"global_value" }];
+    
+    SRGAnalyticsEventRecord *record = [[SRGAnalyticsEventRecord alloc] init];
+    [record setEventId:@"screen"];
+    [record setContentTitle:@"title"];
+    SRGAnalyticsLabelContext *recordContext = [[SRGAnalyticsLabelContext alloc] initWithParentContext:globalContext record:record];
+    
+    SRGAnalyticsLabelContext *customContext = [[SRGAnalyticsLabelContext alloc] initWithParentContext:recordContext labels:@{ @"content_title" : @"custom" }];
+    [customContext setLabel:@"test" forKey:@"srg_test_id"];
+    
+    NSDictionary<NSString *, NSString *> *expectedLabels = @{ @"event_id" : @"screen",
+                                                              @"global_key" : @"global_value",
+                                                              @"content_title" : @"custom",
+                                                              @"srg_test_id" : @"test" };
+    XCTAssertEqualObjects(customContext.dictionary, expectedLabels);
+    XCTAssertEqualObjects([customContext labelForKey:@"event_id"], @"screen");
+    
+    // Writing to a record layer must not alter the record
+    [recordContext setLabel:@"other" forKey:@"event_id"];
+    XCTAssertEqualObjects([recordContext labelForKey:@"event_id"], @"other");
+    XCTAssertEqualObjects([record labelForKey:@"event_id"], @"screen");
+}
+
+@end
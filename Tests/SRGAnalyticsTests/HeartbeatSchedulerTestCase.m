@@ -0,0 +1,113 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsHeartbeatScheduler.h"
+#import "XCTestCase+Tests.h"
+
+@import XCTest;
+
+@interface HeartbeatSchedulerTestCase : XCTestCase
+
+@end
+
+@implementation HeartbeatSchedulerTestCase
+
+#pragma mark Tests
+
+- (void)testHeartbeats
+{
+    SRGAnalyticsHeartbeatScheduler *scheduler = [[SRGAnalyticsHeartbeatScheduler alloc] initWithTickInterval:0.01 slotCount:16];
+    
+    __block NSInteger count = 0;
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Heartbeats"];
+    SRGAnalyticsHeartbeat *heartbeat = [scheduler scheduleHeartbeatWithInterval:0.1 handler:^{
+        XCTAssertTrue(NSThread.isMainThread);
+        
+        count += 1;
+        if (count == 5) {
+            [expectation fulfill];
+        }
+    }];
+    XCTAssertEqual(scheduler.heartbeatCount, 1);
+    
+    [self waitForExpectationsWithTimeout:2. handler:nil];
+    
+    [heartbeat invalidate];
+    XCTAssertFalse(heartbeat.valid);
+    XCTAssertEqual(scheduler.heartbeatCount, 0);
+}
+
+- (void)testLongInterval
+{
+    // Interval longer than a wheel rotation
+    SRGAnalyticsHeartbeatScheduler *scheduler = [[SRGAnalyticsHeartbeatScheduler alloc] initWithTickInterval:0.01 slotCount:4];
+    
+    __block NSInteger count = 0;
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Heartbeats"];
+    SRGAnalyticsHeartbeat *heartbeat = [scheduler scheduleHeartbeatWithInterval:0.2 handler:^{
+        count += 1;
+        if (count == 2) {
+            [expectation fulfill];
+        }
+    }];
+    
+    [self waitForExpectationsWithTimeout:2. handler:nil];
+    [heartbeat invalidate];
+}
+
+- (void)testCoalescing
+{
+    SRGAnalyticsHeartbeatScheduler *scheduler = [[SRGAnalyticsHeartbeatScheduler alloc] initWithTickInterval:0.01 slotCount:64];
+    
+    // Heartbeats scheduled a few ticks apart are aligned on the first one
+    NSMutableArray<SRGAnalyticsHeartbeat *> *heartbeats = [NSMutableArray array];
+    NSMutableArray<NSNumber *> *counts = [NSMutableArray array];
+    for (NSInteger i = 0; i < 10; ++i) {
+        [counts addObject:@0];
+        [heartbeats addObject:[scheduler scheduleHeartbeatWithInterval:0.5 handler:^{
+            counts[i] = @(counts[i].integerValue + 1);
+        }]];
+        [NSThread sleepForTimeInterval:0.003];
+    }
+    
+    [self expectationForElapsedTimeInterval:1.2 withHandler:nil];
+    [self waitForExpectationsWithTimeout:5. handler:nil];
+    
+    for (NSNumber *count in counts) {
+        XCTAssertEqual(count.integerValue, 2);
+    }
+    XCTAssertEqual(scheduler.wakeupCount, 2);
+    
+    for (SRGAnalyticsHeartbeat *heartbeat in heartbeats) {
+        [heartbeat invalidate];
+    }
+}
+
+- (void)testInvalidation
+{
+    SRGAnalyticsHeartbeatScheduler *scheduler = [[SRGAnalyticsHeartbeatScheduler alloc] initWithTickInterval:0.01 slotCount:16];
+    
+    SRGAnalyticsHeartbeat *heartbeat1 = [scheduler scheduleHeartbeatWithInterval:0.1 handler:^{
+        XCTFail(@"Invalidated heartbeats must not fire");
+    }];
+    [heartbeat1 invalidate];
+    
+    __block BOOL fired = NO;
+    __block SRGAnalyticsHeartbeat *heartbeat2 = nil;
+    heartbeat2 = [scheduler scheduleHeartbeatWithInterval:0.1 handler:^{
+        XCTAssertFalse(fired);
+        fired = YES;
+        [heartbeat2 invalidate];
+    }];
+    
+    [self expectationForElapsedTimeInterval:0.5 withHandler:nil];
+    [self waitForExpectationsWithTimeout:5. handler:nil];
+    
+    XCTAssertTrue(fired);
+    XCTAssertEqual(scheduler.heartbeatCount, 0);
+}
+
+@end
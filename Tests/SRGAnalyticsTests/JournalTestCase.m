@@ -0,0 +1,192 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsJournal.h"
+
+@import XCTest;
+
+static NSData *JournalTestData(NSInteger index)
+{
+    return [[NSString stringWithFormat:@"record-%@", @(index)] dataUsingEncoding:NSUTF8StringEncoding];
+}
+
+@interface JournalTestCase : XCTestCase
+
+@property (nonatomic) NSURL *directoryURL;
+
+@end
+
+@implementation JournalTestCase
+
+#pragma mark Helpers
+
+- (SRGAnalyticsJournal *)journal
+{
+    return [[SRGAnalyticsJournal alloc] initWithDirectoryURL:self.directoryURL segmentSize:1024 maximumSegmentCount:4];
+}
+
+#pragma mark Setup and teardown
+
+- (void)setUp
+{
+    self.directoryURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:NSUUID.UUID.UUIDString];
+}
+
+- (void)tearDown
+{
+    [NSFileManager.defaultManager removeItemAtURL:self.directoryURL error:NULL];
+}
+
+#pragma mark Tests
+
+- (void)testReplay
+{
+    SRGAnalyticsJournal *journal = [self journal];
+    XCTAssertNotNil(journal);
+    
+    uint64_t sequence1 = [journal appendRecordWithData:JournalTestData(1)];
+    uint64_t sequence2 = [journal appendRecordWithData:JournalTestData(2)];
+    uint64_t sequence3 = [journal appendRecordWithData:JournalTestData(3)];
+    XCTAssertNotEqual(sequence1, 0);
+    XCTAssertEqual(journal.pendingRecordCount, 3);
+    
+    [journal markRecordAsDelivered:sequence2];
+    XCTAssertEqual(journal.pendingRecordCount, 2);
+    
+    // Nothing to replay from the current session
+    XCTAssertEqual([journal replayRecordsWithMaximumCount:NSUIntegerMax block:^BOOL(NSData * _Nonnull data, uint64_t sequence) {
+        return YES;
+    }], 0);
+    XCTAssertTrue(journal.replayCompleted);
+    
+    journal = nil;
+    
+    SRGAnalyticsJournal *reopenedJournal = [self journal];
+    XCTAssertEqual(reopenedJournal.pendingRecordCount, 2);
+    
+    NSMutableArray<NSData *> *replayedData = [NSMutableArray array];
+    NSMutableArray<NSNumber *> *replayedSequences = [NSMutableArray array];
+    NSUInteger replayedCount = [reopenedJournal replayRecordsWithMaximumCount:NSUIntegerMax block:^BOOL(NSData * _Nonnull data, uint64_t sequence) {
+        [replayedData addObject:data.copy];
+        [replayedSequences addObject:@(sequence)];
+        return YES;
+    }];
+    XCTAssertEqual(replayedCount, 2);
+    XCTAssertEqualObjects(replayedData, (@[ JournalTestData(1), JournalTestData(3) ]));
+    XCTAssertTrue(reopenedJournal.replayCompleted);
+    
+    // Replayed records are only flagged as delivered on request
+    XCTAssertEqual(reopenedJournal.pendingRecordCount, 2);
+    for (NSNumber *sequence in replayedSequences) {
+        [reopenedJournal markRecordAsDelivered:sequence.unsignedLongLongValue];
+    }
+    XCTAssertEqual(reopenedJournal.pendingRecordCount, 0);
+    
+    // New records must not reuse sequence numbers from the previous session
+    XCTAssertGreaterThan([reopenedJournal appendRecordWithData:JournalTestData(4)], sequence3);
+}
+
+- (void)testChunkedReplay
+{
+    SRGAnalyticsJournal *journal = [self journal];
+    for (NSInteger i = 0; i < 5; ++i) {
+        [journal appendRecordWithData:JournalTestData(i)];
+    }
+    journal = nil;
+    
+    SRGAnalyticsJournal *reopenedJournal = [self journal];
+    NSMutableArray<NSData *> *replayedData = [NSMutableArray array];
+    
+    XCTAssertEqual([reopenedJournal replayRecordsWithMaximumCount:2 block:^BOOL(NSData * _Nonnull data, uint64_t sequence) {
+        [replayedData addObject:data.copy];
+        return YES;
+    }], 2);
+    XCTAssertFalse(reopenedJournal.replayCompleted);
+    
+    // A refused record is replayed again first
+    __block BOOL refused = NO;
+    XCTAssertEqual([reopenedJournal replayRecordsWithMaximumCount:2 block:^BOOL(NSData * _Nonnull data, uint64_t sequence) {
+        if (! refused) {
+            refused = YES;
+            return NO;
+        }
+        [replayedData addObject:data.copy];
+        return YES;
+    }], 0);
+    XCTAssertFalse(reopenedJournal.replayCompleted);
+    
+    XCTAssertEqual([reopenedJournal replayRecordsWithMaximumCount:10 block:^BOOL(NSData * _Nonnull data, uint64_t sequence) {
+        [replayedData addObject:data.copy];
+        return YES;
+    }], 3);
+    XCTAssertTrue(reopenedJournal.replayCompleted);
+    XCTAssertEqualObjects(replayedData, (@[ JournalTestData(0), JournalTestData(1), JournalTestData(2), JournalTestData(3), JournalTestData(4) ]));
+    
+    // Accepted records are not replayed twice, even if not delivered yet
+    XCTAssertEqual([reopenedJournal replayRecordsWithMaximumCount:10 block:^BOOL(NSData * _Nonnull data, uint64_t sequence) {
+        return YES;
+    }], 0);
+    XCTAssertEqual(reopenedJournal.pendingRecordCount, 5);
+}
+
+- (void)testCompaction
+{
+    SRGAnalyticsJournal *journal = [self journal];
+    
+    for (NSInteger i = 0; i < 1000; ++i) {
+        uint64_t sequence = [journal appendRecordWithData:JournalTestData(i)];
+        [journal markRecordAsDelivered:sequence];
+    }
+    
+    XCTAssertEqual(journal.pendingRecordCount, 0);
+    XCTAssertEqual(journal.segmentCount, 1);
+}
+
+- (void)testMaximumSegmentCount
+{
+    SRGAnalyticsJournal *journal = [self journal];
+    
+    for (NSInteger i = 0; i < 1000; ++i) {
+        [journal appendRecordWithData:JournalTestData(i)];
+    }
+    
+    XCTAssertEqual(journal.segmentCount, 4);
+    XCTAssertLessThan(journal.pendingRecordCount, 1000);
+}
+
+- (void)testCorruptedRecord
+{
+    SRGAnalyticsJournal *journal = [self journal];
+    [journal appendRecordWithData:JournalTestData(1)];
+    [journal appendRecordWithData:JournalTestData(2)];
+    [journal synchronize];
+    journal = nil;
+    
+    // Damage the payload of the second record
+    NSURL *segmentURL = [[NSFileManager.defaultManager contentsOfDirectoryAtURL:self.directoryURL includingPropertiesForKeys:nil options:0 error:NULL] firstObject];
+    NSMutableData *segmentData = [NSMutableData dataWithContentsOfURL:segmentURL];
+    NSRange range = [segmentData rangeOfData:JournalTestData(2) options:0 range:NSMakeRange(0, segmentData.length)];
+    XCTAssertNotEqual(range.location, NSNotFound);
+    ((uint8_t *)segmentData.mutableBytes)[range.location] ^= 0xFF;
+    [segmentData writeToURL:segmentURL atomically:NO];
+    
+    SRGAnalyticsJournal *reopenedJournal = [self journal];
+    NSMutableArray<NSData *> *replayedData = [NSMutableArray array];
+    [reopenedJournal replayRecordsWithMaximumCount:NSUIntegerMax block:^BOOL(NSData * _Nonnull data, uint64_t sequence) {
+        [replayedData addObject:data.copy];
+        return YES;
+    }];
+    XCTAssertEqualObjects(replayedData, @[ JournalTestData(1) ]);
+}
+
+- (void)testOversizedRecord
+{
+    SRGAnalyticsJournal *journal = [self journal];
+    NSMutableData *data = [NSMutableData dataWithLength:2048];
+    XCTAssertEqual([journal appendRecordWithData:data], 0);
+}
+
+@end
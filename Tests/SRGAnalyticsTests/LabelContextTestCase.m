@@ -0,0 +1,106 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsLabelContext.h"
+
+@import XCTest;
+
+@interface LabelContextTestCase : XCTestCase
+
+@end
+
+@implementation LabelContextTestCase
+
+#pragma mark Tests
+
+- (void)testEmptyContext
+{
+    SRGAnalyticsLabelContext *context = [[SRGAnalyticsLabelContext alloc] initWithParentContext:nil labels:nil];
+    XCTAssertNil([context labelForKey:@"key"]);
+    XCTAssertEqualObjects(context.dictionary, @{});
+}
+
+- (void)testLayers
+{
+    SRGAnalyticsLabelContext *globalContext = [[SRGAnalyticsLabelContext alloc] initWithParentContext:nil labels:@{ @"key1" : @"global1",
+                                                                                                                     @"key2" : @"global2" }];
+    SRGAnalyticsLabelContext *eventContext = [[SRGAnalyticsLabelContext alloc] initWithParentContext:globalContext labels:@{ @"key2" : @"event2",
+                                                                                                                             @"key3" : @"event3" }];
+    SRGAnalyticsLabelContext *customContext = [[SRGAnalyticsLabelContext alloc] initWithParentContext:eventContext labels:@{ @"key3" : @"custom3" }];
+    
+    XCTAssertEqualObjects([customContext labelForKey:@"key1"], @"global1");
+    XCTAssertEqualObjects([customContext labelForKey:@"key2"], @"event2");
+    XCTAssertEqualObjects([customContext labelForKey:@"key3"], @"custom3");
+    XCTAssertNil([customContext labelForKey:@"key4"]);
+    
+    NSDictionary<NSString *, NSString *> *expectedLabels = @{ @"key1" : @"global1",
+                                                              @"key2" : @"event2",
+                                                              @"key3" : @"custom3" };
+    XCTAssertEqualObjects(customContext.dictionary, expectedLabels);
+    
+    NSMutableDictionary<NSString *, NSString *> *enumeratedLabels = [NSMutableDictionary dictionary];
+    [customContext enumerateLabelsUsingBlock:^(NSString * _Nonnull key, NSString * _Nonnull label, BOOL * _Nonnull stop) {
+        XCTAssertNil(enumeratedLabels[key]);
+        enumeratedLabels[key] = label;
+    }];
+    XCTAssertEqualObjects(enumeratedLabels, expectedLabels);
+}
+
+- (void)testSharedLabels
+{
+    NSDictionary<NSString *, NSString *> *labels = @{ @"key" : @"value" };
+    SRGAnalyticsLabelContext *context = [[SRGAnalyticsLabelContext alloc] initWithParentContext:nil labels:labels];
+    XCTAssertTrue(context.dictionary == labels);
+}
+
+- (void)testCopyOnWrite
+{
+    NSDictionary<NSString *, NSString *> *globalLabels = @{ @"key1" : @"global1" };
+    SRGAnalyticsLabelContext *globalContext = [[SRGAnalyticsLabelContext alloc] initWithParentContext:nil labels:globalLabels];
+    
+    NSDictionary<NSString *, NSString *> *customLabels = @{ @"key2" : @"custom2" };
+    SRGAnalyticsLabelContext *customContext = [[SRGAnalyticsLabelContext alloc] initWithParentContext:globalContext labels:customLabels];
+    [customContext setLabel:@"custom1" forKey:@"key1"];
+    [customContext setLabel:@"custom3" forKey:@"key3"];
+    
+    XCTAssertEqualObjects(customContext.dictionary, (@{ @"key1" : @"custom1",
+                                                        @"key2" : @"custom2",
+                                                        @"key3" : @"custom3" }));
+    
+    // Shared layers must not have been altered
+    XCTAssertEqualObjects(globalLabels, @{ @"key1" : @"global1" });
+    XCTAssertEqualObjects(customLabels, @{ @"key2" : @"custom2" });
+    XCTAssertEqualObjects(globalContext.dictionary, @{ @"key1" : @"global1" });
+}
+
+- (void)testRemoval
+{
+    SRGAnalyticsLabelContext *globalContext = [[SRGAnalyticsLabelContext alloc] initWithParentContext:nil labels:@{ @"key1" : @"global1",
+                                                                                                                     @"key2" : @"global2" }];
+    SRGAnalyticsLabelContext *context = [[SRGAnalyticsLabelContext alloc] initWithParentContext:globalContext labels:nil];
+    [context setLabel:nil forKey:@"key1"];
+    
+    XCTAssertNil([context labelForKey:@"key1"]);
+    XCTAssertEqualObjects([context labelForKey:@"key2"], @"global2");
+    XCTAssertEqualObjects(context.dictionary, @{ @"key2" : @"global2" });
+    XCTAssertEqualObjects([globalContext labelForKey:@"key1"], @"global1");
+}
+
+- (void)testEnumerationStop
+{
+    SRGAnalyticsLabelContext *globalContext = [[SRGAnalyticsLabelContext alloc] initWithParentContext:nil labels:@{ @"key1" : @"global1",
+                                                                                                                     @"key2" : @"global2" }];
+    SRGAnalyticsLabelContext *context = [[SRGAnalyticsLabelContext alloc] initWithParentContext:globalContext labels:@{ @"key3" : @"value3",
+                                                                                                                         @"key4" : @"value4" }];
+    __block NSInteger count = 0;
+    [context enumerateLabelsUsingBlock:^(NSString * _Nonnull key, NSString * _Nonnull label, BOOL * _Nonnull stop) {
+        ++count;
+        *stop = YES;
+    }];
+    XCTAssertEqual(count, 1);
+}
+
+@end
@@ -0,0 +1,57 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsLaunchReport+Private.h"
+
+@import SRGAnalytics;
+@import XCTest;
+
+@interface LaunchReportTestCase : XCTestCase
+
+@end
+
+@implementation LaunchReportTestCase
+
+#pragma mark Tests
+
+- (void)testTrackerLaunchReport
+{
+    // The tracker is started before tests run (see `TrackerSingletonSetup.m`)
+    SRGAnalyticsLaunchReport *launchReport = SRGAnalyticsTracker.sharedTracker.launchReport;
+    XCTAssertTrue([launchReport.steps containsObject:SRGAnalyticsLaunchStepTrackerStart]);
+    XCTAssertTrue([launchReport.steps containsObject:SRGAnalyticsLaunchStepViewControllerHooks]);
+    XCTAssertTrue([launchReport.steps containsObject:SRGAnalyticsLaunchStepServicesStart]);
+    XCTAssertEqual(launchReport.steps.firstObject, SRGAnalyticsLaunchStepTrackerStart);
+    
+    XCTAssertGreaterThan([launchReport durationForStep:SRGAnalyticsLaunchStepTrackerStart], 0.);
+    XCTAssertGreaterThanOrEqual(launchReport.totalDuration, [launchReport durationForStep:SRGAnalyticsLaunchStepServicesStart]);
+    
+    // Configuring the tracker itself must remain cheap
+    XCTAssertLessThan([launchReport durationForStep:SRGAnalyticsLaunchStepTrackerStart], 0.05);
+    XCTAssertLessThan([launchReport durationForStep:SRGAnalyticsLaunchStepViewControllerHooks], 0.05);
+}
+
+- (void)testMeasureStep
+{
+    SRGAnalyticsLaunchStep step = NSUUID.UUID.UUIDString;
+    XCTAssertEqual([SRGAnalyticsTracker.sharedTracker.launchReport durationForStep:step], 0.);
+    
+    SRGAnalyticsLaunchReportMeasureStep(step, ^{
+        [NSThread sleepForTimeInterval:0.1];
+    });
+    SRGAnalyticsLaunchReportMeasureStep(step, ^{
+        [NSThread sleepForTimeInterval:0.1];
+    });
+    
+    SRGAnalyticsLaunchReport *launchReport = SRGAnalyticsTracker.sharedTracker.launchReport;
+    XCTAssertEqualObjects(launchReport.steps.lastObject, step);
+    XCTAssertEqual([launchReport.steps indexesOfObjectsPassingTest:^BOOL(SRGAnalyticsLaunchStep _Nonnull otherStep, NSUInteger idx, BOOL * _Nonnull stop) {
+        return [otherStep isEqualToString:step];
+    }].count, 1);
+    XCTAssertGreaterThanOrEqual([launchReport durationForStep:step], 0.2);
+}
+
+@end
@@ -0,0 +1,105 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGMediaBandwidthEstimator.h"
+
+@import XCTest;
+
+@interface MediaBandwidthEstimatorTestCase : XCTestCase
+
+@end
+
+@implementation MediaBandwidthEstimatorTestCase
+
+#pragma mark Tests
+
+- (void)testEmpty
+{
+    SRGMediaBandwidthEstimator *estimator = [[SRGMediaBandwidthEstimator alloc] init];
+    XCTAssertEqual(estimator.observedBitrateSampleCount, 0);
+    XCTAssertNil(estimator.observedBitrate);
+    XCTAssertNil(estimator.indicatedBitrate);
+    XCTAssertNil([estimator observedBitratePercentile:50.]);
+    XCTAssertNil([estimator indicatedBitratePercentile:90.]);
+}
+
+- (void)testMovingAverage
+{
+    SRGMediaBandwidthEstimator *estimator = [[SRGMediaBandwidthEstimator alloc] initWithSmoothingFactor:0.5 windowSize:4];
+    [estimator addObservedBitrate:1000. indicatedBitrate:2000.];
+    XCTAssertEqualObjects(estimator.observedBitrate, @1000.);
+    XCTAssertEqualObjects(estimator.indicatedBitrate, @2000.);
+    
+    [estimator addObservedBitrate:3000. indicatedBitrate:4000.];
+    XCTAssertEqualObjects(estimator.observedBitrate, @2000.);
+    XCTAssertEqualObjects(estimator.indicatedBitrate, @3000.);
+    XCTAssertEqual(estimator.observedBitrateSampleCount, 2);
+}
+
+- (void)testInvalidSamples
+{
+    SRGMediaBandwidthEstimator *estimator = [[SRGMediaBandwidthEstimator alloc] initWithSmoothingFactor:0.5 windowSize:4];
+    [estimator addObservedBitrate:-1. indicatedBitrate:NAN];
+    XCTAssertEqual(estimator.observedBitrateSampleCount, 0);
+    XCTAssertNil(estimator.observedBitrate);
+    
+    [estimator addObservedBitrate:0. indicatedBitrate:0.];
+    XCTAssertEqual(estimator.observedBitrateSampleCount, 0);
+    XCTAssertEqual(estimator.indicatedBitrateSampleCount, 0);
+    
+    // Observed and indicated bitrates are independent
+    [estimator addObservedBitrate:1000. indicatedBitrate:-1.];
+    XCTAssertEqualObjects(estimator.observedBitrate, @1000.);
+    XCTAssertEqual(estimator.indicatedBitrateSampleCount, 0);
+    XCTAssertNil(estimator.indicatedBitrate);
+}
+
+- (void)testPercentiles
+{
+    SRGMediaBandwidthEstimator *estimator = [[SRGMediaBandwidthEstimator alloc] initWithSmoothingFactor:0.5 windowSize:10];
+    for (NSInteger i = 10; i >= 1; --i) {
+        [estimator addObservedBitrate:i * 100. indicatedBitrate:i * 1000.];
+    }
+    XCTAssertEqualObjects([estimator observedBitratePercentile:0.], @100.);
+    XCTAssertEqualObjects([estimator observedBitratePercentile:50.], @500.);
+    XCTAssertEqualObjects([estimator observedBitratePercentile:90.], @900.);
+    XCTAssertEqualObjects([estimator observedBitratePercentile:100.], @1000.);
+    XCTAssertEqualObjects([estimator indicatedBitratePercentile:50.], @5000.);
+}
+
+- (void)testWindow
+{
+    SRGMediaBandwidthEstimator *estimator = [[SRGMediaBandwidthEstimator alloc] initWithSmoothingFactor:0.5 windowSize:3];
+    for (NSInteger i = 1; i <= 10; ++i) {
+        [estimator addObservedBitrate:i * 100. indicatedBitrate:i * 1000.];
+    }
+    XCTAssertEqual(estimator.observedBitrateSampleCount, 10);
+    
+    // Only the latest samples are considered
+    XCTAssertEqualObjects([estimator observedBitratePercentile:0.], @800.);
+    XCTAssertEqualObjects([estimator observedBitratePercentile:50.], @900.);
+    XCTAssertEqualObjects([estimator observedBitratePercentile:100.], @1000.);
+    
+    // Percentiles must be updated after samples are added
+    [estimator addObservedBitrate:50. indicatedBitrate:50.];
+    XCTAssertEqualObjects([estimator observedBitratePercentile:0.], @50.);
+}
+
+- (void)testReset
+{
+    SRGMediaBandwidthEstimator *estimator = [[SRGMediaBandwidthEstimator alloc] initWithSmoothingFactor:0.5 windowSize:4];
+    [estimator addObservedBitrate:1000. indicatedBitrate:2000.];
+    [estimator reset];
+    XCTAssertEqual(estimator.observedBitrateSampleCount, 0);
+    XCTAssertNil(estimator.observedBitrate);
+    XCTAssertNil([estimator observedBitratePercentile:50.]);
+    
+    [estimator addObservedBitrate:3000. indicatedBitrate:4000.];
+    XCTAssertEqualObjects(estimator.observedBitrate, @3000.);
+    XCTAssertEqualObjects([estimator observedBitratePercentile:50.], @3000.);
+}
+
+@end
@@ -0,0 +1,137 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGMediaPlaybackHub.h"
+#import "XCTestCase+Tests.h"
+
+@import SRGAnalyticsMediaPlayer;
+
+static NSString * const TestPlaybackBackendKey = @"TestPlaybackBackend";
+
+static NSURL *OnDemandTestURL(void)
+{
+    return [NSURL URLWithString:@"https://devstreaming-cdn.apple.com/videos/streaming/examples/bipbop_16x9/bipbop_16x9_variant.m3u8"];
+}
+
+@interface TestPlaybackBackend : NSObject <SRGMediaPlaybackBackend>
+
+@property (nonatomic) NSMutableArray<SRGMediaPlaybackSnapshot *> *snapshots;
+@property (nonatomic) SRGMediaPlaybackSnapshot *stopSnapshot;
+
+@end
+
+@implementation TestPlaybackBackend
+
+// Only attached to players of this test case
++ (id<SRGMediaPlaybackBackend>)backendForMediaPlayerController:(SRGMediaPlayerController *)mediaPlayerController withSnapshot:(SRGMediaPlaybackSnapshot *)snapshot
+{
+    if (! [snapshot.userInfo[TestPlaybackBackendKey] boolValue]) {
+        return nil;
+    }
+    
+    TestPlaybackBackend *backend = [[TestPlaybackBackend alloc] init];
+    backend.snapshots = [NSMutableArray array];
+    return backend;
+}
+
+- (void)playbackDidChangeWithSnapshot:(SRGMediaPlaybackSnapshot *)snapshot
+{
+    [self.snapshots addObject:snapshot];
+}
+
+- (void)trackingDidChangeWithSnapshot:(SRGMediaPlaybackSnapshot *)snapshot
+{}
+
+- (void)playbackDidStopWithSnapshot:(SRGMediaPlaybackSnapshot *)snapshot
+{
+    self.stopSnapshot = snapshot;
+}
+
+@end
+
+@interface MediaPlaybackHubTestCase : XCTestCase
+
+@end
+
+@implementation MediaPlaybackHubTestCase
+
+#pragma mark Setup and teardown
+
+- (void)setUp
+{
+    [SRGMediaPlaybackHub.sharedHub registerBackendClass:TestPlaybackBackend.class];
+}
+
+#pragma mark Helpers
+
+- (void)playWithMediaPlayerController:(SRGMediaPlayerController *)mediaPlayerController
+{
+    SRGAnalyticsStreamLabels *labels = [[SRGAnalyticsStreamLabels alloc] init];
+    labels.customInfo = @{ @"test_label" : @"test_value" };
+    [mediaPlayerController playURL:OnDemandTestURL() atPosition:nil withSegments:nil analyticsLabels:labels userInfo:@{ TestPlaybackBackendKey : @YES }];
+}
+
+#pragma mark Tests
+
+- (void)testBackendLifecycle
+{
+    SRGMediaPlayerController *mediaPlayerController = [[SRGMediaPlayerController alloc] init];
+    
+    [self expectationForSingleNotification:SRGMediaPlayerPlaybackStateDidChangeNotification object:mediaPlayerController handler:^BOOL(NSNotification * _Nonnull notification) {
+        return [notification.userInfo[SRGMediaPlayerPlaybackStateKey] integerValue] == SRGMediaPlayerPlaybackStatePlaying;
+    }];
+    
+    [self playWithMediaPlayerController:mediaPlayerController];
+    
+    [self waitForExpectationsWithTimeout:20. handler:nil];
+    
+    // Built-in trackers are attached as well
+    NSArray<id<SRGMediaPlaybackBackend>> *backends = [SRGMediaPlaybackHub.sharedHub backendsForMediaPlayerController:mediaPlayerController];
+    NSUInteger index = [backends indexOfObjectPassingTest:^BOOL(id<SRGMediaPlaybackBackend> backend, NSUInteger idx, BOOL *stop) {
+        return [backend isKindOfClass:TestPlaybackBackend.class];
+    }];
+    XCTAssertNotEqual(index, NSNotFound);
+    XCTAssertGreaterThan(backends.count, 1);
+    
+    TestPlaybackBackend *backend = (TestPlaybackBackend *)backends[index];
+    XCTAssertEqual(backend.snapshots.lastObject.playbackState, SRGMediaPlayerPlaybackStatePlaying);
+    XCTAssertEqual(backend.snapshots.lastObject.streamType, SRGMediaPlayerStreamTypeOnDemand);
+    XCTAssertNil(backend.snapshots.lastObject.timeshift);
+    XCTAssertTrue(backend.snapshots.lastObject.tracked);
+    
+    [mediaPlayerController reset];
+    
+    // Stop snapshots contain information about the stopped playback
+    XCTAssertEqual([SRGMediaPlaybackHub.sharedHub backendsForMediaPlayerController:mediaPlayerController].count, 0);
+    XCTAssertEqual(backend.stopSnapshot.playbackState, SRGMediaPlayerPlaybackStateIdle);
+    XCTAssertEqual(backend.stopSnapshot.streamType, SRGMediaPlayerStreamTypeOnDemand);
+    XCTAssertEqualObjects(backend.stopSnapshot.userInfo[TestPlaybackBackendKey], @YES);
+}
+
+- (void)testReleasedController
+{
+    NSUInteger mediaPlayerControllerCount = SRGMediaPlaybackHub.sharedHub.mediaPlayerControllerCount;
+    
+    __weak TestPlaybackBackend *weakBackend = nil;
+    @autoreleasepool {
+        SRGMediaPlayerController *mediaPlayerController = [[SRGMediaPlayerController alloc] init];
+        [self playWithMediaPlayerController:mediaPlayerController];
+        XCTAssertEqual(SRGMediaPlaybackHub.sharedHub.mediaPlayerControllerCount, mediaPlayerControllerCount + 1);
+        
+        for (id<SRGMediaPlaybackBackend> backend in [SRGMediaPlaybackHub.sharedHub backendsForMediaPlayerController:mediaPlayerController]) {
+            if ([backend isKindOfClass:TestPlaybackBackend.class]) {
+                weakBackend = (TestPlaybackBackend *)backend;
+            }
+        }
+        XCTAssertNotNil(weakBackend);
+    }
+    
+    // Backends do not outlive their controller, even if it never returned to idle
+    XCTAssertNil(weakBackend);
+    XCTAssertEqual(SRGMediaPlaybackHub.sharedHub.mediaPlayerControllerCount, mediaPlayerControllerCount);
+}
+
+@end
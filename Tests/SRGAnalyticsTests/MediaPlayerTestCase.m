@@ -863,9 +863,27 @@ static NSURL *DVRTestURL(void)
     
     [self waitForExpectationsWithTimeout:20. handler:nil];
     
+    // A bandwidth is available during playback, even before any access log entry has been completed
+    __block NSInteger heartbeatCount = 0;
+    id heartbeatEventObserver = [NSNotificationCenter.defaultCenter addObserverForHiddenEventNotificationUsingBlock:^(NSString * _Nonnull event, NSDictionary * _Nonnull labels) {
+        if ([event isEqualToString:@"pos"]) {
+            XCTAssertGreaterThan([labels[@"media_bandwidth"] doubleValue], 0.);
+            ++heartbeatCount;
+        }
+    }];
+    
+    [self expectationForElapsedTimeInterval:7. withHandler:nil];
+    [self waitForExpectationsWithTimeout:20. handler:^(NSError * _Nullable error) {
+        [NSNotificationCenter.defaultCenter removeObserver:heartbeatEventObserver];
+    }];
+    
+    XCTAssertNotEqual(heartbeatCount, 0);
+    
     [self expectationForPlayerEventNotificationWithHandler:^BOOL(NSString *event, NSDictionary *labels) {
         XCTAssertEqualObjects(labels[@"event_id"], @"stop");
         XCTAssertNil(labels[@"media_bandwidth"]);
+        XCTAssertNil(labels[@"media_bandwidth_p90"]);
+        XCTAssertNil(labels[@"media_indicated_bitrate"]);
         return YES;
     }];
     
@@ -0,0 +1,112 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGMediaTrackerStateMachine.h"
+
+@import XCTest;
+
+// Send an event through the state machine like the media player tracker does, returning the events actually sent
+static NSArray<NSNumber *> *SendEvent(SRGMediaTrackerEvent event, SRGMediaTrackerEvent *pLastEvent)
+{
+    NSMutableArray<NSNumber *> *sentEvents = [NSMutableArray array];
+    if (SRGMediaTrackerEventRequiresPlay(*pLastEvent, event)) {
+        [sentEvents addObjectsFromArray:SendEvent(SRGMediaTrackerEventPlay, pLastEvent)];
+    }
+    if (! SRGMediaTrackerEventIsAllowed(*pLastEvent, event)) {
+        return sentEvents.copy;
+    }
+    if (SRGMediaTrackerEventIsPlaybackStateEvent(event)) {
+        *pLastEvent = event;
+    }
+    [sentEvents addObject:@(event)];
+    return sentEvents.copy;
+}
+
+@interface MediaTrackerStateMachineTestCase : XCTestCase
+
+@end
+
+@implementation MediaTrackerStateMachineTestCase
+
+#pragma mark Tests
+
+- (void)testTransitions
+{
+    NSDictionary<NSNumber *, NSArray<NSNumber *> *> *expectedTransitions = @{ @(SRGMediaTrackerEventPlay) : @[ @(SRGMediaTrackerEventPause), @(SRGMediaTrackerEventSeek), @(SRGMediaTrackerEventStop), @(SRGMediaTrackerEventEnd) ],
+                                                                             @(SRGMediaTrackerEventPause) : @[ @(SRGMediaTrackerEventPlay), @(SRGMediaTrackerEventSeek), @(SRGMediaTrackerEventStop), @(SRGMediaTrackerEventEnd) ],
+                                                                             @(SRGMediaTrackerEventSeek) : @[ @(SRGMediaTrackerEventPlay), @(SRGMediaTrackerEventPause), @(SRGMediaTrackerEventStop), @(SRGMediaTrackerEventEnd) ],
+                                                                             @(SRGMediaTrackerEventStop) : @[ @(SRGMediaTrackerEventPlay) ],
+                                                                             @(SRGMediaTrackerEventEnd) : @[ @(SRGMediaTrackerEventPlay) ] };
+    
+    for (SRGMediaTrackerEvent lastEvent = 0; lastEvent < SRGMediaTrackerEventCount; ++lastEvent) {
+        for (SRGMediaTrackerEvent event = 0; event < SRGMediaTrackerEventCount; ++event) {
+            BOOL allowed = SRGMediaTrackerEventIsAllowed(lastEvent, event);
+            
+            // Events not changing the playback state are allowed after any sent playback state event
+            if (! SRGMediaTrackerEventIsPlaybackStateEvent(event) && event != SRGMediaTrackerEventNone) {
+                XCTAssertEqual(allowed, expectedTransitions[@(lastEvent)] != nil, @"%@ -> %@", @(lastEvent), @(event));
+            }
+            else {
+                XCTAssertEqual(allowed, [expectedTransitions[@(lastEvent)] containsObject:@(event)], @"%@ -> %@", @(lastEvent), @(event));
+            }
+            
+            BOOL requiresPlay = (lastEvent == SRGMediaTrackerEventStop && (event == SRGMediaTrackerEventPause || event == SRGMediaTrackerEventSeek));
+            XCTAssertEqual(SRGMediaTrackerEventRequiresPlay(lastEvent, event), requiresPlay, @"%@ -> %@", @(lastEvent), @(event));
+        }
+    }
+    
+    XCTAssertFalse(SRGMediaTrackerEventIsAllowed(-1, SRGMediaTrackerEventPlay));
+    XCTAssertFalse(SRGMediaTrackerEventIsAllowed(SRGMediaTrackerEventPlay, SRGMediaTrackerEventCount));
+}
+
+- (void)testPlaybackStates
+{
+    XCTAssertEqual(SRGMediaTrackerEventForPlaybackState(SRGMediaPlayerPlaybackStateIdle), SRGMediaTrackerEventStop);
+    XCTAssertEqual(SRGMediaTrackerEventForPlaybackState(SRGMediaPlayerPlaybackStatePreparing), SRGMediaTrackerEventBuffer);
+    XCTAssertEqual(SRGMediaTrackerEventForPlaybackState(SRGMediaPlayerPlaybackStatePlaying), SRGMediaTrackerEventPlay);
+    XCTAssertEqual(SRGMediaTrackerEventForPlaybackState(SRGMediaPlayerPlaybackStateSeeking), SRGMediaTrackerEventSeek);
+    XCTAssertEqual(SRGMediaTrackerEventForPlaybackState(SRGMediaPlayerPlaybackStatePaused), SRGMediaTrackerEventPause);
+    XCTAssertEqual(SRGMediaTrackerEventForPlaybackState(SRGMediaPlayerPlaybackStateStalled), SRGMediaTrackerEventBuffer);
+    XCTAssertEqual(SRGMediaTrackerEventForPlaybackState(SRGMediaPlayerPlaybackStateEnded), SRGMediaTrackerEventEnd);
+}
+
+- (void)testIdentifiers
+{
+    for (SRGMediaTrackerEvent event = 0; event < SRGMediaTrackerEventCount; ++event) {
+        BOOL sendable = (event != SRGMediaTrackerEventNone && event != SRGMediaTrackerEventBuffer);
+        XCTAssertEqual(SRGMediaTrackerEventIdentifier(event) != nil, sendable, @"%@", @(event));
+    }
+    XCTAssertEqualObjects(SRGMediaTrackerEventIdentifier(SRGMediaTrackerEventEnd), @"eof");
+    XCTAssertEqualObjects(SRGMediaTrackerEventIdentifier(SRGMediaTrackerEventPosition), @"pos");
+    XCTAssertNil(SRGMediaTrackerEventIdentifier(SRGMediaTrackerEventCount));
+}
+
+- (void)testFuzzing
+{
+    srand48(42);
+    
+    SRGMediaTrackerEvent lastEvent = SRGMediaTrackerEventStop;
+    SRGMediaTrackerEvent lastSentStateEvent = SRGMediaTrackerEventStop;
+    for (NSInteger i = 0; i < 100000; ++i) {
+        SRGMediaTrackerEvent event = (SRGMediaTrackerEvent)(lrand48() % SRGMediaTrackerEventCount);
+        for (NSNumber *sentEventNumber in SendEvent(event, &lastEvent)) {
+            SRGMediaTrackerEvent sentEvent = sentEventNumber.integerValue;
+            XCTAssertNotNil(SRGMediaTrackerEventIdentifier(sentEvent));
+            
+            if (SRGMediaTrackerEventIsPlaybackStateEvent(sentEvent)) {
+                // The same playback state event is never sent twice in a row, and sessions are always opened with a play
+                XCTAssertNotEqual(sentEvent, lastSentStateEvent);
+                if (SRGMediaTrackerEventEndsSession(lastSentStateEvent)) {
+                    XCTAssertEqual(sentEvent, SRGMediaTrackerEventPlay);
+                }
+                lastSentStateEvent = sentEvent;
+            }
+        }
+        XCTAssertEqual(lastEvent, lastSentStateEvent);
+    }
+}
+
+@end
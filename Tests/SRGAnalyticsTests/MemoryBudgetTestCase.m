@@ -0,0 +1,204 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsMemoryBudget.h"
+
+@import XCTest;
+
+@interface MemoryBudgetTestCase : XCTestCase
+
+@end
+
+@implementation MemoryBudgetTestCase
+
+#pragma mark Helpers
+
+- (SRGAnalyticsMemoryBudgetEntry *)admitEntryInBudget:(SRGAnalyticsMemoryBudget *)budget withPriority:(SRGAnalyticsEventPriority)priority
+{
+    return [budget admitEntryWithByteCount:100 priority:priority eventType:SRGAnalyticsEventTypeRecord];
+}
+
+#pragma mark Tests
+
+- (void)testAccounting
+{
+    SRGAnalyticsMemoryBudget *budget = [[SRGAnalyticsMemoryBudget alloc] initWithCapacity:1000 dropPolicy:SRGAnalyticsPendingEventDropPolicyDropOldest];
+    SRGAnalyticsMemoryBudgetEntry *entry1 = [self admitEntryInBudget:budget withPriority:SRGAnalyticsEventPriorityNormal];
+    SRGAnalyticsMemoryBudgetEntry *entry2 = [self admitEntryInBudget:budget withPriority:SRGAnalyticsEventPriorityNormal];
+    XCTAssertEqual(budget.byteCount, 200);
+    XCTAssertEqual(budget.count, 2);
+    
+    // Bytes are released when the last consumer is removed, and only once
+    [entry1 addConsumer];
+    [entry1 removeConsumer];
+    XCTAssertEqual(budget.byteCount, 200);
+    [entry1 removeConsumer];
+    XCTAssertEqual(budget.byteCount, 100);
+    [entry1 removeConsumer];
+    XCTAssertEqual(budget.byteCount, 100);
+    
+    [entry2 removeConsumer];
+    XCTAssertEqual(budget.byteCount, 0);
+    XCTAssertEqual(budget.count, 0);
+    XCTAssertEqual(budget.droppedCount, 0);
+}
+
+- (void)testDropOldest
+{
+    SRGAnalyticsMemoryBudget *budget = [[SRGAnalyticsMemoryBudget alloc] initWithCapacity:300 dropPolicy:SRGAnalyticsPendingEventDropPolicyDropOldest];
+    
+    __block NSArray<SRGAnalyticsMemoryBudgetEntry *> *evictedEntries = nil;
+    budget.evictionHandler = ^(NSArray<SRGAnalyticsMemoryBudgetEntry *> *entries) {
+        evictedEntries = entries;
+    };
+    
+    SRGAnalyticsMemoryBudgetEntry *entry1 = [self admitEntryInBudget:budget withPriority:SRGAnalyticsEventPriorityHigh];
+    [self admitEntryInBudget:budget withPriority:SRGAnalyticsEventPriorityLow];
+    [self admitEntryInBudget:budget withPriority:SRGAnalyticsEventPriorityNormal];
+    XCTAssertNil(evictedEntries);
+    
+    XCTAssertNotNil([self admitEntryInBudget:budget withPriority:SRGAnalyticsEventPriorityLow]);
+    XCTAssertEqualObjects(evictedEntries, @[ entry1 ]);
+    XCTAssertTrue(entry1.evicted);
+    XCTAssertEqual(budget.byteCount, 300);
+    XCTAssertEqual(budget.droppedCount, 1);
+    
+    // Consumers of evicted entries do not release bytes again
+    [entry1 removeConsumer];
+    XCTAssertEqual(budget.byteCount, 300);
+}
+
+- (void)testDropLowestPriority
+{
+    SRGAnalyticsMemoryBudget *budget = [[SRGAnalyticsMemoryBudget alloc] initWithCapacity:300 dropPolicy:SRGAnalyticsPendingEventDropPolicyDropLowestPriority];
+    
+    SRGAnalyticsMemoryBudgetEntry *entry1 = [self admitEntryInBudget:budget withPriority:SRGAnalyticsEventPriorityNormal];
+    SRGAnalyticsMemoryBudgetEntry *entry2 = [self admitEntryInBudget:budget withPriority:SRGAnalyticsEventPriorityLow];
+    SRGAnalyticsMemoryBudgetEntry *entry3 = [self admitEntryInBudget:budget withPriority:SRGAnalyticsEventPriorityHigh];
+    
+    XCTAssertNotNil([self admitEntryInBudget:budget withPriority:SRGAnalyticsEventPriorityNormal]);
+    XCTAssertFalse(entry1.evicted);
+    XCTAssertTrue(entry2.evicted);
+    
+    XCTAssertNotNil([self admitEntryInBudget:budget withPriority:SRGAnalyticsEventPriorityHigh]);
+    XCTAssertTrue(entry1.evicted);
+    XCTAssertFalse(entry3.evicted);
+    
+    // Only higher priority events are pending, the new event is dropped
+    XCTAssertNil([self admitEntryInBudget:budget withPriority:SRGAnalyticsEventPriorityLow]);
+    XCTAssertEqual(budget.byteCount, 300);
+    XCTAssertEqual(budget.droppedCount, 3);
+}
+
+- (void)testSampleHeartbeats
+{
+    SRGAnalyticsMemoryBudget *budget = [[SRGAnalyticsMemoryBudget alloc] initWithCapacity:600 dropPolicy:SRGAnalyticsPendingEventDropPolicySampleHeartbeats];
+    
+    SRGAnalyticsMemoryBudgetEntry *entry = [self admitEntryInBudget:budget withPriority:SRGAnalyticsEventPriorityHigh];
+    NSMutableArray<SRGAnalyticsMemoryBudgetEntry *> *heartbeatEntries = [NSMutableArray array];
+    for (NSInteger i = 0; i < 5; ++i) {
+        [heartbeatEntries addObject:[self admitEntryInBudget:budget withPriority:SRGAnalyticsEventPriorityLow]];
+    }
+    
+    // Every other heartbeat is dropped first, oldest first
+    [self admitEntryInBudget:budget withPriority:SRGAnalyticsEventPriorityHigh];
+    [self admitEntryInBudget:budget withPriority:SRGAnalyticsEventPriorityHigh];
+    XCTAssertEqualObjects([heartbeatEntries valueForKey:@"evicted"], (@[ @NO, @YES, @NO, @YES, @NO ]));
+    XCTAssertFalse(entry.evicted);
+    
+    // Remaining heartbeats are sampled down in another pass
+    [self admitEntryInBudget:budget withPriority:SRGAnalyticsEventPriorityHigh];
+    [self admitEntryInBudget:budget withPriority:SRGAnalyticsEventPriorityHigh];
+    XCTAssertEqualObjects([heartbeatEntries valueForKey:@"evicted"], (@[ @NO, @YES, @YES, @YES, @YES ]));
+    XCTAssertFalse(entry.evicted);
+    
+    // Oldest events are dropped afterwards
+    [self admitEntryInBudget:budget withPriority:SRGAnalyticsEventPriorityHigh];
+    XCTAssertTrue(entry.evicted);
+    XCTAssertFalse(heartbeatEntries.firstObject.evicted);
+    XCTAssertEqual(budget.byteCount, 600);
+}
+
+- (void)testOversizedEntry
+{
+    SRGAnalyticsMemoryBudget *budget = [[SRGAnalyticsMemoryBudget alloc] initWithCapacity:50 dropPolicy:SRGAnalyticsPendingEventDropPolicyDropOldest];
+    XCTAssertNil([self admitEntryInBudget:budget withPriority:SRGAnalyticsEventPriorityHigh]);
+    XCTAssertEqual(budget.droppedCount, 1);
+    XCTAssertEqual([budget takeDroppedCount], 1);
+    XCTAssertEqual([budget takeDroppedCount], 0);
+    XCTAssertEqual(budget.droppedCount, 1);
+}
+
+- (void)testUnlimitedBudget
+{
+    SRGAnalyticsMemoryBudget *budget = [[SRGAnalyticsMemoryBudget alloc] initWithCapacity:0 dropPolicy:SRGAnalyticsPendingEventDropPolicyDropOldest];
+    for (NSInteger i = 0; i < 100; ++i) {
+        XCTAssertNotNil([self admitEntryInBudget:budget withPriority:SRGAnalyticsEventPriorityLow]);
+    }
+    XCTAssertEqual(budget.byteCount, 10000);
+    XCTAssertFalse(budget.underBackpressure);
+}
+
+- (void)testBackpressure
+{
+    SRGAnalyticsMemoryBudget *budget = [[SRGAnalyticsMemoryBudget alloc] initWithCapacity:1000 dropPolicy:SRGAnalyticsPendingEventDropPolicyDropOldest];
+    
+    NSMutableArray<NSNumber *> *changes = [NSMutableArray array];
+    budget.backpressureHandler = ^(BOOL underBackpressure) {
+        [changes addObject:@(underBackpressure)];
+    };
+    
+    NSMutableArray<SRGAnalyticsMemoryBudgetEntry *> *entries = [NSMutableArray array];
+    for (NSInteger i = 0; i < 8; ++i) {
+        [entries addObject:[self admitEntryInBudget:budget withPriority:SRGAnalyticsEventPriorityNormal]];
+    }
+    XCTAssertFalse(budget.underBackpressure);
+    
+    // Starts at 90% usage
+    [entries addObject:[self admitEntryInBudget:budget withPriority:SRGAnalyticsEventPriorityNormal]];
+    XCTAssertTrue(budget.underBackpressure);
+    
+    // Stops below 50% usage only
+    for (NSInteger i = 0; i < 4; ++i) {
+        [entries[i] removeConsumer];
+    }
+    XCTAssertTrue(budget.underBackpressure);
+    [entries[4] removeConsumer];
+    XCTAssertFalse(budget.underBackpressure);
+    
+    XCTAssertEqualObjects(changes, (@[ @YES, @NO ]));
+}
+
+- (void)testConcurrentAccounting
+{
+    static const NSInteger kEntryCount = 10000;
+    
+    SRGAnalyticsMemoryBudget *budget = [[SRGAnalyticsMemoryBudget alloc] initWithCapacity:100 * 100 dropPolicy:SRGAnalyticsPendingEventDropPolicySampleHeartbeats];
+    NSLock *lock = [[NSLock alloc] init];
+    __block NSUInteger releasedCount = 0;
+    
+    dispatch_apply(kEntryCount, dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ^(size_t i) {
+        SRGAnalyticsEventPriority priority = (i % 3 == 0) ? SRGAnalyticsEventPriorityLow : SRGAnalyticsEventPriorityHigh;
+        SRGAnalyticsMemoryBudgetEntry *entry = [self admitEntryInBudget:budget withPriority:priority];
+        if (i % 2 == 0) {
+            [entry removeConsumer];
+            
+            // Released entries cannot be evicted anymore
+            if (! entry.evicted) {
+                [lock lock];
+                releasedCount++;
+                [lock unlock];
+            }
+        }
+    });
+    
+    // Pending, released and dropped entries together account for all admitted entries
+    XCTAssertLessThanOrEqual(budget.byteCount, 100 * 100);
+    XCTAssertEqual(budget.byteCount, budget.count * 100);
+    XCTAssertEqual(budget.count + releasedCount + budget.droppedCount, kEntryCount);
+}
+
+@end
@@ -0,0 +1,115 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsMetrics+Private.h"
+#import "SRGAnalyticsMetricsRecorder.h"
+#import "XCTestCase+Tests.h"
+
+@interface MetricsTestCase : XCTestCase
+
+@end
+
+@implementation MetricsTestCase
+
+#pragma mark Setup and teardown
+
+- (void)setUp
+{
+    SRGAnalyticsRenewUnitTestingIdentifier();
+}
+
+#pragma mark Tests
+
+- (void)testLatencyBuckets
+{
+    for (uint64_t latency = 0; latency < 8; ++latency) {
+        XCTAssertEqual(SRGAnalyticsLatencyBucketIndex(latency), latency);
+    }
+    
+    NSUInteger previousIndex = 0;
+    for (uint64_t latency = 1; latency < 1000000000000ULL; latency = latency * 5 / 4 + 1) {
+        NSUInteger index = SRGAnalyticsLatencyBucketIndex(latency);
+        XCTAssertGreaterThanOrEqual(index, previousIndex);
+        if (index < SRGAnalyticsLatencyBucketCount - 1) {
+            XCTAssertLessThan(latency, SRGAnalyticsLatencyBucketUpperBound(index));
+            XCTAssertLessThanOrEqual(SRGAnalyticsLatencyBucketUpperBound(index) - latency, latency / 8 + 1);
+        }
+        if (index > 0) {
+            XCTAssertGreaterThanOrEqual(latency, SRGAnalyticsLatencyBucketUpperBound(index - 1));
+        }
+        previousIndex = index;
+    }
+}
+
+- (void)testHistogramPercentiles
+{
+    uint64_t bucketCounts[SRGAnalyticsLatencyBucketCount] = { 0 };
+    uint64_t sum = 0;
+    for (uint64_t latency = 1000; latency <= 100000; latency += 1000) {
+        bucketCounts[SRGAnalyticsLatencyBucketIndex(latency)] += 1;
+        sum += latency;
+    }
+    
+    SRGAnalyticsLatencyHistogram *histogram = [[SRGAnalyticsLatencyHistogram alloc] initWithBucketCounts:bucketCounts sum:sum maximum:100000];
+    XCTAssertEqual(histogram.count, 100);
+    XCTAssertEqualWithAccuracy(histogram.mean, 50500e-9, 1e-12);
+    XCTAssertEqualWithAccuracy(histogram.maximum, 100000e-9, 1e-12);
+    XCTAssertEqualWithAccuracy([histogram latencyAtPercentile:50.], 50000e-9, 50000e-9 / 8.);
+    XCTAssertEqualWithAccuracy([histogram latencyAtPercentile:90.], 90000e-9, 90000e-9 / 8.);
+    XCTAssertEqualWithAccuracy([histogram latencyAtPercentile:100.], 100000e-9, 1e-12);
+}
+
+- (void)testConcurrentRecording
+{
+    SRGAnalyticsMetrics *metrics1 = SRGAnalyticsMetricsSnapshot(0, 0);
+    
+    dispatch_apply(10000, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t iteration) {
+        SRGAnalyticsMetricsRecordEvent(SRGAnalyticsMetricsEventTypeHiddenEvent, SRGAnalyticsMetricsOutcomeDropped);
+        SRGAnalyticsMetricsRecordLatency(SRGAnalyticsMetricsLatencyEncoding, 1000);
+    });
+    
+    SRGAnalyticsMetrics *metrics2 = SRGAnalyticsMetricsSnapshot(0, 0);
+    XCTAssertEqual([metrics2 droppedEventCountForType:SRGAnalyticsMetricsEventTypeHiddenEvent] - [metrics1 droppedEventCountForType:SRGAnalyticsMetricsEventTypeHiddenEvent], 10000);
+    XCTAssertEqual(metrics2.encodingLatencies.count - metrics1.encodingLatencies.count, 10000);
+}
+
+- (void)testMediaTrackerCount
+{
+    NSInteger liveMediaTrackerCount = SRGAnalyticsMetricsSnapshot(0, 0).liveMediaTrackerCount;
+    
+    SRGAnalyticsMetricsRecordMediaTrackerCreation();
+    XCTAssertEqual(SRGAnalyticsMetricsSnapshot(0, 0).liveMediaTrackerCount, liveMediaTrackerCount + 1);
+    
+    // Trackers can be destroyed on other threads
+    dispatch_sync(dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ^{
+        SRGAnalyticsMetricsRecordMediaTrackerDestruction();
+    });
+    XCTAssertEqual(SRGAnalyticsMetricsSnapshot(0, 0).liveMediaTrackerCount, liveMediaTrackerCount);
+}
+
+- (void)testTrackerMetrics
+{
+    SRGAnalyticsMetrics *metrics1 = SRGAnalyticsTracker.sharedTracker.metrics;
+    
+    [self expectationForHiddenEventNotificationWithHandler:^BOOL(NSString *event, NSDictionary *labels) {
+        return [labels[@"event_name"] isEqualToString:@"Measured event"];
+    }];
+    
+    [SRGAnalyticsTracker.sharedTracker trackHiddenEventWithName:@"Measured event"];
+    
+    [self waitForExpectationsWithTimeout:20. handler:nil];
+    
+    // Ensure the worker is done with the event
+    XCTAssertTrue([SRGAnalyticsTracker.sharedTracker drainWithTimeout:5.]);
+    
+    SRGAnalyticsMetrics *metrics2 = SRGAnalyticsTracker.sharedTracker.metrics;
+    XCTAssertGreaterThan([metrics2 acceptedEventCountForType:SRGAnalyticsMetricsEventTypeHiddenEvent], [metrics1 acceptedEventCountForType:SRGAnalyticsMetricsEventTypeHiddenEvent]);
+    XCTAssertGreaterThan([metrics2 sentEventCountForType:SRGAnalyticsMetricsEventTypeHiddenEvent], [metrics1 sentEventCountForType:SRGAnalyticsMetricsEventTypeHiddenEvent]);
+    XCTAssertGreaterThan(metrics2.labelBuildingLatencies.count, metrics1.labelBuildingLatencies.count);
+    XCTAssertGreaterThan(metrics2.dispatchLatencies.count, metrics1.dispatchLatencies.count);
+}
+
+@end
@@ -8,6 +8,21 @@
 
 @import XCTest;
 
+// Original regular expression-based implementation, used as reference
+static NSString *ReferenceComScoreFormattedString(NSString *string)
+{
+    NSLocale *posixLocale = [[NSLocale alloc] initWithLocaleIdentifier:@"en_US_POSIX"];
+    NSString *normalizedString = [string.lowercaseString stringByFoldingWithOptions:NSDiacriticInsensitiveSearch locale:posixLocale];
+    
+    NSCharacterSet *andSet = [NSCharacterSet characterSetWithCharactersInString:@"+&"];
+    normalizedString = [[normalizedString componentsSeparatedByCharactersInSet:andSet] componentsJoinedByString:@"and"];
+    
+    NSRegularExpression *regularExpression = [NSRegularExpression regularExpressionWithPattern:@"[^a-z0-9]+" options:0 error:NULL];
+    normalizedString = [regularExpression stringByReplacingMatchesInString:normalizedString options:0 range:NSMakeRange(0, normalizedString.length) withTemplate:@"-"];
+    
+    return [normalizedString stringByTrimmingCharactersInSet:[NSCharacterSet characterSetWithCharactersInString:@"-"]];
+}
+
 @interface NSString_AnalyticsTestCase : XCTestCase
 
 @end
@@ -26,6 +41,45 @@
     XCTAssertEqualObjects(@"     trimmed!   ".srg_comScoreFormattedString, @"trimmed");
     XCTAssertEqualObjects(@"Vue aérienne de la zone de la \"potentielle attaque terroriste\" à Londres".srg_comScoreFormattedString, @"vue-aerienne-de-la-zone-de-la-potentielle-attaque-terroriste-a-londres");
     XCTAssertEqualObjects(@"News: \"Hello\"".srg_comScoreFormattedString, @"news-hello");
+    XCTAssertEqualObjects(@"".srg_comScoreFormattedString, @"");
+    XCTAssertEqualObjects(@"+++".srg_comScoreFormattedString, @"andandand");
+    XCTAssertEqualObjects(@"---".srg_comScoreFormattedString, @"");
+    XCTAssertEqualObjects(@"Ça & Là".srg_comScoreFormattedString, @"ca-and-la");
+}
+
+- (void)testFormattedStringsAgainstReference
+{
+    NSArray<NSString *> *pool = @[ @"a", @"Z", @"m", @"0", @"7", @" ", @"-", @"_", @"+", @"&", @".", @"/", @":", @"!", @"\"", @"^", @"`", @"~",
+                                   @"é", @"À", @"ç", @"Ü", @"ß", @"ø", @"Æ", @"İ", @"ı", @"ﬁ", @"Ⓐ", @"ｆ", @"ŉ", @"ǅ", @"e\u0301", @"\u0300",
+                                   @"日本", @"Ж", @"Ω", @"😀", @"👍🏽", @"\t", @"\n", @"\u00a0" ];
+    
+    srand48(42);
+    for (NSInteger i = 0; i < 20000; ++i) {
+        // Mostly short strings (cached), with some longer ones (not cached)
+        NSInteger length = (i % 100 == 0) ? 300 + lrand48() % 200 : lrand48() % 40;
+        BOOL ASCIIOnly = (i % 2 == 0);
+        
+        NSMutableString *string = [NSMutableString string];
+        for (NSInteger j = 0; j < length; ++j) {
+            NSUInteger count = ASCIIOnly ? 18 : pool.count;
+            [string appendString:pool[lrand48() % count]];
+        }
+        
+        NSString *expectedString = ReferenceComScoreFormattedString(string);
+        XCTAssertEqualObjects(string.srg_comScoreFormattedString, expectedString, @"Formatting mismatch for '%@'", string);
+        
+        // Cache hit
+        XCTAssertEqualObjects(string.srg_comScoreFormattedString, expectedString, @"Cached formatting mismatch for '%@'", string);
+    }
+}
+
+- (void)testMutableString
+{
+    NSMutableString *string = [NSMutableString stringWithString:@"Hello"];
+    XCTAssertEqualObjects(string.srg_comScoreFormattedString, @"hello");
+    
+    [string appendString:@" World"];
+    XCTAssertEqualObjects(string.srg_comScoreFormattedString, @"hello-world");
 }
 
 @end
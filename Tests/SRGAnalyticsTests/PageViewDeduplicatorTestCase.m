@@ -0,0 +1,89 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsPageViewDeduplicator.h"
+
+@import XCTest;
+
+static const uint64_t kMillisecond = 1000000ULL;
+
+@interface PageViewDeduplicatorTestCase : XCTestCase
+
+@end
+
+@implementation PageViewDeduplicatorTestCase
+
+#pragma mark Tests
+
+- (void)testFingerprint
+{
+    SRGAnalyticsPageViewLabels *labels1 = [[SRGAnalyticsPageViewLabels alloc] init];
+    labels1.customInfo = @{ @"a" : @"1", @"b" : @"2" };
+    
+    SRGAnalyticsPageViewLabels *labels2 = [[SRGAnalyticsPageViewLabels alloc] init];
+    labels2.customInfo = @{ @"b" : @"2", @"a" : @"1" };
+    
+    SRGAnalyticsPageViewLabels *labels3 = [[SRGAnalyticsPageViewLabels alloc] init];
+    labels3.customInfo = @{ @"a" : @"2", @"b" : @"1" };
+    
+    XCTAssertEqual(SRGAnalyticsPageViewFingerprint(@"title", @[ @"level" ], labels1, NO), SRGAnalyticsPageViewFingerprint(@"title", @[ @"level" ], labels2, NO));
+    XCTAssertNotEqual(SRGAnalyticsPageViewFingerprint(@"title", @[ @"level" ], labels1, NO), SRGAnalyticsPageViewFingerprint(@"title", @[ @"level" ], labels3, NO));
+    XCTAssertNotEqual(SRGAnalyticsPageViewFingerprint(@"title", @[ @"level" ], labels1, NO), SRGAnalyticsPageViewFingerprint(@"title", @[ @"level" ], labels1, YES));
+    XCTAssertNotEqual(SRGAnalyticsPageViewFingerprint(@"title", @[ @"a", @"b" ], nil, NO), SRGAnalyticsPageViewFingerprint(@"title", @[ @"b", @"a" ], nil, NO));
+    XCTAssertNotEqual(SRGAnalyticsPageViewFingerprint(@"title", nil, nil, NO), SRGAnalyticsPageViewFingerprint(@"other", nil, nil, NO));
+}
+
+- (void)testDebounce
+{
+    SRGAnalyticsPageViewDeduplicator *deduplicator = [[SRGAnalyticsPageViewDeduplicator alloc] initWithDebounceInterval:0.5];
+    
+    uint64_t time = 1000 * kMillisecond;
+    XCTAssertTrue([deduplicator shouldTrackPageViewWithTitle:@"1" levels:nil labels:nil fromPushNotification:NO atTime:time]);
+    XCTAssertFalse([deduplicator shouldTrackPageViewWithTitle:@"1" levels:nil labels:nil fromPushNotification:NO atTime:time + 1 * kMillisecond]);
+    XCTAssertTrue([deduplicator shouldTrackPageViewWithTitle:@"2" levels:nil labels:nil fromPushNotification:NO atTime:time + 2 * kMillisecond]);
+    XCTAssertTrue([deduplicator shouldTrackPageViewWithTitle:@"1" levels:@[ @"level" ] labels:nil fromPushNotification:NO atTime:time + 3 * kMillisecond]);
+    XCTAssertFalse([deduplicator shouldTrackPageViewWithTitle:@"1" levels:nil labels:nil fromPushNotification:NO atTime:time + 499 * kMillisecond]);
+    
+    // Suppressed page views do not extend the window
+    XCTAssertTrue([deduplicator shouldTrackPageViewWithTitle:@"1" levels:nil labels:nil fromPushNotification:NO atTime:time + 500 * kMillisecond]);
+    XCTAssertFalse([deduplicator shouldTrackPageViewWithTitle:@"1" levels:nil labels:nil fromPushNotification:NO atTime:time + 600 * kMillisecond]);
+}
+
+- (void)testLongTitles
+{
+    SRGAnalyticsPageViewDeduplicator *deduplicator = [[SRGAnalyticsPageViewDeduplicator alloc] initWithDebounceInterval:0.5];
+    
+    // String hashes only consider some characters of long strings. Titles only differing elsewhere are distinct.
+    NSString *prefix = [@"" stringByPaddingToLength:40 withString:@"a" startingAtIndex:0];
+    NSString *suffix = [@"" stringByPaddingToLength:200 withString:@"a" startingAtIndex:0];
+    NSString *title1 = [NSString stringWithFormat:@"%@1%@", prefix, suffix];
+    NSString *title2 = [NSString stringWithFormat:@"%@2%@", prefix, suffix];
+    
+    XCTAssertTrue([deduplicator shouldTrackPageViewWithTitle:title1 levels:nil labels:nil fromPushNotification:NO atTime:kMillisecond]);
+    XCTAssertTrue([deduplicator shouldTrackPageViewWithTitle:title2 levels:nil labels:nil fromPushNotification:NO atTime:kMillisecond]);
+    XCTAssertFalse([deduplicator shouldTrackPageViewWithTitle:title1.mutableCopy levels:nil labels:nil fromPushNotification:NO atTime:kMillisecond]);
+}
+
+- (void)testDisabledDebounce
+{
+    SRGAnalyticsPageViewDeduplicator *deduplicator = [[SRGAnalyticsPageViewDeduplicator alloc] initWithDebounceInterval:0.];
+    XCTAssertTrue([deduplicator shouldTrackPageViewWithTitle:@"1" levels:nil labels:nil fromPushNotification:NO atTime:kMillisecond]);
+    XCTAssertTrue([deduplicator shouldTrackPageViewWithTitle:@"1" levels:nil labels:nil fromPushNotification:NO atTime:kMillisecond]);
+}
+
+- (void)testHistoryEviction
+{
+    SRGAnalyticsPageViewDeduplicator *deduplicator = [[SRGAnalyticsPageViewDeduplicator alloc] initWithDebounceInterval:10.];
+    
+    // Many distinct pages evict older ones, which are then tracked again
+    for (NSInteger i = 0; i < 100; ++i) {
+        XCTAssertTrue([deduplicator shouldTrackPageViewWithTitle:@(i).stringValue levels:nil labels:nil fromPushNotification:NO atTime:kMillisecond]);
+    }
+    XCTAssertTrue([deduplicator shouldTrackPageViewWithTitle:@"0" levels:nil labels:nil fromPushNotification:NO atTime:kMillisecond]);
+    XCTAssertFalse([deduplicator shouldTrackPageViewWithTitle:@"99" levels:nil labels:nil fromPushNotification:NO atTime:kMillisecond]);
+}
+
+@end
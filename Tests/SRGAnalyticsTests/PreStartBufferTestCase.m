@@ -0,0 +1,118 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsPreStartBuffer.h"
+
+@import XCTest;
+
+@interface PreStartBufferTestCase : XCTestCase
+
+@end
+
+@implementation PreStartBufferTestCase
+
+#pragma mark Tests
+
+- (void)testBuffering
+{
+    SRGAnalyticsPreStartBuffer *buffer = [[SRGAnalyticsPreStartBuffer alloc] initWithCapacity:10];
+    XCTAssertFalse(buffer.released);
+    
+    for (NSInteger i = 0; i < 5; ++i) {
+        XCTAssertEqual([buffer bufferEvent:[SRGAnalyticsEvent hiddenEventWithName:@(i).stringValue labels:nil]], SRGAnalyticsPreStartBufferOutcomeBuffered);
+    }
+    XCTAssertEqual(buffer.count, 5);
+    
+    __block NSArray<SRGAnalyticsEvent *> *releasedEvents = nil;
+    [buffer releaseWithBlock:^(NSArray<SRGAnalyticsEvent *> *events) {
+        releasedEvents = events;
+    }];
+    XCTAssertTrue(buffer.released);
+    XCTAssertEqual(buffer.count, 0);
+    XCTAssertEqual(buffer.droppedCount, 0);
+    
+    XCTAssertEqual(releasedEvents.count, 5);
+    [releasedEvents enumerateObjectsUsingBlock:^(SRGAnalyticsEvent * _Nonnull event, NSUInteger idx, BOOL * _Nonnull stop) {
+        XCTAssertEqualObjects(event.name, @(idx).stringValue);
+    }];
+}
+
+- (void)testCapacity
+{
+    SRGAnalyticsPreStartBuffer *buffer = [[SRGAnalyticsPreStartBuffer alloc] initWithCapacity:3];
+    for (NSInteger i = 0; i < 5; ++i) {
+        SRGAnalyticsPreStartBufferOutcome expectedOutcome = (i < 3) ? SRGAnalyticsPreStartBufferOutcomeBuffered : SRGAnalyticsPreStartBufferOutcomeDropped;
+        XCTAssertEqual([buffer bufferEvent:[SRGAnalyticsEvent hiddenEventWithName:@(i).stringValue labels:nil]], expectedOutcome);
+    }
+    XCTAssertEqual(buffer.count, 3);
+    XCTAssertEqual(buffer.droppedCount, 2);
+    
+    // Earliest events are kept
+    __block NSArray<SRGAnalyticsEvent *> *releasedEvents = nil;
+    [buffer releaseWithBlock:^(NSArray<SRGAnalyticsEvent *> *events) {
+        releasedEvents = events;
+    }];
+    XCTAssertEqualObjects([releasedEvents valueForKey:@"name"], (@[ @"0", @"1", @"2" ]));
+}
+
+- (void)testRelease
+{
+    SRGAnalyticsPreStartBuffer *buffer = [[SRGAnalyticsPreStartBuffer alloc] initWithCapacity:10];
+    [buffer bufferEvent:[SRGAnalyticsEvent hiddenEventWithName:@"event" labels:nil]];
+    
+    __block NSInteger releaseCount = 0;
+    [buffer releaseWithBlock:^(NSArray<SRGAnalyticsEvent *> *events) {
+        releaseCount++;
+    }];
+    XCTAssertEqual([buffer bufferEvent:[SRGAnalyticsEvent hiddenEventWithName:@"late_event" labels:nil]], SRGAnalyticsPreStartBufferOutcomeReleased);
+    XCTAssertEqual(buffer.count, 0);
+    
+    // Releasing a second time has no effect
+    [buffer releaseWithBlock:^(NSArray<SRGAnalyticsEvent *> *events) {
+        releaseCount++;
+    }];
+    XCTAssertEqual(releaseCount, 1);
+}
+
+- (void)testConcurrentBuffering
+{
+    static const NSInteger kEventCount = 10000;
+    
+    SRGAnalyticsPreStartBuffer *buffer = [[SRGAnalyticsPreStartBuffer alloc] initWithCapacity:kEventCount];
+    NSMutableArray<NSString *> *names = [NSMutableArray array];
+    NSLock *lock = [[NSLock alloc] init];
+    
+    dispatch_group_t group = dispatch_group_create();
+    dispatch_group_async(group, dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ^{
+        for (NSInteger i = 0; i < kEventCount; ++i) {
+            NSString *name = @(i).stringValue;
+            if ([buffer bufferEvent:[SRGAnalyticsEvent hiddenEventWithName:name labels:nil]] == SRGAnalyticsPreStartBufferOutcomeReleased) {
+                [lock lock];
+                [names addObject:name];
+                [lock unlock];
+            }
+        }
+    });
+    dispatch_group_async(group, dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ^{
+        [NSThread sleepForTimeInterval:0.001];
+        [buffer releaseWithBlock:^(NSArray<SRGAnalyticsEvent *> *events) {
+            [lock lock];
+            for (SRGAnalyticsEvent *event in events) {
+                [names addObject:event.name];
+            }
+            [lock unlock];
+        }];
+    });
+    XCTAssertEqual(dispatch_group_wait(group, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(10. * NSEC_PER_SEC))), 0);
+    
+    // No event is lost and order is preserved, whether events were released or rejected
+    XCTAssertEqual(names.count, kEventCount);
+    [names enumerateObjectsUsingBlock:^(NSString * _Nonnull name, NSUInteger idx, BOOL * _Nonnull stop) {
+        XCTAssertEqualObjects(name, @(idx).stringValue);
+    }];
+}
+
+@end
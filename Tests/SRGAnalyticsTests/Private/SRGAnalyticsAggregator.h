@@ -0,0 +1 @@
+../../../Sources/SRGAnalytics/SRGAnalyticsAggregator.h
\ No newline at end of file
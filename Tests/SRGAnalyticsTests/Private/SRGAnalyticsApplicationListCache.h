@@ -0,0 +1 @@
+../../../Sources/SRGAnalytics/SRGAnalyticsApplicationListCache.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../Sources/SRGAnalytics/SRGAnalyticsBatchEncoder.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../Sources/SRGAnalytics/SRGAnalyticsCaptureSink+Private.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../Sources/SRGAnalytics/SRGAnalyticsEvent.h
\ No newline at end of file
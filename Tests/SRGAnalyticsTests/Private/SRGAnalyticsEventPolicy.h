@@ -0,0 +1 @@
+../../../Sources/SRGAnalytics/SRGAnalyticsEventPolicy.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../Sources/SRGAnalytics/SRGAnalyticsEventQueue.h
\ No newline at end of file
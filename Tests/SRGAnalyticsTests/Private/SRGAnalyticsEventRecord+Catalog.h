@@ -0,0 +1 @@
+../../../Sources/SRGAnalytics/SRGAnalyticsEventRecord+Catalog.h
\ No newline at end of file
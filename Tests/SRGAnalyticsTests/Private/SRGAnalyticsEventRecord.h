@@ -0,0 +1 @@
+../../../Sources/SRGAnalytics/SRGAnalyticsEventRecord.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../Sources/SRGAnalytics/SRGAnalyticsHeartbeatScheduler.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../Sources/SRGAnalytics/SRGAnalyticsJournal.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../Sources/SRGAnalytics/SRGAnalyticsLabelCatalog.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../Sources/SRGAnalytics/SRGAnalyticsLabelContext.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../Sources/SRGAnalytics/SRGAnalyticsLaunchReport+Private.h
\ No newline at end of file
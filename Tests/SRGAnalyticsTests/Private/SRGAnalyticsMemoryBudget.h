@@ -0,0 +1 @@
+../../../Sources/SRGAnalytics/SRGAnalyticsMemoryBudget.h
\ No newline at end of file
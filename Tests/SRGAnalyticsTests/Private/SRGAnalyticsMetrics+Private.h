@@ -0,0 +1 @@
+../../../Sources/SRGAnalytics/SRGAnalyticsMetrics+Private.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../Sources/SRGAnalytics/SRGAnalyticsMetricsRecorder.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../Sources/SRGAnalytics/SRGAnalyticsPageViewDeduplicator.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../Sources/SRGAnalytics/SRGAnalyticsPreStartBuffer.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../Sources/SRGAnalytics/SRGAnalyticsRateLimiter.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../Sources/SRGAnalytics/SRGAnalyticsSink.h
\ No newline at end of file
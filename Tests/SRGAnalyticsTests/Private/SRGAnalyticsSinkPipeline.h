@@ -0,0 +1 @@
+../../../Sources/SRGAnalytics/SRGAnalyticsSinkPipeline.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../Sources/SRGAnalyticsMediaPlayer/SRGMediaBandwidthEstimator.h
\ No newline at end of file
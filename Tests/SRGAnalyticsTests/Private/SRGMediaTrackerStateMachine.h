@@ -0,0 +1 @@
+../../../Sources/SRGAnalyticsMediaPlayer/SRGMediaTrackerStateMachine.h
\ No newline at end of file
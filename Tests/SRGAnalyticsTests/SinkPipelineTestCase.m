@@ -0,0 +1,223 @@
+//
+//  Copyright (c) SRG SSR. All rights reserved.
+//
+//  License information is available from the LICENSE file.
+//
+
+#import "SRGAnalyticsSinkPipeline.h"
+
+@import XCTest;
+
+static SRGAnalyticsSinkEvent *SinkEvent(NSString *name)
+{
+    SRGAnalyticsLabelContext *context = [[SRGAnalyticsLabelContext alloc] initWithParentContext:nil labels:@{ @"event_name" : name }];
+    return [[SRGAnalyticsSinkEvent alloc] initWithTagCommanderContext:context comScoreContext:nil replayed:NO deliveryHandler:nil];
+}
+
+// Sink recording event names, optionally slowed down or failing for some events
+@interface TestSink : NSObject <SRGAnalyticsSink>
+
+@property (nonatomic) NSTimeInterval delay;
+@property (nonatomic, copy) NSString *failingEventName;
+
+@property (nonatomic, readonly) NSArray<NSString *> *eventNames;
+@property (nonatomic, readonly) NSInteger flushCount;
+
+@end
+
+@interface TestSink ()
+
+@property (nonatomic) NSMutableArray<NSString *> *mutableEventNames;
+@property (nonatomic) NSInteger flushCount;
+
+@end
+
+@implementation TestSink
+
+- (instancetype)init
+{
+    if (self = [super init]) {
+        self.mutableEventNames = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (NSArray<NSString *> *)eventNames
+{
+    @synchronized (self) {
+        return self.mutableEventNames.copy;
+    }
+}
+
+- (NSString *)name
+{
+    return @"test";
+}
+
+- (void)consumeEvent:(SRGAnalyticsSinkEvent *)event
+{
+    NSString *eventName = [event.tagCommanderContext labelForKey:@"event_name"];
+    if ([eventName isEqualToString:self.failingEventName]) {
+        [NSException raise:NSInternalInconsistencyException format:@"Failing event"];
+    }
+    if (self.delay > 0.) {
+        [NSThread sleepForTimeInterval:self.delay];
+    }
+    @synchronized (self) {
+        [self.mutableEventNames addObject:eventName];
+    }
+}
+
+- (void)flush
+{
+    self.flushCount += 1;
+}
+
+@end
+
+@interface SinkPipelineTestCase : XCTestCase
+
+@end
+
+@implementation SinkPipelineTestCase
+
+#pragma mark Helpers
+
+- (void)waitForPipeline:(SRGAnalyticsSinkPipeline *)pipeline
+{
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Pipeline flushed"];
+    [pipeline performBlock:^{
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10. handler:nil];
+}
+
+#pragma mark Tests
+
+- (void)testOrdering
+{
+    TestSink *sink = [[TestSink alloc] init];
+    SRGAnalyticsSinkPipeline *pipeline = [[SRGAnalyticsSinkPipeline alloc] initWithSink:sink capacity:1000];
+    
+    for (NSInteger i = 0; i < 1000; ++i) {
+        XCTAssertTrue([pipeline enqueueEvent:SinkEvent(@(i).stringValue)]);
+    }
+    [self waitForPipeline:pipeline];
+    
+    XCTAssertEqual(pipeline.pendingCount, 0);
+    XCTAssertEqual(pipeline.droppedCount, 0);
+    XCTAssertEqual(sink.eventNames.count, 1000);
+    [sink.eventNames enumerateObjectsUsingBlock:^(NSString * _Nonnull name, NSUInteger idx, BOOL * _Nonnull stop) {
+        XCTAssertEqualObjects(name, @(idx).stringValue);
+    }];
+}
+
+- (void)testCapacity
+{
+    TestSink *sink = [[TestSink alloc] init];
+    sink.delay = 0.5;
+    SRGAnalyticsSinkPipeline *pipeline = [[SRGAnalyticsSinkPipeline alloc] initWithSink:sink capacity:3];
+    
+    NSUInteger acceptedCount = 0;
+    for (NSInteger i = 0; i < 10; ++i) {
+        if ([pipeline enqueueEvent:SinkEvent(@(i).stringValue)]) {
+            acceptedCount++;
+        }
+    }
+    XCTAssertEqual(acceptedCount, 3);
+    XCTAssertEqual(pipeline.droppedCount, 7);
+    
+    [self waitForPipeline:pipeline];
+    XCTAssertEqualObjects(sink.eventNames, (@[ @"0", @"1", @"2" ]));
+}
+
+- (void)testLaneCapacity
+{
+    TestSink *sink = [[TestSink alloc] init];
+    sink.delay = 0.5;
+    SRGAnalyticsSinkPipeline *pipeline = [[SRGAnalyticsSinkPipeline alloc] initWithSink:sink capacity:4];
+    
+    // Heartbeats can only use half of the buffer, keeping room for more important events
+    for (NSInteger i = 0; i < 3; ++i) {
+        SRGAnalyticsSinkEvent *event = SinkEvent(@(i).stringValue);
+        event.lane = SRGAnalyticsEventLaneHeartbeat;
+        XCTAssertEqual([pipeline enqueueEvent:event], i < 2);
+    }
+    XCTAssertTrue([pipeline enqueueEvent:SinkEvent(@"3")]);
+    XCTAssertTrue([pipeline enqueueEvent:SinkEvent(@"4")]);
+    XCTAssertFalse([pipeline enqueueEvent:SinkEvent(@"5")]);
+    XCTAssertEqual(pipeline.droppedCount, 2);
+    
+    [self waitForPipeline:pipeline];
+    XCTAssertEqualObjects(sink.eventNames, (@[ @"0", @"1", @"3", @"4" ]));
+}
+
+- (void)testFailureIsolation
+{
+    TestSink *sink = [[TestSink alloc] init];
+    sink.failingEventName = @"1";
+    SRGAnalyticsSinkPipeline *pipeline = [[SRGAnalyticsSinkPipeline alloc] initWithSink:sink capacity:10];
+    
+    [pipeline enqueueEvent:SinkEvent(@"0")];
+    [pipeline enqueueEvent:SinkEvent(@"1")];
+    [pipeline enqueueEvent:SinkEvent(@"2")];
+    [self waitForPipeline:pipeline];
+    
+    XCTAssertEqual(pipeline.failureCount, 1);
+    XCTAssertEqualObjects(sink.eventNames, (@[ @"0", @"2" ]));
+}
+
+- (void)testSlowSinkIsolation
+{
+    TestSink *slowSink = [[TestSink alloc] init];
+    slowSink.delay = 1.;
+    SRGAnalyticsSinkPipeline *slowPipeline = [[SRGAnalyticsSinkPipeline alloc] initWithSink:slowSink capacity:10];
+    
+    TestSink *fastSink = [[TestSink alloc] init];
+    SRGAnalyticsSinkPipeline *fastPipeline = [[SRGAnalyticsSinkPipeline alloc] initWithSink:fastSink capacity:10];
+    
+    // The same event instance is shared by both sinks
+    NSDate *startDate = NSDate.date;
+    for (NSInteger i = 0; i < 3; ++i) {
+        SRGAnalyticsSinkEvent *event = SinkEvent(@(i).stringValue);
+        [slowPipeline enqueueEvent:event];
+        [fastPipeline enqueueEvent:event];
+    }
+    XCTAssertLessThan([NSDate.date timeIntervalSinceDate:startDate], 0.5);
+    
+    [self waitForPipeline:fastPipeline];
+    XCTAssertLessThan([NSDate.date timeIntervalSinceDate:startDate], 1.);
+    XCTAssertEqual(fastSink.eventNames.count, 3);
+    XCTAssertLessThan(slowSink.eventNames.count, 3);
+}
+
+- (void)testFlush
+{
+    TestSink *sink = [[TestSink alloc] init];
+    sink.delay = 0.1;
+    SRGAnalyticsSinkPipeline *pipeline = [[SRGAnalyticsSinkPipeline alloc] initWithSink:sink capacity:10];
+    
+    [pipeline enqueueEvent:SinkEvent(@"0")];
+    [pipeline enqueueEvent:SinkEvent(@"1")];
+    
+    // The sink is flushed once pending events have been consumed
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Sink flushed"];
+    [pipeline flushWithCompletionBlock:^{
+        XCTAssertEqual(sink.eventNames.count, 2);
+        XCTAssertEqual(sink.flushCount, 1);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10. handler:nil];
+}
+
+- (void)testDeliveryNotification
+{
+    __block NSInteger deliveryCount = 0;
+    SRGAnalyticsSinkEvent *event = [[SRGAnalyticsSinkEvent alloc] initWithTagCommanderContext:nil comScoreContext:nil replayed:NO deliveryHandler:^{
+        deliveryCount++;
+    }];
+    [event notifyTagCommanderDelivery];
+    XCTAssertEqual(deliveryCount, 1);
+}
+
+@end
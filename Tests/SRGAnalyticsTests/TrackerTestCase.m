@@ -76,6 +76,36 @@
     [self waitForExpectationsWithTimeout:20. handler:nil];
 }
 
+- (void)testAggregatedHiddenEvent
+{
+    [self expectationForHiddenEventNotificationWithHandler:^BOOL(NSString *event, NSDictionary *labels) {
+        XCTAssertEqualObjects(labels[@"event_id"], @"hidden_event");
+        XCTAssertEqualObjects(labels[@"event_name"], @"Aggregated event");
+        XCTAssertEqualObjects(labels[@"row"], @"3");
+        XCTAssertEqualObjects(labels[@"event_count"], @"2");
+        XCTAssertEqualObjects(labels[@"event_value_sum"], @"5");
+        return YES;
+    }];
+    
+    [SRGAnalyticsTracker.sharedTracker aggregateHiddenEventWithName:@"Aggregated event" dimensions:@{ @"row" : @"3" } value:2.];
+    [SRGAnalyticsTracker.sharedTracker aggregateHiddenEventWithName:@"Aggregated event" dimensions:@{ @"row" : @"3" } value:3.];
+    [SRGAnalyticsTracker.sharedTracker flushAggregatedHiddenEvents];
+    
+    [self waitForExpectationsWithTimeout:20. handler:nil];
+}
+
+- (void)testDrain
+{
+    [self expectationForHiddenEventNotificationWithHandler:^BOOL(NSString *event, NSDictionary *labels) {
+        return [labels[@"event_name"] isEqualToString:@"Drained event"];
+    }];
+    
+    [SRGAnalyticsTracker.sharedTracker trackHiddenEventWithName:@"Drained event"];
+    XCTAssertTrue([SRGAnalyticsTracker.sharedTracker drainWithTimeout:10.]);
+    
+    [self waitForExpectationsWithTimeout:20. handler:nil];
+}
+
 - (void)testHiddenEventWithEmptyTitle
 {
     id eventObserver = [NSNotificationCenter.defaultCenter addObserverForHiddenEventNotificationUsingBlock:^(NSString * _Nonnull event, NSDictionary * _Nonnull labels) {